@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+
+import sys
+import os
+import struct
+import plistlib
+import datetime
+
+# the layout of the audit log, which must be kept in sync with common/SLAuditLog.h and common/SLAuditLog.c
+AUDIT_LOG_MAGIC = 0x4C414C53
+AUDIT_LOG_VERSION = 2
+AUDIT_LOG_HEADER_FORMAT = "<IHHIIQ40x"
+AUDIT_LOG_RECORD_FORMAT = "<IBBBBQIIII"
+
+# the location of the log on the device, which can be pulled with scp to decode it
+AUDIT_LOG_DEVICE_PATH = "/var/mobile/Library/Preferences/com.joshuaseltzer.sleeper.auditlog"
+
+# the names of the values of the hook, decision, and reason enums in SLAuditLog.h
+HOOK_NAMES = {
+    1: "setSpecificContent",
+    2: "publishBulletin",
+    3: "publishBulletinLegacy",
+    4: "skipAlert",
+    5: "updateAlarms",
+}
+DECISION_NAMES = ["fire", "skip", "update"]
+REASON_NONE = 0
+REASON_CUSTOM_DATE = 4
+REASON_HOLIDAY = 5
+REASON_SKIP_RULE = 6
+REASON_SHARED_DECISION = 7
+REASON_AUTO_SET_SUNRISE = 9
+REASON_AUTO_SET_SUNSET = 10
+REASON_NAMES = ["no skip date", "no prefs", "skip disabled", "popup", "custom date", "holiday", "skip rule", "shared decision",
+                "user response", "auto-set sunrise", "auto-set sunset"]
+
+# the keys of the preferences file that are used to name the alarms
+ALARMS_KEY = "Alarms"
+ALARM_ID_KEY = "alarmId"
+
+# the offset basis and prime of the 32-bit FNV-1a hash that is used for the alarm Ids
+HASH_OFFSET_BASIS = 2166136261
+HASH_PRIME = 16777619
+
+# returns the 32-bit FNV-1a hash of the given alarm Id, matching SLAuditLogHashAlarmId
+def hash_alarm_id(alarm_id):
+    hash_value = HASH_OFFSET_BASIS
+    for byte in alarm_id.encode("utf-8"):
+        hash_value = ((hash_value ^ byte) * HASH_PRIME) & 0xFFFFFFFF
+    return hash_value
+
+# returns a dictionary of the alarm Ids in the given preferences file, keyed by their hashes
+def load_alarm_ids(prefs_file_path):
+    with open(prefs_file_path, 'rb') as fp:
+        prefs = plistlib.load(fp)
+    alarm_ids = {}
+    for alarm in prefs.get(ALARMS_KEY, []):
+        alarm_id = alarm.get(ALARM_ID_KEY)
+        if alarm_id is not None:
+            alarm_ids[hash_alarm_id(alarm_id)] = alarm_id
+    return alarm_ids
+
+# Returns a function that names a holiday from its holiday country and Id using the holiday resources in the Sleeper bundle, or None if
+# the holiday generator can not be loaded.  The holidays that a subdivision observes from its country are recorded for the country.
+def load_holiday_namer():
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    try:
+        import holiday_gen
+        regions = holiday_gen.holiday_regions()
+    except (ImportError, OSError):
+        return None
+    names = {}
+    for holiday_country, region in enumerate(regions):
+        plist_file_path = os.path.join(holiday_gen.SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(region[1]))
+        with open(plist_file_path, 'rb') as fp:
+            for holiday in plistlib.load(fp).get(holiday_gen.HOLIDAYS_KEY, []):
+                if holiday_gen.ID_KEY in holiday:
+                    names[(holiday_country, holiday[holiday_gen.ID_KEY])] = "{0}: {1}".format(region[1], holiday[holiday_gen.NAME_KEY])
+    return lambda holiday_country, holiday_id: names.get((holiday_country, holiday_id),
+                                                         "country {0} holiday {1}".format(holiday_country, holiday_id))
+
+# Reads the records from the given log, returning them in the order that they were appended.  Records that were being written when the
+# log was pulled (or that were overwritten by a later lap while being read) are skipped.
+def read_records(log_file_path):
+    with open(log_file_path, 'rb') as fp:
+        data = fp.read()
+    header_size = struct.calcsize(AUDIT_LOG_HEADER_FORMAT)
+    record_size = struct.calcsize(AUDIT_LOG_RECORD_FORMAT)
+    if len(data) < header_size:
+        raise ValueError("the log is too short to contain a header")
+    magic, version, header_record_size, capacity, _, next_index = struct.unpack_from(AUDIT_LOG_HEADER_FORMAT, data, 0)
+    if magic != AUDIT_LOG_MAGIC or version != AUDIT_LOG_VERSION or header_record_size != record_size:
+        raise ValueError("the log does not have a supported layout (magic {0:#x}, version {1})".format(magic, version))
+    if len(data) < header_size + capacity * record_size:
+        raise ValueError("the log is truncated")
+
+    records = []
+    num_torn = 0
+    for index in range(max(next_index - capacity, 0), next_index):
+        fields = struct.unpack_from(AUDIT_LOG_RECORD_FORMAT, data, header_size + (index % capacity) * record_size)
+        if fields[0] != (index + 1) & 0xFFFFFFFF:
+            num_torn += 1
+            continue
+        records.append((index,) + fields[1:])
+    return records, num_torn, next_index
+
+# returns the modification time of the preferences file that is stored in a record (in seconds since 1970), or "-" if there was no file
+def describe_prefs_modification_time(prefs_modification_time):
+    if prefs_modification_time == 0:
+        return "-"
+    return datetime.datetime.fromtimestamp(prefs_modification_time, datetime.timezone.utc).strftime('%Y-%m-%d %H:%M:%S')
+
+# returns a readable description of the detail of a record, which depends on the reason for the decision
+def describe_detail(reason, holiday_country, detail_id, holiday_namer):
+    if reason == REASON_HOLIDAY:
+        if holiday_namer is not None:
+            return holiday_namer(holiday_country, detail_id)
+        return "country {0} holiday {1}".format(holiday_country, detail_id)
+    elif reason == REASON_CUSTOM_DATE or reason == REASON_SHARED_DECISION:
+        return (datetime.date(1970, 1, 1) + datetime.timedelta(days=detail_id)).isoformat()
+    elif reason == REASON_SKIP_RULE:
+        return "rule {0}".format(detail_id)
+    elif reason == REASON_AUTO_SET_SUNRISE or reason == REASON_AUTO_SET_SUNSET:
+        return "{0:02d}:{1:02d}".format(detail_id // 60, detail_id % 60)
+    return ""
+
+# prints the timeline of the records in the given log
+def decode_log(log_file_path, prefs_file_path=None):
+    alarm_ids = load_alarm_ids(prefs_file_path) if prefs_file_path is not None else {}
+    holiday_namer = load_holiday_namer()
+    records, num_torn, next_index = read_records(log_file_path)
+    for index, hook, decision, reason, holiday_country, timestamp, alarm_id_hash, detail_id, prefs_modification_time, process_id in records:
+        time_string = datetime.datetime.fromtimestamp(timestamp / 1000000, datetime.timezone.utc).strftime('%Y-%m-%d %H:%M:%S.%f')
+        decision_name = DECISION_NAMES[decision] if decision < len(DECISION_NAMES) else str(decision)
+        reason_name = REASON_NAMES[reason] if reason < len(REASON_NAMES) else str(reason)
+        print("{0:>8} {1} pid {2:<6} {3:<22} {4:<36} {5:<6} {6:<16} prefs {7:<19} {8}".format(
+              index, time_string, process_id, HOOK_NAMES.get(hook, str(hook)), alarm_ids.get(alarm_id_hash, "{0:08x}".format(alarm_id_hash)),
+              decision_name, reason_name, describe_prefs_modification_time(prefs_modification_time), describe_detail(reason, holiday_country, detail_id, holiday_namer)).rstrip())
+    print("{0} records ({1} appended in total, {2} torn)".format(len(records), next_index, num_torn))
+
+if __name__== "__main__":
+    if len(sys.argv) == 2:
+        # decode the log that was pulled from the device (e.g. scp mobile@<device>:<AUDIT_LOG_DEVICE_PATH> .)
+        decode_log(sys.argv[1])
+    elif len(sys.argv) == 3:
+        # decode the log using the alarm Ids from the preferences file that was pulled along with it
+        decode_log(sys.argv[1], sys.argv[2])
+    else:
+        print("Incorrect usage! Please supply the path to the audit log (and optionally the path to the preferences file).")
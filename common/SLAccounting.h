@@ -0,0 +1,96 @@
+//
+//  SLAccounting.h
+//  Debug accounting of the work that is performed by each entry point into the decision logic of the tweak.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// the entry points into the decision logic that work is attributed to
+typedef enum SLAccountingEntryPoint : NSInteger {
+    // +[SLPrefsManager alarmPrefsForAlarmId:]
+    kSLAccountingEntryPointAlarmPrefs,
+    // -[SLAlarmPrefs shouldSkipToday]
+    kSLAccountingEntryPointShouldSkipToday,
+    // +[SLCompatibilityHelper updateAlarms:withBaseHour:withBaseMinute:]
+    kSLAccountingEntryPointUpdateAlarms,
+    // +[SLCompatibilityHelper isAlarmSkippableForAlarmId:withNextFireDate:]
+    kSLAccountingEntryPointIsAlarmSkippable,
+    // the scan for the next skippable alarm when the device is unlocked
+    kSLAccountingEntryPointUnlockScan,
+    kSLAccountingEntryPointNumEntryPoints
+} SLAccountingEntryPoint;
+
+// the work that is counted for each entry point
+typedef enum SLAccountingMetric : NSInteger {
+    // the number of times the entry point was called
+    kSLAccountingMetricCalls,
+    // the objects that are created for an alarm (the alarm preferences and their compiled skip rules)
+    kSLAccountingMetricObjects,
+    // the number of bytes that are read from the preferences file
+    kSLAccountingMetricBytesRead,
+    // the number of times the preferences file is opened
+    kSLAccountingMetricFileOpens,
+    // the number of times the entire preferences file is parsed
+    kSLAccountingMetricPrefsParses,
+    // the number of dates that are converted with the date formatter for the preferences
+    kSLAccountingMetricFormatterCalls,
+    kSLAccountingMetricNumMetrics
+} SLAccountingMetric;
+
+// the budget of a metric that is not limited
+#define kSLAccountingNoBudget       UINT64_MAX
+
+#ifdef DEBUG
+
+// an entry point that is active on the current thread, along with the counts for the thread when the entry point was entered
+typedef struct SLAccountingScope {
+    SLAccountingEntryPoint entryPoint;
+    uint32_t previousEntryPoints;
+    uint64_t startCounts[kSLAccountingMetricNumMetrics];
+} SLAccountingScope;
+
+// Enters the given entry point on the current thread.  Any work that is recorded on the thread is attributed to every entry point that is
+// active, so the work of a nested entry point is also counted for the entry points that called it.
+SLAccountingScope SLAccountingEnterEntryPoint(SLAccountingEntryPoint entryPoint);
+
+// exits the entry point for the given scope, checking the work that was recorded during the call against the budgets of the entry point
+void SLAccountingExitEntryPoint(SLAccountingScope *scope);
+
+// records the given amount of work for every entry point that is active on the current thread
+void SLAccountingRecordMetric(SLAccountingMetric metric, uint64_t count);
+
+// returns the total amount of work that has been recorded for the given entry point since the counters were last reset
+uint64_t SLAccountingCount(SLAccountingEntryPoint entryPoint, SLAccountingMetric metric);
+
+// returns the number of calls to the given entry point that have exceeded any of its budgets since the counters were last reset
+uint64_t SLAccountingBudgetViolations(SLAccountingEntryPoint entryPoint);
+
+// sets the maximum amount of work for the given metric that a single call to the given entry point can perform (or kSLAccountingNoBudget)
+void SLAccountingSetBudget(SLAccountingEntryPoint entryPoint, SLAccountingMetric metric, uint64_t budget);
+
+// sets whether or not a call that exceeds a budget aborts the process (instead of only being logged), which can be used to fail a run
+void SLAccountingSetAbortsOnBudgetViolation(BOOL abortsOnBudgetViolation);
+
+// resets all of the counters and budget violations
+void SLAccountingReset(void);
+
+// returns a dictionary of the counters and budget violations for each entry point, keyed by the names of the entry points and metrics
+NSDictionary *SLAccountingReport(void);
+
+// Enters the given entry point until the end of the enclosing scope.  Every entry point is expected to use this on its first line.
+#define SLAccountingEnter(entryPoint)       SLAccountingScope slAccountingScope __attribute__((cleanup(SLAccountingExitEntryPoint), unused)) = \
+                                            SLAccountingEnterEntryPoint(entryPoint)
+
+// records the given amount of work for the entry points that are active on the current thread
+#define SLAccountingRecord(metric, count)   SLAccountingRecordMetric(metric, count)
+
+#else
+
+// the accounting is compiled out of release builds
+#define SLAccountingEnter(entryPoint)
+#define SLAccountingRecord(metric, count)
+
+#endif
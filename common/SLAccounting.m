@@ -0,0 +1,199 @@
+//
+//  SLAccounting.m
+//  Debug accounting of the work that is performed by each entry point into the decision logic of the tweak.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import "SLAccounting.h"
+
+#ifdef DEBUG
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+// the names of the entry points and metrics that are used in the report
+static NSString *const kSLAccountingEntryPointNames[kSLAccountingEntryPointNumEntryPoints] = {
+    @"alarmPrefsForAlarmId",
+    @"shouldSkipToday",
+    @"updateAlarms",
+    @"isAlarmSkippable",
+    @"unlockScan"
+};
+static NSString *const kSLAccountingMetricNames[kSLAccountingMetricNumMetrics] = {
+    @"calls",
+    @"objects",
+    @"bytesRead",
+    @"fileOpens",
+    @"prefsParses",
+    @"formatterCalls"
+};
+
+// the key for the budget violations of each entry point in the report
+static NSString *const kSLAccountingBudgetViolationsKey = @"budgetViolations";
+
+// The default budgets for a single call to each entry point (in the same order as the metrics).  These keep the alarm-fire path from
+// parsing the preferences file (or formatting dates) more than once for each decision, while the first call after the file is modified
+// is still allowed to load it.
+static const uint64_t kSLAccountingDefaultBudgets[kSLAccountingEntryPointNumEntryPoints][kSLAccountingMetricNumMetrics] = {
+    {kSLAccountingNoBudget, 1, kSLAccountingNoBudget, 1, 1, 1},
+    {kSLAccountingNoBudget, kSLAccountingNoBudget, 0, 0, 0, 1},
+    {kSLAccountingNoBudget, kSLAccountingNoBudget, kSLAccountingNoBudget, 1, 1, kSLAccountingNoBudget},
+    {kSLAccountingNoBudget, kSLAccountingNoBudget, kSLAccountingNoBudget, 1, 1, 2},
+    {kSLAccountingNoBudget, kSLAccountingNoBudget, kSLAccountingNoBudget, 1, 1, kSLAccountingNoBudget}
+};
+
+// the work that has been recorded on a single thread, which is used to find the work that was performed during a single call
+typedef struct SLAccountingThreadState {
+    uint32_t activeEntryPoints;
+    uint64_t counts[kSLAccountingEntryPointNumEntryPoints][kSLAccountingMetricNumMetrics];
+} SLAccountingThreadState;
+
+// the counters that are shared by every thread, which are updated atomically so that they can be read while the entry points are running
+static _Atomic uint64_t sSLAccountingCounts[kSLAccountingEntryPointNumEntryPoints][kSLAccountingMetricNumMetrics];
+static _Atomic uint64_t sSLAccountingBudgetViolations[kSLAccountingEntryPointNumEntryPoints];
+static _Atomic uint64_t sSLAccountingBudgets[kSLAccountingEntryPointNumEntryPoints][kSLAccountingMetricNumMetrics];
+static atomic_bool sSLAccountingAbortsOnBudgetViolation;
+
+// the key for the state of each thread (pthread keys are used since thread-local variables are not available on iOS 8)
+static pthread_key_t sSLAccountingThreadStateKey;
+static pthread_once_t sSLAccountingOnce = PTHREAD_ONCE_INIT;
+
+// creates the key for the state of each thread and loads the default budgets
+static void SLAccountingInitialize(void)
+{
+    pthread_key_create(&sSLAccountingThreadStateKey, free);
+    for (NSInteger entryPoint = 0; entryPoint < kSLAccountingEntryPointNumEntryPoints; entryPoint++) {
+        for (NSInteger metric = 0; metric < kSLAccountingMetricNumMetrics; metric++) {
+            atomic_store_explicit(&sSLAccountingBudgets[entryPoint][metric], kSLAccountingDefaultBudgets[entryPoint][metric], memory_order_relaxed);
+        }
+    }
+}
+
+// returns the state of the current thread, creating it if needed (or NULL if it could not be created)
+static SLAccountingThreadState *SLAccountingCurrentThreadState(void)
+{
+    pthread_once(&sSLAccountingOnce, SLAccountingInitialize);
+    SLAccountingThreadState *state = pthread_getspecific(sSLAccountingThreadStateKey);
+    if (state == NULL) {
+        state = calloc(1, sizeof(SLAccountingThreadState));
+        if (state != NULL && pthread_setspecific(sSLAccountingThreadStateKey, state) != 0) {
+            free(state);
+            state = NULL;
+        }
+    }
+    return state;
+}
+
+// enters the given entry point on the current thread
+SLAccountingScope SLAccountingEnterEntryPoint(SLAccountingEntryPoint entryPoint)
+{
+    SLAccountingScope scope = {entryPoint, 0, {0}};
+    SLAccountingThreadState *state = SLAccountingCurrentThreadState();
+    if (state != NULL) {
+        scope.previousEntryPoints = state->activeEntryPoints;
+        memcpy(scope.startCounts, state->counts[entryPoint], sizeof(scope.startCounts));
+        state->activeEntryPoints |= 1 << entryPoint;
+        ++state->counts[entryPoint][kSLAccountingMetricCalls];
+    }
+    atomic_fetch_add_explicit(&sSLAccountingCounts[entryPoint][kSLAccountingMetricCalls], 1, memory_order_relaxed);
+    return scope;
+}
+
+// exits the entry point for the given scope, checking the work that was recorded during the call against the budgets of the entry point
+void SLAccountingExitEntryPoint(SLAccountingScope *scope)
+{
+    SLAccountingThreadState *state = SLAccountingCurrentThreadState();
+    if (state == NULL) {
+        return;
+    }
+    state->activeEntryPoints = scope->previousEntryPoints;
+
+    BOOL exceededBudget = NO;
+    for (NSInteger metric = 0; metric < kSLAccountingMetricNumMetrics; metric++) {
+        uint64_t count = state->counts[scope->entryPoint][metric] - scope->startCounts[metric];
+        uint64_t budget = atomic_load_explicit(&sSLAccountingBudgets[scope->entryPoint][metric], memory_order_relaxed);
+        if (count > budget) {
+            NSLog(@"Sleeper: a call to %@ exceeded its %@ budget (%llu with a budget of %llu)", kSLAccountingEntryPointNames[scope->entryPoint],
+                  kSLAccountingMetricNames[metric], count, budget);
+            exceededBudget = YES;
+        }
+    }
+    if (exceededBudget) {
+        atomic_fetch_add_explicit(&sSLAccountingBudgetViolations[scope->entryPoint], 1, memory_order_relaxed);
+        if (atomic_load_explicit(&sSLAccountingAbortsOnBudgetViolation, memory_order_relaxed)) {
+            abort();
+        }
+    }
+}
+
+// records the given amount of work for every entry point that is active on the current thread
+void SLAccountingRecordMetric(SLAccountingMetric metric, uint64_t count)
+{
+    SLAccountingThreadState *state = SLAccountingCurrentThreadState();
+    if (state == NULL) {
+        return;
+    }
+    for (NSInteger entryPoint = 0; entryPoint < kSLAccountingEntryPointNumEntryPoints; entryPoint++) {
+        if (state->activeEntryPoints & (1 << entryPoint)) {
+            state->counts[entryPoint][metric] += count;
+            atomic_fetch_add_explicit(&sSLAccountingCounts[entryPoint][metric], count, memory_order_relaxed);
+        }
+    }
+}
+
+// returns the total amount of work that has been recorded for the given entry point since the counters were last reset
+uint64_t SLAccountingCount(SLAccountingEntryPoint entryPoint, SLAccountingMetric metric)
+{
+    return atomic_load_explicit(&sSLAccountingCounts[entryPoint][metric], memory_order_relaxed);
+}
+
+// returns the number of calls to the given entry point that have exceeded any of its budgets since the counters were last reset
+uint64_t SLAccountingBudgetViolations(SLAccountingEntryPoint entryPoint)
+{
+    return atomic_load_explicit(&sSLAccountingBudgetViolations[entryPoint], memory_order_relaxed);
+}
+
+// sets the maximum amount of work for the given metric that a single call to the given entry point can perform
+void SLAccountingSetBudget(SLAccountingEntryPoint entryPoint, SLAccountingMetric metric, uint64_t budget)
+{
+    pthread_once(&sSLAccountingOnce, SLAccountingInitialize);
+    atomic_store_explicit(&sSLAccountingBudgets[entryPoint][metric], budget, memory_order_relaxed);
+}
+
+// sets whether or not a call that exceeds a budget aborts the process
+void SLAccountingSetAbortsOnBudgetViolation(BOOL abortsOnBudgetViolation)
+{
+    atomic_store_explicit(&sSLAccountingAbortsOnBudgetViolation, abortsOnBudgetViolation, memory_order_relaxed);
+}
+
+// resets all of the counters and budget violations (the state of each thread is only used to find the work of a single call)
+void SLAccountingReset(void)
+{
+    for (NSInteger entryPoint = 0; entryPoint < kSLAccountingEntryPointNumEntryPoints; entryPoint++) {
+        for (NSInteger metric = 0; metric < kSLAccountingMetricNumMetrics; metric++) {
+            atomic_store_explicit(&sSLAccountingCounts[entryPoint][metric], 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&sSLAccountingBudgetViolations[entryPoint], 0, memory_order_relaxed);
+    }
+}
+
+// returns a dictionary of the counters and budget violations for each entry point
+NSDictionary *SLAccountingReport(void)
+{
+    NSMutableDictionary *report = [[NSMutableDictionary alloc] initWithCapacity:kSLAccountingEntryPointNumEntryPoints];
+    for (NSInteger entryPoint = 0; entryPoint < kSLAccountingEntryPointNumEntryPoints; entryPoint++) {
+        NSMutableDictionary *entryPointReport = [[NSMutableDictionary alloc] initWithCapacity:kSLAccountingMetricNumMetrics + 1];
+        for (NSInteger metric = 0; metric < kSLAccountingMetricNumMetrics; metric++) {
+            [entryPointReport setObject:[NSNumber numberWithUnsignedLongLong:SLAccountingCount((SLAccountingEntryPoint)entryPoint, (SLAccountingMetric)metric)]
+                                 forKey:kSLAccountingMetricNames[metric]];
+        }
+        [entryPointReport setObject:[NSNumber numberWithUnsignedLongLong:SLAccountingBudgetViolations((SLAccountingEntryPoint)entryPoint)]
+                             forKey:kSLAccountingBudgetViolationsKey];
+        [report setObject:[entryPointReport copy] forKey:kSLAccountingEntryPointNames[entryPoint]];
+    }
+    return [report copy];
+}
+
+#endif
@@ -7,69 +7,9 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "SLHolidayCountries.h"
+#import "SLAuditLog.h"
 
-// enum that defines the rows countries that are available to choose from for the holiday selection
-typedef enum SLHolidayCountry : NSInteger {
-    kSLHolidayCountryArgentina,
-    kSLHolidayCountryAruba,
-    kSLHolidayCountryAustralia,
-    kSLHolidayCountryAustria,
-    kSLHolidayCountryBelarus,
-    kSLHolidayCountryBelgium,
-    kSLHolidayCountryBrazil,
-    kSLHolidayCountryBulgaria,
-    kSLHolidayCountryCanada,
-    kSLHolidayCountryChina,
-    kSLHolidayCountryColombia,
-    kSLHolidayCountryCroatia,
-    kSLHolidayCountryCzechia,
-    kSLHolidayCountryDenmark,
-    kSLHolidayCountryDominicanRepublic,
-    kSLHolidayCountryEgypt,
-    kSLHolidayCountryEstonia,
-    kSLHolidayCountryFinland,
-    kSLHolidayCountryFrance,
-    kSLHolidayCountryGermany,
-    kSLHolidayCountryHongKong,
-    kSLHolidayCountryHungary,
-    kSLHolidayCountryIceland,
-    kSLHolidayCountryIndia,
-    kSLHolidayCountryIreland,
-    kSLHolidayCountryIsrael,
-    kSLHolidayCountryItaly,
-    kSLHolidayCountryJapan,
-    kSLHolidayCountryKenya,
-    kSLHolidayCountryKorea,
-    kSLHolidayCountryLithuania,
-    kSLHolidayCountryLuxembourg,
-    kSLHolidayCountryMexico,
-    kSLHolidayCountryMorocco,
-    kSLHolidayCountryNetherlands,
-    kSLHolidayCountryNewZealand,
-    kSLHolidayCountryNicaragua,
-    kSLHolidayCountryNigeria,
-    kSLHolidayCountryNorway,
-    kSLHolidayCountryParaguay,
-    kSLHolidayCountryPeru,
-    kSLHolidayCountryPoland,
-    kSLHolidayCountryPortugal,
-    kSLHolidayCountryRussia,
-    kSLHolidayCountrySerbia,
-    kSLHolidayCountrySingapore,
-    kSLHolidayCountrySlovakia,
-    kSLHolidayCountrySlovenia,
-    kSLHolidayCountrySouthAfrica,
-    kSLHolidayCountrySpain,
-    kSLHolidayCountrySweden,
-    kSLHolidayCountrySwitzerland,
-    kSLHolidayCountryTaiwan,
-    kSLHolidayCountryTurkey,
-    kSLHolidayCountryUkraine,
-    kSLHolidayCountryUnitedKingdom,
-    kSLHolidayCountryUnitedStates,
-    kSLHolidayCountryVietnam,
-    kSLHolidayCountryNumCountries
-} SLHolidayCountry;
 
 // enum to define the different options that can be returned for the alarm's skip activation
 typedef enum SLSkipActivatedStatus : NSInteger {
@@ -116,12 +56,18 @@ static NSInteger const kSLDefaultAutoSetOffsetMinute =  0;
 // returns the total number of selected holidays to be skipped for the given alarm
 - (NSInteger)totalSelectedHolidays;
 
+// returns the set of selected holiday IDs for the given holiday country
+- (SLHolidaySelection)holidaySelectionForHolidayCountry:(SLHolidayCountry)holidayCountry;
+
 // returns a customized string that indicates the total number of selected skip dates and/or holidays
 - (NSString *)totalSelectedDatesString;
 
 // determines whether or not this alarm should be skipped today
 - (BOOL)shouldSkipToday;
 
+// determines whether or not this alarm should be skipped today, filling in the cause of the decision (if given) for the audit log
+- (BOOL)shouldSkipTodayWithCause:(SLAuditCause *)cause;
+
 // determines whether or not the alarm should be skipped on a given date
 - (BOOL)shouldSkipOnDate:(NSDate *)date;
 
@@ -173,7 +119,18 @@ static NSInteger const kSLDefaultAutoSetOffsetMinute =  0;
 // an array of NSDate objects that represent the custom skip dates for this alarm
 @property (nonatomic, strong) NSArray *customSkipDates;
 
-// a dictionary containing additional dictionaries that correspond to the selected holidays per country
+// a dictionary containing the selected holidays per country, keyed by the resource name of each country (each selection is an NSNumber
+// that contains an SLHolidaySelection)
 @property (nonatomic, strong) NSDictionary *holidaySkipDates;
 
+// an array of dictionaries that represent the recurring skip rules for this alarm (see the skip rule keys in SLPrefsManager.h)
+@property (nonatomic, strong) NSArray *skipRules;
+
+// the Id of the skip profile that provides the skip dates for this alarm, or nil if the alarm uses its own skip dates
+@property (nonatomic, strong) NSString *skipProfileId;
+
+// The generation of the preferences that this object was loaded from, which is used to share the skip decisions of a skip profile between
+// alarms.  This is reset to 0 whenever any of the skip dates are modified.
+@property (nonatomic) NSUInteger prefsGeneration;
+
 @end
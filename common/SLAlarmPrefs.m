@@ -9,6 +9,67 @@
 #import "SLAlarmPrefs.h"
 #import "SLPrefsManager.h"
 #import "SLLocalizedStrings.h"
+#import "SLHolidayManager.h"
+#import "SLClock.h"
+#import "SLSkipRules.h"
+#import "SLAccounting.h"
+
+// compiles the given skip rule dictionary from the preferences, returning NO if the rule is not valid
+static BOOL SLCompileSkipRule(NSDictionary *skipRuleDictionary, SLSkipRule *skipRule)
+{
+    if (![skipRuleDictionary isKindOfClass:[NSDictionary class]]) {
+        return NO;
+    }
+
+    // every rule must have a start date, while only date ranges require an end date
+    NSString *type = [skipRuleDictionary objectForKey:kSLSkipRuleTypeKey];
+    NSString *startDateString = [skipRuleDictionary objectForKey:kSLSkipRuleStartDateKey];
+    NSString *endDateString = [skipRuleDictionary objectForKey:kSLSkipRuleEndDateKey];
+    memset(skipRule, 0, sizeof(SLSkipRule));
+    if (![startDateString isKindOfClass:[NSString class]] || !SLSkipRuleParseDateString([startDateString UTF8String], &skipRule->startDay)) {
+        return NO;
+    }
+    if ([endDateString isKindOfClass:[NSString class]]) {
+        if (!SLSkipRuleParseDateString([endDateString UTF8String], &skipRule->endDay)) {
+            return NO;
+        }
+    } else if ([type isEqualToString:kSLSkipRuleTypeDateRangeString]) {
+        return NO;
+    } else {
+        skipRule->endDay = kSLSkipRuleNoEndDay;
+    }
+    skipRule->interval = (int32_t)MAX([[skipRuleDictionary objectForKey:kSLSkipRuleIntervalKey] integerValue], 1);
+
+    if ([type isEqualToString:kSLSkipRuleTypeWeeklyString]) {
+        skipRule->type = kSLSkipRuleTypeWeekly;
+        skipRule->weekdays = (uint8_t)([[skipRuleDictionary objectForKey:kSLSkipRuleWeekdaysKey] integerValue] & ((1 << kSLWeekdayNumWeekdays) - 1));
+        return skipRule->weekdays != 0;
+    } else if ([type isEqualToString:kSLSkipRuleTypeNthWeekdayString]) {
+        NSInteger weekday = [[skipRuleDictionary objectForKey:kSLSkipRuleWeekdayKey] integerValue];
+        NSInteger ordinal = [[skipRuleDictionary objectForKey:kSLSkipRuleOrdinalKey] integerValue];
+        if (weekday < kSLWeekdayMonday || weekday > kSLWeekdaySunday || ((ordinal < 1 || ordinal > 5) && ordinal != kSLHolidayRuleLastOrdinal)) {
+            return NO;
+        }
+        skipRule->type = kSLSkipRuleTypeNthWeekday;
+        skipRule->weekday = (SLWeekday)weekday;
+        skipRule->ordinal = (int32_t)ordinal;
+        return YES;
+    } else if ([type isEqualToString:kSLSkipRuleTypeDateRangeString]) {
+        skipRule->type = kSLSkipRuleTypeDateRange;
+        return skipRule->endDay >= skipRule->startDay;
+    }
+    return NO;
+}
+
+@interface SLAlarmPrefs ()
+
+// The compiled skip rules (an array of SLSkipRule structs), the sorted exception days for each compiled rule (NSData objects containing
+// SLDay values), and the rule dictionaries that were compiled.  These are compiled lazily and cleared whenever the skip rules change.
+@property (nonatomic, strong) NSData *compiledSkipRules;
+@property (nonatomic, strong) NSArray *compiledSkipRuleExceptions;
+@property (nonatomic, strong) NSArray *compiledSkipRuleDictionaries;
+
+@end
 
 @implementation SLAlarmPrefs
 
@@ -32,15 +93,86 @@
         self.autoSetOffsetMinute = kSLDefaultAutoSetOffsetMinute;
         self.customSkipDates = [[NSArray alloc] init];
         self.holidaySkipDates = [[NSDictionary alloc] init];
+        self.skipRules = [[NSArray alloc] init];
     }
     return self;
 }
 
+// override the setter for the skip rules so that the compiled rules are recompiled when they are next evaluated
+- (void)setSkipRules:(NSArray *)skipRules
+{
+    _skipRules = skipRules;
+    _prefsGeneration = 0;
+    self.compiledSkipRules = nil;
+    self.compiledSkipRuleExceptions = nil;
+    self.compiledSkipRuleDictionaries = nil;
+}
+
+// override the setters for the remaining skip dates so that the skip decisions of a skip profile are no longer shared with this object
+- (void)setCustomSkipDates:(NSArray *)customSkipDates
+{
+    _customSkipDates = customSkipDates;
+    _prefsGeneration = 0;
+}
+
+- (void)setHolidaySkipDates:(NSDictionary *)holidaySkipDates
+{
+    _holidaySkipDates = holidaySkipDates;
+    _prefsGeneration = 0;
+}
+
+- (void)setSkipProfileId:(NSString *)skipProfileId
+{
+    _skipProfileId = skipProfileId;
+    _prefsGeneration = 0;
+}
+
+// compiles the skip rules into constant-sized records (if they have not already been compiled) so that they can be evaluated quickly
+- (void)compileSkipRulesIfNeeded
+{
+    if (self.compiledSkipRules != nil) {
+        return;
+    }
+
+    NSMutableData *compiledSkipRules = [[NSMutableData alloc] initWithCapacity:self.skipRules.count * sizeof(SLSkipRule)];
+    NSMutableArray *compiledSkipRuleExceptions = [[NSMutableArray alloc] initWithCapacity:self.skipRules.count];
+    NSMutableArray *compiledSkipRuleDictionaries = [[NSMutableArray alloc] initWithCapacity:self.skipRules.count];
+    for (NSDictionary *skipRuleDictionary in self.skipRules) {
+        SLSkipRule skipRule;
+        if (!SLCompileSkipRule(skipRuleDictionary, &skipRule)) {
+            continue;
+        }
+
+        // the exceptions are sorted as days so that they can be searched when finding the next occurrence of a rule
+        NSArray *exceptionStrings = [skipRuleDictionary objectForKey:kSLSkipRuleExceptionsKey];
+        NSMutableData *exceptions = [[NSMutableData alloc] initWithCapacity:exceptionStrings.count * sizeof(SLDay)];
+        for (NSString *exceptionString in exceptionStrings) {
+            SLDay exceptionDay;
+            if ([exceptionString isKindOfClass:[NSString class]] && SLSkipRuleParseDateString([exceptionString UTF8String], &exceptionDay)) {
+                [exceptions appendBytes:&exceptionDay length:sizeof(SLDay)];
+            }
+        }
+        qsort_b(exceptions.mutableBytes, exceptions.length / sizeof(SLDay), sizeof(SLDay), ^int(const void *lhs, const void *rhs) {
+            SLDay lhsDay = *(const SLDay *)lhs;
+            SLDay rhsDay = *(const SLDay *)rhs;
+            return (lhsDay > rhsDay) - (lhsDay < rhsDay);
+        });
+
+        [compiledSkipRules appendBytes:&skipRule length:sizeof(SLSkipRule)];
+        [compiledSkipRuleExceptions addObject:exceptions];
+        [compiledSkipRuleDictionaries addObject:skipRuleDictionary];
+    }
+    self.compiledSkipRuleExceptions = [compiledSkipRuleExceptions copy];
+    self.compiledSkipRuleDictionaries = [compiledSkipRuleDictionaries copy];
+    self.compiledSkipRules = [compiledSkipRules copy];
+    SLAccountingRecord(kSLAccountingMetricObjects, 3 + compiledSkipRuleExceptions.count);
+}
+
 // returns the total number of selected holidays to be skipped for the given alarm
 - (NSInteger)totalSelectedHolidays
 {
     NSInteger total = 0;
-    for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumCountries; holidayCountry++) {
+    for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
         total = total + [self selectedHolidaysForHolidayCountry:holidayCountry];
     }
     return total;
@@ -49,12 +181,16 @@
 // returns the number of selected holidays for the given holiday country
 - (NSInteger)selectedHolidaysForHolidayCountry:(SLHolidayCountry)holidayCountry
 {
-    NSInteger selectedHolidays = 0;
-    NSArray *selectedHolidayNames = [self.holidaySkipDates objectForKey:[SLPrefsManager resourceNameForHolidayCountry:holidayCountry]];
-    if (selectedHolidayNames != nil) {
-        selectedHolidays = selectedHolidayNames.count;
+    return __builtin_popcountll([self holidaySelectionForHolidayCountry:holidayCountry]);
+}
+
+// returns the set of selected holiday IDs for the given holiday country
+- (SLHolidaySelection)holidaySelectionForHolidayCountry:(SLHolidayCountry)holidayCountry
+{
+    if (holidayCountry < 0 || holidayCountry >= kSLHolidayCountryNumRegions) {
+        return 0;
     }
-    return selectedHolidays;
+    return [[self.holidaySkipDates objectForKey:kSLHolidayCountryInfo[holidayCountry].resourceName] unsignedLongLongValue];
 }
 
 // returns a customized string that indicates the total number of selected skip dates and/or holidays
@@ -90,14 +226,61 @@
 // determines whether or not this alarm should be skipped
 - (BOOL)shouldSkipToday
 {
-    NSDate *today = [NSDate date];
-    return self.skipEnabled && ([self shouldSkipFromPopupDecision] || [self shouldSkipFromSelectedDatesOnDate:today] || [self shouldSkipFromSelectedHolidaysOnDate:today]);
+    return [self shouldSkipTodayWithCause:NULL];
+}
+
+// determines whether or not this alarm should be skipped today, filling in the cause of the decision for the audit log
+- (BOOL)shouldSkipTodayWithCause:(SLAuditCause *)cause
+{
+    SLAccountingEnter(kSLAccountingEntryPointShouldSkipToday);
+    return [self shouldSkipOnDate:[SLClock now] cause:cause];
 }
 
 // determines whether or not the alarm should be skipped on a given date
 - (BOOL)shouldSkipOnDate:(NSDate *)date
 {
-    return self.skipEnabled && ([self shouldSkipFromPopupDecision] || [self shouldSkipFromSelectedDatesOnDate:date] || [self shouldSkipFromSelectedHolidaysOnDate:date]);
+    return [self shouldSkipOnDate:date cause:NULL];
+}
+
+// determines whether or not the alarm should be skipped on a given date, filling in the cause of the decision if one is given
+- (BOOL)shouldSkipOnDate:(NSDate *)date cause:(SLAuditCause *)cause
+{
+    SLAuditCause unusedCause;
+    if (cause == NULL) {
+        cause = &unusedCause;
+    }
+    memset(cause, 0, sizeof(SLAuditCause));
+    if (!self.skipEnabled) {
+        cause->reason = kSLAuditReasonSkipDisabled;
+        return NO;
+    } else if ([self shouldSkipFromPopupDecision]) {
+        cause->reason = kSLAuditReasonPopup;
+        return YES;
+    }
+    return [self shouldSkipFromSkipDatesOnDate:date cause:cause];
+}
+
+// Determines whether or not the custom skip dates, selected holidays, or skip rules fall on a particular date.  If the skip dates come from a
+// skip profile, the decision is shared with every other alarm that was loaded from the same preferences and uses the same profile.
+- (BOOL)shouldSkipFromSkipDatesOnDate:(NSDate *)date cause:(SLAuditCause *)cause
+{
+    BOOL shareDecision = self.skipProfileId != nil && self.prefsGeneration != 0;
+    SLDay day = [SLHolidayManager dayForDate:date];
+    if (shareDecision) {
+        NSNumber *skipDecision = [SLPrefsManager skipDecisionForSkipProfileId:self.skipProfileId onDay:day prefsGeneration:self.prefsGeneration];
+        if (skipDecision != nil) {
+            cause->reason = kSLAuditReasonSharedDecision;
+            cause->detailId = (uint32_t)day;
+            return [skipDecision boolValue];
+        }
+    }
+
+    BOOL shouldSkip = [self shouldSkipFromSelectedDatesOnDate:date cause:cause] || [self shouldSkipFromSelectedHolidaysOnDate:date cause:cause] ||
+                      [self shouldSkipFromSkipRulesOnDate:date cause:cause];
+    if (shareDecision) {
+        [SLPrefsManager setSkipDecision:shouldSkip forSkipProfileId:self.skipProfileId onDay:day prefsGeneration:self.prefsGeneration];
+    }
+    return shouldSkip;
 }
 
 // determines whether or not the alarm should be skipped from activating the popup
@@ -107,35 +290,92 @@
 }
 
 // determines whether or not the alarm will be skipped from a custom skip date in a particular date
-- (BOOL)shouldSkipFromSelectedDatesOnDate:(NSDate *)date
+- (BOOL)shouldSkipFromSelectedDatesOnDate:(NSDate *)date cause:(SLAuditCause *)cause
 {
-    for (NSString *skipDateString in self.customSkipDates) {
-        NSDate *skipDate = [[SLPrefsManager plistDateFormatter] dateFromString:skipDateString];
-        if ([[NSCalendar currentCalendar] isDate:skipDate inSameDayAsDate:date]) {
-            return YES;
-        }
+    // the custom skip dates are stored sorted, so the day only needs to be converted to a string once and can then be found with a binary search
+    NSUInteger numCustomSkipDates = self.customSkipDates.count;
+    if (numCustomSkipDates == 0) {
+        return NO;
+    }
+    SLDay day = [SLHolidayManager dayForDate:date];
+    NSString *dateString = [SLPrefsManager skipDateStringForDay:day];
+    NSUInteger index = [self.customSkipDates indexOfObject:dateString
+                                             inSortedRange:NSMakeRange(0, numCustomSkipDates)
+                                                   options:NSBinarySearchingFirstEqual
+                                           usingComparator:^NSComparisonResult(NSString *skipDateString1, NSString *skipDateString2) {
+        return [skipDateString1 compare:skipDateString2];
+    }];
+    if (index != NSNotFound) {
+        cause->reason = kSLAuditReasonCustomDate;
+        cause->detailId = (uint32_t)day;
+        return YES;
     }
     return NO;
 }
 
-// determines whether or not the first selected holiday name falls on a particular date
-- (BOOL)shouldSkipFromSelectedHolidaysOnDate:(NSDate *)date
+// determines whether or not any of the recurring skip rules occur on a particular date (exceptions to a rule are not skipped)
+- (BOOL)shouldSkipFromSkipRulesOnDate:(NSDate *)date cause:(SLAuditCause *)cause
 {
-    for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumCountries; holidayCountry++) {
-        // check to see if any holidays are selected for the given holiday country
-        NSArray *selectedHolidayNames = [self.holidaySkipDates objectForKey:[SLPrefsManager resourceNameForHolidayCountry:holidayCountry]];
-        if (selectedHolidayNames != nil) {
-            for (NSString *holidayName in selectedHolidayNames) {
-                NSDate *firstHolidayDate = [SLPrefsManager firstSkipDateForHolidayName:holidayName inHolidayCountry:holidayCountry];
-                if (firstHolidayDate != nil && [[NSCalendar currentCalendar] isDate:firstHolidayDate inSameDayAsDate:date]) {
-                    return YES;
-                }
+    if (self.skipRules.count == 0) {
+        return NO;
+    }
+
+    [self compileSkipRulesIfNeeded];
+    const SLSkipRule *skipRules = self.compiledSkipRules.bytes;
+    NSUInteger numSkipRules = self.compiledSkipRules.length / sizeof(SLSkipRule);
+    SLDay day = [SLHolidayManager dayForDate:date];
+    for (NSUInteger i = 0; i < numSkipRules; i++) {
+        if (SLSkipRuleOccursOnDay(&skipRules[i], day)) {
+            NSData *exceptions = [self.compiledSkipRuleExceptions objectAtIndex:i];
+            SLDay nextDay;
+            if (SLSkipRuleNextDay(&skipRules[i], day, exceptions.bytes, exceptions.length / sizeof(SLDay), &nextDay) && nextDay == day) {
+                cause->reason = kSLAuditReasonSkipRule;
+                cause->detailId = (uint32_t)i;
+                return YES;
             }
         }
     }
     return NO;
 }
 
+// Fills the given array (indexed by the holiday country) with the holiday selections for every holiday country and subdivision so that
+// the holidays can be tested with a single bit operation.  The selection of a subdivision only contains its regional holidays, since the
+// holidays that it observes from its country are selected for the country.
+- (void)getHolidaySelections:(SLHolidaySelection *)holidaySelections
+{
+    for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
+        holidaySelections[holidayCountry] = [self holidaySelectionForHolidayCountry:holidayCountry];
+    }
+}
+
+// determines whether or not any of the selected holidays fall on a particular date
+- (BOOL)shouldSkipFromSelectedHolidaysOnDate:(NSDate *)date cause:(SLAuditCause *)cause
+{
+    // no need to check the holiday index if no holidays are selected
+    if (self.holidaySkipDates.count == 0) {
+        return NO;
+    }
+
+    // seek to the given day in the holiday index and check if any of the holidays on that day are selected
+    __block BOOL shouldSkip = NO;
+    SLHolidaySelection holidaySelectionsArray[kSLHolidayCountryNumRegions];
+    SLHolidaySelection *holidaySelections = holidaySelectionsArray;
+    [self getHolidaySelections:holidaySelections];
+    SLDay day = [SLHolidayManager dayForDate:date];
+    [[SLHolidayManager sharedInstance] enumerateHolidaysFromDay:day holidaySelections:holidaySelections usingBlock:^(SLHolidayCountry holidayCountry, NSString *resourceName, NSString *holidayName, SLHolidayId holidayId, SLDay holidayDay, BOOL *stop) {
+        if (holidayDay != day) {
+            *stop = YES;
+        } else if (holidaySelections[holidayCountry] & SLHolidaySelectionForHolidayId(holidayId)) {
+            cause->reason = kSLAuditReasonHoliday;
+            cause->holidayCountry = (uint32_t)holidayCountry;
+            cause->detailId = (uint32_t)holidayId;
+            shouldSkip = YES;
+            *stop = YES;
+        }
+    }];
+    return shouldSkip;
+}
+
 // returns an explanation of why a given alarm will be skipped
 - (NSString *)skipReasonExplanation
 {
@@ -150,7 +390,7 @@
     // check to see if there are any custom skip dates to display
     if (self.customSkipDates != nil && self.customSkipDates.count > 0) {
         // append or create the skip explanation string
-        NSDate *skipDate = [[SLPrefsManager plistDateFormatter] dateFromString:[self.customSkipDates objectAtIndex:0]];
+        NSDate *skipDate = [SLPrefsManager dateForSkipDateString:[self.customSkipDates objectAtIndex:0]];
         NSString *skipExplanationDateString = kSLSkipReasonDateString([SLPrefsManager skipDateStringForDate:skipDate showRelativeString:YES]);
         if (skipExplanation != nil) {
             [skipExplanation appendString:@"\n\n"];
@@ -160,15 +400,31 @@
         }
     }
     
-    // grab the first available selected holiday date and name
-    NSString *firstSelectedHolidayName = nil;
-    NSDate *firstSelectedHolidayDate = nil;
-    for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumCountries; holidayCountry++) {
-        // check to see if any holidays are selected for the given holiday country
-        NSArray *selectedHolidayNames = [self.holidaySkipDates objectForKey:[SLPrefsManager resourceNameForHolidayCountry:holidayCountry]];
-        if (selectedHolidayNames != nil) {
-            for (NSString *holidayName in selectedHolidayNames) {
-                NSDate *firstHolidayDate = [SLPrefsManager firstSkipDateForHolidayName:holidayName inHolidayCountry:holidayCountry];
+    // grab the first available selected holiday date and name from the holiday index
+    __block NSString *firstSelectedHolidayName = nil;
+    __block NSDate *firstSelectedHolidayDate = nil;
+    if (self.holidaySkipDates.count > 0) {
+        SLHolidaySelection holidaySelectionsArray[kSLHolidayCountryNumRegions];
+        SLHolidaySelection *holidaySelections = holidaySelectionsArray;
+        [self getHolidaySelections:holidaySelections];
+        [[SLHolidayManager sharedInstance] enumerateHolidaysFromDay:[SLHolidayManager dayForDate:[SLClock now]] holidaySelections:holidaySelections usingBlock:^(SLHolidayCountry holidayCountry, NSString *resourceName, NSString *holidayName, SLHolidayId holidayId, SLDay holidayDay, BOOL *stop) {
+            if (holidaySelections[holidayCountry] & SLHolidaySelectionForHolidayId(holidayId)) {
+                firstSelectedHolidayDate = [SLHolidayManager dateForDay:holidayDay];
+                firstSelectedHolidayName = holidayName;
+                *stop = YES;
+            }
+        }];
+
+        // if none of the selected holidays occur within the holiday index, search the selected holidays for each country individually
+        if (firstSelectedHolidayDate == nil) {
+            for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
+                if (holidaySelections[holidayCountry] == 0) {
+                    continue;
+                }
+                NSString *holidayName = nil;
+                NSDate *firstHolidayDate = [SLPrefsManager firstSkipDateForHolidaySelection:holidaySelections[holidayCountry]
+                                                                           inHolidayCountry:holidayCountry
+                                                                                holidayName:&holidayName];
                 if (firstHolidayDate != nil && (firstSelectedHolidayDate == nil || [firstHolidayDate compare:firstSelectedHolidayDate] == NSOrderedAscending)) {
                     firstSelectedHolidayDate = firstHolidayDate;
                     firstSelectedHolidayName = holidayName;
@@ -189,6 +445,37 @@
         }
     }
 
+    // find the next day that any of the recurring skip rules occur on
+    if (self.skipRules.count > 0) {
+        [self compileSkipRulesIfNeeded];
+        const SLSkipRule *skipRules = self.compiledSkipRules.bytes;
+        NSUInteger numSkipRules = self.compiledSkipRules.length / sizeof(SLSkipRule);
+        SLDay today = [SLHolidayManager dayForDate:[SLClock now]];
+        NSDictionary *firstSkipRule = nil;
+        SLDay firstSkipRuleDay = 0;
+        for (NSUInteger i = 0; i < numSkipRules; i++) {
+            NSData *exceptions = [self.compiledSkipRuleExceptions objectAtIndex:i];
+            SLDay nextDay;
+            if (SLSkipRuleNextDay(&skipRules[i], today, exceptions.bytes, exceptions.length / sizeof(SLDay), &nextDay) &&
+                (firstSkipRule == nil || nextDay < firstSkipRuleDay)) {
+                firstSkipRule = [self.compiledSkipRuleDictionaries objectAtIndex:i];
+                firstSkipRuleDay = nextDay;
+            }
+        }
+
+        // append or create the skip explanation string
+        if (firstSkipRule != nil) {
+            NSString *skipExplanationRuleString = kSLSkipReasonRuleString([SLPrefsManager skipDateStringForDate:[SLHolidayManager dateForDay:firstSkipRuleDay] showRelativeString:YES],
+                                                                          [SLPrefsManager friendlyNameForSkipRule:firstSkipRule]);
+            if (skipExplanation != nil) {
+                [skipExplanation appendString:@"\n\n"];
+                [skipExplanation appendString:skipExplanationRuleString];
+            } else {
+                skipExplanation = [NSMutableString stringWithString:skipExplanationRuleString];
+            }
+        }
+    }
+
     // if there is no skip explanation up to this point, display the default skip explanation string
     if (skipExplanation == nil) {
         skipExplanation = [NSMutableString stringWithString:kSLSkipExplanationString];
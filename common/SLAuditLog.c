@@ -0,0 +1,170 @@
+//
+//  SLAuditLog.c
+//  Fixed-size binary ring buffer of the skip decisions that is shared by every process that the tweak is injected into.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLAuditLog.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+// the magic number ("SLAL") and version at the start of the log, which is recreated if either of these (or the layout) do not match
+#define kSLAuditLogMagic                0x4C414C53
+#define kSLAuditLogVersion              2
+
+// The location of the preferences file (relative to the home directory), whose modification time is stored in each record so that the
+// records of different processes can be matched to the same version of the preferences.  This must be kept in sync with SLPrefsManager.
+#define kSLAuditLogPrefsFileName        "/Library/Preferences/com.joshuaseltzer.sleeper.plist"
+
+// the number of records in the log (a power of 2 so that the slot of a record can be found with a mask)
+#define kSLAuditLogCapacity             1024
+
+// the offset basis and prime of the 32-bit FNV-1a hash
+#define kSLAuditLogHashOffsetBasis      2166136261u
+#define kSLAuditLogHashPrime            16777619u
+
+// The header at the start of the log (64 bytes, little-endian).  The index of the next record only increases, so the record with a given
+// index is stored in the slot at (index % capacity) until it is overwritten one lap later.
+typedef struct SLAuditLogHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t capacity;
+    uint32_t reserved;
+    _Atomic uint64_t nextIndex;
+    uint8_t padding[40];
+} SLAuditLogHeader;
+
+// A single record in the log (32 bytes, little-endian), which directly follows the header.  The sequence is the low 32 bits of
+// (index + 1) once the record has been written and 0 while it is being written, so the decoder can discard any records that were torn
+// or that are left over from an earlier lap.
+typedef struct SLAuditRecord {
+    _Atomic uint32_t sequence;
+    uint8_t hook;
+    uint8_t decision;
+    uint8_t reason;
+    uint8_t holidayCountry;
+    uint64_t timestamp;
+    uint32_t alarmIdHash;
+    uint32_t detailId;
+    uint32_t prefsModificationTime;
+    uint32_t processId;
+} SLAuditRecord;
+
+_Static_assert(sizeof(SLAuditLogHeader) == 64, "the audit log header must match the decoder");
+_Static_assert(sizeof(SLAuditRecord) == 32, "the audit log records must match the decoder");
+
+// the log that is mapped into this process (or NULL if it could not be mapped), along with the identifier of this process and the path of
+// the preferences file
+static SLAuditLogHeader *sSLAuditLogHeader;
+static SLAuditRecord *sSLAuditLogRecords;
+static uint32_t sSLAuditLogProcessId;
+static char sSLAuditLogPrefsPath[1024];
+static pthread_once_t sSLAuditLogOnce = PTHREAD_ONCE_INIT;
+
+// Maps the log into this process, creating (or recreating) the log if it does not have the expected layout.  The file is locked while it
+// is being checked so that the processes that map it at the same time do not initialize it more than once.
+static void SLAuditLogMap(void)
+{
+    sSLAuditLogProcessId = (uint32_t)getpid();
+    const char *homeDirectory = getenv("HOME");
+    if (homeDirectory == NULL) {
+        return;
+    }
+    char path[1024];
+    if (snprintf(path, sizeof(path), "%s%s", homeDirectory, kSLAuditLogFileName) >= (int)sizeof(path)) {
+        return;
+    }
+    if (snprintf(sSLAuditLogPrefsPath, sizeof(sSLAuditLogPrefsPath), "%s%s", homeDirectory, kSLAuditLogPrefsFileName) >=
+        (int)sizeof(sSLAuditLogPrefsPath)) {
+        return;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return;
+    }
+    size_t logSize = sizeof(SLAuditLogHeader) + kSLAuditLogCapacity * sizeof(SLAuditRecord);
+    void *log = MAP_FAILED;
+    struct stat fileStat;
+    if (flock(fd, LOCK_EX) == 0) {
+        if (fstat(fd, &fileStat) == 0 && (fileStat.st_size == (off_t)logSize || ftruncate(fd, (off_t)logSize) == 0)) {
+            log = mmap(NULL, logSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        if (log != MAP_FAILED) {
+            SLAuditLogHeader *header = log;
+            if (header->magic != kSLAuditLogMagic || header->version != kSLAuditLogVersion || header->recordSize != sizeof(SLAuditRecord) ||
+                header->capacity != kSLAuditLogCapacity) {
+                memset(log, 0, logSize);
+                header->version = kSLAuditLogVersion;
+                header->recordSize = sizeof(SLAuditRecord);
+                header->capacity = kSLAuditLogCapacity;
+                atomic_store_explicit(&header->nextIndex, 0, memory_order_relaxed);
+                atomic_thread_fence(memory_order_release);
+                header->magic = kSLAuditLogMagic;
+            }
+            sSLAuditLogHeader = header;
+            sSLAuditLogRecords = (SLAuditRecord *)(header + 1);
+        }
+        flock(fd, LOCK_UN);
+    }
+
+    // the mapping remains valid once the file is closed
+    close(fd);
+}
+
+// returns the 32-bit FNV-1a hash of the given (UTF-8) alarm Id that is stored in the records
+uint32_t SLAuditLogHashAlarmId(const char *alarmId)
+{
+    uint32_t hash = kSLAuditLogHashOffsetBasis;
+    if (alarmId != NULL) {
+        for (const unsigned char *c = (const unsigned char *)alarmId; *c != '\0'; c++) {
+            hash = (hash ^ *c) * kSLAuditLogHashPrime;
+        }
+    }
+    return hash;
+}
+
+// Appends a record of a decision to the log.  A writer claims a slot with a single atomic increment, marks the slot as being written,
+// fills it in, and then publishes it with its sequence, so writers in different processes never wait on each other.
+void SLAuditLogAppend(SLAuditHook hook, const char *alarmId, SLAuditDecision decision, SLAuditCause cause)
+{
+    pthread_once(&sSLAuditLogOnce, SLAuditLogMap);
+    if (sSLAuditLogHeader == NULL) {
+        return;
+    }
+
+    // the modification time of the preferences file is 0 if the file does not exist
+    struct stat prefsStat;
+    uint32_t prefsModificationTime = stat(sSLAuditLogPrefsPath, &prefsStat) == 0 ? (uint32_t)prefsStat.st_mtime : 0;
+
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    uint64_t index = atomic_fetch_add_explicit(&sSLAuditLogHeader->nextIndex, 1, memory_order_relaxed);
+    SLAuditRecord *record = &sSLAuditLogRecords[index & (kSLAuditLogCapacity - 1)];
+    atomic_store_explicit(&record->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    record->hook = (uint8_t)hook;
+    record->decision = (uint8_t)decision;
+    record->reason = (uint8_t)cause.reason;
+    record->holidayCountry = (uint8_t)cause.holidayCountry;
+    record->timestamp = (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_usec;
+    record->alarmIdHash = SLAuditLogHashAlarmId(alarmId);
+    record->detailId = cause.detailId;
+    record->prefsModificationTime = prefsModificationTime;
+    record->processId = sSLAuditLogProcessId;
+    atomic_store_explicit(&record->sequence, (uint32_t)(index + 1), memory_order_release);
+}
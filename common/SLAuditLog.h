@@ -0,0 +1,91 @@
+//
+//  SLAuditLog.h
+//  Fixed-size binary ring buffer of the skip decisions that is shared by every process that the tweak is injected into.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLAuditLog_h
+#define SLAuditLog_h
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The location of the log (relative to the home directory), which is pulled from the device and decoded with audit_log_decode.py.  The
+// layout of the file (see SLAuditLog.c) and the values of the enums below must be kept in sync with the decoder.
+#define kSLAuditLogFileName             "/Library/Preferences/com.joshuaseltzer.sleeper.auditlog"
+
+// the hooks (and other entry points) that make the decisions that are recorded
+typedef enum SLAuditHook {
+    // +[MTUserNotificationCenter _setSpecificContent:forScheduledAlarm:] (iOS 12 - iOS 14)
+    kSLAuditHookSetSpecificContent = 1,
+    // -[SBClockDataProvider _publishBulletinForNotification:] (iOS 10 / iOS 11)
+    kSLAuditHookPublishBulletin,
+    // -[SBClockDataProvider _publishBulletinForLocalNotification:] (iOS 8 / iOS 9)
+    kSLAuditHookPublishBulletinLegacy,
+    // the Yes and No actions of SLSkipAlarmAlertItem
+    kSLAuditHookSkipAlert,
+    // +[SLCompatibilityHelper updateAlarms:withBaseHour:withBaseMinute:]
+    kSLAuditHookUpdateAlarms
+} SLAuditHook;
+
+// the decision that was made for an alarm
+typedef enum SLAuditDecision {
+    // the alarm was allowed to fire (or the user chose not to skip it)
+    kSLAuditDecisionFire,
+    // the alarm was skipped (or the user chose to skip it)
+    kSLAuditDecisionSkip,
+    // the time of the alarm was updated by the auto-set option
+    kSLAuditDecisionUpdate
+} SLAuditDecision;
+
+// the reason for a decision, along with what the detail Id of the record refers to
+typedef enum SLAuditReason {
+    // none of the skip dates fall on the day of the decision
+    kSLAuditReasonNone,
+    // the alarm does not have any preferences
+    kSLAuditReasonNoPrefs,
+    // skipping is not enabled for the alarm
+    kSLAuditReasonSkipDisabled,
+    // the user chose to skip the alarm from the skip alert
+    kSLAuditReasonPopup,
+    // a custom skip date (the detail Id is the SLDay of the date)
+    kSLAuditReasonCustomDate,
+    // a selected holiday (the holiday country is set and the detail Id is the Id of the holiday)
+    kSLAuditReasonHoliday,
+    // a recurring skip rule (the detail Id is the index of the rule)
+    kSLAuditReasonSkipRule,
+    // the decision that was already made by another alarm that uses the same skip profile (the detail Id is the SLDay of the decision)
+    kSLAuditReasonSharedDecision,
+    // the user answered the skip alert
+    kSLAuditReasonUserResponse,
+    // the auto-set option of the alarm (the detail Id is the updated time of the alarm in minutes after midnight)
+    kSLAuditReasonAutoSetSunrise,
+    kSLAuditReasonAutoSetSunset
+} SLAuditReason;
+
+// the cause of a decision, which is filled in by the decision logic and then recorded by the hook that acted on the decision
+typedef struct SLAuditCause {
+    SLAuditReason reason;
+    uint32_t holidayCountry;
+    uint32_t detailId;
+} SLAuditCause;
+
+// returns the 32-bit FNV-1a hash of the given (UTF-8) alarm Id that is stored in the records
+uint32_t SLAuditLogHashAlarmId(const char *alarmId);
+
+// Appends a record of a decision to the log, where the timestamp is the current time in microseconds since 1970.  Each record also stores
+// the modification time of the preferences file (in seconds since 1970), which is the same in every process for the same version of the
+// preferences.  The log is mapped into the process the first time that a record is appended, after which appending a record only costs a
+// stat of the preferences file and a few atomic operations.  Records are silently dropped if the log could not be mapped.
+void SLAuditLogAppend(SLAuditHook hook, const char *alarmId, SLAuditDecision decision, SLAuditCause cause);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLAuditLog_h */
@@ -9,8 +9,9 @@
 #import <Foundation/Foundation.h>
 #import "SLAlarmPrefs.h"
 
-// the notification key that will be fired when the auto-set options are updated for a specific alarm
-static NSString *const kSLAutoSetOptionsUpdatedNotification = @"SLAutoSetOptionsUpdated";
+// The name of the notify(3) notification that is posted when the auto-set options are updated for any alarm.  The state of the notification
+// is a generation number that increases with every post, while the updated options themselves are read from the preferences.
+#define kSLAutoSetOptionsUpdatedNotifyName      "com.joshuaseltzer.sleeper.autosetoptionsupdated"
 
 // the location object that will be associated with a forecast model
 @interface WFLocation : NSObject
@@ -58,7 +59,16 @@ static NSString *const kSLAutoSetOptionsUpdatedNotification = @"SLAutoSetOptions
 // return a singleton instance of this manager
 + (instancetype)sharedInstance;
 
-// routine to update to a single alarm object that has updated auto-set settings
-- (void)updateAutoSetAlarm:(NSDictionary *)alarmDict;
+// Schedules the initial update of all of the auto-set alarms on the main queue a short time after SpringBoard has finished launching,
+// where only reading the auto-set alarms from the preferences is performed on a low priority queue.  The manager is ready once this
+// update has completed.
+- (void)startDeferred;
+
+// invokes the given block on the main queue once the manager is ready, or immediately (asynchronously) if it is already ready
+- (void)performWhenReady:(dispatch_block_t)block;
+
+// Signals the auto-set manager (from any process) that the auto-set options of an alarm were updated and written to the preferences.
+// Rapid signals are coalesced by the receiver into a single update.
++ (void)postAutoSetOptionsUpdated;
 
 @end
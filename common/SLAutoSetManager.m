@@ -11,20 +11,14 @@
 #import "SLCommonHeaders.h"
 #import "SLCompatibilityHelper.h"
 #import <objc/runtime.h>
+#import "SLClock.h"
+#import <notify.h>
 
-// this is a timer that will be able to fire even when SpringBoard is backgrounded
-@interface PCSimpleTimer : NSObject
+// the number of seconds to wait after SpringBoard launches before the auto-set alarms are first updated
+#define kSLInitialAutoSetDelay          15.0
 
-// initializer that will be used to create a persistent timer
-- (id)initWithFireDate:(NSDate *)fireDate serviceIdentifier:(NSString *)serviceIdentifier target:(id)target selector:(SEL)selector userInfo:(NSDictionary *)userInfo;
-
-// just like NSTimer, this will invalidate the timer object
-- (void)invalidate;
-
-// schedules the timer in the specified run loop
-- (void)scheduleInRunLoop:(NSRunLoop *)runLoop;
-
-@end
+// the number of seconds to wait for further changes after the auto-set options are updated before the alarms are updated
+#define kSLAutoSetUpdateDebounceInterval 1.0
 
 // this is the today model which will be instantiated when the singleton class is created
 @interface WATodayAutoupdatingLocationModel : WATodayModel
@@ -51,11 +45,37 @@
 @property (nonatomic) NSInteger lastSunsetHour;
 @property (nonatomic) NSInteger lastSunsetMinute;
 
+// The serial, low priority queue that the auto-set alarms are read from the preferences on.  Everything else (the today model, the
+// persistent timers, and updating the alarms) is performed on the main queue.
+@property (nonatomic, strong) dispatch_queue_t autoSetQueue;
+
+// the group that is left once the initial update of the auto-set alarms has completed
+@property (nonatomic, strong) dispatch_group_t readyGroup;
+
+// the token that is registered for the auto-set options updated notification, along with the last generation that was received
+@property (nonatomic) int autoSetOptionsUpdatedToken;
+@property (nonatomic) uint64_t lastAutoSetOptionsGeneration;
+
+// incremented for every received update so that only the last of several rapid updates is handled
+@property (nonatomic) NSUInteger pendingUpdateCount;
+
+// the auto-set options that were last applied for each alarm (keyed by the alarm Id), which are used to find the alarms that changed
+@property (nonatomic, strong) NSDictionary *appliedAutoSetOptions;
+
 @end
 
 // define the default hour/minute values for the auto-set times
 static NSInteger const kSLDefaultHourMinute = -1;
 
+// returns the values from the given alarm dictionary that affect the time of an auto-set alarm
+static NSArray *SLAutoSetOptionsForAlarm(NSDictionary *alarm)
+{
+    return @[[alarm objectForKey:kSLAutoSetOptionKey] ?: @(kSLAutoSetOptionOff),
+             [alarm objectForKey:kSLAutoSetOffsetOptionKey] ?: @(kSLAutoSetOffsetOptionOff),
+             [alarm objectForKey:kSLAutoSetOffsetHourKey] ?: @0,
+             [alarm objectForKey:kSLAutoSetOffsetMinuteKey] ?: @0];
+}
+
 @implementation SLAutoSetManager
 
 // return a singleton instance of this manager
@@ -80,25 +100,118 @@ static NSInteger const kSLDefaultHourMinute = -1;
         self.lastSunsetHour = kSLDefaultHourMinute;
         self.lastSunsetMinute = kSLDefaultHourMinute;
 
-        // attempt to update all of the auto-set alarms
-        [self updateAllAutoSetAlarms];
+        // the manager is not ready until the auto-set alarms have been updated for the first time
+        self.autoSetQueue = dispatch_queue_create("com.joshuaseltzer.sleeper.autoset",
+                                                  dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        self.readyGroup = dispatch_group_create();
+        dispatch_group_enter(self.readyGroup);
+
+        // observe the updates to the auto-set options from any process, which are only handled once the manager is ready
+        int autoSetOptionsUpdatedToken = NOTIFY_TOKEN_INVALID;
+        __weak SLAutoSetManager *weakSelf = self;
+        notify_register_dispatch(kSLAutoSetOptionsUpdatedNotifyName, &autoSetOptionsUpdatedToken, dispatch_get_main_queue(), ^(int token) {
+            [weakSelf performWhenReady:^{
+                [weakSelf autoSetOptionsUpdated];
+            }];
+        });
+        self.autoSetOptionsUpdatedToken = autoSetOptionsUpdatedToken;
     }
     return self;
 }
 
+// Signals the auto-set manager (from any process) that the auto-set options of an alarm were updated and written to the preferences.
+// Rapid signals are coalesced by the receiver into a single update.
++ (void)postAutoSetOptionsUpdated
+{
+    static dispatch_once_t pred;
+    static int sSLAutoSetOptionsUpdatedPostToken = NOTIFY_TOKEN_INVALID;
+    dispatch_once(&pred, ^{
+        notify_register_check(kSLAutoSetOptionsUpdatedNotifyName, &sSLAutoSetOptionsUpdatedPostToken);
+    });
+
+    // advance the generation so that the receiver can ignore any duplicate deliveries
+    if (sSLAutoSetOptionsUpdatedPostToken != NOTIFY_TOKEN_INVALID) {
+        uint64_t generation = 0;
+        notify_get_state(sSLAutoSetOptionsUpdatedPostToken, &generation);
+        notify_set_state(sSLAutoSetOptionsUpdatedPostToken, generation + 1);
+    }
+    notify_post(kSLAutoSetOptionsUpdatedNotifyName);
+}
+
+// invoked on the main queue whenever the auto-set options are updated, which schedules a single update after any further changes
+- (void)autoSetOptionsUpdated
+{
+    uint64_t generation = 0;
+    if (notify_get_state(self.autoSetOptionsUpdatedToken, &generation) == NOTIFY_STATUS_OK && generation != 0) {
+        if (generation == self.lastAutoSetOptionsGeneration) {
+            return;
+        }
+        self.lastAutoSetOptionsGeneration = generation;
+    }
+
+    NSUInteger updateCount = ++self.pendingUpdateCount;
+    dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kSLAutoSetUpdateDebounceInterval * NSEC_PER_SEC));
+    dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
+        if (updateCount == self.pendingUpdateCount) {
+            [self updateChangedAutoSetAlarms];
+        }
+    });
+}
+
+// Schedules the initial update of all of the auto-set alarms on the main queue a short time after SpringBoard has finished launching,
+// where only reading the auto-set alarms from the preferences is performed on the low priority queue.  The manager is ready once this
+// update has completed.
+- (void)startDeferred
+{
+    static dispatch_once_t pred;
+    dispatch_once(&pred, ^{
+        dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kSLInitialAutoSetDelay * NSEC_PER_SEC));
+        dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
+            [self loadAutoSetAlarmsWithCompletion:^(NSDictionary *autoSetAlarms) {
+                [self applyAllAutoSetAlarms:autoSetAlarms];
+                dispatch_group_leave(self.readyGroup);
+            }];
+        });
+    });
+}
+
+// invokes the given block on the main queue once the manager is ready, or immediately (asynchronously) if it is already ready
+- (void)performWhenReady:(dispatch_block_t)block
+{
+    dispatch_group_notify(self.readyGroup, dispatch_get_main_queue(), block);
+}
+
+// Reads all of the auto-set alarms from the preferences on the low priority queue (without collecting the alarms when the cached summary
+// says that none exist) and then invokes the given completion with them on the main queue.  The completions are invoked in the order that
+// the alarms were requested.
+- (void)loadAutoSetAlarmsWithCompletion:(void (^)(NSDictionary *autoSetAlarms))completion
+{
+    dispatch_async(self.autoSetQueue, ^(void) {
+        NSDictionary *autoSetAlarms = nil;
+        if ([SLPrefsManager hasAutoSetAlarms]) {
+            autoSetAlarms = [SLPrefsManager allAutoSetAlarms];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^(void) {
+            completion(autoSetAlarms);
+        });
+    });
+}
+
 // invoked when one of the persistent timers is fired
 - (void)persistentTimerFired:(PCSimpleTimer *)timer
 {
-    // force a reload of the forecast data with the today model and then update all alarms
-    [self.autoupdatingTodayModel _reloadForecastData:YES];
-    [self updateAllAutoSetAlarms];
-
-    // re-create the timer that was fired to be scheduled for the next day
-    if ([timer isEqual:self.startOfDayTimer]) {
-        [self createStartOfDayTimer];
-    } else if ([timer isEqual:self.midDayTimer]) {
-        [self createMidDayTimer];
-    }
+    [self performWhenReady:^{
+        // force a reload of the forecast data with the today model and then update all alarms
+        [self.autoupdatingTodayModel _reloadForecastData:YES];
+        [self updateAllAutoSetAlarms];
+
+        // re-create the timer that was fired to be scheduled for the next day
+        if ([timer isEqual:self.startOfDayTimer]) {
+            [self createStartOfDayTimer];
+        } else if ([timer isEqual:self.midDayTimer]) {
+            [self createMidDayTimer];
+        }
+    }];
 }
 
 // creates the start of day timer for the following day and potentially invalidating/destroying the previous timer
@@ -111,8 +224,8 @@ static NSInteger const kSLDefaultHourMinute = -1;
     }
 
     // create the date and timer that will fire at the start of the day tomorrow
-    NSDate *today = [NSDate date];
-    NSCalendar *calendar = [NSCalendar currentCalendar];
+    NSDate *today = [SLClock now];
+    NSCalendar *calendar = [SLClock calendar];
     NSDateComponents *adjustDateComponents = [[NSDateComponents alloc] init];
     adjustDateComponents.day = 1;
     adjustDateComponents.minute = arc4random_uniform(5) + 1;
@@ -140,8 +253,8 @@ static NSInteger const kSLDefaultHourMinute = -1;
     }
 
     // create the date for the middle of the day either for the current day or the next day
-    NSDate *today = [NSDate date];
-    NSCalendar *calendar = [NSCalendar currentCalendar];
+    NSDate *today = [SLClock now];
+    NSCalendar *calendar = [SLClock calendar];
     NSDateComponents *adjustDateComponents = [[NSDateComponents alloc] init];
     adjustDateComponents.hour = 12;
     adjustDateComponents.minute = arc4random_uniform(5) + 1;
@@ -239,32 +352,72 @@ static NSInteger const kSLDefaultHourMinute = -1;
     }
 }
 
-// routine to update to a single alarm object that has updated auto-set settings
-- (void)updateAutoSetAlarm:(NSDictionary *)alarmDict
+// updates the alarms whose auto-set options have changed since they were last applied, reading the options from the preferences
+- (void)updateChangedAutoSetAlarms
 {
-    // check to ensure a valid alarm dictionary object was passed
-    if (alarmDict != nil) {
-        NSNumber *autoSetOptionNum = [alarmDict objectForKey:kSLAutoSetOptionKey];
-        if (autoSetOptionNum != nil) {
-            if (![self.autoupdatingTodayModel _reloadForecastData:YES] && (self.autoupdatingTodayModel == nil || self.autoupdatingTodayModel.forecastModel == nil)) {
-                // ensure that the today model is created and running properly before trying to update an alarm
-                [self setupAutoupdatingTodayModel];
-            }
+    [self loadAutoSetAlarmsWithCompletion:^(NSDictionary *autoSetAlarms) {
+        [self applyChangedAutoSetAlarms:autoSetAlarms];
+    }];
+}
 
-            // ensure we are using the latest auto-set times from the today model (we do not care about the return value here)
-            [self hasUpdatedAutoSetTimes];
-            
-            // update the alarm according to the auto-set option as long as valid times were generated
-            if (self.lastSunriseHour != -1 && self.lastSunriseMinute != -1 && self.lastSunsetHour != -1 && self.lastSunsetMinute != -1) {
-                SLAutoSetOption autoSetOption = [autoSetOptionNum integerValue];
-                if (autoSetOption == kSLAutoSetOptionSunrise) {
-                    [SLCompatibilityHelper updateAlarms:@[alarmDict] withBaseHour:self.lastSunriseHour withBaseMinute:self.lastSunriseMinute];
-                } else if (autoSetOption == kSLAutoSetOptionSunset) {
-                    [SLCompatibilityHelper updateAlarms:@[alarmDict] withBaseHour:self.lastSunsetHour withBaseMinute:self.lastSunsetMinute];
-                }
+// Updates the given auto-set alarms (keyed by the auto-set option) whose options have changed since they were last applied.  The forecast
+// is reloaded at most once regardless of how many alarms changed.
+- (void)applyChangedAutoSetAlarms:(NSDictionary *)autoSetAlarms
+{
+    if (autoSetAlarms == nil) {
+        [self teardownAutoupdatingTodayModel];
+        self.appliedAutoSetOptions = nil;
+        return;
+    }
+
+    // find the auto-set alarms whose options differ from the options that were last applied
+    NSMutableDictionary *changedAutoSetAlarms = [[NSMutableDictionary alloc] initWithCapacity:autoSetAlarms.count];
+    for (NSNumber *autoSetOptionNum in autoSetAlarms) {
+        NSMutableArray *changedAlarms = [[NSMutableArray alloc] init];
+        for (NSDictionary *alarm in [autoSetAlarms objectForKey:autoSetOptionNum]) {
+            NSArray *appliedOptions = [self.appliedAutoSetOptions objectForKey:[alarm objectForKey:kSLAlarmIdKey]];
+            if (![appliedOptions isEqualToArray:SLAutoSetOptionsForAlarm(alarm)]) {
+                [changedAlarms addObject:alarm];
             }
-        } 
+        }
+        if (changedAlarms.count > 0) {
+            [changedAutoSetAlarms setObject:[changedAlarms copy] forKey:autoSetOptionNum];
+        }
+    }
+    if (changedAutoSetAlarms.count == 0) {
+        return;
+    }
+
+    if (![self.autoupdatingTodayModel _reloadForecastData:YES] && (self.autoupdatingTodayModel == nil || self.autoupdatingTodayModel.forecastModel == nil)) {
+        // ensure that the today model is created and running properly before trying to update an alarm
+        [self setupAutoupdatingTodayModel];
+    }
+
+    // If the auto-set times changed, every auto-set alarm needs to be updated.  Otherwise only the alarms that changed are updated (as long
+    // as valid times were generated).
+    if ([self hasUpdatedAutoSetTimes]) {
+        [self bulkUpdateAutoSetAlarms:autoSetAlarms];
+    } else {
+        [self bulkUpdateAutoSetAlarms:[changedAutoSetAlarms copy]];
+    }
+    [self recordAppliedAutoSetOptionsForAutoSetAlarms:autoSetAlarms];
+}
+
+// remembers the auto-set options for each of the given auto-set alarms (keyed by the auto-set option) once they have been applied
+- (void)recordAppliedAutoSetOptionsForAutoSetAlarms:(NSDictionary *)autoSetAlarms
+{
+    // the options are only considered applied once valid times have been generated
+    if (self.lastSunriseHour == -1 || self.lastSunriseMinute == -1 || self.lastSunsetHour == -1 || self.lastSunsetMinute == -1) {
+        return;
     }
+
+    NSMutableDictionary *appliedAutoSetOptions = [[NSMutableDictionary alloc] init];
+    for (NSNumber *autoSetOptionNum in autoSetAlarms) {
+        for (NSDictionary *alarm in [autoSetAlarms objectForKey:autoSetOptionNum]) {
+            [appliedAutoSetOptions setObject:SLAutoSetOptionsForAlarm(alarm) forKey:[alarm objectForKey:kSLAlarmIdKey]];
+        }
+    }
+    self.appliedAutoSetOptions = [appliedAutoSetOptions copy];
 }
 
 // Returns whether or not there were updated auto-set times using the today model that will be created and monitored in this instance.
@@ -311,11 +464,18 @@ static NSInteger const kSLDefaultHourMinute = -1;
     return hasUpdatedAutoSetTime;
 }
 
-// updates all auto-set alarms if necessary
+// updates all auto-set alarms if necessary, reading the alarms from the preferences
 - (void)updateAllAutoSetAlarms
 {
-    // Update all auto-set alarms that might exist.  If there are no auto-set alarms, do not create the today model.
-    NSDictionary *autoSetAlarms = [SLPrefsManager allAutoSetAlarms];
+    [self loadAutoSetAlarmsWithCompletion:^(NSDictionary *autoSetAlarms) {
+        [self applyAllAutoSetAlarms:autoSetAlarms];
+    }];
+}
+
+// Updates all of the given auto-set alarms (keyed by the auto-set option).  If there are no auto-set alarms, do not create the today
+// model.
+- (void)applyAllAutoSetAlarms:(NSDictionary *)autoSetAlarms
+{
     if (autoSetAlarms != nil) {
         // if the today model hasn't been initiated yet, create it now
         if (self.autoupdatingTodayModel == nil) {
@@ -325,10 +485,12 @@ static NSInteger const kSLDefaultHourMinute = -1;
         // update all of the auto-set alarms upon initialization
         if ([self hasUpdatedAutoSetTimes]) {
             [self bulkUpdateAutoSetAlarms:autoSetAlarms];
+            [self recordAppliedAutoSetOptionsForAutoSetAlarms:autoSetAlarms];
         }
     } else {
         // attempt to teardown the today model
         [self teardownAutoupdatingTodayModel];
+        self.appliedAutoSetOptions = nil;
     }
 }
 
@@ -0,0 +1,520 @@
+//
+//  SLCalendarImport.c
+//  Portable streaming parser that imports the all-day events from an iCalendar (.ics) file as skip dates.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLCalendarImport.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+// the number of bytes that are read from the file at a time
+#define kSLCalendarReadBufferSize       16384
+
+// the maximum length of a single (unfolded) line, where any longer lines are truncated since the properties we need are short
+#define kSLCalendarMaxLineLength        1024
+
+// the maximum number of excluded dates that are remembered for a single event
+#define kSLCalendarMaxExcludedDays      64
+
+// the maximum number of recurrences that will be evaluated for a single event, which guards against malformed rules
+#define kSLCalendarMaxRecurrences       100000
+
+// the frequencies of the recurrence rules that can be expanded
+typedef enum SLCalendarFrequency {
+    kSLCalendarFrequencyNone,
+    kSLCalendarFrequencyDaily,
+    kSLCalendarFrequencyWeekly,
+    kSLCalendarFrequencyMonthly,
+    kSLCalendarFrequencyYearly
+} SLCalendarFrequency;
+
+// buffered reader that is used to stream the file
+typedef struct SLCalendarReader {
+    FILE *file;
+    size_t position;
+    size_t length;
+    int error;
+    char buffer[kSLCalendarReadBufferSize];
+} SLCalendarReader;
+
+// the properties of the event that is currently being parsed
+typedef struct SLCalendarEvent {
+    int hasStart;
+    int isAllDay;
+    int isCancelled;
+    SLDay startDay;
+    int hasEnd;
+    SLDay endDay;
+    int32_t durationDays;
+    SLCalendarFrequency frequency;
+    // set when the recurrence rule contains any parts that cannot be expanded
+    int hasUnsupportedRule;
+    int32_t interval;
+    int32_t count;
+    int hasUntil;
+    SLDay untilDay;
+    // a mask of the weekdays that a weekly rule occurs on (using the SLWeekday values as bit positions)
+    uint8_t weekdays;
+    SLWeekday weekStart;
+    SLDay excludedDays[kSLCalendarMaxExcludedDays];
+    size_t numExcludedDays;
+} SLCalendarEvent;
+
+// the state that is used to expand the occurrences of an event
+typedef struct SLCalendarExpansion {
+    const SLCalendarEvent *event;
+    int32_t numDays;
+    SLDay fromDay;
+    SLDay toDay;
+    SLCalendarImportDayRangeFunction function;
+    void *context;
+    int32_t numRecurrences;
+} SLCalendarExpansion;
+
+// the state that is used to collect the imported days
+typedef struct SLCalendarDayCollection {
+    uint8_t *bitmap;
+    SLDay fromDay;
+} SLCalendarDayCollection;
+
+// the two letter codes for the weekdays, in the order of the SLWeekday values
+static const char *const kSLCalendarWeekdayCodes[kSLWeekdayNumWeekdays] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
+
+// returns the next character from the reader without consuming it, or EOF at the end of the file
+static int SLCalendarReaderPeek(SLCalendarReader *reader)
+{
+    if (reader->position == reader->length) {
+        reader->position = 0;
+        reader->length = fread(reader->buffer, 1, sizeof(reader->buffer), reader->file);
+        if (reader->length == 0) {
+            if (ferror(reader->file)) {
+                reader->error = 1;
+            }
+            return EOF;
+        }
+    }
+    return (unsigned char)reader->buffer[reader->position];
+}
+
+// Reads the next line into the given buffer, unfolding any continuation lines and truncating lines that are too long.  Returns 0 at the
+// end of the file.
+static int SLCalendarReaderReadLine(SLCalendarReader *reader, char *line, size_t capacity)
+{
+    int c = SLCalendarReaderPeek(reader);
+    if (c == EOF) {
+        return 0;
+    }
+
+    size_t length = 0;
+    while (c != EOF) {
+        reader->position++;
+        if (c == '\n') {
+            // a line that begins with whitespace is a continuation of the previous line
+            int next = SLCalendarReaderPeek(reader);
+            if (next != ' ' && next != '\t') {
+                break;
+            }
+            reader->position++;
+        } else if (c != '\r' && length + 1 < capacity) {
+            line[length++] = (char)c;
+        }
+        c = SLCalendarReaderPeek(reader);
+    }
+    line[length] = '\0';
+    return 1;
+}
+
+// returns whether or not the given string (with the given length) matches the expected string, ignoring case
+static int SLCalendarStringEquals(const char *string, size_t length, const char *expected)
+{
+    return strlen(expected) == length && strncasecmp(string, expected, length) == 0;
+}
+
+// Parses the date at the start of the given value (i.e. "20261019" or "20261019T090000Z"), returning 0 if it is not a valid date.  The
+// time of a date-time value is ignored.
+static int SLCalendarParseDate(const char *value, SLDay *day, int *isDateOnly)
+{
+    for (int i = 0; i < 8; i++) {
+        if (!isdigit((unsigned char)value[i])) {
+            return 0;
+        }
+    }
+    int32_t year = (value[0] - '0') * 1000 + (value[1] - '0') * 100 + (value[2] - '0') * 10 + (value[3] - '0');
+    int32_t month = (value[4] - '0') * 10 + (value[5] - '0');
+    int32_t dayOfMonth = (value[6] - '0') * 10 + (value[7] - '0');
+    if (month < 1 || month > 12 || dayOfMonth < 1 || dayOfMonth > SLDaysInMonth(year, month)) {
+        return 0;
+    }
+
+    *day = SLDayFromCivil(year, month, dayOfMonth);
+    if (isDateOnly != NULL) {
+        *isDateOnly = value[8] != 'T' && value[8] != 't';
+    }
+    return 1;
+}
+
+// parses a duration value (i.e. "P3D" or "P1W") into a number of days, returning 0 if the duration does not contain any days
+static int32_t SLCalendarParseDurationDays(const char *value)
+{
+    if (*value == '+') {
+        value++;
+    }
+    if (*value != 'P' && *value != 'p') {
+        return 0;
+    }
+    value++;
+
+    int32_t days = 0;
+    while (isdigit((unsigned char)*value)) {
+        int32_t number = 0;
+        while (isdigit((unsigned char)*value) && number < kSLCalendarImportMaxDays) {
+            number = number * 10 + (*value++ - '0');
+        }
+        if (*value == 'W' || *value == 'w') {
+            days += number * 7;
+        } else if (*value == 'D' || *value == 'd') {
+            days += number;
+        } else {
+            break;
+        }
+        value++;
+    }
+    return days;
+}
+
+// parses the parts of a recurrence rule (i.e. "FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE;UNTIL=20261231") into the given event
+static void SLCalendarParseRecurrenceRule(SLCalendarEvent *event, const char *value)
+{
+    while (*value != '\0') {
+        size_t partLength = strcspn(value, ";");
+        const char *separator = memchr(value, '=', partLength);
+        if (separator != NULL) {
+            size_t nameLength = separator - value;
+            const char *partValue = separator + 1;
+            size_t partValueLength = partLength - nameLength - 1;
+            if (SLCalendarStringEquals(value, nameLength, "FREQ")) {
+                if (SLCalendarStringEquals(partValue, partValueLength, "DAILY")) {
+                    event->frequency = kSLCalendarFrequencyDaily;
+                } else if (SLCalendarStringEquals(partValue, partValueLength, "WEEKLY")) {
+                    event->frequency = kSLCalendarFrequencyWeekly;
+                } else if (SLCalendarStringEquals(partValue, partValueLength, "MONTHLY")) {
+                    event->frequency = kSLCalendarFrequencyMonthly;
+                } else if (SLCalendarStringEquals(partValue, partValueLength, "YEARLY")) {
+                    event->frequency = kSLCalendarFrequencyYearly;
+                } else {
+                    event->hasUnsupportedRule = 1;
+                }
+            } else if (SLCalendarStringEquals(value, nameLength, "INTERVAL")) {
+                int32_t interval = (int32_t)strtol(partValue, NULL, 10);
+                if (interval > 0) {
+                    event->interval = interval;
+                }
+            } else if (SLCalendarStringEquals(value, nameLength, "COUNT")) {
+                event->count = (int32_t)strtol(partValue, NULL, 10);
+            } else if (SLCalendarStringEquals(value, nameLength, "UNTIL")) {
+                event->hasUntil = SLCalendarParseDate(partValue, &event->untilDay, NULL);
+            } else if (SLCalendarStringEquals(value, nameLength, "BYDAY")) {
+                // only plain weekdays are supported (i.e. "MO,WE" but not "2MO" or "-1FR")
+                while (partValueLength > 0) {
+                    size_t dayLength = strcspn(partValue, ",;");
+                    if (dayLength > partValueLength) {
+                        dayLength = partValueLength;
+                    }
+                    int matched = 0;
+                    for (int weekday = 0; weekday < kSLWeekdayNumWeekdays && !matched; weekday++) {
+                        if (SLCalendarStringEquals(partValue, dayLength, kSLCalendarWeekdayCodes[weekday])) {
+                            event->weekdays |= (uint8_t)(1 << weekday);
+                            matched = 1;
+                        }
+                    }
+                    if (!matched) {
+                        event->hasUnsupportedRule = 1;
+                    }
+                    partValue += dayLength;
+                    partValueLength -= dayLength;
+                    if (partValueLength > 0) {
+                        partValue++;
+                        partValueLength--;
+                    }
+                }
+            } else if (SLCalendarStringEquals(value, nameLength, "WKST")) {
+                for (int weekday = 0; weekday < kSLWeekdayNumWeekdays; weekday++) {
+                    if (SLCalendarStringEquals(partValue, partValueLength, kSLCalendarWeekdayCodes[weekday])) {
+                        event->weekStart = (SLWeekday)weekday;
+                    }
+                }
+            } else {
+                // any other rule parts (i.e. BYMONTHDAY or BYSETPOS) cannot be expanded
+                event->hasUnsupportedRule = 1;
+            }
+        }
+        value += partLength;
+        if (*value == ';') {
+            value++;
+        }
+    }
+}
+
+// parses the comma separated dates that are excluded from a recurring event
+static void SLCalendarParseExcludedDates(SLCalendarEvent *event, const char *value)
+{
+    while (*value != '\0' && event->numExcludedDays < kSLCalendarMaxExcludedDays) {
+        SLDay excludedDay;
+        if (SLCalendarParseDate(value, &excludedDay, NULL)) {
+            event->excludedDays[event->numExcludedDays++] = excludedDay;
+        }
+        value += strcspn(value, ",");
+        if (*value == ',') {
+            value++;
+        }
+    }
+}
+
+// Invokes the expansion's function for the occurrence of the event that starts on the given day if it was not excluded.  Returns 0 once
+// no further occurrences should be expanded.
+static int SLCalendarExpandOccurrence(SLCalendarExpansion *expansion, SLDay day)
+{
+    const SLCalendarEvent *event = expansion->event;
+    int isExcluded = 0;
+    for (size_t i = 0; i < event->numExcludedDays && !isExcluded; i++) {
+        isExcluded = event->excludedDays[i] == day;
+    }
+
+    if (!isExcluded) {
+        SLDay firstDay = day > expansion->fromDay ? day : expansion->fromDay;
+        SLDay lastDay = day + expansion->numDays - 1;
+        if (lastDay > expansion->toDay) {
+            lastDay = expansion->toDay;
+        }
+        if (firstDay <= lastDay) {
+            expansion->function(firstDay, lastDay, expansion->context);
+        }
+    }
+
+    // the excluded occurrences still count towards the number of occurrences in the rule
+    expansion->numRecurrences++;
+    return (event->count <= 0 || expansion->numRecurrences < event->count) && expansion->numRecurrences < kSLCalendarMaxRecurrences;
+}
+
+// expands all of the occurrences of the given event that overlap the range of days
+static void SLCalendarExpandEvent(const SLCalendarEvent *event, SLDay fromDay, SLDay toDay, SLCalendarImportDayRangeFunction function,
+                                  void *context)
+{
+    if (!event->hasStart || !event->isAllDay || event->isCancelled) {
+        return;
+    }
+
+    // the end of an all-day event is exclusive, while events without an end or duration occur on a single day
+    SLCalendarExpansion expansion = {event, 1, fromDay, toDay, function, context, 0};
+    if (event->hasEnd && event->endDay > event->startDay) {
+        expansion.numDays = event->endDay - event->startDay;
+    } else if (!event->hasEnd && event->durationDays > 0) {
+        expansion.numDays = event->durationDays;
+    }
+    if (expansion.numDays > kSLCalendarImportMaxDays) {
+        expansion.numDays = kSLCalendarImportMaxDays;
+    }
+
+    // no occurrences that start after the last day (or after the end of the rule) can overlap the range of days
+    SLDay lastStartDay = toDay;
+    if (event->hasUntil && event->untilDay < lastStartDay) {
+        lastStartDay = event->untilDay;
+    }
+
+    // events that do not recur (or recur with a rule that cannot be expanded) only include the first occurrence
+    if (event->frequency == kSLCalendarFrequencyNone || event->hasUnsupportedRule) {
+        SLCalendarExpandOccurrence(&expansion, event->startDay);
+        return;
+    }
+
+    // Occurrences that end before the first day can be skipped entirely when the rule is not limited by a count.  The daily and weekly
+    // rules occur in fixed steps, so the expansion can start at the step just before the first day.
+    SLDay firstStartDay = fromDay - expansion.numDays + 1;
+    int32_t interval = event->interval > 0 ? event->interval : 1;
+    int32_t startYear, startMonth, startDayOfMonth;
+    SLCivilFromDay(event->startDay, &startYear, &startMonth, &startDayOfMonth);
+    switch (event->frequency) {
+        case kSLCalendarFrequencyDaily: {
+            int64_t step = event->count <= 0 && firstStartDay > event->startDay ? (firstStartDay - event->startDay) / interval : 0;
+            for (SLDay day = event->startDay + (SLDay)(step * interval); day <= lastStartDay; day += interval) {
+                if (!SLCalendarExpandOccurrence(&expansion, day)) {
+                    break;
+                }
+            }
+            break;
+        }
+        case kSLCalendarFrequencyWeekly: {
+            // weekly rules without any weekdays occur on the weekday of the first occurrence
+            uint8_t weekdays = event->weekdays != 0 ? event->weekdays : (uint8_t)(1 << SLWeekdayForDay(event->startDay));
+            int32_t weekInterval = interval * kSLWeekdayNumWeekdays;
+            SLDay firstWeekDay = event->startDay - (SLDay)((SLWeekdayForDay(event->startDay) - event->weekStart + kSLWeekdayNumWeekdays) % kSLWeekdayNumWeekdays);
+            int64_t step = event->count <= 0 && firstStartDay > firstWeekDay ? (firstStartDay - firstWeekDay) / weekInterval : 0;
+            int expanding = 1;
+            for (SLDay weekDay = firstWeekDay + (SLDay)(step * weekInterval); expanding && weekDay <= lastStartDay; weekDay += weekInterval) {
+                for (int i = 0; expanding && i < kSLWeekdayNumWeekdays; i++) {
+                    SLDay day = weekDay + i;
+                    if ((weekdays & (1 << ((event->weekStart + i) % kSLWeekdayNumWeekdays))) && day >= event->startDay) {
+                        expanding = day <= lastStartDay && SLCalendarExpandOccurrence(&expansion, day);
+                    }
+                }
+            }
+            break;
+        }
+        case kSLCalendarFrequencyMonthly:
+        case kSLCalendarFrequencyYearly: {
+            // occurrences are skipped in any month that does not contain the day of the month (i.e. the 31st or February 29th)
+            int32_t monthInterval = event->frequency == kSLCalendarFrequencyMonthly ? interval : interval * 12;
+            for (int32_t monthIndex = 0; monthIndex < kSLCalendarMaxRecurrences; monthIndex += monthInterval) {
+                int32_t months = startMonth - 1 + monthIndex;
+                int32_t year = startYear + months / 12;
+                int32_t month = months % 12 + 1;
+                if (SLDayFromCivil(year, month, 1) > lastStartDay) {
+                    break;
+                }
+                if (startDayOfMonth <= SLDaysInMonth(year, month)) {
+                    SLDay day = SLDayFromCivil(year, month, startDayOfMonth);
+                    if (day > lastStartDay || !SLCalendarExpandOccurrence(&expansion, day)) {
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Streams the given iCalendar file with a fixed amount of memory, invoking the given function for every occurrence of an all-day event
+// that overlaps the given range of days (inclusive).
+SLCalendarImportStatus SLCalendarImportEnumerateFile(FILE *file, SLDay fromDay, SLDay toDay, SLCalendarImportDayRangeFunction function,
+                                                     void *context)
+{
+    SLCalendarReader *reader = calloc(1, sizeof(SLCalendarReader));
+    SLCalendarEvent *event = calloc(1, sizeof(SLCalendarEvent));
+    if (reader == NULL || event == NULL) {
+        free(reader);
+        free(event);
+        return kSLCalendarImportStatusOutOfMemory;
+    }
+    reader->file = file;
+
+    char line[kSLCalendarMaxLineLength];
+    int foundCalendar = 0;
+    int inEvent = 0;
+    int nestedComponents = 0;
+    while (SLCalendarReaderReadLine(reader, line, sizeof(line))) {
+        // split the line into the property name and value, ignoring any parameters (the value starts after the first unquoted colon)
+        size_t nameLength = strcspn(line, ";:");
+        const char *value = line + nameLength;
+        int inQuotes = 0;
+        while (*value != '\0' && (inQuotes || *value != ':')) {
+            if (*value == '"') {
+                inQuotes = !inQuotes;
+            }
+            value++;
+        }
+        if (*value == ':') {
+            value++;
+        }
+
+        if (SLCalendarStringEquals(line, nameLength, "BEGIN")) {
+            if (strcasecmp(value, "VCALENDAR") == 0) {
+                foundCalendar = 1;
+            } else if (inEvent) {
+                // ignore the properties of any components within an event (i.e. alarms)
+                nestedComponents++;
+            } else if (strcasecmp(value, "VEVENT") == 0) {
+                memset(event, 0, sizeof(SLCalendarEvent));
+                event->interval = 1;
+                event->weekStart = kSLWeekdayMonday;
+                inEvent = 1;
+            }
+        } else if (SLCalendarStringEquals(line, nameLength, "END")) {
+            if (inEvent && nestedComponents > 0) {
+                nestedComponents--;
+            } else if (inEvent && strcasecmp(value, "VEVENT") == 0) {
+                SLCalendarExpandEvent(event, fromDay, toDay, function, context);
+                inEvent = 0;
+            }
+        } else if (inEvent && nestedComponents == 0) {
+            if (SLCalendarStringEquals(line, nameLength, "DTSTART")) {
+                event->hasStart = SLCalendarParseDate(value, &event->startDay, &event->isAllDay);
+            } else if (SLCalendarStringEquals(line, nameLength, "DTEND")) {
+                event->hasEnd = SLCalendarParseDate(value, &event->endDay, NULL);
+            } else if (SLCalendarStringEquals(line, nameLength, "DURATION")) {
+                event->durationDays = SLCalendarParseDurationDays(value);
+            } else if (SLCalendarStringEquals(line, nameLength, "RRULE")) {
+                SLCalendarParseRecurrenceRule(event, value);
+            } else if (SLCalendarStringEquals(line, nameLength, "EXDATE")) {
+                SLCalendarParseExcludedDates(event, value);
+            } else if (SLCalendarStringEquals(line, nameLength, "STATUS")) {
+                event->isCancelled = strcasecmp(value, "CANCELLED") == 0;
+            }
+        }
+    }
+
+    SLCalendarImportStatus status = kSLCalendarImportStatusSuccess;
+    if (reader->error) {
+        status = kSLCalendarImportStatusReadError;
+    } else if (!foundCalendar) {
+        status = kSLCalendarImportStatusInvalidFile;
+    }
+    free(reader);
+    free(event);
+    return status;
+}
+
+// marks the given range of days in the collection's bitmap
+static void SLCalendarCollectDayRange(SLDay firstDay, SLDay lastDay, void *context)
+{
+    SLCalendarDayCollection *collection = (SLCalendarDayCollection *)context;
+    for (SLDay day = firstDay; day <= lastDay; day++) {
+        int32_t offset = day - collection->fromDay;
+        collection->bitmap[offset / 8] |= (uint8_t)(1 << (offset % 8));
+    }
+}
+
+// Imports the days from the given iCalendar file that fall within the given range of days (inclusive), which can include at most
+// kSLCalendarImportMaxDays.  On success, the days are returned sorted and without duplicates in an array that must be freed by the caller.
+SLCalendarImportStatus SLCalendarImportDaysFromFile(FILE *file, SLDay fromDay, SLDay toDay, SLDay **days, size_t *numDays)
+{
+    *days = NULL;
+    *numDays = 0;
+    if (toDay - fromDay + 1 > kSLCalendarImportMaxDays) {
+        toDay = fromDay + kSLCalendarImportMaxDays - 1;
+    }
+    int32_t numWindowDays = toDay >= fromDay ? toDay - fromDay + 1 : 0;
+
+    // a bitmap of the days in the range keeps the days sorted and removes duplicates without needing to sort any of the occurrences
+    SLCalendarDayCollection collection = {calloc((numWindowDays + 7) / 8 + 1, 1), fromDay};
+    if (collection.bitmap == NULL) {
+        return kSLCalendarImportStatusOutOfMemory;
+    }
+    SLCalendarImportStatus status = SLCalendarImportEnumerateFile(file, fromDay, toDay, SLCalendarCollectDayRange, &collection);
+    if (status == kSLCalendarImportStatusSuccess) {
+        size_t count = 0;
+        for (int32_t offset = 0; offset < numWindowDays; offset++) {
+            count += (collection.bitmap[offset / 8] >> (offset % 8)) & 1;
+        }
+        if (count > 0) {
+            *days = malloc(count * sizeof(SLDay));
+            if (*days == NULL) {
+                status = kSLCalendarImportStatusOutOfMemory;
+            } else {
+                for (int32_t offset = 0; offset < numWindowDays; offset++) {
+                    if ((collection.bitmap[offset / 8] >> (offset % 8)) & 1) {
+                        (*days)[(*numDays)++] = fromDay + offset;
+                    }
+                }
+            }
+        }
+    }
+    free(collection.bitmap);
+    return status;
+}
@@ -0,0 +1,52 @@
+//
+//  SLCalendarImport.h
+//  Portable streaming parser that imports the all-day events from an iCalendar (.ics) file as skip dates.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLCalendarImport_h
+#define SLCalendarImport_h
+
+#include <stdio.h>
+#include "SLHolidayRules.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the maximum number of days that can be imported from a calendar, starting from the first day of the import
+#define kSLCalendarImportMaxDays        (366 * 3)
+
+// the results of importing a calendar file
+typedef enum SLCalendarImportStatus {
+    // the calendar was imported (which does not necessarily mean that any days were found)
+    kSLCalendarImportStatusSuccess,
+    // the file is not an iCalendar file
+    kSLCalendarImportStatusInvalidFile,
+    // the file could not be read
+    kSLCalendarImportStatusReadError,
+    // memory could not be allocated for the imported days
+    kSLCalendarImportStatusOutOfMemory
+} SLCalendarImportStatus;
+
+// function that is invoked for each range of days (inclusive) that an all-day event occurs on
+typedef void (*SLCalendarImportDayRangeFunction)(SLDay firstDay, SLDay lastDay, void *context);
+
+// Streams the given iCalendar file with a fixed amount of memory, invoking the given function for every occurrence of an all-day event
+// that overlaps the given range of days (inclusive).  Recurring events are expanded for the daily, weekly, monthly, and yearly rules
+// (along with the interval, count, until, and weekly weekday parts).  Recurring events with any other rule parts only import the first
+// occurrence.  Timed and cancelled events are ignored.
+SLCalendarImportStatus SLCalendarImportEnumerateFile(FILE *file, SLDay fromDay, SLDay toDay, SLCalendarImportDayRangeFunction function,
+                                                     void *context);
+
+// Imports the days from the given iCalendar file that fall within the given range of days (inclusive), which can include at most
+// kSLCalendarImportMaxDays.  On success, the days are returned sorted and without duplicates in an array that must be freed by the caller.
+SLCalendarImportStatus SLCalendarImportDaysFromFile(FILE *file, SLDay fromDay, SLDay toDay, SLDay **days, size_t *numDays);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLCalendarImport_h */
@@ -0,0 +1,28 @@
+//
+//  SLClock.h
+//  The clock that is used for every date and calendar decision that the tweak makes.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// block that returns the current date for a replaced clock
+typedef NSDate * (^SLClockDateProvider)(void);
+
+// Provides the current date and calendar to the decision logic of the tweak.  The system clock is used by default, but it can be replaced
+// so that the behavior across day boundaries, time zone changes, and year rollovers can be simulated without waiting in real time.
+@interface SLClock : NSObject
+
+// returns the current date
++ (NSDate *)now;
+
+// returns the calendar that is used to interpret dates (i.e. finding the start of a day)
++ (NSCalendar *)calendar;
+
+// Replaces the clock with the given date provider and calendar.  Passing nil for the date provider restores the system clock, while
+// passing nil for the calendar uses the current calendar of the device.
++ (void)setDateProvider:(SLClockDateProvider)dateProvider calendar:(NSCalendar *)calendar;
+
+@end
@@ -0,0 +1,46 @@
+//
+//  SLClock.m
+//  The clock that is used for every date and calendar decision that the tweak makes.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import "SLClock.h"
+
+// the replaced date provider and calendar, which are nil when the system clock is used
+static SLClockDateProvider sSLClockDateProvider;
+static NSCalendar *sSLClockCalendar;
+
+@implementation SLClock
+
+// returns the current date
++ (NSDate *)now
+{
+    SLClockDateProvider dateProvider = nil;
+    @synchronized(self) {
+        dateProvider = sSLClockDateProvider;
+    }
+    return dateProvider != nil ? dateProvider() : [NSDate date];
+}
+
+// returns the calendar that is used to interpret dates (i.e. finding the start of a day)
++ (NSCalendar *)calendar
+{
+    NSCalendar *calendar = nil;
+    @synchronized(self) {
+        calendar = sSLClockCalendar;
+    }
+    return calendar != nil ? calendar : [NSCalendar currentCalendar];
+}
+
+// replaces the clock with the given date provider and calendar
++ (void)setDateProvider:(SLClockDateProvider)dateProvider calendar:(NSCalendar *)calendar
+{
+    @synchronized(self) {
+        sSLClockDateProvider = [dateProvider copy];
+        sSLClockCalendar = calendar;
+    }
+}
+
+@end
@@ -6,15 +6,22 @@
 //
 //
 
-#import <UIKit/UIKit.h>
+#import <Foundation/Foundation.h>
 #import <UserNotifications/UNNotificationTrigger.h>
 #import <UserNotifications/UNNotificationServiceExtension.h>
 #import <UserNotifications/UNNotificationRequest.h>
 #import <UserNotifications/UNNotificationContent.h>
 #import <UserNotifications/UNNotification.h>
 
-// iOS 8 / iOS 9: the notification that gets fired when the user decides to snooze an alarm
-@interface UIConcreteLocalNotification : UILocalNotification
+// iOS 8 / iOS 9: the notification that gets fired when the user decides to snooze an alarm.  This is a subclass of UILocalNotification,
+// but only the members that are used are declared so that the shared headers do not import UIKit.
+@interface UIConcreteLocalNotification : NSObject
+
+// the date that the notification will be fired
+@property (nonatomic, copy) NSDate *fireDate;
+
+// the custom information that is attached to the notification (i.e. the alarm Id)
+@property (nonatomic, copy) NSDictionary *userInfo;
 
 // returns a date for a given notification that will happen after a date in a given time zone
 - (NSDate *)nextFireDateAfterDate:(NSDate *)date localTimeZone:(NSTimeZone *)timeZone;
@@ -104,6 +111,9 @@
 // iOS 10 / iOS 11: the special sleep alarm (i.e. Bedtime alarm)
 @property (nonatomic, readonly) Alarm *sleepAlarm;
 
+// all of the alarms that have been loaded by the manager
+@property (nonatomic, readonly) NSArray *alarms;
+
 // the shared alarm manager
 + (id)sharedManager;
 
@@ -179,6 +189,9 @@
 // returns an alarm object given the corresponding alarm Id string
 - (MTAlarm *)alarmWithIDString:(NSString *)alarmId;
 
+// returns an array of all MTAlarm objects on the system
+- (NSArray *)alarmsSync;
+
 @end
 
 // iOS 8 - iOS 11: data provider which lets us know which alarms have notifications scheduled
@@ -224,4 +237,18 @@
 // iOS 10 / iOS 11: returns pending notification request objects in the completion handler
 - (void)getPendingNotificationRequestsWithCompletionHandler:(void (^)(NSArray<UNNotificationRequest *> *requests))completionHandler;
 
-@end
\ No newline at end of file
+@end
+
+// this is a timer that will be able to fire even when SpringBoard is backgrounded
+@interface PCSimpleTimer : NSObject
+
+// initializer that will be used to create a persistent timer
+- (id)initWithFireDate:(NSDate *)fireDate serviceIdentifier:(NSString *)serviceIdentifier target:(id)target selector:(SEL)selector userInfo:(NSDictionary *)userInfo;
+
+// just like NSTimer, this will invalidate the timer object
+- (void)invalidate;
+
+// schedules the timer in the specified run loop
+- (void)scheduleInRunLoop:(NSRunLoop *)runLoop;
+
+@end
@@ -47,7 +47,11 @@
 #define kSLSystemVersioniOS9 (kCFCoreFoundationVersionNumber >= kCFCoreFoundationVersionNumber_iOS_9_0 && kCFCoreFoundationVersionNumber < kCFCoreFoundationVersionNumber_iOS_10_0)
 #define kSLSystemVersioniOS8 (kCFCoreFoundationVersionNumber >= kCFCoreFoundationVersionNumber_iOS_8_0 && kCFCoreFoundationVersionNumber < kCFCoreFoundationVersionNumber_iOS_9_0)
 
-// interface for version compatibility functions throughout the application
+// the bundle identifier used for the weather application (required for auto-set)
+#define kSLWeatherAppBundleId @"com.apple.weather"
+
+// Interface for version compatibility functions throughout the application.  The user interface functions are declared in the
+// UserInterface category, which is only built into the user interface support library.
 @interface SLCompatibilityHelper : NSObject
 
 // iOS 8 / iOS 9: modifies a snooze UIConcreteLocalNotification object with the selected snooze time (if applicable)
@@ -79,50 +83,26 @@
 // returns the appropriate title string for a given MTAlarm object
 + (NSString *)alarmTitleForMTAlarm:(MTAlarm *)alarm;
 
-// returns the picker view's background color, which will depend on the iOS version
-+ (UIColor *)pickerViewBackgroundColor;
-
-// returns the color of the standard labels used throughout the tweak
-+ (UIColor *)defaultLabelColor;
-
-// returns the color of the destructive labels used throughout the tweak
-+ (UIColor *)destructiveLabelColor;
-
-// iOS 13: returns the background color used for cells used in the various views
-+ (UIColor *)tableViewCellBackgroundColor;
-
-// iOS 10, iOS 11, iOS 12, iOS 13: returns the cell selection background color for cells
-+ (UIColor *)tableViewCellSelectedBackgroundColor;
-
-// modifies an alert controller's subviews appropriately if necessary for the current version of iOS
-+ (void)updateSubviewsForAlertController:(UIAlertController *)alertController;
-
-// uses the appearance API to modify the look and feel of a UIAlertController's various views for the current version of iOS
-+ (void)updateDefaultUIAlertControllerAppearance;
-
-// returns the checkmark image used to indicate selection throughout the UI
-+ (UIImage *)checkmarkImage;
-
-// returns the "open in" image
-+ (UIImage *)openInImage;
-
 // returns whether or not the device is even capable of using the auto-set feature (requires iOS 10 and iPhone device)
 + (BOOL)canHaveAutoSet;
 
 // returns whether or not the device is in a state that can use the auto-set feature
 + (BOOL)canEnableAutoSet;
 
-// navigates the user to the Weather application
-+ (void)openWeatherApplication;
-
 // Updates the given alarms (represented as SLAlarmPref dictionaries) with the base hour and base minute.
 // The implementation of updating the alarms will differ depending on which iOS is currently running.
 + (void)updateAlarms:(NSArray *)alarms withBaseHour:(NSInteger)baseHour withBaseMinute:(NSInteger)baseMinute;
 
-// returns an NSBundle object corresponding to the SleepHealthUI Private Framework
-+ (NSBundle *)sleepHealthUIBundle;
+// Returns the alarm Ids from the given array which no longer correspond to an alarm on the system.  Returns nil if the alarms on the
+// system could not be determined (including when the system returns no alarms at all), in which case none of the alarm Ids should be
+// considered orphaned.
++ (NSSet *)orphanedAlarmIdsForAlarmIds:(NSArray *)alarmIds;
 
 // returns the internally used alarm ID for the new "Wake Up" alarm (iOS 14)
 + (NSString *)wakeUpAlarmId;
 
+// Returns the class of the skip alarm alert item, loading the user interface support library the first time that it is needed.
+// Returns nil if the library could not be loaded.
++ (Class)skipAlarmAlertItemClass;
+
 @end
\ No newline at end of file
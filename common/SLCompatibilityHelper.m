@@ -9,11 +9,12 @@
 #import "SLCompatibilityHelper.h"
 #import "SLLocalizedStrings.h"
 #import "SLPrefsManager.h"
+#import <UIKit/UIKit.h>
 #import <objc/runtime.h>
-
-// the name of the image files as it exists in the bundle
-#define kSLCheckmarkImageName           @"checkmark"
-#define kSLOpenInImageName              @"open_in"
+#import <dlfcn.h>
+#import "SLClock.h"
+#import "SLAccounting.h"
+#import "SLAuditLog.h"
 
 @interface LSApplicationProxy : NSObject
 
@@ -25,63 +26,13 @@
 
 @end
 
-@interface LSApplicationWorkspace : NSObject
-
-// returns the default app workspace for the device (i.e. shared instance)
-+ (id)defaultWorkspace;
-
-// opens the application on the device corresponding to the given bundle identifier
-- (BOOL)openApplicationWithBundleID:(NSString *)bundleId;
-
-@end
-
-// define an extension to UIView to allow for customization of a UIAlertController's background colors using associated objects
-@interface UIView (AssociatedObject)
-
-@property (nonatomic, strong) id subviewsBackgroundColor;
-
-@end
-
-@implementation UIView (AssociatedObject)
-@dynamic subviewsBackgroundColor;
-
-- (id)subviewsBackgroundColor
-{
-    return objc_getAssociatedObject(self, @selector(subviewsBackgroundColor));
-}
-- (void)setSubviewsBackgroundColor:(id)color
-{
-    objc_setAssociatedObject(self, @selector(subviewsBackgroundColor), color, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    for (UIView *subview in self.subviews) {
-        subview.backgroundColor = color;
-    }
-}
-
-@end
-
-// define some static color objects that will be used throughout the UI
-static UIColor *sSLPickerViewBackgroundColor = nil;
-static UIColor *sSLDefaultLabelColor = nil;
-static UIColor *sSLDestructiveLabelColor = nil;
-static UIColor *sSLTableViewCellBackgroundColor = nil;
-static UIColor *sSLTableViewCellSelectedBackgroundColor = nil;
-static UIColor *sSLAlertControllerDarkBackgroundColor = nil;
-static UIColor *sSLAlertControllerDarkLineSeparatorColor = nil;
-
-// keep a single, static instance of the UIImages used throughout the UI
-static UIImage *sSLCheckmarkImage;
-static UIImage *sSLOpenInImage;
-
-// define the bundle identifier used for the weather application (required for auto-set)
-static NSString *const kSLWeatherAppBundleId = @"com.apple.weather";
-
-// define the path for the bundle corresponding to the SleepHealthUI PrivateFramework (introduced with iOS 14)
-static NSString *const kSLSleepHealthUIPrivateFrameworkPath = @"/System/Library/PrivateFrameworks/SleepHealthUI.framework";
-
 // Constant that defines the special "Wake Up" alarm ID (iOS 14) used for Sleeper preferences.  This ID does not appear to remain
 // constant when the alarm's preferences are changed.
 static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-000000000000";
 
+// the path to the library that contains the user interface functions and the skip alarm alert item
+#define kSLUISupportLibraryPath     "/usr/lib/libSleeperUISupport.dylib"
+
 @implementation SLCompatibilityHelper
 
 // iOS 8 / iOS 9: modifies a snooze UIConcreteLocalNotification object with the selected snooze time (if applicable)
@@ -136,15 +87,17 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
 // iOS 8 / iOS 9: Returns the next skippable alarm local notification.  If there is no skippable notification found, return nil.
 + (UIConcreteLocalNotification *)nextSkippableAlarmLocalNotification
 {
+    SLAccountingEnter(kSLAccountingEntryPointUnlockScan);
+
     // create a comparator block to sort the array of notifications
     NSComparisonResult (^notificationComparator) (UIConcreteLocalNotification *, UIConcreteLocalNotification *) =
     ^(UIConcreteLocalNotification *lhs, UIConcreteLocalNotification *rhs) {
         // get the next fire date of the left hand side notification
-        NSDate *lhsNextFireDate = [lhs nextFireDateAfterDate:[NSDate date]
+        NSDate *lhsNextFireDate = [lhs nextFireDateAfterDate:[SLClock now]
                                                localTimeZone:[NSTimeZone localTimeZone]];
         
         // get the next fire date of the right hand side notification
-        NSDate *rhsNextFireDate = [rhs nextFireDateAfterDate:[NSDate date]
+        NSDate *rhsNextFireDate = [rhs nextFireDateAfterDate:[SLClock now]
                                                localTimeZone:[NSTimeZone localTimeZone]];
         
         return [lhsNextFireDate compare:rhsNextFireDate];
@@ -192,17 +145,19 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
 // If there is no skippable notification found, return nil.
 + (UNNotificationRequest *)nextSkippableAlarmNotificationRequestForNotificationRequests:(NSArray *)notificationRequests
 {
+    SLAccountingEnter(kSLAccountingEntryPointUnlockScan);
+
     // create a comparator block to sort the array of notification requests
     NSComparisonResult (^notificationRequestComparator) (UNNotificationRequest *, UNNotificationRequest *) =
     ^(UNNotificationRequest *lhs, UNNotificationRequest *rhs) {
         // get the next trigger date of the left hand side notification request
         if ([lhs.trigger isKindOfClass:objc_getClass("UNLegacyNotificationTrigger")] && [rhs.trigger isKindOfClass:objc_getClass("UNLegacyNotificationTrigger")]) {
-            NSDate *lhsTriggerDate = [((UNLegacyNotificationTrigger *)lhs.trigger) _nextTriggerDateAfterDate:[NSDate date]
+            NSDate *lhsTriggerDate = [((UNLegacyNotificationTrigger *)lhs.trigger) _nextTriggerDateAfterDate:[SLClock now]
                                                                                            withRequestedDate:nil
                                                                                              defaultTimeZone:[NSTimeZone localTimeZone]];
             
             // get the next trigger date of the right hand side notification request
-            NSDate *rhsTriggerDate = [((UNLegacyNotificationTrigger *)rhs.trigger) _nextTriggerDateAfterDate:[NSDate date]
+            NSDate *rhsTriggerDate = [((UNLegacyNotificationTrigger *)rhs.trigger) _nextTriggerDateAfterDate:[SLClock now]
                                                                                            withRequestedDate:nil
                                                                                              defaultTimeZone:[NSTimeZone localTimeZone]];
 
@@ -278,167 +233,12 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
     return alarmTitle;
 }
 
-// returns the picker view's background color, which will depend on the iOS version
-+ (UIColor *)pickerViewBackgroundColor
-{
-    // check the version of iOS that the device is running to determine which color to pick
-    if (!sSLPickerViewBackgroundColor) {
-        if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13) {
-            if (@available(iOS 13.0, *)) {
-                // use the new system grouped background color if available
-                sSLPickerViewBackgroundColor = [UIColor systemGroupedBackgroundColor];
-            } else {
-                // fallback to the color that was extracted from the time picker
-                sSLPickerViewBackgroundColor = [UIColor colorWithRed:0.109804 green:0.109804 blue:0.117647 alpha:1.0];
-            }
-        } else if (kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
-            sSLPickerViewBackgroundColor = [UIColor blackColor];
-        } else {
-            sSLPickerViewBackgroundColor = [UIColor whiteColor];
-        }
-    }
-
-    return sSLPickerViewBackgroundColor;
-}
-
-// returns the color of the standard labels used throughout the tweak
-+ (UIColor *)defaultLabelColor
-{
-    // check the version of iOS that the device is running to determine which color to pick
-    if (!sSLDefaultLabelColor) {
-        if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13 || kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
-            sSLDefaultLabelColor = [UIColor whiteColor];
-        } else {
-            sSLDefaultLabelColor = [UIColor blackColor];
-        }
-    }
-    
-    return sSLDefaultLabelColor;
-}
-
-// returns the color of the destructive labels used throughout the tweak
-+ (UIColor *)destructiveLabelColor
-{
-    if (!sSLDestructiveLabelColor) {
-        sSLDestructiveLabelColor = [UIColor colorWithRed:1.0
-                                                   green:0.231373
-                                                    blue:0.188235
-                                                   alpha:1.0];
-    }
-    return sSLDestructiveLabelColor;
-}
-
-// iOS 13: returns the background color used for cells used in the various views
-+ (UIColor *)tableViewCellBackgroundColor
-{
-    if (!sSLTableViewCellBackgroundColor) {
-        if (@available(iOS 13.0, *)) {
-            sSLTableViewCellBackgroundColor = [UIColor secondarySystemGroupedBackgroundColor];
-        } else {
-            sSLTableViewCellBackgroundColor = [UIColor colorWithRed:0.172549 green:0.172549 blue:0.180392 alpha:1.0];
-        }
-    }
-    return sSLTableViewCellBackgroundColor;
-}
-
-// returns the cell selection background color for cells
-+ (UIColor *)tableViewCellSelectedBackgroundColor
-{
-    if (!sSLTableViewCellSelectedBackgroundColor) {
-        if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13) {
-            if (@available(iOS 13.0, *)) {
-                sSLTableViewCellSelectedBackgroundColor = [UIColor quaternaryLabelColor];
-            } else {
-                sSLTableViewCellSelectedBackgroundColor = [UIColor colorWithRed:0.922 green:0.922 blue:0.961 alpha:0.180];
-            }
-        } else {
-            sSLTableViewCellSelectedBackgroundColor = [UIColor colorWithRed:52.0 / 255.0
-                                                                      green:52.0 / 255.0
-                                                                       blue:52.0 / 255.0
-                                                                      alpha:1.0];
-        }
-    }
-    return sSLTableViewCellSelectedBackgroundColor;
-}
-
-// iOS 10, iOS 11, iOS 12: returns the custom background color applied to some of the subviews contained in a UIAlertController to mimic the dark appearance
-// Note this is not necessary in iOS 13 since the alert controller uses the native dark mode APIs
-+ (UIColor *)alertControllerDarkBackgroundColor
-{
-    if (!sSLAlertControllerDarkBackgroundColor) {
-        sSLAlertControllerDarkBackgroundColor = [UIColor colorWithRed:41.0 / 255.0
-                                                                green:41.0 / 255.0
-                                                                 blue:41.0 / 255.0
-                                                                alpha:1.0];
-    }
-    return sSLAlertControllerDarkBackgroundColor;
-}
-
-// iOS 10, iOS 11, iOS 12: returns the custom background color for the line separators that are used in UIAlertControllers
-// Note this is not necessary in iOS 13 since the alert controller uses the native dark mode APIs
-+ (UIColor *)alertControllerDarkLineSeparatorColor
-{
-    if (!sSLAlertControllerDarkLineSeparatorColor) {
-        sSLAlertControllerDarkLineSeparatorColor = [UIColor colorWithRed:101.0 / 255.0
-                                                                   green:101.0 / 255.0
-                                                                    blue:101.0 / 255.0
-                                                                   alpha:1.0];
-    }
-    return sSLAlertControllerDarkLineSeparatorColor;
-}
-
-// modifies an alert controller's subviews appropriately if necessary for the current version of iOS
-+ (void)updateSubviewsForAlertController:(UIAlertController *)alertController
-{
-    // iterate through the alert controller's subviews to set the background color of the action buttons (not including the cancel buttons)
-    UIView *firstSubview = alertController.view.subviews.firstObject;
-    if (firstSubview != nil && firstSubview.subviews.count > 0) {
-        UIView *secondSubview = firstSubview.subviews.firstObject;
-        for (UIView *subview in secondSubview.subviews) {
-            subview.backgroundColor = [SLCompatibilityHelper alertControllerDarkBackgroundColor];
-        }
-    }
-
-    // for alert styles of UIAlertController, update the title and message font color
-    if (alertController.preferredStyle == UIAlertControllerStyleAlert) {
-        // modify the title and message text with the correct foreground color
-        NSMutableAttributedString *modifiedTitle = [[NSMutableAttributedString alloc] initWithString:alertController.title];
-        [modifiedTitle addAttribute:NSForegroundColorAttributeName value:[SLCompatibilityHelper defaultLabelColor] range:NSMakeRange(0, alertController.title.length)];
-        [modifiedTitle addAttribute:NSFontAttributeName value:[UIFont boldSystemFontOfSize:17.0] range:NSMakeRange(0, alertController.title.length)];
-        [alertController setValue:modifiedTitle forKey:@"attributedTitle"];
-        NSMutableAttributedString *modifiedMessage = [[NSMutableAttributedString alloc] initWithString:alertController.message];
-        [modifiedMessage addAttribute:NSForegroundColorAttributeName value:[SLCompatibilityHelper defaultLabelColor] range:NSMakeRange(0, alertController.message.length)];
-        [modifiedMessage addAttribute:NSFontAttributeName value:[UIFont systemFontOfSize:13.0] range:NSMakeRange(0, alertController.message.length)];
-        [alertController setValue:modifiedMessage forKey:@"attributedMessage"];
-    }
-}
-
-// Uses the appearance API to modify the look and feel of a UIAlertController's various views for the current version of iOS
-// This method will take care of coloring the header of the alert (only for action sheet alerts), the cancel button, and the separator lines
-+ (void)updateDefaultUIAlertControllerAppearance
-{
-    // modify the header view of an alert controller (only applicable to UIAlertControllerStyleActionSheet)
-    ((UIView *)[NSClassFromString(@"_UIInterfaceActionGroupHeaderScrollView") appearance]).subviewsBackgroundColor = [SLCompatibilityHelper alertControllerDarkBackgroundColor];
-    
-    // modify the cancel button's background view
-    ((UIView *)[NSClassFromString(@"_UIAlertControlleriOSActionSheetCancelBackgroundView") appearance]).subviewsBackgroundColor = [SLCompatibilityHelper alertControllerDarkBackgroundColor];
-
-    // modify the colors of various views to display the selection of the action correctly
-    ((UIView *)[NSClassFromString(@"_UIBlendingHighlightView") appearanceWhenContainedIn:NSClassFromString(@"_UIInterfaceActionCustomViewRepresentationView"), nil]).backgroundColor = [SLCompatibilityHelper tableViewCellSelectedBackgroundColor];
-    ((UIView *)[NSClassFromString(@"_UIBlendingHighlightView") appearanceWhenContainedIn:NSClassFromString(@"_UIAlertControlleriOSActionSheetCancelBackgroundView"), nil]).alpha = 0.92;
-    ((UIView *)[NSClassFromString(@"_UIBlendingHighlightView") appearanceWhenContainedIn:NSClassFromString(@"_UIInterfaceActionCustomViewRepresentationView"), nil]).subviewsBackgroundColor = [UIColor clearColor];
-
-    // modify the separator line colors
-    ((UIView *)[NSClassFromString(@"_UIInterfaceActionItemSeparatorView_iOS") appearance]).backgroundColor = [SLCompatibilityHelper alertControllerDarkLineSeparatorColor];
-    ((UIView *)[NSClassFromString(@"_UIInterfaceActionItemSeparatorView_iOS") appearance]).subviewsBackgroundColor = [UIColor clearColor];
-}
-
 // iOS 8 / iOS 9: helper function that will investigate an alarm local notification and alarm Id to see if it is skippable
 + (BOOL)isAlarmLocalNotificationSkippable:(UIConcreteLocalNotification *)localNotification
                                forAlarmId:(NSString *)alarmId
 {
     // get the fire date of the notification we are checking
-    NSDate *nextFireDate = [localNotification nextFireDateAfterDate:[NSDate date]
+    NSDate *nextFireDate = [localNotification nextFireDateAfterDate:[SLClock now]
                                                       localTimeZone:[NSTimeZone localTimeZone]];
     
     return [SLCompatibilityHelper isAlarmSkippableForAlarmId:alarmId withNextFireDate:nextFireDate];
@@ -451,7 +251,7 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
     BOOL skippable = NO;
     if ([notificationRequest.trigger isKindOfClass:objc_getClass("UNLegacyNotificationTrigger")]) {
         // get the fire date of the alarm we are checking
-        NSDate *nextTriggerDate = [((UNLegacyNotificationTrigger *)notificationRequest.trigger) _nextTriggerDateAfterDate:[NSDate date]
+        NSDate *nextTriggerDate = [((UNLegacyNotificationTrigger *)notificationRequest.trigger) _nextTriggerDateAfterDate:[SLClock now]
                                                                                                         withRequestedDate:nil
                                                                                                           defaultTimeZone:[NSTimeZone localTimeZone]];
         
@@ -464,6 +264,8 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
 // returns whether or not an alarm is skippable based on the alarm Id
 + (BOOL)isAlarmSkippableForAlarmId:(NSString *)alarmId withNextFireDate:(NSDate *)nextFireDate
 {
+    SLAccountingEnter(kSLAccountingEntryPointIsAlarmSkippable);
+
     // grab the attributes for the alarm
     BOOL skippable = NO;
     SLAlarmPrefs *alarmPrefs = [SLPrefsManager alarmPrefsForAlarmId:alarmId];
@@ -474,11 +276,11 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
         [components setHour:alarmPrefs.skipTimeHour];
         [components setMinute:alarmPrefs.skipTimeMinute];
         [components setSecond:alarmPrefs.skipTimeSecond];
-        NSCalendar *calendar = [NSCalendar currentCalendar];
+        NSCalendar *calendar = [SLClock calendar];
         
         // create a date that is the amount of time ahead of the current date
         NSDate *thresholdDate = [calendar dateByAddingComponents:components
-                                                          toDate:[NSDate date]
+                                                          toDate:[SLClock now]
                                                          options:0];
         
         // compare the dates to see if this notification is skippable
@@ -487,32 +289,11 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
     return skippable;
 }
 
-// returns the checkmark image used to indicate selection throughout the UI
-+ (UIImage *)checkmarkImage
-{
-    if (!sSLCheckmarkImage) {
-        sSLCheckmarkImage = [[UIImage imageNamed:kSLCheckmarkImageName
-                                        inBundle:kSLSleeperBundle
-                   compatibleWithTraitCollection:nil] imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
-    }
-    return sSLCheckmarkImage;
-}
-
-// returns the "open in" image
-+ (UIImage *)openInImage
-{
-    if (!sSLOpenInImage) {
-        sSLOpenInImage = [[UIImage imageNamed:kSLOpenInImageName
-                                     inBundle:kSLSleeperBundle
-                compatibleWithTraitCollection:nil] imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
-    }
-    return sSLOpenInImage;
-}
-
 // returns whether or not the device is even capable of using the auto-set feature (requires iOS 10 and iPhone device)
 + (BOOL)canHaveAutoSet
 {
-    return (kCFCoreFoundationVersionNumber >= kCFCoreFoundationVersionNumber_iOS_10_0) && UI_USER_INTERFACE_IDIOM() == UIUserInterfaceIdiomPhone;
+    // the device class is looked up at runtime so that the library does not reference any UIKit classes directly
+    return (kCFCoreFoundationVersionNumber >= kCFCoreFoundationVersionNumber_iOS_10_0) && [(UIDevice *)[objc_getClass("UIDevice") currentDevice] userInterfaceIdiom] == UIUserInterfaceIdiomPhone;
 }
 
 // returns whether or not the device is in a state that can use the auto-set feature
@@ -531,19 +312,12 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
     }
 }
 
-// navigates the user to the Weather application
-+ (void)openWeatherApplication
-{
-    LSApplicationWorkspace *appWorkspace = [objc_getClass("LSApplicationWorkspace") defaultWorkspace];
-    if (appWorkspace != nil && [appWorkspace respondsToSelector:@selector(openApplicationWithBundleID:)]) {
-        [appWorkspace openApplicationWithBundleID:kSLWeatherAppBundleId];
-    }
-}
-
 // Updates the given alarms (represented as SLAlarmPref dictionaries) with the base hour and base minute.
 // The implementation of updating the alarms will differ depending on which iOS is currently running.
 + (void)updateAlarms:(NSArray *)alarms withBaseHour:(NSInteger)baseHour withBaseMinute:(NSInteger)baseMinute
 {
+    SLAccountingEnter(kSLAccountingEntryPointUpdateAlarms);
+
     // updating the alarms will differ depending on which version of iOS we are on
     if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13 || kSLSystemVersioniOS12) {
         // create an instance of the alarm manager that will get us the actual alarm objects
@@ -590,6 +364,10 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
                         }
                     }
 
+                    // the auto-set option and updated time of the alarm are recorded in the audit log once the alarm is modified
+                    BOOL isSunset = [[alarmDict objectForKey:kSLAutoSetOptionKey] integerValue] == kSLAutoSetOptionSunset;
+                    SLAuditCause cause = {isSunset ? kSLAuditReasonAutoSetSunset : kSLAuditReasonAutoSetSunrise, 0, (uint32_t)(updatedHour * 60 + updatedMinute)};
+
                     // modify the alarm after a small delay since this could happen right after an alarm was just saved
                     dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)((1 + alarmCount) * NSEC_PER_SEC));
                     dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
@@ -602,6 +380,7 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
 
                             // persist the changes to the system
                             [alarmManager updateAlarm:mutableAlarm];
+                            SLAuditLogAppend(kSLAuditHookUpdateAlarms, [alarmId UTF8String], kSLAuditDecisionUpdate, cause);
                         }
                     });
                 }
@@ -657,6 +436,10 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
                         }
                     }
 
+                    // the auto-set option and updated time of the alarm are recorded in the audit log once the alarm is modified
+                    BOOL isSunset = [[alarmDict objectForKey:kSLAutoSetOptionKey] integerValue] == kSLAutoSetOptionSunset;
+                    SLAuditCause cause = {isSunset ? kSLAuditReasonAutoSetSunset : kSLAuditReasonAutoSetSunrise, 0, (uint32_t)(updatedHour * 60 + updatedMinute)};
+
                     // modify the alarm after a small delay since this could happen right after an alarm was just saved
                     dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)((5 + alarmCount) * NSEC_PER_SEC));
                     dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
@@ -669,6 +452,7 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
 
                             // persist changes to the system
                             [alarmManager updateAlarm:alarm active:[alarm isActive]];
+                            SLAuditLogAppend(kSLAuditHookUpdateAlarms, [alarmId UTF8String], kSLAuditDecisionUpdate, cause);
                         }
                     });
                 }
@@ -680,10 +464,70 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
     }
 }
 
-// returns an NSBundle object corresponding to the SleepHealthUI Private Framework
-+ (NSBundle *)sleepHealthUIBundle
+// Returns the alarm Ids from the given array which no longer correspond to an alarm on the system.  Returns nil if the alarms on the
+// system could not be determined, in which case none of the alarm Ids should be considered orphaned.  An empty list of alarms from the
+// system is also treated as undetermined, since the alarm manager returns no alarms when it has not loaded them yet (i.e. shortly after
+// a reboot) and the preferences would otherwise be deleted for every alarm.
++ (NSSet *)orphanedAlarmIdsForAlarmIds:(NSArray *)alarmIds
 {
-    return [NSBundle bundleWithPath:kSLSleepHealthUIPrivateFrameworkPath];
+    // the "Wake Up" alarm is not managed by the alarm manager, so it is never considered orphaned
+    NSMutableSet *liveAlarmIds = [[NSMutableSet alloc] initWithObjects:kSLWakeUpAlarmID, nil];
+    NSMutableSet *orphanedAlarmIds = [[NSMutableSet alloc] init];
+
+    // collect all of the alarm Ids on the system in a single pass, then confirm each missing alarm individually before reporting it
+    if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13 || kSLSystemVersioniOS12) {
+        MTAlarmManager *alarmManager = [[objc_getClass("MTAlarmManager") alloc] init];
+        if (alarmManager == nil) {
+            return nil;
+        }
+        if (![alarmManager respondsToSelector:@selector(alarmsSync)]) {
+            return nil;
+        }
+        NSArray *alarms = [alarmManager alarmsSync];
+        if (alarms.count == 0) {
+            return nil;
+        }
+        for (MTAlarm *alarm in alarms) {
+            NSString *alarmId = [alarm alarmIDString];
+            if (alarmId != nil) {
+                [liveAlarmIds addObject:alarmId];
+            }
+        }
+        for (NSString *alarmId in alarmIds) {
+            if (![liveAlarmIds containsObject:alarmId] && [alarmManager alarmWithIDString:alarmId] == nil) {
+                [orphanedAlarmIds addObject:alarmId];
+            }
+        }
+    } else if (kSLSystemVersioniOS11 || kSLSystemVersioniOS10 || kSLSystemVersioniOS9 || kSLSystemVersioniOS8) {
+        AlarmManager *alarmManager = (AlarmManager *)[objc_getClass("AlarmManager") sharedManager];
+        if (alarmManager == nil) {
+            return nil;
+        }
+        [alarmManager loadAlarms];
+        if (alarmManager.alarms.count == 0) {
+            return nil;
+        }
+        for (Alarm *alarm in alarmManager.alarms) {
+            NSString *alarmId = [SLCompatibilityHelper alarmIdForAlarm:alarm];
+            if (alarmId != nil) {
+                [liveAlarmIds addObject:alarmId];
+            }
+        }
+        if ((kSLSystemVersioniOS11 || kSLSystemVersioniOS10) && alarmManager.sleepAlarm != nil) {
+            NSString *sleepAlarmId = [SLCompatibilityHelper alarmIdForAlarm:alarmManager.sleepAlarm];
+            if (sleepAlarmId != nil) {
+                [liveAlarmIds addObject:sleepAlarmId];
+            }
+        }
+        for (NSString *alarmId in alarmIds) {
+            if (![liveAlarmIds containsObject:alarmId] && [alarmManager alarmWithId:alarmId] == nil) {
+                [orphanedAlarmIds addObject:alarmId];
+            }
+        }
+    } else {
+        return nil;
+    }
+    return [orphanedAlarmIds copy];
 }
 
 // returns the internally used alarm ID for the new "Wake Up" alarm (iOS 14)
@@ -692,4 +536,18 @@ static NSString * const kSLWakeUpAlarmID = @"00000000-0000-0000-0000-00000000000
     return kSLWakeUpAlarmID;
 }
 
-@end
\ No newline at end of file
+// Returns the class of the skip alarm alert item, loading the user interface support library the first time that it is needed.
+// SpringBoard is the only process that displays the alert, and only once an alarm is found to be skippable, so the library (and the
+// UIKit customizations within it) are kept out of the other processes and off of the launch of SpringBoard.
++ (Class)skipAlarmAlertItemClass
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        if (dlopen(kSLUISupportLibraryPath, RTLD_LAZY) == NULL) {
+            NSLog(@"Sleeper: unable to load the user interface support library: %s", dlerror());
+        }
+    });
+    return objc_getClass("SLSkipAlarmAlertItem");
+}
+
+@end
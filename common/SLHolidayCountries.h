@@ -0,0 +1,209 @@
+//
+//  SLHolidayCountries.h
+//  The registry of the holiday countries that are available to choose from for the holiday selection.
+//
+//  This file is generated by holiday_gen.py ("holiday_gen.py -r").  Do not edit it directly.
+//
+
+#import <Foundation/Foundation.h>
+
+// enum that defines the rows countries that are available to choose from for the holiday selection
+typedef enum SLHolidayCountry : NSInteger {
+    kSLHolidayCountryArgentina,
+    kSLHolidayCountryAruba,
+    kSLHolidayCountryAustralia,
+    kSLHolidayCountryAustria,
+    kSLHolidayCountryBelarus,
+    kSLHolidayCountryBelgium,
+    kSLHolidayCountryBrazil,
+    kSLHolidayCountryBulgaria,
+    kSLHolidayCountryCanada,
+    kSLHolidayCountryChina,
+    kSLHolidayCountryColombia,
+    kSLHolidayCountryCroatia,
+    kSLHolidayCountryCzechia,
+    kSLHolidayCountryDenmark,
+    kSLHolidayCountryDominicanRepublic,
+    kSLHolidayCountryEgypt,
+    kSLHolidayCountryEstonia,
+    kSLHolidayCountryFinland,
+    kSLHolidayCountryFrance,
+    kSLHolidayCountryGermany,
+    kSLHolidayCountryHongKong,
+    kSLHolidayCountryHungary,
+    kSLHolidayCountryIceland,
+    kSLHolidayCountryIndia,
+    kSLHolidayCountryIreland,
+    kSLHolidayCountryIsrael,
+    kSLHolidayCountryItaly,
+    kSLHolidayCountryJapan,
+    kSLHolidayCountryKenya,
+    kSLHolidayCountryKorea,
+    kSLHolidayCountryLithuania,
+    kSLHolidayCountryLuxembourg,
+    kSLHolidayCountryMexico,
+    kSLHolidayCountryMorocco,
+    kSLHolidayCountryNetherlands,
+    kSLHolidayCountryNewZealand,
+    kSLHolidayCountryNicaragua,
+    kSLHolidayCountryNigeria,
+    kSLHolidayCountryNorway,
+    kSLHolidayCountryParaguay,
+    kSLHolidayCountryPeru,
+    kSLHolidayCountryPoland,
+    kSLHolidayCountryPortugal,
+    kSLHolidayCountryRussia,
+    kSLHolidayCountrySerbia,
+    kSLHolidayCountrySingapore,
+    kSLHolidayCountrySlovakia,
+    kSLHolidayCountrySlovenia,
+    kSLHolidayCountrySouthAfrica,
+    kSLHolidayCountrySpain,
+    kSLHolidayCountrySweden,
+    kSLHolidayCountrySwitzerland,
+    kSLHolidayCountryTaiwan,
+    kSLHolidayCountryTurkey,
+    kSLHolidayCountryUkraine,
+    kSLHolidayCountryUnitedKingdom,
+    kSLHolidayCountryUnitedStates,
+    kSLHolidayCountryVietnam,
+    kSLHolidayCountryNumCountries,
+    // the subdivisions of the holiday countries, which only store the holidays that differ from the holidays of their country
+    kSLHolidayCountryAustraliaACT = kSLHolidayCountryNumCountries,
+    kSLHolidayCountryAustraliaNSW,
+    kSLHolidayCountryAustraliaNT,
+    kSLHolidayCountryAustraliaQLD,
+    kSLHolidayCountryAustraliaSA,
+    kSLHolidayCountryAustraliaTAS,
+    kSLHolidayCountryAustraliaVIC,
+    kSLHolidayCountryAustraliaWA,
+    kSLHolidayCountryGermanyBB,
+    kSLHolidayCountryGermanyBE,
+    kSLHolidayCountryGermanyBW,
+    kSLHolidayCountryGermanyBY,
+    kSLHolidayCountryGermanyHB,
+    kSLHolidayCountryGermanyHE,
+    kSLHolidayCountryGermanyHH,
+    kSLHolidayCountryGermanyMV,
+    kSLHolidayCountryGermanyNI,
+    kSLHolidayCountryGermanyNW,
+    kSLHolidayCountryGermanyRP,
+    kSLHolidayCountryGermanySH,
+    kSLHolidayCountryGermanySL,
+    kSLHolidayCountryGermanySN,
+    kSLHolidayCountryGermanyST,
+    kSLHolidayCountryGermanyTH,
+    kSLHolidayCountrySwitzerlandAG,
+    kSLHolidayCountrySwitzerlandAI,
+    kSLHolidayCountrySwitzerlandAR,
+    kSLHolidayCountrySwitzerlandBE,
+    kSLHolidayCountrySwitzerlandBL,
+    kSLHolidayCountrySwitzerlandBS,
+    kSLHolidayCountrySwitzerlandFR,
+    kSLHolidayCountrySwitzerlandGE,
+    kSLHolidayCountrySwitzerlandGL,
+    kSLHolidayCountrySwitzerlandGR,
+    kSLHolidayCountrySwitzerlandJU,
+    kSLHolidayCountrySwitzerlandLU,
+    kSLHolidayCountrySwitzerlandNE,
+    kSLHolidayCountrySwitzerlandNW,
+    kSLHolidayCountrySwitzerlandOW,
+    kSLHolidayCountrySwitzerlandSG,
+    kSLHolidayCountrySwitzerlandSH,
+    kSLHolidayCountrySwitzerlandSO,
+    kSLHolidayCountrySwitzerlandSZ,
+    kSLHolidayCountrySwitzerlandTG,
+    kSLHolidayCountrySwitzerlandTI,
+    kSLHolidayCountrySwitzerlandUR,
+    kSLHolidayCountrySwitzerlandVD,
+    kSLHolidayCountrySwitzerlandVS,
+    kSLHolidayCountrySwitzerlandZG,
+    kSLHolidayCountrySwitzerlandZH,
+    kSLHolidayCountryUnitedStatesAK,
+    kSLHolidayCountryUnitedStatesAL,
+    kSLHolidayCountryUnitedStatesAR,
+    kSLHolidayCountryUnitedStatesAZ,
+    kSLHolidayCountryUnitedStatesCA,
+    kSLHolidayCountryUnitedStatesCO,
+    kSLHolidayCountryUnitedStatesCT,
+    kSLHolidayCountryUnitedStatesDC,
+    kSLHolidayCountryUnitedStatesDE,
+    kSLHolidayCountryUnitedStatesFL,
+    kSLHolidayCountryUnitedStatesGA,
+    kSLHolidayCountryUnitedStatesHI,
+    kSLHolidayCountryUnitedStatesIA,
+    kSLHolidayCountryUnitedStatesID,
+    kSLHolidayCountryUnitedStatesIL,
+    kSLHolidayCountryUnitedStatesIN,
+    kSLHolidayCountryUnitedStatesKS,
+    kSLHolidayCountryUnitedStatesKY,
+    kSLHolidayCountryUnitedStatesLA,
+    kSLHolidayCountryUnitedStatesMA,
+    kSLHolidayCountryUnitedStatesMD,
+    kSLHolidayCountryUnitedStatesME,
+    kSLHolidayCountryUnitedStatesMI,
+    kSLHolidayCountryUnitedStatesMN,
+    kSLHolidayCountryUnitedStatesMO,
+    kSLHolidayCountryUnitedStatesMS,
+    kSLHolidayCountryUnitedStatesMT,
+    kSLHolidayCountryUnitedStatesNC,
+    kSLHolidayCountryUnitedStatesND,
+    kSLHolidayCountryUnitedStatesNE,
+    kSLHolidayCountryUnitedStatesNH,
+    kSLHolidayCountryUnitedStatesNJ,
+    kSLHolidayCountryUnitedStatesNM,
+    kSLHolidayCountryUnitedStatesNV,
+    kSLHolidayCountryUnitedStatesNY,
+    kSLHolidayCountryUnitedStatesOH,
+    kSLHolidayCountryUnitedStatesOK,
+    kSLHolidayCountryUnitedStatesOR,
+    kSLHolidayCountryUnitedStatesPA,
+    kSLHolidayCountryUnitedStatesRI,
+    kSLHolidayCountryUnitedStatesSC,
+    kSLHolidayCountryUnitedStatesSD,
+    kSLHolidayCountryUnitedStatesTN,
+    kSLHolidayCountryUnitedStatesTX,
+    kSLHolidayCountryUnitedStatesUT,
+    kSLHolidayCountryUnitedStatesVA,
+    kSLHolidayCountryUnitedStatesVT,
+    kSLHolidayCountryUnitedStatesWA,
+    kSLHolidayCountryUnitedStatesWI,
+    kSLHolidayCountryUnitedStatesWV,
+    kSLHolidayCountryUnitedStatesWY,
+    kSLHolidayCountryNumRegions
+} SLHolidayCountry;
+
+// the number of holiday IDs that can be assigned for a single holiday country
+#define kSLHolidayMaxHolidayIds         64
+
+// the stable ID that is assigned to a holiday by holiday_gen.py, which is unique within a holiday country
+typedef uint8_t SLHolidayId;
+
+// a set of the selected holiday IDs for a single holiday country, using each holiday ID as a bit position
+typedef uint64_t SLHolidaySelection;
+
+// returns the holiday selection that only contains the given holiday ID
+#define SLHolidaySelectionForHolidayId(holidayId)   (((SLHolidaySelection)1) << (holidayId))
+
+// the information for a single holiday country
+typedef struct SLHolidayCountryInfo {
+    // the code that is used to name the holiday resource for the country
+    __unsafe_unretained NSString *countryCode;
+    // the ISO 3166-1 code for the country that is used by the system locale
+    __unsafe_unretained NSString *isoCountryCode;
+    // the name of the holiday resource for the country in the Sleeper bundle
+    __unsafe_unretained NSString *resourceName;
+    // the number of holidays that are available for the country (including the holidays that a subdivision shares with its country)
+    NSInteger numHolidays;
+    // the country that a subdivision belongs to (or the country itself)
+    SLHolidayCountry parentCountry;
+    // the name that is displayed for a subdivision (or nil for the country itself)
+    __unsafe_unretained NSString *subdivisionName;
+} SLHolidayCountryInfo;
+
+// the information for each of the holiday countries and subdivisions (indexed by the holiday country)
+extern const SLHolidayCountryInfo kSLHolidayCountryInfo[kSLHolidayCountryNumRegions];
+
+// Returns the holiday country or subdivision for the given resource code or ISO code (case insensitive), or kSLHolidayCountryNumRegions
+// if no holiday country exists for the code.
+SLHolidayCountry SLHolidayCountryForCountryCode(NSString *countryCode);
@@ -0,0 +1,466 @@
+//
+//  SLHolidayCountries.m
+//  The registry of the holiday countries that are available to choose from for the holiday selection.
+//
+//  This file is generated by holiday_gen.py ("holiday_gen.py -r").  Do not edit it directly.
+//
+
+#import "SLHolidayCountries.h"
+
+// an entry in the table that is used to look up the holiday country for a given code
+typedef struct SLHolidayCountryCodeEntry {
+    __unsafe_unretained NSString *code;
+    SLHolidayCountry holidayCountry;
+} SLHolidayCountryCodeEntry;
+
+const SLHolidayCountryInfo kSLHolidayCountryInfo[kSLHolidayCountryNumRegions] = {
+    {@"ar", @"AR", @"ar_holidays", 17, kSLHolidayCountryArgentina, nil},
+    {@"aw", @"AW", @"aw_holidays", 11, kSLHolidayCountryAruba, nil},
+    {@"au", @"AU", @"au_holidays", 7, kSLHolidayCountryAustralia, nil},
+    {@"at", @"AT", @"at_holidays", 13, kSLHolidayCountryAustria, nil},
+    {@"by", @"BY", @"by_holidays", 9, kSLHolidayCountryBelarus, nil},
+    {@"be", @"BE", @"be_holidays", 12, kSLHolidayCountryBelgium, nil},
+    {@"br", @"BR", @"br_holidays", 13, kSLHolidayCountryBrazil, nil},
+    {@"bg", @"BG", @"bg_holidays", 15, kSLHolidayCountryBulgaria, nil},
+    {@"ca", @"CA", @"ca_holidays", 10, kSLHolidayCountryCanada, nil},
+    {@"cn", @"CN", @"cn_holidays", 7, kSLHolidayCountryChina, nil},
+    {@"co", @"CO", @"co_holidays", 18, kSLHolidayCountryColombia, nil},
+    {@"hr", @"HR", @"hr_holidays", 14, kSLHolidayCountryCroatia, nil},
+    {@"cz", @"CZ", @"cz_holidays", 13, kSLHolidayCountryCzechia, nil},
+    {@"dk", @"DK", @"dk_holidays", 12, kSLHolidayCountryDenmark, nil},
+    {@"do", @"DO", @"do_holidays", 12, kSLHolidayCountryDominicanRepublic, nil},
+    {@"eg", @"EG", @"eg_holidays", 10, kSLHolidayCountryEgypt, nil},
+    {@"ee", @"EE", @"ee_holidays", 12, kSLHolidayCountryEstonia, nil},
+    {@"fi", @"FI", @"fi_holidays", 15, kSLHolidayCountryFinland, nil},
+    {@"fra", @"FR", @"fra_holidays", 11, kSLHolidayCountryFrance, nil},
+    {@"de", @"DE", @"de_holidays", 10, kSLHolidayCountryGermany, nil},
+    {@"hk", @"HK", @"hk_holidays", 19, kSLHolidayCountryHongKong, nil},
+    {@"hu", @"HU", @"hu_holidays", 13, kSLHolidayCountryHungary, nil},
+    {@"is", @"IS", @"is_holidays", 15, kSLHolidayCountryIceland, nil},
+    {@"ind", @"IN", @"ind_holidays", 7, kSLHolidayCountryIndia, nil},
+    {@"ie", @"IE", @"ie_holidays", 9, kSLHolidayCountryIreland, nil},
+    {@"il", @"IL", @"il_holidays", 23, kSLHolidayCountryIsrael, nil},
+    {@"it", @"IT", @"it_holidays", 12, kSLHolidayCountryItaly, nil},
+    {@"jp", @"JP", @"jp_holidays", 15, kSLHolidayCountryJapan, nil},
+    {@"ke", @"KE", @"ke_holidays", 9, kSLHolidayCountryKenya, nil},
+    {@"kr", @"KR", @"kr_holidays", 16, kSLHolidayCountryKorea, nil},
+    {@"lt", @"LT", @"lt_holidays", 15, kSLHolidayCountryLithuania, nil},
+    {@"lu", @"LU", @"lu_holidays", 11, kSLHolidayCountryLuxembourg, nil},
+    {@"mx", @"MX", @"mx_holidays", 7, kSLHolidayCountryMexico, nil},
+    {@"ma", @"MA", @"ma_holidays", 13, kSLHolidayCountryMorocco, nil},
+    {@"nl", @"NL", @"nl_holidays", 10, kSLHolidayCountryNetherlands, nil},
+    {@"nz", @"NZ", @"nz_holidays", 10, kSLHolidayCountryNewZealand, nil},
+    {@"ni", @"NI", @"ni_holidays", 11, kSLHolidayCountryNicaragua, nil},
+    {@"ng", @"NG", @"ng_holidays", 7, kSLHolidayCountryNigeria, nil},
+    {@"no", @"NO", @"no_holidays", 12, kSLHolidayCountryNorway, nil},
+    {@"py", @"PY", @"py_holidays", 12, kSLHolidayCountryParaguay, nil},
+    {@"pe", @"PE", @"pe_holidays", 14, kSLHolidayCountryPeru, nil},
+    {@"pl", @"PL", @"pl_holidays", 13, kSLHolidayCountryPoland, nil},
+    {@"pt", @"PT", @"pt_holidays", 13, kSLHolidayCountryPortugal, nil},
+    {@"ru", @"RU", @"ru_holidays", 8, kSLHolidayCountryRussia, nil},
+    {@"rs", @"RS", @"rs_holidays", 9, kSLHolidayCountrySerbia, nil},
+    {@"sg", @"SG", @"sg_holidays", 6, kSLHolidayCountrySingapore, nil},
+    {@"sk", @"SK", @"sk_holidays", 15, kSLHolidayCountrySlovakia, nil},
+    {@"si", @"SI", @"si_holidays", 12, kSLHolidayCountrySlovenia, nil},
+    {@"za", @"ZA", @"za_holidays", 12, kSLHolidayCountrySouthAfrica, nil},
+    {@"es", @"ES", @"es_holidays", 10, kSLHolidayCountrySpain, nil},
+    {@"se", @"SE", @"se_holidays", 16, kSLHolidayCountrySweden, nil},
+    {@"ch", @"CH", @"ch_holidays", 9, kSLHolidayCountrySwitzerland, nil},
+    {@"tw", @"TW", @"tw_holidays", 9, kSLHolidayCountryTaiwan, nil},
+    {@"tr", @"TR", @"tr_holidays", 11, kSLHolidayCountryTurkey, nil},
+    {@"ua", @"UA", @"ua_holidays", 11, kSLHolidayCountryUkraine, nil},
+    {@"uk", @"GB", @"uk_holidays", 13, kSLHolidayCountryUnitedKingdom, nil},
+    {@"us", @"US", @"us_holidays", 14, kSLHolidayCountryUnitedStates, nil},
+    {@"vn", @"VN", @"vn_holidays", 11, kSLHolidayCountryVietnam, nil},
+    {@"au_act", @"AU-ACT", @"au_act_holidays", 13, kSLHolidayCountryAustralia, @"Australian Capital Territory"},
+    {@"au_nsw", @"AU-NSW", @"au_nsw_holidays", 11, kSLHolidayCountryAustralia, @"New South Wales"},
+    {@"au_nt", @"AU-NT", @"au_nt_holidays", 12, kSLHolidayCountryAustralia, @"Northern Territory"},
+    {@"au_qld", @"AU-QLD", @"au_qld_holidays", 12, kSLHolidayCountryAustralia, @"Queensland"},
+    {@"au_sa", @"AU-SA", @"au_sa_holidays", 12, kSLHolidayCountryAustralia, @"South Australia"},
+    {@"au_tas", @"AU-TAS", @"au_tas_holidays", 9, kSLHolidayCountryAustralia, @"Tasmania"},
+    {@"au_vic", @"AU-VIC", @"au_vic_holidays", 13, kSLHolidayCountryAustralia, @"Victoria"},
+    {@"au_wa", @"AU-WA", @"au_wa_holidays", 11, kSLHolidayCountryAustralia, @"Western Australia"},
+    {@"de_bb", @"DE-BB", @"de_bb_holidays", 12, kSLHolidayCountryGermany, @"Brandenburg"},
+    {@"de_be", @"DE-BE", @"de_be_holidays", 12, kSLHolidayCountryGermany, @"Berlin"},
+    {@"de_bw", @"DE-BW", @"de_bw_holidays", 12, kSLHolidayCountryGermany, @"Baden-Württemberg"},
+    {@"de_by", @"DE-BY", @"de_by_holidays", 12, kSLHolidayCountryGermany, @"Bavaria"},
+    {@"de_hb", @"DE-HB", @"de_hb_holidays", 10, kSLHolidayCountryGermany, @"Bremen"},
+    {@"de_he", @"DE-HE", @"de_he_holidays", 10, kSLHolidayCountryGermany, @"Hesse"},
+    {@"de_hh", @"DE-HH", @"de_hh_holidays", 10, kSLHolidayCountryGermany, @"Hamburg"},
+    {@"de_mv", @"DE-MV", @"de_mv_holidays", 11, kSLHolidayCountryGermany, @"Mecklenburg-Vorpommern"},
+    {@"de_ni", @"DE-NI", @"de_ni_holidays", 10, kSLHolidayCountryGermany, @"Lower Saxony"},
+    {@"de_nw", @"DE-NW", @"de_nw_holidays", 11, kSLHolidayCountryGermany, @"North Rhine-Westphalia"},
+    {@"de_rp", @"DE-RP", @"de_rp_holidays", 11, kSLHolidayCountryGermany, @"Rhineland-Palatinate"},
+    {@"de_sh", @"DE-SH", @"de_sh_holidays", 10, kSLHolidayCountryGermany, @"Schleswig-Holstein"},
+    {@"de_sl", @"DE-SL", @"de_sl_holidays", 12, kSLHolidayCountryGermany, @"Saarland"},
+    {@"de_sn", @"DE-SN", @"de_sn_holidays", 11, kSLHolidayCountryGermany, @"Saxony"},
+    {@"de_st", @"DE-ST", @"de_st_holidays", 11, kSLHolidayCountryGermany, @"Saxony-Anhalt"},
+    {@"de_th", @"DE-TH", @"de_th_holidays", 11, kSLHolidayCountryGermany, @"Thuringia"},
+    {@"ch_ag", @"CH-AG", @"ch_ag_holidays", 14, kSLHolidayCountrySwitzerland, @"Aargau"},
+    {@"ch_ai", @"CH-AI", @"ch_ai_holidays", 12, kSLHolidayCountrySwitzerland, @"Appenzell Innerrhoden"},
+    {@"ch_ar", @"CH-AR", @"ch_ar_holidays", 8, kSLHolidayCountrySwitzerland, @"Appenzell Ausserrhoden"},
+    {@"ch_be", @"CH-BE", @"ch_be_holidays", 9, kSLHolidayCountrySwitzerland, @"Bern"},
+    {@"ch_bl", @"CH-BL", @"ch_bl_holidays", 9, kSLHolidayCountrySwitzerland, @"Basel-Landschaft"},
+    {@"ch_bs", @"CH-BS", @"ch_bs_holidays", 9, kSLHolidayCountrySwitzerland, @"Basel-Stadt"},
+    {@"ch_fr", @"CH-FR", @"ch_fr_holidays", 5, kSLHolidayCountrySwitzerland, @"Fribourg"},
+    {@"ch_ge", @"CH-GE", @"ch_ge_holidays", 9, kSLHolidayCountrySwitzerland, @"Geneva"},
+    {@"ch_gl", @"CH-GL", @"ch_gl_holidays", 10, kSLHolidayCountrySwitzerland, @"Glarus"},
+    {@"ch_gr", @"CH-GR", @"ch_gr_holidays", 7, kSLHolidayCountrySwitzerland, @"Graubünden"},
+    {@"ch_ju", @"CH-JU", @"ch_ju_holidays", 13, kSLHolidayCountrySwitzerland, @"Jura"},
+    {@"ch_lu", @"CH-LU", @"ch_lu_holidays", 13, kSLHolidayCountrySwitzerland, @"Lucerne"},
+    {@"ch_ne", @"CH-NE", @"ch_ne_holidays", 10, kSLHolidayCountrySwitzerland, @"Neuchâtel"},
+    {@"ch_nw", @"CH-NW", @"ch_nw_holidays", 10, kSLHolidayCountrySwitzerland, @"Nidwalden"},
+    {@"ch_ow", @"CH-OW", @"ch_ow_holidays", 10, kSLHolidayCountrySwitzerland, @"Obwalden"},
+    {@"ch_sg", @"CH-SG", @"ch_sg_holidays", 9, kSLHolidayCountrySwitzerland, @"St. Gallen"},
+    {@"ch_sh", @"CH-SH", @"ch_sh_holidays", 9, kSLHolidayCountrySwitzerland, @"Schaffhausen"},
+    {@"ch_so", @"CH-SO", @"ch_so_holidays", 5, kSLHolidayCountrySwitzerland, @"Solothurn"},
+    {@"ch_sz", @"CH-SZ", @"ch_sz_holidays", 14, kSLHolidayCountrySwitzerland, @"Schwyz"},
+    {@"ch_tg", @"CH-TG", @"ch_tg_holidays", 10, kSLHolidayCountrySwitzerland, @"Thurgau"},
+    {@"ch_ti", @"CH-TI", @"ch_ti_holidays", 15, kSLHolidayCountrySwitzerland, @"Ticino"},
+    {@"ch_ur", @"CH-UR", @"ch_ur_holidays", 14, kSLHolidayCountrySwitzerland, @"Uri"},
+    {@"ch_vd", @"CH-VD", @"ch_vd_holidays", 9, kSLHolidayCountrySwitzerland, @"Vaud"},
+    {@"ch_vs", @"CH-VS", @"ch_vs_holidays", 9, kSLHolidayCountrySwitzerland, @"Valais"},
+    {@"ch_zg", @"CH-ZG", @"ch_zg_holidays", 9, kSLHolidayCountrySwitzerland, @"Zug"},
+    {@"ch_zh", @"CH-ZH", @"ch_zh_holidays", 9, kSLHolidayCountrySwitzerland, @"Zurich"},
+    {@"us_ak", @"US-AK", @"us_ak_holidays", 16, kSLHolidayCountryUnitedStates, @"Alaska"},
+    {@"us_al", @"US-AL", @"us_al_holidays", 16, kSLHolidayCountryUnitedStates, @"Alabama"},
+    {@"us_ar", @"US-AR", @"us_ar_holidays", 13, kSLHolidayCountryUnitedStates, @"Arkansas"},
+    {@"us_az", @"US-AZ", @"us_az_holidays", 14, kSLHolidayCountryUnitedStates, @"Arizona"},
+    {@"us_ca", @"US-CA", @"us_ca_holidays", 16, kSLHolidayCountryUnitedStates, @"California"},
+    {@"us_co", @"US-CO", @"us_co_holidays", 15, kSLHolidayCountryUnitedStates, @"Colorado"},
+    {@"us_ct", @"US-CT", @"us_ct_holidays", 16, kSLHolidayCountryUnitedStates, @"Connecticut"},
+    {@"us_dc", @"US-DC", @"us_dc_holidays", 16, kSLHolidayCountryUnitedStates, @"District of Columbia"},
+    {@"us_de", @"US-DE", @"us_de_holidays", 14, kSLHolidayCountryUnitedStates, @"Delaware"},
+    {@"us_fl", @"US-FL", @"us_fl_holidays", 14, kSLHolidayCountryUnitedStates, @"Florida"},
+    {@"us_ga", @"US-GA", @"us_ga_holidays", 15, kSLHolidayCountryUnitedStates, @"Georgia"},
+    {@"us_hi", @"US-HI", @"us_hi_holidays", 17, kSLHolidayCountryUnitedStates, @"Hawaii"},
+    {@"us_ia", @"US-IA", @"us_ia_holidays", 14, kSLHolidayCountryUnitedStates, @"Iowa"},
+    {@"us_id", @"US-ID", @"us_id_holidays", 14, kSLHolidayCountryUnitedStates, @"Idaho"},
+    {@"us_il", @"US-IL", @"us_il_holidays", 17, kSLHolidayCountryUnitedStates, @"Illinois"},
+    {@"us_in", @"US-IN", @"us_in_holidays", 18, kSLHolidayCountryUnitedStates, @"Indiana"},
+    {@"us_ks", @"US-KS", @"us_ks_holidays", 13, kSLHolidayCountryUnitedStates, @"Kansas"},
+    {@"us_ky", @"US-KY", @"us_ky_holidays", 14, kSLHolidayCountryUnitedStates, @"Kentucky"},
+    {@"us_la", @"US-LA", @"us_la_holidays", 16, kSLHolidayCountryUnitedStates, @"Louisiana"},
+    {@"us_ma", @"US-MA", @"us_ma_holidays", 15, kSLHolidayCountryUnitedStates, @"Massachusetts"},
+    {@"us_md", @"US-MD", @"us_md_holidays", 16, kSLHolidayCountryUnitedStates, @"Maryland"},
+    {@"us_me", @"US-ME", @"us_me_holidays", 15, kSLHolidayCountryUnitedStates, @"Maine"},
+    {@"us_mi", @"US-MI", @"us_mi_holidays", 14, kSLHolidayCountryUnitedStates, @"Michigan"},
+    {@"us_mn", @"US-MN", @"us_mn_holidays", 13, kSLHolidayCountryUnitedStates, @"Minnesota"},
+    {@"us_mo", @"US-MO", @"us_mo_holidays", 15, kSLHolidayCountryUnitedStates, @"Missouri"},
+    {@"us_ms", @"US-MS", @"us_ms_holidays", 14, kSLHolidayCountryUnitedStates, @"Mississippi"},
+    {@"us_mt", @"US-MT", @"us_mt_holidays", 15, kSLHolidayCountryUnitedStates, @"Montana"},
+    {@"us_nc", @"US-NC", @"us_nc_holidays", 15, kSLHolidayCountryUnitedStates, @"North Carolina"},
+    {@"us_nd", @"US-ND", @"us_nd_holidays", 13, kSLHolidayCountryUnitedStates, @"North Dakota"},
+    {@"us_ne", @"US-NE", @"us_ne_holidays", 15, kSLHolidayCountryUnitedStates, @"Nebraska"},
+    {@"us_nh", @"US-NH", @"us_nh_holidays", 14, kSLHolidayCountryUnitedStates, @"New Hampshire"},
+    {@"us_nj", @"US-NJ", @"us_nj_holidays", 17, kSLHolidayCountryUnitedStates, @"New Jersey"},
+    {@"us_nm", @"US-NM", @"us_nm_holidays", 14, kSLHolidayCountryUnitedStates, @"New Mexico"},
+    {@"us_nv", @"US-NV", @"us_nv_holidays", 15, kSLHolidayCountryUnitedStates, @"Nevada"},
+    {@"us_ny", @"US-NY", @"us_ny_holidays", 17, kSLHolidayCountryUnitedStates, @"New York"},
+    {@"us_oh", @"US-OH", @"us_oh_holidays", 14, kSLHolidayCountryUnitedStates, @"Ohio"},
+    {@"us_ok", @"US-OK", @"us_ok_holidays", 13, kSLHolidayCountryUnitedStates, @"Oklahoma"},
+    {@"us_or", @"US-OR", @"us_or_holidays", 13, kSLHolidayCountryUnitedStates, @"Oregon"},
+    {@"us_pa", @"US-PA", @"us_pa_holidays", 14, kSLHolidayCountryUnitedStates, @"Pennsylvania"},
+    {@"us_ri", @"US-RI", @"us_ri_holidays", 15, kSLHolidayCountryUnitedStates, @"Rhode Island"},
+    {@"us_sc", @"US-SC", @"us_sc_holidays", 14, kSLHolidayCountryUnitedStates, @"South Carolina"},
+    {@"us_sd", @"US-SD", @"us_sd_holidays", 14, kSLHolidayCountryUnitedStates, @"South Dakota"},
+    {@"us_tn", @"US-TN", @"us_tn_holidays", 14, kSLHolidayCountryUnitedStates, @"Tennessee"},
+    {@"us_tx", @"US-TX", @"us_tx_holidays", 22, kSLHolidayCountryUnitedStates, @"Texas"},
+    {@"us_ut", @"US-UT", @"us_ut_holidays", 15, kSLHolidayCountryUnitedStates, @"Utah"},
+    {@"us_va", @"US-VA", @"us_va_holidays", 15, kSLHolidayCountryUnitedStates, @"Virginia"},
+    {@"us_vt", @"US-VT", @"us_vt_holidays", 15, kSLHolidayCountryUnitedStates, @"Vermont"},
+    {@"us_wa", @"US-WA", @"us_wa_holidays", 14, kSLHolidayCountryUnitedStates, @"Washington"},
+    {@"us_wi", @"US-WI", @"us_wi_holidays", 14, kSLHolidayCountryUnitedStates, @"Wisconsin"},
+    {@"us_wv", @"US-WV", @"us_wv_holidays", 16, kSLHolidayCountryUnitedStates, @"West Virginia"},
+    {@"us_wy", @"US-WY", @"us_wy_holidays", 13, kSLHolidayCountryUnitedStates, @"Wyoming"},
+};
+
+// the lowercase resource codes and ISO codes for each holiday country and subdivision, sorted by code
+static const SLHolidayCountryCodeEntry kSLHolidayCountryCodes[] = {
+    {@"ar", kSLHolidayCountryArgentina},
+    {@"at", kSLHolidayCountryAustria},
+    {@"au", kSLHolidayCountryAustralia},
+    {@"au-act", kSLHolidayCountryAustraliaACT},
+    {@"au-nsw", kSLHolidayCountryAustraliaNSW},
+    {@"au-nt", kSLHolidayCountryAustraliaNT},
+    {@"au-qld", kSLHolidayCountryAustraliaQLD},
+    {@"au-sa", kSLHolidayCountryAustraliaSA},
+    {@"au-tas", kSLHolidayCountryAustraliaTAS},
+    {@"au-vic", kSLHolidayCountryAustraliaVIC},
+    {@"au-wa", kSLHolidayCountryAustraliaWA},
+    {@"au_act", kSLHolidayCountryAustraliaACT},
+    {@"au_nsw", kSLHolidayCountryAustraliaNSW},
+    {@"au_nt", kSLHolidayCountryAustraliaNT},
+    {@"au_qld", kSLHolidayCountryAustraliaQLD},
+    {@"au_sa", kSLHolidayCountryAustraliaSA},
+    {@"au_tas", kSLHolidayCountryAustraliaTAS},
+    {@"au_vic", kSLHolidayCountryAustraliaVIC},
+    {@"au_wa", kSLHolidayCountryAustraliaWA},
+    {@"aw", kSLHolidayCountryAruba},
+    {@"be", kSLHolidayCountryBelgium},
+    {@"bg", kSLHolidayCountryBulgaria},
+    {@"br", kSLHolidayCountryBrazil},
+    {@"by", kSLHolidayCountryBelarus},
+    {@"ca", kSLHolidayCountryCanada},
+    {@"ch", kSLHolidayCountrySwitzerland},
+    {@"ch-ag", kSLHolidayCountrySwitzerlandAG},
+    {@"ch-ai", kSLHolidayCountrySwitzerlandAI},
+    {@"ch-ar", kSLHolidayCountrySwitzerlandAR},
+    {@"ch-be", kSLHolidayCountrySwitzerlandBE},
+    {@"ch-bl", kSLHolidayCountrySwitzerlandBL},
+    {@"ch-bs", kSLHolidayCountrySwitzerlandBS},
+    {@"ch-fr", kSLHolidayCountrySwitzerlandFR},
+    {@"ch-ge", kSLHolidayCountrySwitzerlandGE},
+    {@"ch-gl", kSLHolidayCountrySwitzerlandGL},
+    {@"ch-gr", kSLHolidayCountrySwitzerlandGR},
+    {@"ch-ju", kSLHolidayCountrySwitzerlandJU},
+    {@"ch-lu", kSLHolidayCountrySwitzerlandLU},
+    {@"ch-ne", kSLHolidayCountrySwitzerlandNE},
+    {@"ch-nw", kSLHolidayCountrySwitzerlandNW},
+    {@"ch-ow", kSLHolidayCountrySwitzerlandOW},
+    {@"ch-sg", kSLHolidayCountrySwitzerlandSG},
+    {@"ch-sh", kSLHolidayCountrySwitzerlandSH},
+    {@"ch-so", kSLHolidayCountrySwitzerlandSO},
+    {@"ch-sz", kSLHolidayCountrySwitzerlandSZ},
+    {@"ch-tg", kSLHolidayCountrySwitzerlandTG},
+    {@"ch-ti", kSLHolidayCountrySwitzerlandTI},
+    {@"ch-ur", kSLHolidayCountrySwitzerlandUR},
+    {@"ch-vd", kSLHolidayCountrySwitzerlandVD},
+    {@"ch-vs", kSLHolidayCountrySwitzerlandVS},
+    {@"ch-zg", kSLHolidayCountrySwitzerlandZG},
+    {@"ch-zh", kSLHolidayCountrySwitzerlandZH},
+    {@"ch_ag", kSLHolidayCountrySwitzerlandAG},
+    {@"ch_ai", kSLHolidayCountrySwitzerlandAI},
+    {@"ch_ar", kSLHolidayCountrySwitzerlandAR},
+    {@"ch_be", kSLHolidayCountrySwitzerlandBE},
+    {@"ch_bl", kSLHolidayCountrySwitzerlandBL},
+    {@"ch_bs", kSLHolidayCountrySwitzerlandBS},
+    {@"ch_fr", kSLHolidayCountrySwitzerlandFR},
+    {@"ch_ge", kSLHolidayCountrySwitzerlandGE},
+    {@"ch_gl", kSLHolidayCountrySwitzerlandGL},
+    {@"ch_gr", kSLHolidayCountrySwitzerlandGR},
+    {@"ch_ju", kSLHolidayCountrySwitzerlandJU},
+    {@"ch_lu", kSLHolidayCountrySwitzerlandLU},
+    {@"ch_ne", kSLHolidayCountrySwitzerlandNE},
+    {@"ch_nw", kSLHolidayCountrySwitzerlandNW},
+    {@"ch_ow", kSLHolidayCountrySwitzerlandOW},
+    {@"ch_sg", kSLHolidayCountrySwitzerlandSG},
+    {@"ch_sh", kSLHolidayCountrySwitzerlandSH},
+    {@"ch_so", kSLHolidayCountrySwitzerlandSO},
+    {@"ch_sz", kSLHolidayCountrySwitzerlandSZ},
+    {@"ch_tg", kSLHolidayCountrySwitzerlandTG},
+    {@"ch_ti", kSLHolidayCountrySwitzerlandTI},
+    {@"ch_ur", kSLHolidayCountrySwitzerlandUR},
+    {@"ch_vd", kSLHolidayCountrySwitzerlandVD},
+    {@"ch_vs", kSLHolidayCountrySwitzerlandVS},
+    {@"ch_zg", kSLHolidayCountrySwitzerlandZG},
+    {@"ch_zh", kSLHolidayCountrySwitzerlandZH},
+    {@"cn", kSLHolidayCountryChina},
+    {@"co", kSLHolidayCountryColombia},
+    {@"cz", kSLHolidayCountryCzechia},
+    {@"de", kSLHolidayCountryGermany},
+    {@"de-bb", kSLHolidayCountryGermanyBB},
+    {@"de-be", kSLHolidayCountryGermanyBE},
+    {@"de-bw", kSLHolidayCountryGermanyBW},
+    {@"de-by", kSLHolidayCountryGermanyBY},
+    {@"de-hb", kSLHolidayCountryGermanyHB},
+    {@"de-he", kSLHolidayCountryGermanyHE},
+    {@"de-hh", kSLHolidayCountryGermanyHH},
+    {@"de-mv", kSLHolidayCountryGermanyMV},
+    {@"de-ni", kSLHolidayCountryGermanyNI},
+    {@"de-nw", kSLHolidayCountryGermanyNW},
+    {@"de-rp", kSLHolidayCountryGermanyRP},
+    {@"de-sh", kSLHolidayCountryGermanySH},
+    {@"de-sl", kSLHolidayCountryGermanySL},
+    {@"de-sn", kSLHolidayCountryGermanySN},
+    {@"de-st", kSLHolidayCountryGermanyST},
+    {@"de-th", kSLHolidayCountryGermanyTH},
+    {@"de_bb", kSLHolidayCountryGermanyBB},
+    {@"de_be", kSLHolidayCountryGermanyBE},
+    {@"de_bw", kSLHolidayCountryGermanyBW},
+    {@"de_by", kSLHolidayCountryGermanyBY},
+    {@"de_hb", kSLHolidayCountryGermanyHB},
+    {@"de_he", kSLHolidayCountryGermanyHE},
+    {@"de_hh", kSLHolidayCountryGermanyHH},
+    {@"de_mv", kSLHolidayCountryGermanyMV},
+    {@"de_ni", kSLHolidayCountryGermanyNI},
+    {@"de_nw", kSLHolidayCountryGermanyNW},
+    {@"de_rp", kSLHolidayCountryGermanyRP},
+    {@"de_sh", kSLHolidayCountryGermanySH},
+    {@"de_sl", kSLHolidayCountryGermanySL},
+    {@"de_sn", kSLHolidayCountryGermanySN},
+    {@"de_st", kSLHolidayCountryGermanyST},
+    {@"de_th", kSLHolidayCountryGermanyTH},
+    {@"dk", kSLHolidayCountryDenmark},
+    {@"do", kSLHolidayCountryDominicanRepublic},
+    {@"ee", kSLHolidayCountryEstonia},
+    {@"eg", kSLHolidayCountryEgypt},
+    {@"es", kSLHolidayCountrySpain},
+    {@"fi", kSLHolidayCountryFinland},
+    {@"fr", kSLHolidayCountryFrance},
+    {@"fra", kSLHolidayCountryFrance},
+    {@"gb", kSLHolidayCountryUnitedKingdom},
+    {@"hk", kSLHolidayCountryHongKong},
+    {@"hr", kSLHolidayCountryCroatia},
+    {@"hu", kSLHolidayCountryHungary},
+    {@"ie", kSLHolidayCountryIreland},
+    {@"il", kSLHolidayCountryIsrael},
+    {@"in", kSLHolidayCountryIndia},
+    {@"ind", kSLHolidayCountryIndia},
+    {@"is", kSLHolidayCountryIceland},
+    {@"it", kSLHolidayCountryItaly},
+    {@"jp", kSLHolidayCountryJapan},
+    {@"ke", kSLHolidayCountryKenya},
+    {@"kr", kSLHolidayCountryKorea},
+    {@"lt", kSLHolidayCountryLithuania},
+    {@"lu", kSLHolidayCountryLuxembourg},
+    {@"ma", kSLHolidayCountryMorocco},
+    {@"mx", kSLHolidayCountryMexico},
+    {@"ng", kSLHolidayCountryNigeria},
+    {@"ni", kSLHolidayCountryNicaragua},
+    {@"nl", kSLHolidayCountryNetherlands},
+    {@"no", kSLHolidayCountryNorway},
+    {@"nz", kSLHolidayCountryNewZealand},
+    {@"pe", kSLHolidayCountryPeru},
+    {@"pl", kSLHolidayCountryPoland},
+    {@"pt", kSLHolidayCountryPortugal},
+    {@"py", kSLHolidayCountryParaguay},
+    {@"rs", kSLHolidayCountrySerbia},
+    {@"ru", kSLHolidayCountryRussia},
+    {@"se", kSLHolidayCountrySweden},
+    {@"sg", kSLHolidayCountrySingapore},
+    {@"si", kSLHolidayCountrySlovenia},
+    {@"sk", kSLHolidayCountrySlovakia},
+    {@"tr", kSLHolidayCountryTurkey},
+    {@"tw", kSLHolidayCountryTaiwan},
+    {@"ua", kSLHolidayCountryUkraine},
+    {@"uk", kSLHolidayCountryUnitedKingdom},
+    {@"us", kSLHolidayCountryUnitedStates},
+    {@"us-ak", kSLHolidayCountryUnitedStatesAK},
+    {@"us-al", kSLHolidayCountryUnitedStatesAL},
+    {@"us-ar", kSLHolidayCountryUnitedStatesAR},
+    {@"us-az", kSLHolidayCountryUnitedStatesAZ},
+    {@"us-ca", kSLHolidayCountryUnitedStatesCA},
+    {@"us-co", kSLHolidayCountryUnitedStatesCO},
+    {@"us-ct", kSLHolidayCountryUnitedStatesCT},
+    {@"us-dc", kSLHolidayCountryUnitedStatesDC},
+    {@"us-de", kSLHolidayCountryUnitedStatesDE},
+    {@"us-fl", kSLHolidayCountryUnitedStatesFL},
+    {@"us-ga", kSLHolidayCountryUnitedStatesGA},
+    {@"us-hi", kSLHolidayCountryUnitedStatesHI},
+    {@"us-ia", kSLHolidayCountryUnitedStatesIA},
+    {@"us-id", kSLHolidayCountryUnitedStatesID},
+    {@"us-il", kSLHolidayCountryUnitedStatesIL},
+    {@"us-in", kSLHolidayCountryUnitedStatesIN},
+    {@"us-ks", kSLHolidayCountryUnitedStatesKS},
+    {@"us-ky", kSLHolidayCountryUnitedStatesKY},
+    {@"us-la", kSLHolidayCountryUnitedStatesLA},
+    {@"us-ma", kSLHolidayCountryUnitedStatesMA},
+    {@"us-md", kSLHolidayCountryUnitedStatesMD},
+    {@"us-me", kSLHolidayCountryUnitedStatesME},
+    {@"us-mi", kSLHolidayCountryUnitedStatesMI},
+    {@"us-mn", kSLHolidayCountryUnitedStatesMN},
+    {@"us-mo", kSLHolidayCountryUnitedStatesMO},
+    {@"us-ms", kSLHolidayCountryUnitedStatesMS},
+    {@"us-mt", kSLHolidayCountryUnitedStatesMT},
+    {@"us-nc", kSLHolidayCountryUnitedStatesNC},
+    {@"us-nd", kSLHolidayCountryUnitedStatesND},
+    {@"us-ne", kSLHolidayCountryUnitedStatesNE},
+    {@"us-nh", kSLHolidayCountryUnitedStatesNH},
+    {@"us-nj", kSLHolidayCountryUnitedStatesNJ},
+    {@"us-nm", kSLHolidayCountryUnitedStatesNM},
+    {@"us-nv", kSLHolidayCountryUnitedStatesNV},
+    {@"us-ny", kSLHolidayCountryUnitedStatesNY},
+    {@"us-oh", kSLHolidayCountryUnitedStatesOH},
+    {@"us-ok", kSLHolidayCountryUnitedStatesOK},
+    {@"us-or", kSLHolidayCountryUnitedStatesOR},
+    {@"us-pa", kSLHolidayCountryUnitedStatesPA},
+    {@"us-ri", kSLHolidayCountryUnitedStatesRI},
+    {@"us-sc", kSLHolidayCountryUnitedStatesSC},
+    {@"us-sd", kSLHolidayCountryUnitedStatesSD},
+    {@"us-tn", kSLHolidayCountryUnitedStatesTN},
+    {@"us-tx", kSLHolidayCountryUnitedStatesTX},
+    {@"us-ut", kSLHolidayCountryUnitedStatesUT},
+    {@"us-va", kSLHolidayCountryUnitedStatesVA},
+    {@"us-vt", kSLHolidayCountryUnitedStatesVT},
+    {@"us-wa", kSLHolidayCountryUnitedStatesWA},
+    {@"us-wi", kSLHolidayCountryUnitedStatesWI},
+    {@"us-wv", kSLHolidayCountryUnitedStatesWV},
+    {@"us-wy", kSLHolidayCountryUnitedStatesWY},
+    {@"us_ak", kSLHolidayCountryUnitedStatesAK},
+    {@"us_al", kSLHolidayCountryUnitedStatesAL},
+    {@"us_ar", kSLHolidayCountryUnitedStatesAR},
+    {@"us_az", kSLHolidayCountryUnitedStatesAZ},
+    {@"us_ca", kSLHolidayCountryUnitedStatesCA},
+    {@"us_co", kSLHolidayCountryUnitedStatesCO},
+    {@"us_ct", kSLHolidayCountryUnitedStatesCT},
+    {@"us_dc", kSLHolidayCountryUnitedStatesDC},
+    {@"us_de", kSLHolidayCountryUnitedStatesDE},
+    {@"us_fl", kSLHolidayCountryUnitedStatesFL},
+    {@"us_ga", kSLHolidayCountryUnitedStatesGA},
+    {@"us_hi", kSLHolidayCountryUnitedStatesHI},
+    {@"us_ia", kSLHolidayCountryUnitedStatesIA},
+    {@"us_id", kSLHolidayCountryUnitedStatesID},
+    {@"us_il", kSLHolidayCountryUnitedStatesIL},
+    {@"us_in", kSLHolidayCountryUnitedStatesIN},
+    {@"us_ks", kSLHolidayCountryUnitedStatesKS},
+    {@"us_ky", kSLHolidayCountryUnitedStatesKY},
+    {@"us_la", kSLHolidayCountryUnitedStatesLA},
+    {@"us_ma", kSLHolidayCountryUnitedStatesMA},
+    {@"us_md", kSLHolidayCountryUnitedStatesMD},
+    {@"us_me", kSLHolidayCountryUnitedStatesME},
+    {@"us_mi", kSLHolidayCountryUnitedStatesMI},
+    {@"us_mn", kSLHolidayCountryUnitedStatesMN},
+    {@"us_mo", kSLHolidayCountryUnitedStatesMO},
+    {@"us_ms", kSLHolidayCountryUnitedStatesMS},
+    {@"us_mt", kSLHolidayCountryUnitedStatesMT},
+    {@"us_nc", kSLHolidayCountryUnitedStatesNC},
+    {@"us_nd", kSLHolidayCountryUnitedStatesND},
+    {@"us_ne", kSLHolidayCountryUnitedStatesNE},
+    {@"us_nh", kSLHolidayCountryUnitedStatesNH},
+    {@"us_nj", kSLHolidayCountryUnitedStatesNJ},
+    {@"us_nm", kSLHolidayCountryUnitedStatesNM},
+    {@"us_nv", kSLHolidayCountryUnitedStatesNV},
+    {@"us_ny", kSLHolidayCountryUnitedStatesNY},
+    {@"us_oh", kSLHolidayCountryUnitedStatesOH},
+    {@"us_ok", kSLHolidayCountryUnitedStatesOK},
+    {@"us_or", kSLHolidayCountryUnitedStatesOR},
+    {@"us_pa", kSLHolidayCountryUnitedStatesPA},
+    {@"us_ri", kSLHolidayCountryUnitedStatesRI},
+    {@"us_sc", kSLHolidayCountryUnitedStatesSC},
+    {@"us_sd", kSLHolidayCountryUnitedStatesSD},
+    {@"us_tn", kSLHolidayCountryUnitedStatesTN},
+    {@"us_tx", kSLHolidayCountryUnitedStatesTX},
+    {@"us_ut", kSLHolidayCountryUnitedStatesUT},
+    {@"us_va", kSLHolidayCountryUnitedStatesVA},
+    {@"us_vt", kSLHolidayCountryUnitedStatesVT},
+    {@"us_wa", kSLHolidayCountryUnitedStatesWA},
+    {@"us_wi", kSLHolidayCountryUnitedStatesWI},
+    {@"us_wv", kSLHolidayCountryUnitedStatesWV},
+    {@"us_wy", kSLHolidayCountryUnitedStatesWY},
+    {@"vn", kSLHolidayCountryVietnam},
+    {@"za", kSLHolidayCountrySouthAfrica},
+};
+
+// Returns the holiday country or subdivision for the given resource code or ISO code (case insensitive), or kSLHolidayCountryNumRegions
+// if no holiday country exists for the code.
+SLHolidayCountry SLHolidayCountryForCountryCode(NSString *countryCode)
+{
+    if (countryCode.length > 0) {
+        // binary search the sorted codes, which avoids creating a lowercase copy of the given code
+        size_t low = 0;
+        size_t high = sizeof(kSLHolidayCountryCodes) / sizeof(kSLHolidayCountryCodes[0]);
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            NSComparisonResult result = [kSLHolidayCountryCodes[mid].code caseInsensitiveCompare:countryCode];
+            if (result == NSOrderedSame) {
+                return kSLHolidayCountryCodes[mid].holidayCountry;
+            } else if (result == NSOrderedAscending) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+    }
+    return kSLHolidayCountryNumRegions;
+}
@@ -0,0 +1,72 @@
+//
+//  SLHolidayManager.h
+//  A singleton object that evaluates the compiled holiday rules for each of the holiday countries.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "SLAlarmPrefs.h"
+#import "SLHolidayRules.h"
+
+// the keys that are used in the compiled holiday resources (in addition to the name and dates keys)
+static NSString *const kSLHolidayVersionKey =           @"version";
+static NSString *const kSLHolidayAliasesKey =           @"aliases";
+static NSString *const kSLHolidayIdKey =                @"id";
+static NSString *const kSLHolidayTypeKey =              @"type";
+static NSString *const kSLHolidayMonthKey =             @"month";
+static NSString *const kSLHolidayDayKey =               @"day";
+static NSString *const kSLHolidayWeekdayKey =           @"weekday";
+static NSString *const kSLHolidayOrdinalKey =           @"ordinal";
+static NSString *const kSLHolidayOffsetKey =            @"offset";
+static NSString *const kSLHolidayObservedKey =          @"observed";
+static NSString *const kSLHolidayAddedKey =             @"added";
+static NSString *const kSLHolidayRemovedKey =           @"removed";
+static NSString *const kSLHolidayParentKey =            @"parent";
+static NSString *const kSLHolidayExcludedKey =          @"excluded";
+
+// the key that marks a holiday of a subdivision that is observed from its country (the ID of the holiday belongs to the country)
+static NSString *const kSLHolidayInheritedKey =         @"inherited";
+
+// block that is invoked for each holiday when enumerating the holiday index (set stop to YES to finish the enumeration)
+typedef void (^SLHolidayIndexEnumerationBlock)(SLHolidayCountry holidayCountry, NSString *resourceName, NSString *holidayName, SLHolidayId holidayId,
+                                               SLDay day, BOOL *stop);
+
+// manager that loads the compiled holiday rules and caches the dates that each holiday occurs for a given year
+@interface SLHolidayManager : NSObject
+
+// return a singleton instance of this manager
++ (instancetype)sharedInstance;
+
+// returns the day number that corresponds to the given date in the current calendar
++ (SLDay)dayForDate:(NSDate *)date;
+
+// returns the date at the start of the given day number in the current calendar
++ (NSDate *)dateForDay:(SLDay)day;
+
+// Returns a dictionary in the same form as the legacy holiday resources where each holiday contains the upcoming dates for the
+// holiday starting from today, along with the ID of the holiday.  The holidays of a subdivision start with the holidays that it observes
+// from its country, which are marked with the inherited key.
+- (NSDictionary *)holidayResourceForResourceName:(NSString *)resourceName;
+
+// Returns the holiday selection for the given holiday names (which were saved before holidays were selected by ID).  Any names that a
+// holiday was previously generated with are matched using the aliases in the holiday resource, while unknown names are ignored.
+- (SLHolidaySelection)holidaySelectionForHolidayNames:(NSArray *)holidayNames inResourceName:(NSString *)resourceName;
+
+// Returns the first date that any of the holidays in the given selection occur on or after the given date (along with the name of that
+// holiday), or nil if none of the holidays occur again.
+- (NSDate *)firstDateForHolidaySelection:(SLHolidaySelection)holidaySelection inResourceName:(NSString *)resourceName
+                           onOrAfterDate:(NSDate *)date holidayName:(NSString **)holidayName;
+
+// Enumerates the holidays of each holiday country that has any holidays in the given selections (an array indexed by the holiday country)
+// in order of date, starting with the holidays that occur on the given day.  Each holiday country has its own slice of the holiday index,
+// which is built the first time that the country is enumerated and covers the current year and the following years.  The holidays that a
+// subdivision observes from its country are only enumerated for the country.
+- (void)enumerateHolidaysFromDay:(SLDay)day holidaySelections:(const SLHolidaySelection *)holidaySelections
+                      usingBlock:(SLHolidayIndexEnumerationBlock)block;
+
+// builds the slices of the holiday index for each holiday country that has any holidays in the given selections ahead of time
+- (void)prebuildHolidayIndexForHolidaySelections:(const SLHolidaySelection *)holidaySelections;
+
+@end
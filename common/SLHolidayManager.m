@@ -0,0 +1,608 @@
+//
+//  SLHolidayManager.m
+//  A singleton object that evaluates the compiled holiday rules for each of the holiday countries.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import "SLHolidayManager.h"
+#import "SLPrefsManager.h"
+#import "SLClock.h"
+
+// the version of the holiday resources that contain compiled rules (the legacy resources only contain a list of dates)
+#define kSLHolidayRulesVersion          2
+
+// the number of years after the current year that will be included in the upcoming dates for a holiday resource
+#define kSLHolidayResourceYears         1
+
+// the maximum number of years to search when looking for the next occurrence of a holiday
+#define kSLHolidayMaxSearchYears        10
+
+// the number of years after the current year that will be included in the holiday index
+#define kSLHolidayIndexYears            2
+
+// a single entry in a slice of the holiday index, which maps a day to a holiday for a particular holiday country
+typedef struct SLHolidayIndexEntry {
+    SLDay day;
+    uint16_t holidayCountry;
+    uint16_t holidayIndex;
+} SLHolidayIndexEntry;
+
+// a single holiday that was loaded from a compiled holiday resource
+@interface SLCompiledHoliday : NSObject
+
+// the name of the holiday to be displayed
+@property (nonatomic, copy) NSString *name;
+
+// the stable ID of the holiday, which is used when saving the holiday selections
+@property (nonatomic) SLHolidayId holidayId;
+
+// the rule that describes when the holiday occurs
+@property (nonatomic) SLHolidayRule rule;
+
+// the sorted day numbers that are explicitly included for this holiday (either a table of dates or exceptions to the rule)
+@property (nonatomic, strong) NSArray *addedDays;
+
+// the day numbers that are generated by the rule but should not be included for this holiday
+@property (nonatomic, strong) NSSet *removedDays;
+
+@end
+
+@implementation SLCompiledHoliday
+
+@end
+
+@interface SLHolidayManager ()
+
+// the compiled holidays that have been loaded, keyed by the resource name
+@property (nonatomic, strong) NSMutableDictionary *compiledHolidays;
+
+// the previous names of the holidays mapped to their IDs (from the aliases of each holiday resource), keyed by the resource name
+@property (nonatomic, strong) NSMutableDictionary *holidayAliases;
+
+// the resource name of the country for each subdivision resource, keyed by the resource name of the subdivision
+@property (nonatomic, strong) NSMutableDictionary *parentResourceNames;
+
+// the IDs of the holidays of the country that are not observed in each subdivision, keyed by the resource name of the subdivision
+@property (nonatomic, strong) NSMutableDictionary *excludedHolidayIds;
+
+// The dates that each holiday occurs in a given year (aligned with the compiled holidays for the resource), keyed by the resource name
+// and then by the year (which is a tagged pointer number, so a lookup does not allocate).  Only the years that the holiday index covers
+// are kept.
+@property (nonatomic, strong) NSMutableDictionary *yearlyOccurrences;
+
+// the sorted entries of the holiday index for each holiday country that has been enumerated, keyed by the holiday country
+@property (nonatomic, strong) NSMutableDictionary *indexSlices;
+
+// the first year that the slices of the holiday index cover
+@property (nonatomic) int32_t indexFirstYear;
+
+@end
+
+// compares two entries of the holiday index by day, then holiday country, then holiday index
+static int SLCompareHolidayIndexEntries(const void *a, const void *b)
+{
+    const SLHolidayIndexEntry *entryA = a;
+    const SLHolidayIndexEntry *entryB = b;
+    if (entryA->day != entryB->day) {
+        return entryA->day < entryB->day ? -1 : 1;
+    } else if (entryA->holidayCountry != entryB->holidayCountry) {
+        return entryA->holidayCountry < entryB->holidayCountry ? -1 : 1;
+    }
+    return (int)entryA->holidayIndex - (int)entryB->holidayIndex;
+}
+
+// returns the position of the first of the given sorted index entries that occurs on or after the given day
+static size_t SLFirstHolidayIndexEntryOnOrAfterDay(const SLHolidayIndexEntry *entries, size_t numEntries, SLDay day)
+{
+    size_t low = 0;
+    size_t high = numEntries;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (entries[mid].day < day) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// returns the day number for a date string from a holiday resource (yyyy-MM-dd)
+static BOOL SLDayFromDateString(NSString *dateString, SLDay *day)
+{
+    int year, month, dayOfMonth;
+    if (dateString != nil && sscanf([dateString UTF8String], "%d-%d-%d", &year, &month, &dayOfMonth) == 3) {
+        *day = SLDayFromCivil(year, month, dayOfMonth);
+        return YES;
+    }
+    return NO;
+}
+
+// returns the date string for a holiday resource (yyyy-MM-dd) from a day number
+static NSString *SLDateStringFromDay(SLDay day)
+{
+    int32_t year, month, dayOfMonth;
+    SLCivilFromDay(day, &year, &month, &dayOfMonth);
+    return [NSString stringWithFormat:@"%04d-%02d-%02d", year, month, dayOfMonth];
+}
+
+// converts an array of date strings from a holiday resource to a sorted array of day numbers
+static NSArray *SLDaysFromDateStrings(NSArray *dateStrings)
+{
+    NSMutableArray *days = [[NSMutableArray alloc] initWithCapacity:dateStrings.count];
+    for (NSString *dateString in dateStrings) {
+        SLDay day;
+        if ([dateString isKindOfClass:[NSString class]] && SLDayFromDateString(dateString, &day)) {
+            [days addObject:[NSNumber numberWithInt:day]];
+        }
+    }
+    return [days sortedArrayUsingSelector:@selector(compare:)];
+}
+
+@implementation SLHolidayManager
+
+// return a singleton instance of this manager
++ (instancetype)sharedInstance
+{
+    static dispatch_once_t pred;
+    static id sharedInstance = nil;
+    dispatch_once(&pred, ^{
+        sharedInstance = [[[self class] alloc] init];
+    });
+    return sharedInstance;
+}
+
+// override the default initializer to create the caches
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.compiledHolidays = [[NSMutableDictionary alloc] init];
+        self.holidayAliases = [[NSMutableDictionary alloc] init];
+        self.parentResourceNames = [[NSMutableDictionary alloc] init];
+        self.excludedHolidayIds = [[NSMutableDictionary alloc] init];
+        self.yearlyOccurrences = [[NSMutableDictionary alloc] init];
+        self.indexSlices = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+// returns the day number that corresponds to the given date in the current calendar
++ (SLDay)dayForDate:(NSDate *)date
+{
+    NSDateComponents *components = [[SLClock calendar] components:NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay
+                                                         fromDate:date];
+    return SLDayFromCivil((int32_t)components.year, (int32_t)components.month, (int32_t)components.day);
+}
+
+// returns the date at the start of the given day number in the current calendar
++ (NSDate *)dateForDay:(SLDay)day
+{
+    int32_t year, month, dayOfMonth;
+    SLCivilFromDay(day, &year, &month, &dayOfMonth);
+    NSDateComponents *components = [[NSDateComponents alloc] init];
+    components.year = year;
+    components.month = month;
+    components.day = dayOfMonth;
+    return [[SLClock calendar] dateFromComponents:components];
+}
+
+// returns the rule type that corresponds to the type string in a compiled holiday resource
++ (SLHolidayRuleType)ruleTypeForTypeString:(NSString *)typeString
+{
+    static NSDictionary *sSLHolidayRuleTypes = nil;
+    static dispatch_once_t pred;
+    dispatch_once(&pred, ^{
+        sSLHolidayRuleTypes = @{@"dates":[NSNumber numberWithInt:kSLHolidayRuleTypeDates],
+                                @"fixed":[NSNumber numberWithInt:kSLHolidayRuleTypeFixed],
+                                @"nthWeekday":[NSNumber numberWithInt:kSLHolidayRuleTypeNthWeekday],
+                                @"weekdayOnOrAfter":[NSNumber numberWithInt:kSLHolidayRuleTypeWeekdayOnOrAfter],
+                                @"weekdayOnOrBefore":[NSNumber numberWithInt:kSLHolidayRuleTypeWeekdayOnOrBefore],
+                                @"easter":[NSNumber numberWithInt:kSLHolidayRuleTypeEaster],
+                                @"orthodoxEaster":[NSNumber numberWithInt:kSLHolidayRuleTypeOrthodoxEaster]};
+    });
+    NSNumber *ruleType = [sSLHolidayRuleTypes objectForKey:typeString];
+    return ruleType != nil ? (SLHolidayRuleType)[ruleType intValue] : kSLHolidayRuleTypeDates;
+}
+
+// Returns the compiled holidays for the given resource name, loading them from the bundle if needed.  Legacy resources that only
+// contain a list of dates for each holiday are loaded as a table of dates, and any holidays without an ID use their index as the ID.
+// A subdivision resource only contains the holidays that differ from its country (which have their own IDs), so only those holidays are
+// compiled for the subdivision, while the holidays that it observes from its country stay with the country.  This must be called while
+// synchronized.
+- (NSArray *)compiledHolidaysForResourceName:(NSString *)resourceName
+{
+    NSArray *compiledHolidays = [self.compiledHolidays objectForKey:resourceName];
+    if (compiledHolidays == nil) {
+        NSMutableArray *loadedHolidays = [[NSMutableArray alloc] init];
+        NSDictionary *aliases = nil;
+        NSString *resourcePath = [kSLSleeperBundle pathForResource:resourceName ofType:@"plist"];
+        if (resourcePath != nil) {
+            NSDictionary *holidayResource = [[NSDictionary alloc] initWithContentsOfFile:resourcePath];
+            BOOL hasRules = [[holidayResource objectForKey:kSLHolidayVersionKey] integerValue] >= kSLHolidayRulesVersion;
+            aliases = [holidayResource objectForKey:kSLHolidayAliasesKey];
+
+            // keep track of the country of a subdivision along with the holidays of the country that it does not observe
+            NSString *parentResourceName = [holidayResource objectForKey:kSLHolidayParentKey];
+            if ([parentResourceName isKindOfClass:[NSString class]] && ![parentResourceName isEqualToString:resourceName]) {
+                [self.parentResourceNames setObject:parentResourceName forKey:resourceName];
+                [self.excludedHolidayIds setObject:[NSSet setWithArray:[holidayResource objectForKey:kSLHolidayExcludedKey]] forKey:resourceName];
+            }
+            for (NSDictionary *holiday in [holidayResource objectForKey:kSLHolidayHolidaysKey]) {
+                SLCompiledHoliday *compiledHoliday = [[SLCompiledHoliday alloc] init];
+                compiledHoliday.name = [holiday objectForKey:kSLHolidayNameKey];
+                NSNumber *holidayId = [holiday objectForKey:kSLHolidayIdKey];
+                compiledHoliday.holidayId = (SLHolidayId)(holidayId != nil ? [holidayId unsignedIntegerValue] : loadedHolidays.count);
+
+                SLHolidayRule rule;
+                memset(&rule, 0, sizeof(rule));
+                if (hasRules) {
+                    rule.type = [SLHolidayManager ruleTypeForTypeString:[holiday objectForKey:kSLHolidayTypeKey]];
+                    rule.month = (int32_t)[[holiday objectForKey:kSLHolidayMonthKey] integerValue];
+                    rule.day = (int32_t)[[holiday objectForKey:kSLHolidayDayKey] integerValue];
+                    rule.weekday = (SLWeekday)[[holiday objectForKey:kSLHolidayWeekdayKey] integerValue];
+                    rule.ordinal = (int32_t)[[holiday objectForKey:kSLHolidayOrdinalKey] integerValue];
+                    rule.offset = (int32_t)[[holiday objectForKey:kSLHolidayOffsetKey] integerValue];
+                    NSString *observed = [holiday objectForKey:kSLHolidayObservedKey];
+                    if (observed != nil) {
+                        SLHolidayRuleParseObserved(&rule, [observed UTF8String]);
+                    }
+                }
+                compiledHoliday.rule = rule;
+
+                // a table of dates is stored with the dates key, while the exceptions to a rule are stored with the added key
+                NSArray *addedDateStrings = rule.type == kSLHolidayRuleTypeDates ? [holiday objectForKey:kSLHolidayDatesKey] : [holiday objectForKey:kSLHolidayAddedKey];
+                compiledHoliday.addedDays = SLDaysFromDateStrings(addedDateStrings);
+                compiledHoliday.removedDays = [NSSet setWithArray:SLDaysFromDateStrings([holiday objectForKey:kSLHolidayRemovedKey])];
+                [loadedHolidays addObject:compiledHoliday];
+            }
+        }
+        compiledHolidays = [loadedHolidays copy];
+        [self.compiledHolidays setObject:compiledHolidays forKey:resourceName];
+        [self.holidayAliases setObject:aliases != nil ? aliases : [[NSDictionary alloc] init] forKey:resourceName];
+    }
+    return compiledHolidays;
+}
+
+// returns whether or not the given year is covered by the holiday index (must be called while synchronized)
+- (BOOL)holidayIndexContainsYear:(int32_t)year
+{
+    return year >= self.indexFirstYear && year <= self.indexFirstYear + kSLHolidayIndexYears;
+}
+
+// Returns an array (aligned with the compiled holidays) containing the sorted day numbers for each holiday that occur in the given
+// year.  The rules are evaluated only once for each resource and year that the holiday index covers, while any other year is evaluated
+// every time it is requested.  This must be called while synchronized.
+- (NSArray *)occurrencesForResourceName:(NSString *)resourceName inYear:(int32_t)year
+{
+    BOOL isCached = [self holidayIndexContainsYear:year];
+    NSNumber *yearKey = [NSNumber numberWithInt:year];
+    NSMutableDictionary *resourceOccurrences = [self.yearlyOccurrences objectForKey:resourceName];
+    NSArray *occurrences = isCached ? [resourceOccurrences objectForKey:yearKey] : nil;
+    if (occurrences == nil) {
+        SLDay firstDayOfYear = SLDayFromCivil(year, 1, 1);
+        SLDay firstDayOfNextYear = SLDayFromCivil(year + 1, 1, 1);
+
+        NSArray *compiledHolidays = [self compiledHolidaysForResourceName:resourceName];
+        NSMutableArray *yearOccurrences = [[NSMutableArray alloc] initWithCapacity:compiledHolidays.count];
+        for (SLCompiledHoliday *compiledHoliday in compiledHolidays) {
+            NSMutableArray *days = [[NSMutableArray alloc] init];
+
+            // evaluate the rule while excluding any of the removed days
+            SLHolidayRule rule = compiledHoliday.rule;
+            SLDay ruleDays[kSLHolidayRuleMaxOccurrences];
+            size_t numRuleDays = SLHolidayRuleOccurrencesInYear(&rule, year, ruleDays, kSLHolidayRuleMaxOccurrences);
+            for (size_t i = 0; i < numRuleDays; i++) {
+                NSNumber *day = [NSNumber numberWithInt:ruleDays[i]];
+                if (![compiledHoliday.removedDays containsObject:day]) {
+                    [days addObject:day];
+                }
+            }
+
+            // include any of the explicit days that fall within this year
+            for (NSNumber *day in compiledHoliday.addedDays) {
+                if ([day intValue] >= firstDayOfYear && [day intValue] < firstDayOfNextYear && ![days containsObject:day]) {
+                    [days addObject:day];
+                }
+            }
+            [yearOccurrences addObject:[days sortedArrayUsingSelector:@selector(compare:)]];
+        }
+        occurrences = [yearOccurrences copy];
+        if (isCached) {
+            if (resourceOccurrences == nil) {
+                resourceOccurrences = [[NSMutableDictionary alloc] initWithCapacity:kSLHolidayIndexYears + 1];
+                [self.yearlyOccurrences setObject:resourceOccurrences forKey:resourceName];
+            }
+            [resourceOccurrences setObject:occurrences forKey:yearKey];
+        }
+    }
+    return occurrences;
+}
+
+// returns the sorted day numbers for the holiday at the given index that fall within the range of days (inclusive)
+- (NSArray *)daysForHolidayAtIndex:(NSUInteger)holidayIndex inResourceName:(NSString *)resourceName fromDay:(SLDay)fromDay toDay:(SLDay)toDay
+{
+    int32_t fromYear, toYear;
+    SLCivilFromDay(fromDay, &fromYear, NULL, NULL);
+    SLCivilFromDay(toDay, &toYear, NULL, NULL);
+
+    NSMutableArray *days = [[NSMutableArray alloc] init];
+    for (int32_t year = fromYear; year <= toYear; year++) {
+        NSArray *occurrences = [self occurrencesForResourceName:resourceName inYear:year];
+        for (NSNumber *day in [occurrences objectAtIndex:holidayIndex]) {
+            if ([day intValue] >= fromDay && [day intValue] <= toDay) {
+                [days addObject:day];
+            }
+        }
+    }
+    return days;
+}
+
+// returns the first day number that the holiday at the given index occurs on or after the given day, or NO if there are none
+- (BOOL)firstDay:(SLDay *)firstDay forHolidayAtIndex:(NSUInteger)holidayIndex inResourceName:(NSString *)resourceName onOrAfterDay:(SLDay)day
+{
+    SLCompiledHoliday *compiledHoliday = [[self compiledHolidaysForResourceName:resourceName] objectAtIndex:holidayIndex];
+
+    // holidays that are only described by a table of dates will not occur after the final date in the table
+    SLDay lastDay = day + kSLHolidayMaxSearchYears * 366;
+    if (compiledHoliday.rule.type == kSLHolidayRuleTypeDates) {
+        if (compiledHoliday.addedDays.count == 0) {
+            return NO;
+        }
+        lastDay = MIN(lastDay, [[compiledHoliday.addedDays lastObject] intValue]);
+    }
+
+    int32_t year, lastYear;
+    SLCivilFromDay(day, &year, NULL, NULL);
+    SLCivilFromDay(lastDay, &lastYear, NULL, NULL);
+    for (; year <= lastYear; year++) {
+        NSArray *occurrences = [self occurrencesForResourceName:resourceName inYear:year];
+        for (NSNumber *occurrence in [occurrences objectAtIndex:holidayIndex]) {
+            if ([occurrence intValue] >= day) {
+                *firstDay = [occurrence intValue];
+                return YES;
+            }
+        }
+    }
+    return NO;
+}
+
+// Returns the holidays of the given resource name in the same form as the legacy holiday resources, where each holiday contains the
+// upcoming dates from the given day through the end of the resource years, along with the ID of the holiday.  Holidays with any of the
+// excluded IDs are skipped.  This must be called while synchronized.
+- (NSArray *)upcomingHolidaysForResourceName:(NSString *)resourceName fromDay:(SLDay)today excludingHolidayIds:(NSSet *)excludedHolidayIds
+                                   inherited:(BOOL)inherited
+{
+    int32_t year;
+    SLCivilFromDay(today, &year, NULL, NULL);
+    SLDay lastDay = SLDayFromCivil(year + kSLHolidayResourceYears + 1, 1, 1) - 1;
+
+    NSArray *compiledHolidays = [self compiledHolidaysForResourceName:resourceName];
+    NSMutableArray *holidays = [[NSMutableArray alloc] initWithCapacity:compiledHolidays.count];
+    for (NSUInteger i = 0; i < compiledHolidays.count; i++) {
+        SLCompiledHoliday *compiledHoliday = [compiledHolidays objectAtIndex:i];
+        NSNumber *holidayId = [NSNumber numberWithUnsignedInteger:compiledHoliday.holidayId];
+        if ([excludedHolidayIds containsObject:holidayId]) {
+            continue;
+        }
+        NSArray *days = [self daysForHolidayAtIndex:i inResourceName:resourceName fromDay:today toDay:lastDay];
+
+        // always provide the next occurrence of a holiday, even if it falls outside of the resource years
+        SLDay nextDay;
+        if (days.count == 0 && [self firstDay:&nextDay forHolidayAtIndex:i inResourceName:resourceName onOrAfterDay:today]) {
+            days = @[[NSNumber numberWithInt:nextDay]];
+        }
+
+        NSMutableArray *dateStrings = [[NSMutableArray alloc] initWithCapacity:days.count];
+        for (NSNumber *day in days) {
+            [dateStrings addObject:SLDateStringFromDay([day intValue])];
+        }
+        if (inherited) {
+            [holidays addObject:@{kSLHolidayIdKey:holidayId,
+                                  kSLHolidayNameKey:compiledHoliday.name,
+                                  kSLHolidayDatesKey:[dateStrings copy],
+                                  kSLHolidayInheritedKey:[NSNumber numberWithBool:YES]}];
+        } else {
+            [holidays addObject:@{kSLHolidayIdKey:holidayId,
+                                  kSLHolidayNameKey:compiledHoliday.name,
+                                  kSLHolidayDatesKey:[dateStrings copy]}];
+        }
+    }
+    return holidays;
+}
+
+// Returns a dictionary in the same form as the legacy holiday resources where each holiday contains the upcoming dates for the
+// holiday starting from today.  The holidays of a subdivision start with the holidays that it observes from its country, which are
+// marked as inherited since their IDs belong to the country.
+- (NSDictionary *)holidayResourceForResourceName:(NSString *)resourceName
+{
+    @synchronized(self) {
+        [self invalidateHolidayIndexIfNeeded];
+        SLDay today = [SLHolidayManager dayForDate:[SLClock now]];
+        NSArray *regionalHolidays = [self upcomingHolidaysForResourceName:resourceName fromDay:today excludingHolidayIds:nil inherited:NO];
+        NSMutableArray *holidays = [[NSMutableArray alloc] init];
+        NSString *parentResourceName = [self.parentResourceNames objectForKey:resourceName];
+        if (parentResourceName != nil) {
+            [holidays addObjectsFromArray:[self upcomingHolidaysForResourceName:parentResourceName fromDay:today
+                                                            excludingHolidayIds:[self.excludedHolidayIds objectForKey:resourceName]
+                                                                      inherited:YES]];
+        }
+        [holidays addObjectsFromArray:regionalHolidays];
+        if (holidays.count == 0) {
+            return nil;
+        }
+        return @{kSLHolidayHolidaysKey:[holidays copy]};
+    }
+}
+
+// Returns the holiday selection for the given holiday names (which were saved before holidays were selected by ID).  Any names that a
+// holiday was previously generated with are matched using the aliases in the holiday resource, while unknown names are ignored.
+- (SLHolidaySelection)holidaySelectionForHolidayNames:(NSArray *)holidayNames inResourceName:(NSString *)resourceName
+{
+    @synchronized(self) {
+        NSArray *compiledHolidays = [self compiledHolidaysForResourceName:resourceName];
+        NSDictionary *aliases = [self.holidayAliases objectForKey:resourceName];
+        SLHolidaySelection holidaySelection = 0;
+        for (NSString *holidayName in holidayNames) {
+            if (![holidayName isKindOfClass:[NSString class]]) {
+                continue;
+            }
+            NSNumber *aliasedHolidayId = [aliases objectForKey:holidayName];
+            if (aliasedHolidayId != nil && [aliasedHolidayId unsignedIntegerValue] < kSLHolidayMaxHolidayIds) {
+                holidaySelection |= SLHolidaySelectionForHolidayId([aliasedHolidayId unsignedIntegerValue]);
+                continue;
+            }
+            for (SLCompiledHoliday *compiledHoliday in compiledHolidays) {
+                if ([holidayName isEqualToString:compiledHoliday.name] && compiledHoliday.holidayId < kSLHolidayMaxHolidayIds) {
+                    holidaySelection |= SLHolidaySelectionForHolidayId(compiledHoliday.holidayId);
+                    break;
+                }
+            }
+        }
+        return holidaySelection;
+    }
+}
+
+// Returns the first date that any of the holidays in the given selection occur on or after the given date (along with the name of that
+// holiday), or nil if none of the holidays occur again.
+- (NSDate *)firstDateForHolidaySelection:(SLHolidaySelection)holidaySelection inResourceName:(NSString *)resourceName
+                           onOrAfterDate:(NSDate *)date holidayName:(NSString **)holidayName
+{
+    @synchronized(self) {
+        [self invalidateHolidayIndexIfNeeded];
+        NSArray *compiledHolidays = [self compiledHolidaysForResourceName:resourceName];
+        SLDay day = [SLHolidayManager dayForDate:date];
+        SLCompiledHoliday *firstHoliday = nil;
+        SLDay firstHolidayDay = 0;
+        for (NSUInteger i = 0; i < compiledHolidays.count && holidaySelection != 0; i++) {
+            SLCompiledHoliday *compiledHoliday = [compiledHolidays objectAtIndex:i];
+            if (compiledHoliday.holidayId >= kSLHolidayMaxHolidayIds || !(holidaySelection & SLHolidaySelectionForHolidayId(compiledHoliday.holidayId))) {
+                continue;
+            }
+            SLDay holidayDay;
+            if ([self firstDay:&holidayDay forHolidayAtIndex:i inResourceName:resourceName onOrAfterDay:day] && (firstHoliday == nil || holidayDay < firstHolidayDay)) {
+                firstHoliday = compiledHoliday;
+                firstHolidayDay = holidayDay;
+            }
+        }
+        if (firstHoliday == nil) {
+            return nil;
+        }
+        if (holidayName != NULL) {
+            *holidayName = firstHoliday.name;
+        }
+        return [SLHolidayManager dateForDay:firstHolidayDay];
+    }
+}
+
+// Returns the slice of the holiday index for the given holiday country, building it if needed to cover the first year of the index and the
+// following index years.  The holidays that a subdivision observes from its country are included once in the slice of the country (and are
+// selected for the country), so the slice of a subdivision only includes its regional holidays.  This must be called while synchronized.
+- (NSData *)holidayIndexSliceForHolidayCountry:(SLHolidayCountry)holidayCountry
+{
+    NSNumber *sliceKey = [NSNumber numberWithInt:holidayCountry];
+    NSData *indexSlice = [self.indexSlices objectForKey:sliceKey];
+    if (indexSlice == nil) {
+        NSString *resourceName = kSLHolidayCountryInfo[holidayCountry].resourceName;
+        NSMutableData *indexEntries = [[NSMutableData alloc] init];
+        for (int32_t year = self.indexFirstYear; year <= self.indexFirstYear + kSLHolidayIndexYears; year++) {
+            NSArray *occurrences = [self occurrencesForResourceName:resourceName inYear:year];
+            for (NSUInteger holidayIndex = 0; holidayIndex < occurrences.count; holidayIndex++) {
+                for (NSNumber *day in [occurrences objectAtIndex:holidayIndex]) {
+                    SLHolidayIndexEntry entry = {[day intValue], (uint16_t)holidayCountry, (uint16_t)holidayIndex};
+                    [indexEntries appendBytes:&entry length:sizeof(entry)];
+                }
+            }
+        }
+        qsort(indexEntries.mutableBytes, indexEntries.length / sizeof(SLHolidayIndexEntry), sizeof(SLHolidayIndexEntry), SLCompareHolidayIndexEntries);
+        indexSlice = [indexEntries copy];
+        [self.indexSlices setObject:indexSlice forKey:sliceKey];
+    }
+    return indexSlice;
+}
+
+// Discards the slices of the holiday index if the current year has moved past the first year that they cover, along with the occurrences
+// of any year that the index no longer covers (must be called while synchronized).
+- (void)invalidateHolidayIndexIfNeeded
+{
+    int32_t currentYear;
+    SLCivilFromDay([SLHolidayManager dayForDate:[SLClock now]], &currentYear, NULL, NULL);
+    if (self.indexFirstYear != currentYear) {
+        [self.indexSlices removeAllObjects];
+        self.indexFirstYear = currentYear;
+        for (NSMutableDictionary *resourceOccurrences in [self.yearlyOccurrences objectEnumerator]) {
+            for (NSNumber *yearKey in [resourceOccurrences allKeys]) {
+                if (![self holidayIndexContainsYear:[yearKey intValue]]) {
+                    [resourceOccurrences removeObjectForKey:yearKey];
+                }
+            }
+        }
+    }
+}
+
+// Enumerates the holidays of each holiday country that has any holidays in the given selections (an array indexed by the holiday country)
+// in order of date, starting with the holidays that occur on the given day.  The slices of the selected holiday countries are merged as
+// they are enumerated, so only the countries that are selected are ever evaluated.
+- (void)enumerateHolidaysFromDay:(SLDay)day holidaySelections:(const SLHolidaySelection *)holidaySelections
+                      usingBlock:(SLHolidayIndexEnumerationBlock)block
+{
+    @synchronized(self) {
+        [self invalidateHolidayIndexIfNeeded];
+
+        // Seek to the first entry of each selected slice that occurs on or after the given day.  The slices are kept for the duration of
+        // the enumeration in case the block causes the index to be invalidated.
+        NSMutableArray *indexSlices = [[NSMutableArray alloc] init];
+        const SLHolidayIndexEntry *sliceEntries[kSLHolidayCountryNumRegions];
+        size_t slicePositions[kSLHolidayCountryNumRegions];
+        size_t sliceCounts[kSLHolidayCountryNumRegions];
+        size_t numSlices = 0;
+        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
+            if (holidaySelections[holidayCountry] == 0) {
+                continue;
+            }
+            NSData *indexSlice = [self holidayIndexSliceForHolidayCountry:holidayCountry];
+            [indexSlices addObject:indexSlice];
+            sliceEntries[numSlices] = indexSlice.bytes;
+            sliceCounts[numSlices] = indexSlice.length / sizeof(SLHolidayIndexEntry);
+            slicePositions[numSlices] = SLFirstHolidayIndexEntryOnOrAfterDay(sliceEntries[numSlices], sliceCounts[numSlices], day);
+            numSlices++;
+        }
+
+        // Repeatedly take the earliest entry among the slices.  The slices are in order of the holiday country, so holidays on the same day
+        // are enumerated in the same order as a single index of every holiday country.
+        BOOL stop = NO;
+        while (!stop) {
+            size_t earliestSlice = numSlices;
+            for (size_t i = 0; i < numSlices; i++) {
+                if (slicePositions[i] < sliceCounts[i] && (earliestSlice == numSlices ||
+                    sliceEntries[i][slicePositions[i]].day < sliceEntries[earliestSlice][slicePositions[earliestSlice]].day)) {
+                    earliestSlice = i;
+                }
+            }
+            if (earliestSlice == numSlices) {
+                break;
+            }
+            const SLHolidayIndexEntry *entry = &sliceEntries[earliestSlice][slicePositions[earliestSlice]++];
+            NSString *resourceName = kSLHolidayCountryInfo[entry->holidayCountry].resourceName;
+            SLCompiledHoliday *compiledHoliday = [[self compiledHolidaysForResourceName:resourceName] objectAtIndex:entry->holidayIndex];
+            block((SLHolidayCountry)entry->holidayCountry, resourceName, compiledHoliday.name, compiledHoliday.holidayId, entry->day, &stop);
+        }
+    }
+}
+
+// builds the slices of the holiday index for each holiday country that has any holidays in the given selections ahead of time
+- (void)prebuildHolidayIndexForHolidaySelections:(const SLHolidaySelection *)holidaySelections
+{
+    @synchronized(self) {
+        [self invalidateHolidayIndexIfNeeded];
+        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
+            if (holidaySelections[holidayCountry] != 0) {
+                [self holidayIndexSliceForHolidayCountry:holidayCountry];
+            }
+        }
+    }
+}
+
+@end
@@ -0,0 +1,197 @@
+//
+//  SLHolidayRules.c
+//  Portable calendar arithmetic used to evaluate the compiled holiday rules.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLHolidayRules.h"
+#include <stdlib.h>
+
+// performs a floor division (rounding towards negative infinity) which is needed for dates prior to 1970
+static int32_t SLFloorDivide(int32_t a, int32_t b)
+{
+    return (a >= 0) ? a / b : (a - b + 1) / b;
+}
+
+// returns the day number for the given year, month (1-12), and day of the month (1-31)
+SLDay SLDayFromCivil(int32_t year, int32_t month, int32_t day)
+{
+    // shift the year to start in March so that the leap day is the last day of the year
+    year -= month <= 2;
+    int32_t era = SLFloorDivide(year, 400);
+    int32_t yearOfEra = year - era * 400;
+    int32_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// converts the day number to the year, month (1-12), and day of the month (1-31)
+void SLCivilFromDay(SLDay day, int32_t *year, int32_t *month, int32_t *dayOfMonth)
+{
+    day += 719468;
+    int32_t era = SLFloorDivide(day, 146097);
+    int32_t dayOfEra = day - era * 146097;
+    int32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int32_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    int32_t civilMonth = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    if (year != NULL) {
+        *year = yearOfEra + era * 400 + (civilMonth <= 2);
+    }
+    if (month != NULL) {
+        *month = civilMonth;
+    }
+    if (dayOfMonth != NULL) {
+        *dayOfMonth = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    }
+}
+
+// returns the weekday for a given day number (January 1, 1970 was a Thursday)
+SLWeekday SLWeekdayForDay(SLDay day)
+{
+    int32_t weekday = (day + kSLWeekdayThursday) % kSLWeekdayNumWeekdays;
+    return (SLWeekday)(weekday < 0 ? weekday + kSLWeekdayNumWeekdays : weekday);
+}
+
+// returns the number of days in a given month
+int32_t SLDaysInMonth(int32_t year, int32_t month)
+{
+    if (month == 2) {
+        return ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0) ? 29 : 28;
+    }
+    return (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+}
+
+// returns the day number of the western (Gregorian) Easter for the given year using the anonymous Gregorian algorithm
+SLDay SLWesternEasterForYear(int32_t year)
+{
+    int32_t a = year % 19;
+    int32_t b = year / 100;
+    int32_t c = year % 100;
+    int32_t d = (19 * a + b - b / 4 - ((b - (b + 8) / 25 + 1) / 3) + 15) % 30;
+    int32_t e = (32 + 2 * (b % 4) + 2 * (c / 4) - d - (c % 4)) % 7;
+    int32_t f = d + e - 7 * ((a + 11 * d + 22 * e) / 451) + 114;
+    return SLDayFromCivil(year, f / 31, f % 31 + 1);
+}
+
+// returns the day number of the orthodox (Julian) Easter for the given year, converted to the Gregorian calendar
+SLDay SLOrthodoxEasterForYear(int32_t year)
+{
+    int32_t d = (19 * (year % 19) + 15) % 30;
+    int32_t e = (2 * (year % 4) + 4 * (year % 7) - d + 34) % 7;
+    int32_t f = d + e + 114;
+    int32_t julianDays = year / 100 - year / 400 - 2;
+    return SLDayFromCivil(year, f / 31, f % 31 + 1) + julianDays;
+}
+
+// Parses an observed shift string (i.e. "0,0,0,0,0,-1,1") from a compiled holiday into the given rule.  Returns 0 if the string
+// could not be parsed, in which case the rule will not have any observed shifts.
+int SLHolidayRuleParseObserved(SLHolidayRule *rule, const char *observed)
+{
+    int8_t shifts[kSLWeekdayNumWeekdays];
+    const char *cursor = observed;
+    for (int weekday = 0; weekday < kSLWeekdayNumWeekdays; weekday++) {
+        if (*cursor == 'x') {
+            shifts[weekday] = kSLHolidayRuleNotObserved;
+            cursor++;
+        } else {
+            char *end = NULL;
+            long shift = strtol(cursor, &end, 10);
+            if (end == cursor || shift < -7 || shift > 7) {
+                break;
+            }
+            shifts[weekday] = (int8_t)shift;
+            cursor = end;
+        }
+
+        // each shift must be separated by a comma, with the final shift ending the string
+        if (weekday == kSLWeekdayNumWeekdays - 1 && *cursor == '\0') {
+            for (int i = 0; i < kSLWeekdayNumWeekdays; i++) {
+                rule->observed[i] = shifts[i];
+            }
+            return 1;
+        } else if (*cursor != ',') {
+            break;
+        }
+        cursor++;
+    }
+
+    for (int i = 0; i < kSLWeekdayNumWeekdays; i++) {
+        rule->observed[i] = 0;
+    }
+    return 0;
+}
+
+// Returns the actual day of the rule for a given rule year (before any observed shift is applied), or returns 0 and does not
+// set the day if the rule does not occur in that year (i.e. February 29 or a fifth weekday of a month).
+static int SLHolidayRuleDayForRuleYear(const SLHolidayRule *rule, int32_t year, SLDay *day)
+{
+    switch (rule->type) {
+        case kSLHolidayRuleTypeFixed:
+            if (rule->day > SLDaysInMonth(year, rule->month)) {
+                return 0;
+            }
+            *day = SLDayFromCivil(year, rule->month, rule->day);
+            return 1;
+        case kSLHolidayRuleTypeNthWeekday: {
+            if (rule->ordinal == kSLHolidayRuleLastOrdinal) {
+                SLDay lastDay = SLDayFromCivil(year, rule->month, SLDaysInMonth(year, rule->month));
+                *day = lastDay - (SLWeekdayForDay(lastDay) - rule->weekday + kSLWeekdayNumWeekdays) % kSLWeekdayNumWeekdays;
+                return 1;
+            }
+            SLDay firstDay = SLDayFromCivil(year, rule->month, 1);
+            int32_t dayOfMonth = 1 + (rule->weekday - SLWeekdayForDay(firstDay) + kSLWeekdayNumWeekdays) % kSLWeekdayNumWeekdays
+                                 + kSLWeekdayNumWeekdays * (rule->ordinal - 1);
+            if (rule->ordinal < 1 || dayOfMonth > SLDaysInMonth(year, rule->month)) {
+                return 0;
+            }
+            *day = firstDay + dayOfMonth - 1;
+            return 1;
+        }
+        case kSLHolidayRuleTypeWeekdayOnOrAfter: {
+            SLDay baseDay = SLDayFromCivil(year, rule->month, rule->day);
+            *day = baseDay + (rule->weekday - SLWeekdayForDay(baseDay) + kSLWeekdayNumWeekdays) % kSLWeekdayNumWeekdays;
+            return 1;
+        }
+        case kSLHolidayRuleTypeWeekdayOnOrBefore: {
+            SLDay baseDay = SLDayFromCivil(year, rule->month, rule->day);
+            *day = baseDay - (SLWeekdayForDay(baseDay) - rule->weekday + kSLWeekdayNumWeekdays) % kSLWeekdayNumWeekdays;
+            return 1;
+        }
+        case kSLHolidayRuleTypeEaster:
+            *day = SLWesternEasterForYear(year) + rule->offset;
+            return 1;
+        case kSLHolidayRuleTypeOrthodoxEaster:
+            *day = SLOrthodoxEasterForYear(year) + rule->offset;
+            return 1;
+        case kSLHolidayRuleTypeDates:
+        default:
+            return 0;
+    }
+}
+
+// Populates the given array with the sorted day numbers on which the rule occurs within a given calendar year and returns the number
+// of days written.  Observed shifts may move an occurrence into an adjacent year, so at most kSLHolidayRuleMaxOccurrences are returned.
+size_t SLHolidayRuleOccurrencesInYear(const SLHolidayRule *rule, int32_t year, SLDay *days, size_t capacity)
+{
+    SLDay firstDayOfYear = SLDayFromCivil(year, 1, 1);
+    SLDay firstDayOfNextYear = SLDayFromCivil(year + 1, 1, 1);
+
+    // evaluate the rule for the adjacent years as well, since those occurrences might be observed in the requested year
+    size_t numDays = 0;
+    for (int32_t ruleYear = year - 1; ruleYear <= year + 1 && numDays < capacity; ruleYear++) {
+        SLDay day;
+        if (SLHolidayRuleDayForRuleYear(rule, ruleYear, &day)) {
+            int8_t shift = rule->observed[SLWeekdayForDay(day)];
+            if (shift != kSLHolidayRuleNotObserved) {
+                day += shift;
+                if (day >= firstDayOfYear && day < firstDayOfNextYear && (numDays == 0 || days[numDays - 1] < day)) {
+                    days[numDays++] = day;
+                }
+            }
+        }
+    }
+    return numDays;
+}
@@ -0,0 +1,103 @@
+//
+//  SLHolidayRules.h
+//  Portable calendar arithmetic used to evaluate the compiled holiday rules.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLHolidayRules_h
+#define SLHolidayRules_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// a day number, represented as the number of days since January 1, 1970 (proleptic Gregorian calendar)
+typedef int32_t SLDay;
+
+// the weekdays as they are represented by the compiled holiday rules (Monday being the first day of the week)
+typedef enum SLWeekday {
+    kSLWeekdayMonday,
+    kSLWeekdayTuesday,
+    kSLWeekdayWednesday,
+    kSLWeekdayThursday,
+    kSLWeekdayFriday,
+    kSLWeekdaySaturday,
+    kSLWeekdaySunday,
+    kSLWeekdayNumWeekdays
+} SLWeekday;
+
+// the types of rules that can describe a holiday (these must match the rule types that are written by holiday_gen.py)
+typedef enum SLHolidayRuleType {
+    // the holiday does not follow a rule and is described by an explicit table of dates
+    kSLHolidayRuleTypeDates,
+    // the holiday falls on the same month and day each year
+    kSLHolidayRuleTypeFixed,
+    // the holiday falls on the nth (or last) weekday of a month
+    kSLHolidayRuleTypeNthWeekday,
+    // the holiday falls on the first weekday on or after a particular month and day
+    kSLHolidayRuleTypeWeekdayOnOrAfter,
+    // the holiday falls on the first weekday on or before a particular month and day
+    kSLHolidayRuleTypeWeekdayOnOrBefore,
+    // the holiday is offset from the western (Gregorian) Easter
+    kSLHolidayRuleTypeEaster,
+    // the holiday is offset from the orthodox (Julian) Easter
+    kSLHolidayRuleTypeOrthodoxEaster
+} SLHolidayRuleType;
+
+// the observed shift that indicates a holiday is not observed when it falls on a particular weekday
+#define kSLHolidayRuleNotObserved       INT8_MIN
+
+// the ordinal that represents the last weekday of a month
+#define kSLHolidayRuleLastOrdinal       -1
+
+// the maximum number of occurrences that a single rule can have within a single calendar year
+#define kSLHolidayRuleMaxOccurrences    3
+
+// a single compiled holiday rule
+typedef struct SLHolidayRule {
+    SLHolidayRuleType type;
+    int32_t month;
+    int32_t day;
+    SLWeekday weekday;
+    int32_t ordinal;
+    int32_t offset;
+    // the number of days a holiday is moved when the actual date falls on each weekday (or kSLHolidayRuleNotObserved)
+    int8_t observed[kSLWeekdayNumWeekdays];
+} SLHolidayRule;
+
+// returns the day number for the given year, month (1-12), and day of the month (1-31)
+SLDay SLDayFromCivil(int32_t year, int32_t month, int32_t day);
+
+// converts the day number to the year, month (1-12), and day of the month (1-31)
+void SLCivilFromDay(SLDay day, int32_t *year, int32_t *month, int32_t *dayOfMonth);
+
+// returns the weekday for a given day number
+SLWeekday SLWeekdayForDay(SLDay day);
+
+// returns the number of days in a given month
+int32_t SLDaysInMonth(int32_t year, int32_t month);
+
+// returns the day number of the western (Gregorian) Easter for the given year
+SLDay SLWesternEasterForYear(int32_t year);
+
+// returns the day number of the orthodox (Julian) Easter for the given year, converted to the Gregorian calendar
+SLDay SLOrthodoxEasterForYear(int32_t year);
+
+// Parses an observed shift string (i.e. "0,0,0,0,0,-1,1") from a compiled holiday into the given rule.  Returns 0 if the string
+// could not be parsed, in which case the rule will not have any observed shifts.
+int SLHolidayRuleParseObserved(SLHolidayRule *rule, const char *observed);
+
+// Populates the given array with the sorted day numbers on which the rule occurs within a given calendar year and returns the number
+// of days written.  Observed shifts may move an occurrence into an adjacent year, so at most kSLHolidayRuleMaxOccurrences are returned.
+size_t SLHolidayRuleOccurrencesInYear(const SLHolidayRule *rule, int32_t year, SLDay *days, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLHolidayRules_h */
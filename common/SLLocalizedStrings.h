@@ -61,12 +61,27 @@
 #define kSLSkipReasonPopupString                    [kSLSleeperBundle localizedStringForKey:@"SKIP_REASON_POPUP" value:@"You have decided to skip this alarm the next time it is set to fire. This decision will be reset if you save the alarm." table:@"Localizable"]
 #define kSLSkipReasonDateString(date)               [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_REASON_DATE" value:@"The next skip date you've selected for this alarm is %@." table:@"Localizable"], date]
 #define kSLSkipReasonHolidayString(date, holiday)   [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_REASON_HOLIDAY" value:@"The next holiday you've selected for this alarm is %@ (%@)." table:@"Localizable"], date, holiday]
+#define kSLSkipReasonRuleString(date, rule)         [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_REASON_RULE" value:@"The next repeating skip date you've selected for this alarm is %@ (%@)." table:@"Localizable"], date, rule]
+#define kSLSkipRuleWeeklyString(days)               [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_WEEKLY" value:@"Every %@" table:@"Localizable"], days]
+#define kSLSkipRuleWeeklyIntervalString(num, days)  [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_WEEKLY_INTERVAL" value:@"Every %ld weeks on %@" table:@"Localizable"], num, days]
+#define kSLSkipRuleNthWeekdayString(day, nth)       [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_NTH_WEEKDAY" value:@"%@ #%ld of every month" table:@"Localizable"], day, nth]
+#define kSLSkipRuleNthWeekdayIntervalString(day, nth, num) [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_NTH_WEEKDAY_INTERVAL" value:@"%@ #%ld of every %ld months" table:@"Localizable"], day, nth, num]
+#define kSLSkipRuleLastWeekdayString(day)           [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_LAST_WEEKDAY" value:@"Last %@ of every month" table:@"Localizable"], day]
+#define kSLSkipRuleLastWeekdayIntervalString(day, num) [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_LAST_WEEKDAY_INTERVAL" value:@"Last %@ of every %ld months" table:@"Localizable"], day, num]
+#define kSLSkipRuleDateRangeString(start, end)      [NSString stringWithFormat:[kSLSleeperBundle localizedStringForKey:@"SKIP_RULE_DATE_RANGE" value:@"%@ to %@" table:@"Localizable"], start, end]
 #define kSLAllHolidaysString                        [kSLSleeperBundle localizedStringForKey:@"ALL_HOLIDAYS" value:@"All Holidays" table:@"Localizable"]
 #define kSLRecommendedHolidaysExplanationString     [kSLSleeperBundle localizedStringForKey:@"RECOMMENDED_HOLIDAYS_EXPLANATION" value:@"These are the recommended holidays based on your device's current locale." table:@"Localizable"]
 #define kSLTodayString                              [kSLMobileTimerBundle localizedStringForKey:@"TODAY" value:@"Today" table:@"Localizable"]
 #define kSLTomorrowString                           [kSLMobileTimerBundle localizedStringForKey:@"TOMORROW" value:@"Tomorrow" table:@"Localizable"]
 #define kSLSingleDateString                         [kSLSleeperBundle localizedStringForKey:@"SINGLE_DATE" value:@"Single Date" table:@"Localizable"]
 #define kSLDateRangeString                          [kSLSleeperBundle localizedStringForKey:@"DATE_RANGE" value:@"Date Range" table:@"Localizable"]
+#define kSLImportCalendarString                     [kSLSleeperBundle localizedStringForKey:@"IMPORT_CALENDAR" value:@"Import Calendar" table:@"Localizable"]
+#define kSLImportCalendarFailedString               [kSLSleeperBundle localizedStringForKey:@"IMPORT_CALENDAR_FAILED" value:@"The selected file could not be imported. Please choose a calendar (.ics) file." table:@"Localizable"]
+#define kSLSkipProfileString                        [kSLSleeperBundle localizedStringForKey:@"SKIP_PROFILE" value:@"Skip Profile" table:@"Localizable"]
+#define kSLNewSkipProfileString                     [kSLSleeperBundle localizedStringForKey:@"NEW_SKIP_PROFILE" value:@"New Profile..." table:@"Localizable"]
+#define kSLSkipProfileNameString                    [kSLSleeperBundle localizedStringForKey:@"SKIP_PROFILE_NAME" value:@"Profile Name" table:@"Localizable"]
+#define kSLStopUsingSkipProfileString               [kSLSleeperBundle localizedStringForKey:@"STOP_USING_SKIP_PROFILE" value:@"Stop Using Profile" table:@"Localizable"]
+#define kSLSkipProfileExplanationString             [kSLSleeperBundle localizedStringForKey:@"SKIP_PROFILE_EXPLANATION" value:@"A skip profile shares the same skip dates and holidays between alarms. Any changes made while a profile is selected apply to every alarm that uses it." table:@"Localizable"]
 #define kSLSkipExplanationString                    [kSLSleeperBundle localizedStringForKey:@"SKIP_EXPLANATION" value:@"Use the skip feature to temporarily disable alarms based on selected away dates/holidays or by setting a time in which the system will prompt you upon unlocking the device to skip the alarm before it fires." table:@"Localizable"]
 #define kSLNoFutureDatesString                      [kSLSleeperBundle localizedStringForKey:@"NO_FUTURE_DATES" value:@"No Future Dates Available" table:@"Localizable"]    
 
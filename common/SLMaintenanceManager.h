@@ -0,0 +1,23 @@
+//
+//  SLMaintenanceManager.h
+//  A singleton object that periodically performs maintenance on the preferences for the tweak.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// manager that removes orphaned alarms and expired skip dates from the preferences once per day (SpringBoard only)
+@interface SLMaintenanceManager : NSObject
+
+// return a singleton instance of this manager
++ (instancetype)sharedInstance;
+
+// the results of the last maintenance pass (see the maintenance keys in SLPrefsManager.h), or nil if no maintenance was performed yet
+@property (nonatomic, strong, readonly) NSDictionary *lastMaintenanceResult;
+
+// performs a maintenance pass on a background queue
+- (void)performMaintenance;
+
+@end
@@ -0,0 +1,148 @@
+//
+//  SLMaintenanceManager.m
+//  A singleton object that periodically performs maintenance on the preferences for the tweak.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import "SLMaintenanceManager.h"
+#import "SLPrefsManager.h"
+#import "SLCommonHeaders.h"
+#import "SLCompatibilityHelper.h"
+#import <objc/runtime.h>
+#import "SLClock.h"
+#import "SLAccounting.h"
+
+// the number of seconds to wait after SpringBoard launches before performing the first maintenance pass
+#define kSLInitialMaintenanceDelay      120.0
+
+// the hour of the day that the daily maintenance will be performed
+#define kSLDailyMaintenanceHour         3
+
+@interface SLMaintenanceManager ()
+
+// the persistent timer that will be used to perform the daily maintenance
+@property (nonatomic, strong) PCSimpleTimer *dailyMaintenanceTimer;
+
+// the serial queue that the maintenance is performed on
+@property (nonatomic, strong) dispatch_queue_t maintenanceQueue;
+
+// redeclare the results of the last maintenance pass so that it can be updated
+@property (nonatomic, strong, readwrite) NSDictionary *lastMaintenanceResult;
+
+// the alarm Ids that were missing from the system during the last maintenance pass that could determine the alarms on the system, which
+// are only removed from the preferences if they are still missing during the next pass (only accessed on the maintenance queue)
+@property (nonatomic, strong) NSSet *suspectedOrphanedAlarmIds;
+
+@end
+
+@implementation SLMaintenanceManager
+
+// return a singleton instance of this manager
++ (instancetype)sharedInstance
+{
+    static dispatch_once_t pred;
+    static id sharedInstance = nil;
+    dispatch_once(&pred, ^{
+        sharedInstance = [[[self class] alloc] init];
+    });
+    return sharedInstance;
+}
+
+// override the default initializer to schedule the maintenance passes
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.maintenanceQueue = dispatch_queue_create("com.joshuaseltzer.sleeper.maintenance", DISPATCH_QUEUE_SERIAL);
+
+        // perform the first pass after a delay so that the alarm managers are ready and SpringBoard is not slowed down while launching
+        dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kSLInitialMaintenanceDelay * NSEC_PER_SEC));
+        dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
+            [self performMaintenance];
+        });
+        [self createDailyMaintenanceTimer];
+    }
+    return self;
+}
+
+// invoked when the persistent timer is fired
+- (void)persistentTimerFired:(PCSimpleTimer *)timer
+{
+    [self performMaintenance];
+    [self createDailyMaintenanceTimer];
+}
+
+// creates the daily maintenance timer for the following night and potentially invalidating/destroying the previous timer
+- (void)createDailyMaintenanceTimer
+{
+    // check to see if the daily maintenance timer was already created
+    if (self.dailyMaintenanceTimer) {
+        [self.dailyMaintenanceTimer invalidate];
+        self.dailyMaintenanceTimer = nil;
+    }
+
+    // create the date and timer that will fire early in the morning tomorrow
+    NSDate *today = [SLClock now];
+    NSCalendar *calendar = [SLClock calendar];
+    NSDateComponents *adjustDateComponents = [[NSDateComponents alloc] init];
+    adjustDateComponents.day = 1;
+    adjustDateComponents.hour = kSLDailyMaintenanceHour;
+    adjustDateComponents.minute = arc4random_uniform(30) + 1;
+    adjustDateComponents.second = arc4random_uniform(59) + 1;
+    NSDate *maintenanceDate = [calendar dateByAddingComponents:adjustDateComponents toDate:[calendar startOfDayForDate:today] options:0];
+
+    // as a sanity check, ensure that the new date that was calculated is in the future since we end up in an infinite loop otherwise
+    if ([today compare:maintenanceDate] == NSOrderedAscending) {
+        self.dailyMaintenanceTimer = [[objc_getClass("PCSimpleTimer") alloc] initWithFireDate:maintenanceDate
+                                                                            serviceIdentifier:kSLBundleIdentifier
+                                                                                       target:self
+                                                                                     selector:@selector(persistentTimerFired:)
+                                                                                     userInfo:nil];
+        [self.dailyMaintenanceTimer scheduleInRunLoop:[NSRunLoop mainRunLoop]];
+    }
+}
+
+// performs a maintenance pass on a background queue
+- (void)performMaintenance
+{
+    dispatch_async(self.maintenanceQueue, ^{
+        // Diff all of the alarms in the preferences against the alarms on the system at once.  An alarm is only considered orphaned once it
+        // has been missing on two consecutive passes, so a single pass where the system reports a partial list of alarms (i.e. while the
+        // alarms are still loading after a reboot) never deletes any preferences.  A pass that could not determine the alarms on the
+        // system keeps the alarms that were already suspected.
+        NSArray *alarmIds = [SLPrefsManager allAlarmIds];
+        NSMutableSet *orphanedAlarmIds = nil;
+        if (alarmIds.count > 0) {
+            NSSet *missingAlarmIds = [SLCompatibilityHelper orphanedAlarmIdsForAlarmIds:alarmIds];
+            if (missingAlarmIds != nil) {
+                orphanedAlarmIds = [missingAlarmIds mutableCopy];
+                [orphanedAlarmIds intersectSet:self.suspectedOrphanedAlarmIds != nil ? self.suspectedOrphanedAlarmIds : [NSSet set]];
+                self.suspectedOrphanedAlarmIds = missingAlarmIds;
+            }
+        } else {
+            self.suspectedOrphanedAlarmIds = nil;
+        }
+
+        // remove the orphaned alarms and expired skip dates from the preferences
+        NSDictionary *maintenanceResult = [SLPrefsManager performMaintenanceRemovingAlarmIds:orphanedAlarmIds];
+        self.lastMaintenanceResult = maintenanceResult;
+
+        // build the holiday index for the selected holidays now, rather than during the first skip decision that needs it
+        [SLPrefsManager prebuildHolidayIndex];
+#ifdef DEBUG
+        NSLog(@"Sleeper: maintenance removed %@ alarm(s), %@ skip date(s), and %@ skip profile(s), reclaiming %@ byte(s)",
+              [maintenanceResult objectForKey:kSLMaintenanceRemovedAlarmsKey],
+              [maintenanceResult objectForKey:kSLMaintenanceRemovedSkipDatesKey],
+              [maintenanceResult objectForKey:kSLMaintenanceRemovedSkipProfilesKey],
+              [maintenanceResult objectForKey:kSLMaintenanceReclaimedBytesKey]);
+
+        // export the work that each entry point has performed since the last maintenance pass
+        NSLog(@"Sleeper: accounting since the last maintenance pass: %@", SLAccountingReport());
+        SLAccountingReset();
+#endif
+    });
+}
+
+@end
@@ -8,14 +8,20 @@
 
 #import <Foundation/Foundation.h>
 #import "SLAlarmPrefs.h"
+#import "SLHolidayRules.h"
 
 // the bundle path which includes some custom preference files needed for the tweak
-#define kSLSleeperBundle                                [NSBundle bundleWithPath:@"/Library/Application Support/Sleeper.bundle"]
+#define kSLSleeperBundlePath                            @"/Library/Application Support/Sleeper.bundle"
+#define kSLSleeperBundle                                [NSBundle bundleWithPath:kSLSleeperBundlePath]
 
 // define the bundle identifier for the tweak
 static NSString *const kSLBundleIdentifier =            @"com.joshuaseltzer.sleeper";
 
+// the current schema version of the preferences file (any preferences file without a schema version is considered version 1)
+#define kSLPrefsSchemaVersion                           3
+
 // constant keys for the values we are going to add to the preferences file
+static NSString *const kSLSchemaVersionKey =            @"schemaVersion";
 static NSString *const kSLAlarmsKey =                   @"Alarms";
 static NSString *const kSLAlarmIdKey =                  @"alarmId";
 static NSString *const kSLSnoozeHourKey =               @"snoozeTimeHour";
@@ -28,8 +34,8 @@ static NSString *const kSLSkipSecondKey =               @"skipTimeSecond";
 static NSString *const kSLSkipActivatedStatusKey =      @"skipActivatedStatus";
 static NSString *const kSLSkipDatesKey =                @"skipDates";
 static NSString *const kSLHolidaySkipDatesKey =         @"holidaySkipDates";
-static NSString *const kSLCustomSkipDatesKey =          @"customSkipDates";
 static NSString *const kSLCustomSkipDateStringsKey =    @"customSkipDateStrings";
+static NSString *const kSLSkipRulesKey =                @"skipRules";
 static NSString *const kSLHolidayHolidaysKey =          @"holidays";
 static NSString *const kSLHolidayNameKey =              @"name";
 static NSString *const kSLHolidayDatesKey =             @"dates";
@@ -37,6 +43,32 @@ static NSString *const kSLAutoSetOptionKey =            @"autoSetOption";
 static NSString *const kSLAutoSetOffsetOptionKey =      @"autoSetOffsetOption";
 static NSString *const kSLAutoSetOffsetHourKey =        @"autoSetOffsetHour";
 static NSString *const kSLAutoSetOffsetMinuteKey =      @"autoSetOffsetMinute";
+static NSString *const kSLSkipProfilesKey =             @"skipProfiles";
+static NSString *const kSLSkipProfileIdKey =            @"skipProfileId";
+static NSString *const kSLSkipProfileNameKey =          @"name";
+
+// keys for each of the recurring skip rules, along with the possible values for the type of rule
+static NSString *const kSLSkipRuleTypeKey =             @"type";
+static NSString *const kSLSkipRuleNameKey =             @"name";
+static NSString *const kSLSkipRuleStartDateKey =        @"startDate";
+static NSString *const kSLSkipRuleEndDateKey =          @"endDate";
+static NSString *const kSLSkipRuleIntervalKey =         @"interval";
+static NSString *const kSLSkipRuleWeekdaysKey =         @"weekdays";
+static NSString *const kSLSkipRuleWeekdayKey =          @"weekday";
+static NSString *const kSLSkipRuleOrdinalKey =          @"ordinal";
+static NSString *const kSLSkipRuleExceptionsKey =       @"exceptions";
+static NSString *const kSLSkipRuleTypeWeeklyString =    @"weekly";
+static NSString *const kSLSkipRuleTypeNthWeekdayString = @"nthWeekday";
+static NSString *const kSLSkipRuleTypeDateRangeString = @"dateRange";
+
+// keys for the results that are returned when performing maintenance on the preferences
+static NSString *const kSLMaintenanceRemovedAlarmsKey =         @"removedAlarms";
+static NSString *const kSLMaintenanceRemovedSkipDatesKey =      @"removedSkipDates";
+static NSString *const kSLMaintenanceRemovedSkipProfilesKey =   @"removedSkipProfiles";
+static NSString *const kSLMaintenanceReclaimedBytesKey =        @"reclaimedBytes";
+
+// the legacy key for the custom skip dates that were stored as dates before Sleeper 6.0.4 (only read when migrating to version 2)
+static NSString *const kSLCustomSkipDatesKey =          @"customSkipDates";
 
 // define the key that will be used in the notification sent to observers when auto-set alarms are updated
 static NSString *const kSLUpdatedAutoSetAlarmNotificationKey = @"updatedAutoSetAlarm";
@@ -49,15 +81,38 @@ static NSString *const kSLUpdatedAutoSetAlarmNotificationKey = @"updatedAutoSetA
 // returns the date formatter for converting to and from saving to the plist
 + (NSDateFormatter *)plistDateFormatter;
 
-// Return an SLAlarmPrefs object with alarm information for a given alarm Id.  Return nil if no alarm is found.
+// Returns the skip date string (as it is stored in the preferences) for the given day number.  The strings that are compared with the
+// stored skip dates are built from day numbers, so they always agree with the days that the skip decisions are made for.
++ (NSString *)skipDateStringForDay:(SLDay)day;
+
+// returns the date at the start of the day of the given skip date string, or nil if the string is not a valid date
++ (NSDate *)dateForSkipDateString:(NSString *)skipDateString;
+
+// Returns a copy of the given preferences that has been migrated to the current schema version (or the same preferences if they are
+// already current).  Any legacy keys are rewritten in the current format so that readers can ignore them.  This does not depend on the
+// preferences file (only the holiday resources in the bundle), so it can be run against any preferences that are loaded from a file.  The
+// preferences file itself is migrated lazily on the I/O queue the first time that it is loaded with an older schema.
++ (NSDictionary *)migratedPrefsForPrefs:(NSDictionary *)prefs;
+
+// Return an SLAlarmPrefs object with alarm information for a given alarm Id.  Return nil if no alarm is found.  Alarms that use a skip
+// profile are returned with the skip dates of the profile.
 + (SLAlarmPrefs *)alarmPrefsForAlarmId:(NSString *)alarmId;
 
 // returns whether or not the preferences file contains preferences for an alarm with the given alarm Id
 + (BOOL)prefsContainAlarmWithAlarmId:(NSString *)alarmId;
 
-// save the specific alarm preferences object
+// Save the specific alarm preferences object.  If the alarm uses a skip profile, the skip dates are saved to the profile (updating every
+// alarm that uses the profile) instead of the alarm.
 + (void)saveAlarmPrefs:(SLAlarmPrefs *)alarmPrefs;
 
+// Saves the specific alarm preferences object asynchronously.  The saved preferences are immediately available to readers in this process,
+// while the write to the file system is coalesced with any other saves and performed on a background queue.  The optional completion
+// is invoked on the main queue once the preferences have been written.
++ (void)saveAlarmPrefs:(SLAlarmPrefs *)alarmPrefs completion:(void (^)(BOOL success))completion;
+
+// writes any pending modifications to the preferences file immediately, blocking until the write has completed
++ (void)synchronizePrefs;
+
 // save the skip activation status for a given alarm
 + (void)setSkipActivatedStatusForAlarmId:(NSString *)alarmId
                      skipActivatedStatus:(SLSkipActivatedStatus)skipActivatedStatus;
@@ -65,17 +120,52 @@ static NSString *const kSLUpdatedAutoSetAlarmNotificationKey = @"updatedAutoSetA
 // delete an alarm from our settings
 + (void)deleteAlarmForAlarmId:(NSString *)alarmId;
 
+// returns the alarm Ids for all of the alarms that are contained in the preferences file
++ (NSArray *)allAlarmIds;
+
+// Removes the alarms with the given alarm Ids from the preferences file in a single pass, along with any custom skip dates that have
+// passed, any skip rules that have ended, any empty holiday selections, and any skip profiles that are no longer used by an alarm.
+// Returns a dictionary with the number of records removed and the bytes reclaimed.
++ (NSDictionary *)performMaintenanceRemovingAlarmIds:(NSSet *)alarmIds;
+
+// builds the holiday index ahead of time for the holiday countries that are selected by any alarm or skip profile
++ (void)prebuildHolidayIndex;
+
+// returns all of the skip profiles (dictionaries containing the Id, name, and skip dates of each profile) sorted by name
++ (NSArray *)allSkipProfiles;
+
+// Creates a new skip profile with the given name and skip dates, returning the Id of the new profile.  Alarms are linked to the profile
+// by saving their preferences with the Id of the profile.
++ (NSString *)createSkipProfileWithName:(NSString *)name
+                        customSkipDates:(NSArray *)customSkipDates
+                       holidaySkipDates:(NSDictionary *)holidaySkipDates
+                              skipRules:(NSArray *)skipRules;
+
+// Returns the skip decision for the given skip profile and day that was made by any alarm that was loaded from the given generation of the
+// preferences, or nil if no decision has been made yet.  This allows a skip profile to be evaluated once per day for all of its alarms.
++ (NSNumber *)skipDecisionForSkipProfileId:(NSString *)skipProfileId onDay:(SLDay)day prefsGeneration:(NSUInteger)prefsGeneration;
+
+// saves the skip decision for the given skip profile and day, which is discarded if the preferences have changed since the given generation
++ (void)setSkipDecision:(BOOL)shouldSkip forSkipProfileId:(NSString *)skipProfileId onDay:(SLDay)day prefsGeneration:(NSUInteger)prefsGeneration;
+
+// Returns whether or not any alarm in the preferences uses an auto-set option.  This is summarized once for each generation of the
+// preferences, so it is cheap to call repeatedly.
++ (BOOL)hasAutoSetAlarms;
+
 // Provides the caller with a dictionary containing all of the auto-set alarms using the auto-set option as the key for the dictionary.
 // The value for each key will be an array containing dictionaries with the alarm information.
 // Returns nil when no auto-set alarms exist.
 + (NSDictionary *)allAutoSetAlarms;
 
 // Returns a dictionary that corresponds to the default holiday source for the given holiday resource name.
-// This function will also remove any passed dates.
+// This function will only include the upcoming dates for each holiday, evaluated from the compiled holiday rules.
 + (NSDictionary *)holidayResourceForResourceName:(NSString *)resourceName;
 
-// Returns the first available skip date for the given holiday name and country.  This function will not take into consideration any passed dates.
-+ (NSDate *)firstSkipDateForHolidayName:(NSString *)holidayName inHolidayCountry:(SLHolidayCountry)holidayCountry;
+// Returns the first available skip date for any of the holidays in the given selection for a country, along with the name of that holiday.
+// This function will not take into consideration any passed dates.
++ (NSDate *)firstSkipDateForHolidaySelection:(SLHolidaySelection)holidaySelection
+                            inHolidayCountry:(SLHolidayCountry)holidayCountry
+                                 holidayName:(NSString **)holidayName;
 
 // returns a corresponding country code for any given country
 + (NSString *)countryCodeForHolidayCountry:(SLHolidayCountry)country;
@@ -86,15 +176,25 @@ static NSString *const kSLUpdatedAutoSetAlarmNotificationKey = @"updatedAutoSetA
 // returns a string that corresponds to the resource name for a given country code
 + (NSString *)resourceNameForCountryCode:(NSString *)countryCode;
 
-// returns the localized, friendly name to be displayed for the given country
+// returns the localized, friendly name to be displayed for the given country (or subdivision, which is displayed along with its country)
 + (NSString *)friendlyNameForHolidayCountry:(SLHolidayCountry)country;
 
+// returns the name to be displayed for the given skip rule, which is either the name given to the rule or a description of the rule
++ (NSString *)friendlyNameForSkipRule:(NSDictionary *)skipRule;
+
 // returns the localized, friendly name to be displayed for an auto-set option
 + (NSString *)friendlyNameForAutoSetOption:(SLAutoSetOption)autoSetOption;
 
 // returns the localized, friendly name to be displayed for an auto-set offset option
 + (NSString *)friendlyNameForAutoSetOffsetOption:(SLAutoSetOffsetOption)autoSetOffsetOption;
 
+// Merges the all-day events from the iCalendar (.ics) file at the given path into the given sorted custom skip date strings in a single
+// pass.  Only the events from today through the import limit are included and recurring events are expanded.  Returns the merged and
+// sorted skip date strings (with the number of new dates that were added), or nil if the file could not be imported.
++ (NSArray *)customSkipDateStrings:(NSArray *)customSkipDateStrings
+     byImportingCalendarFileAtPath:(NSString *)path
+                  numImportedDates:(NSInteger *)numImportedDates;
+
 // Returns a string that represents a date that is going to be skipped.  If showRelativeString is enabled,
 // a relative string is shown instead (i.e. Today, Tomorrow)
 + (NSString *)skipDateStringForDate:(NSDate *)date showRelativeString:(BOOL)showRelativeString;
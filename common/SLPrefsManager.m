@@ -7,18 +7,145 @@
 //
 
 #import <Foundation/Foundation.h>
-#import <Foundation/NSDistributedNotificationCenter.h>
+#import <sys/stat.h>
+#import <sys/file.h>
+#import <fcntl.h>
 #import "SLPrefsManager.h"
 #import "SLLocalizedStrings.h"
 #import "SLAutoSetManager.h"
+#import "SLHolidayManager.h"
+#import "SLCalendarImport.h"
+#import "SLSkipRules.h"
+#import "SLPrefsReader.h"
+#import "SLClock.h"
+#import "SLAccounting.h"
+
+// the directory that contains the preferences
+#define kSLSettingsDirectoryPath    [NSHomeDirectory() stringByAppendingPathComponent:@"/Library/Preferences"]
 
 // the path of our settings that is used to store the alarm snooze times
-#define kSLSettingsFile         [NSHomeDirectory() stringByAppendingPathComponent:@"/Library/Preferences/com.joshuaseltzer.sleeper.plist"]
+#define kSLSettingsFile         [kSLSettingsDirectoryPath stringByAppendingPathComponent:@"com.joshuaseltzer.sleeper.plist"]
+
+// the path of the lock file that is held while the preferences file is written or migrated to the current schema version
+#define kSLSettingsLockFile     [kSLSettingsDirectoryPath stringByAppendingPathComponent:@"com.joshuaseltzer.sleeper.lock"]
+
+// the number of seconds that modifications to the preferences are held before being written, so that back-to-back saves are coalesced
+#define kSLPrefsWriteCoalesceInterval   0.25
 
 // keep a single, static instances of the date formatters that will be used to convert date objects to strings and vice versa
 static NSDateFormatter *sSLSkipDatesUIDateFormatter;
 static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
 
+// The in-memory copy of the preferences, which is shared by every reader and writer in the process.  The state is only accessed on
+// the state queue, while the preferences are written to the file system on the serial I/O queue.
+static NSDictionary *sSLPrefsCache;
+static struct timespec sSLPrefsCacheModificationTime;
+static BOOL sSLPrefsCacheLoaded;
+static BOOL sSLPrefsCacheNeedsMigration;
+static BOOL sSLPrefsMigrationScheduled;
+static BOOL sSLPrefsDirty;
+static BOOL sSLPrefsWriting;
+static BOOL sSLPrefsWriteScheduled;
+static NSMutableArray *sSLPrefsWriteCompletions;
+
+// The preferences that the pending modifications were first applied to (i.e. the preferences in the file before the write), which are
+// passed to the write completions along with the preferences that were written.
+static NSDictionary *sSLPrefsWriteBase;
+
+// The modifications that were applied to the in-memory copy since it was last written.  If another process writes the file in the
+// meantime, these are applied again to the contents of the file when writing so that the modifications of the other process are kept.
+static NSMutableArray *sSLPrefsPendingModifications;
+
+// The generation of the in-memory copy of the preferences, which changes every time the preferences are loaded or modified, along with
+// the skip decisions that were made for each skip profile for the current generation.  The decisions are keyed by the skip profile Id,
+// where each profile has its own dictionary of decisions keyed by the day (which is a tagged pointer number, so a lookup does not
+// allocate).  These are also only accessed on the state queue.
+static NSUInteger sSLPrefsGeneration = 1;
+static NSMutableDictionary *sSLSkipProfileDecisions;
+
+// A summary of whether or not any alarm uses an auto-set option, along with the generation of the preferences that it was computed from.
+// This lets the auto-set manager decide whether or not it needs to start without collecting every auto-set alarm.
+static NSUInteger sSLAutoSetSummaryGeneration = 0;
+static BOOL sSLAutoSetSummaryHasAlarms = NO;
+
+// Returns a copy of the given skip dates with any custom skip dates that have passed, any skip rules that have ended, and any empty holiday
+// selections removed.  The number of records that were removed is added to the given count.
+static NSDictionary *SLMaintainedSkipDates(NSDictionary *skipDates, NSString *todayString, NSInteger *removedSkipDates)
+{
+    // only keep the custom skip dates that have not passed
+    NSArray *customSkipDateStrings = [skipDates objectForKey:kSLCustomSkipDateStringsKey];
+    NSMutableArray *customSkipDates = [[NSMutableArray alloc] initWithCapacity:customSkipDateStrings.count];
+    for (NSString *skipDateString in customSkipDateStrings) {
+        if ([skipDateString compare:todayString] != NSOrderedAscending) {
+            [customSkipDates addObject:skipDateString];
+        }
+    }
+    *removedSkipDates = *removedSkipDates + customSkipDateStrings.count - customSkipDates.count;
+
+    // remove any holiday countries which do not have any selected holidays
+    NSDictionary *holidaySkipDates = [skipDates objectForKey:kSLHolidaySkipDatesKey];
+    NSMutableDictionary *maintainedHolidaySkipDates = [[NSMutableDictionary alloc] initWithCapacity:holidaySkipDates.count];
+    for (NSString *resourceName in holidaySkipDates) {
+        NSNumber *holidaySelection = [holidaySkipDates objectForKey:resourceName];
+        if ([holidaySelection unsignedLongLongValue] != 0) {
+            [maintainedHolidaySkipDates setObject:holidaySelection forKey:resourceName];
+        } else {
+            ++(*removedSkipDates);
+        }
+    }
+
+    // remove any skip rules that have ended (the end date of a rule is stored in the same format as the custom skip dates)
+    NSArray *skipRules = [skipDates objectForKey:kSLSkipRulesKey];
+    NSMutableArray *maintainedSkipRules = [[NSMutableArray alloc] initWithCapacity:skipRules.count];
+    for (NSDictionary *skipRule in skipRules) {
+        NSString *endDateString = [skipRule objectForKey:kSLSkipRuleEndDateKey];
+        if (endDateString == nil || [endDateString compare:todayString] != NSOrderedAscending) {
+            [maintainedSkipRules addObject:skipRule];
+        }
+    }
+    *removedSkipDates = *removedSkipDates + skipRules.count - maintainedSkipRules.count;
+
+    return @{kSLCustomSkipDateStringsKey:[customSkipDates copy], kSLHolidaySkipDatesKey:[maintainedHolidaySkipDates copy],
+             kSLSkipRulesKey:[maintainedSkipRules copy]};
+}
+
+// returns the skip profile with the given Id from the given preferences, or nil if the profile does not exist
+static NSDictionary *SLSkipProfileForId(NSDictionary *prefs, NSString *skipProfileId)
+{
+    if (skipProfileId != nil) {
+        for (NSDictionary *skipProfile in [prefs objectForKey:kSLSkipProfilesKey]) {
+            if ([[skipProfile objectForKey:kSLSkipProfileIdKey] isEqualToString:skipProfileId]) {
+                return skipProfile;
+            }
+        }
+    }
+    return nil;
+}
+
+// returns the values that affect the time of the auto-set alarm with the given Id in the given preferences (all off if there is no alarm)
+static NSArray *SLAutoSetOptionsForAlarmId(NSDictionary *prefs, NSString *alarmId)
+{
+    NSDictionary *alarm = nil;
+    for (NSDictionary *prefsAlarm in [prefs objectForKey:kSLAlarmsKey]) {
+        if ([[prefsAlarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
+            alarm = prefsAlarm;
+            break;
+        }
+    }
+    return @[[alarm objectForKey:kSLAutoSetOptionKey] ?: @(kSLAutoSetOptionOff),
+             [alarm objectForKey:kSLAutoSetOffsetOptionKey] ?: @(kSLAutoSetOffsetOptionOff),
+             [alarm objectForKey:kSLAutoSetOffsetHourKey] ?: @0,
+             [alarm objectForKey:kSLAutoSetOffsetMinuteKey] ?: @0];
+}
+
+// returns the skip date string (as it is stored in the preferences) for the given day number
+static NSString *SLSkipDateStringForDay(SLDay day)
+{
+    int32_t year, month, dayOfMonth;
+    SLCivilFromDay(day, &year, &month, &dayOfMonth);
+    return [[NSString alloc] initWithFormat:@"%04d-%02d-%02d", year, month, dayOfMonth];
+}
+
 @implementation SLPrefsManager
 
 // returns the date formatter for displaying dates within the UI
@@ -42,14 +169,495 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
         sSLSkipDatesPlistDateFormatter.dateFormat = @"yyyy-MM-dd";
         sSLSkipDatesPlistDateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
     }
+
+    // The date strings are days in the calendar of the clock, so the calendar and time zone are taken again on every call to follow any
+    // time zone change of the device.  They are only replaced when they differ, since replacing them resets the formatter.
+    NSCalendar *calendar = [SLClock calendar];
+    if (![sSLSkipDatesPlistDateFormatter.calendar isEqual:calendar]) {
+        sSLSkipDatesPlistDateFormatter.calendar = calendar;
+    }
+    if (![sSLSkipDatesPlistDateFormatter.timeZone isEqual:calendar.timeZone]) {
+        sSLSkipDatesPlistDateFormatter.timeZone = calendar.timeZone;
+    }
     return sSLSkipDatesPlistDateFormatter;
 }
 
-// Return an SLAlarmPrefs object with alarm information for a given alarm Id.  Return nil if no alarm is found.
+// returns the skip date string (as it is stored in the preferences) for the given day number
++ (NSString *)skipDateStringForDay:(SLDay)day
+{
+    return SLSkipDateStringForDay(day);
+}
+
+// returns the date at the start of the day of the given skip date string, or nil if the string is not a valid date
++ (NSDate *)dateForSkipDateString:(NSString *)skipDateString
+{
+    SLDay day;
+    if (![skipDateString isKindOfClass:[NSString class]] || !SLSkipRuleParseDateString([skipDateString UTF8String], &day)) {
+        return nil;
+    }
+    return [SLHolidayManager dateForDay:day];
+}
+
+// returns the serial queue that guards the in-memory copy of the preferences
++ (dispatch_queue_t)prefsStateQueue
+{
+    static dispatch_once_t pred;
+    static dispatch_queue_t sSLPrefsStateQueue = nil;
+    dispatch_once(&pred, ^{
+        sSLPrefsStateQueue = dispatch_queue_create("com.joshuaseltzer.sleeper.prefs.state", DISPATCH_QUEUE_SERIAL);
+        sSLPrefsWriteCompletions = [[NSMutableArray alloc] init];
+        sSLPrefsPendingModifications = [[NSMutableArray alloc] init];
+        sSLSkipProfileDecisions = [[NSMutableDictionary alloc] init];
+    });
+    return sSLPrefsStateQueue;
+}
+
+// returns the serial queue that is used to write the preferences to the file system
++ (dispatch_queue_t)prefsIOQueue
+{
+    static dispatch_once_t pred;
+    static dispatch_queue_t sSLPrefsIOQueue = nil;
+    dispatch_once(&pred, ^{
+        sSLPrefsIOQueue = dispatch_queue_create("com.joshuaseltzer.sleeper.prefs.io", DISPATCH_QUEUE_SERIAL);
+    });
+    return sSLPrefsIOQueue;
+}
+
+// returns the modification time of the preferences file, or a zero time if the file does not exist
+static struct timespec SLPrefsFileModificationTime(void)
+{
+    struct stat fileStat;
+    if (stat([kSLSettingsFile fileSystemRepresentation], &fileStat) == 0) {
+        return fileStat.st_mtimespec;
+    }
+    struct timespec noTime = {0, 0};
+    return noTime;
+}
+
+// returns whether or not the two given modification times are the same
+static BOOL SLPrefsModificationTimesEqual(struct timespec modificationTime, struct timespec otherModificationTime)
+{
+    return modificationTime.tv_sec == otherModificationTime.tv_sec && modificationTime.tv_nsec == otherModificationTime.tv_nsec;
+}
+
+// returns the preferences that are stored in the file, or nil if the file does not exist or can not be read
+static NSDictionary *SLReadPrefsFile(void)
+{
+    NSData *prefsData = [[NSData alloc] initWithContentsOfFile:kSLSettingsFile];
+    SLAccountingRecord(kSLAccountingMetricFileOpens, 1);
+    SLAccountingRecord(kSLAccountingMetricBytesRead, prefsData.length);
+    if (prefsData != nil) {
+        id prefs = [NSPropertyListSerialization propertyListWithData:prefsData options:NSPropertyListImmutable format:NULL error:NULL];
+        SLAccountingRecord(kSLAccountingMetricPrefsParses, 1);
+        if ([prefs isKindOfClass:[NSDictionary class]]) {
+            return prefs;
+        }
+    }
+    return nil;
+}
+
+// Takes the lock that is shared by every process that writes the preferences file, returning the descriptor of the lock file (or -1 if
+// the lock file could not be opened, in which case the file is written without the lock).
+static int SLPrefsLock(void)
+{
+    int lockFile = open([kSLSettingsLockFile fileSystemRepresentation], O_RDWR | O_CREAT, 0644);
+    if (lockFile >= 0) {
+        flock(lockFile, LOCK_EX);
+    }
+    return lockFile;
+}
+
+// releases the lock that was taken with SLPrefsLock
+static void SLPrefsUnlock(int lockFile)
+{
+    if (lockFile >= 0) {
+        flock(lockFile, LOCK_UN);
+        close(lockFile);
+    }
+}
+
+// Invalidates any state that was derived from the in-memory copy of the preferences.  This must be called on the state queue whenever the
+// in-memory copy is replaced.
+static void SLPrefsCacheDidChange(void)
+{
+    ++sSLPrefsGeneration;
+    [sSLSkipProfileDecisions removeAllObjects];
+}
+
+// Returns whether or not the in-memory copy of the preferences needs to be loaded from the file (either because it was never loaded or
+// because the file was modified by another process), along with the modification time of the file.  This must be called on the state queue.
+static BOOL SLPrefsCacheNeedsReload(struct timespec *modificationTime)
+{
+    if (sSLPrefsDirty || sSLPrefsWriting) {
+        return NO;
+    }
+    *modificationTime = SLPrefsFileModificationTime();
+    return !sSLPrefsCacheLoaded || !SLPrefsModificationTimesEqual(*modificationTime, sSLPrefsCacheModificationTime);
+}
+
+// Reloads the in-memory copy of the preferences if the file was modified by another process.  Modifications that have not been written
+// yet are never replaced (read-your-writes).  This must be called on the state queue.
+static void SLReloadPrefsCacheIfNeeded(void)
+{
+    struct timespec modificationTime;
+    if (SLPrefsCacheNeedsReload(&modificationTime)) {
+        sSLPrefsCache = SLReadPrefsFile();
+        sSLPrefsCacheModificationTime = modificationTime;
+
+        // a file that has not been migrated yet is migrated in memory so that readers only ever see the current schema
+        sSLPrefsCacheNeedsMigration = sSLPrefsCache != nil && [[sSLPrefsCache objectForKey:kSLSchemaVersionKey] integerValue] < kSLPrefsSchemaVersion;
+        if (sSLPrefsCacheNeedsMigration) {
+            sSLPrefsCache = [SLPrefsManager migratedPrefsForPrefs:sSLPrefsCache];
+
+            // the file itself is migrated lazily on the I/O queue the first time that an older schema is loaded
+            if (!sSLPrefsMigrationScheduled) {
+                sSLPrefsMigrationScheduled = YES;
+                dispatch_async([SLPrefsManager prefsIOQueue], ^(void) {
+                    [SLPrefsManager migratePrefsFile];
+                });
+            }
+        }
+        sSLPrefsCacheLoaded = YES;
+        SLPrefsCacheDidChange();
+    }
+}
+
+// returns the in-memory copy of the preferences, or nil if no preferences exist
++ (NSDictionary *)cachedPrefs
+{
+    return [SLPrefsManager cachedPrefsWithGeneration:NULL];
+}
+
+// returns the in-memory copy of the preferences (or nil if no preferences exist) along with the generation of the preferences
++ (NSDictionary *)cachedPrefsWithGeneration:(NSUInteger *)generation
+{
+    __block NSDictionary *prefs = nil;
+    __block NSUInteger prefsGeneration = 0;
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        SLReloadPrefsCacheIfNeeded();
+        prefs = sSLPrefsCache;
+        prefsGeneration = sSLPrefsGeneration;
+    });
+    if (generation != NULL) {
+        *generation = prefsGeneration;
+    }
+    return prefs;
+}
+
+// Modifies the preferences with the given block, which is passed a mutable copy of the preferences (including any nested containers).
+// If the block returns YES, the in-memory copy is updated immediately and a coalesced write is scheduled on the I/O queue.  The optional
+// completion is invoked on the main queue once the modification has been written, along with the preferences in the file before the
+// write and the final preferences that were written (which include the modifications of any other process).  The block might be invoked
+// again when writing if another process modified the file in the meantime, so it should only depend on the preferences that it is passed.
++ (void)modifyPrefsWithBlock:(BOOL (^)(NSMutableDictionary *prefs))block
+                  completion:(void (^)(BOOL success, NSDictionary *previousPrefs, NSDictionary *writtenPrefs))completion
+{
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        SLReloadPrefsCacheIfNeeded();
+        NSMutableDictionary *prefs = nil;
+        if (sSLPrefsCache != nil) {
+            prefs = (__bridge_transfer NSMutableDictionary *)CFPropertyListCreateDeepCopy(kCFAllocatorDefault, (__bridge CFPropertyListRef)sSLPrefsCache, kCFPropertyListMutableContainers);
+        } else {
+            prefs = [[NSMutableDictionary alloc] initWithObjectsAndKeys:[NSNumber numberWithInteger:kSLPrefsSchemaVersion], kSLSchemaVersionKey, nil];
+        }
+
+        if (block(prefs)) {
+            if (!sSLPrefsDirty) {
+                sSLPrefsWriteBase = sSLPrefsCache;
+            }
+            sSLPrefsCache = (__bridge_transfer NSDictionary *)CFPropertyListCreateDeepCopy(kCFAllocatorDefault, (__bridge CFPropertyListRef)prefs, kCFPropertyListImmutable);
+            sSLPrefsDirty = YES;
+            [sSLPrefsPendingModifications addObject:[block copy]];
+            SLPrefsCacheDidChange();
+            if (completion != nil) {
+                [sSLPrefsWriteCompletions addObject:[completion copy]];
+            }
+
+            // schedule a single write for any modifications that are made within the coalesce interval
+            if (!sSLPrefsWriteScheduled) {
+                sSLPrefsWriteScheduled = YES;
+                dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kSLPrefsWriteCoalesceInterval * NSEC_PER_SEC));
+                dispatch_after(popTime, [SLPrefsManager prefsIOQueue], ^(void) {
+                    [SLPrefsManager writePendingPrefs];
+                });
+            }
+        } else if (completion != nil) {
+            NSDictionary *unmodifiedPrefs = sSLPrefsCache;
+            dispatch_async(dispatch_get_main_queue(), ^(void) {
+                completion(YES, unmodifiedPrefs, unmodifiedPrefs);
+            });
+        }
+    });
+}
+
+// Returns the given preferences from the file with the given modifications applied to them in order, which is used when the file was
+// modified by another process since the in-memory copy was loaded.  The migrated preferences from the file are also returned.
+static NSDictionary *SLPrefsByApplyingModifications(NSDictionary *filePrefs, NSArray *modifications, NSDictionary **migratedFilePrefs)
+{
+    NSMutableDictionary *prefs = nil;
+    if (filePrefs != nil) {
+        filePrefs = [SLPrefsManager migratedPrefsForPrefs:filePrefs];
+        *migratedFilePrefs = filePrefs;
+        prefs = (__bridge_transfer NSMutableDictionary *)CFPropertyListCreateDeepCopy(kCFAllocatorDefault, (__bridge CFPropertyListRef)filePrefs, kCFPropertyListMutableContainers);
+    } else {
+        prefs = [[NSMutableDictionary alloc] initWithObjectsAndKeys:[NSNumber numberWithInteger:kSLPrefsSchemaVersion], kSLSchemaVersionKey, nil];
+    }
+    for (BOOL (^modification)(NSMutableDictionary *prefs) in modifications) {
+        modification(prefs);
+    }
+    return (__bridge_transfer NSDictionary *)CFPropertyListCreateDeepCopy(kCFAllocatorDefault, (__bridge CFPropertyListRef)prefs, kCFPropertyListImmutable);
+}
+
+// Writes any pending modifications to the preferences file (this must be called on the I/O queue).  The file is written under the same
+// lock that is used for the migration, and if another process wrote the file since the in-memory copy was loaded, the pending
+// modifications are applied to the contents of the file instead of overwriting them.
++ (void)writePendingPrefs
+{
+    __block NSDictionary *prefs = nil;
+    __block NSDictionary *previousPrefs = nil;
+    __block NSArray *modifications = nil;
+    __block struct timespec cacheModificationTime;
+    __block NSArray *completions = nil;
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        if (sSLPrefsDirty) {
+            prefs = sSLPrefsCache;
+            previousPrefs = sSLPrefsWriteBase;
+            sSLPrefsWriteBase = nil;
+            modifications = [sSLPrefsPendingModifications copy];
+            [sSLPrefsPendingModifications removeAllObjects];
+            cacheModificationTime = sSLPrefsCacheModificationTime;
+            sSLPrefsDirty = NO;
+            sSLPrefsWriting = YES;
+        }
+        sSLPrefsWriteScheduled = NO;
+        completions = [sSLPrefsWriteCompletions copy];
+        [sSLPrefsWriteCompletions removeAllObjects];
+    });
+
+    BOOL success = YES;
+    if (prefs != nil) {
+        int lockFile = SLPrefsLock();
+        BOOL fileChanged = !SLPrefsModificationTimesEqual(SLPrefsFileModificationTime(), cacheModificationTime);
+        if (fileChanged) {
+            previousPrefs = nil;
+            prefs = SLPrefsByApplyingModifications(SLReadPrefsFile(), modifications, &previousPrefs);
+        }
+        success = [prefs writeToFile:kSLSettingsFile atomically:YES];
+        struct timespec modificationTime = SLPrefsFileModificationTime();
+
+        // Adopt what was written and remember the modification time of our own write so that it is not needlessly reloaded.  If more
+        // modifications were made while writing, the in-memory copy is kept and the next write applies them to the file.
+        dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+            sSLPrefsWriting = NO;
+            if (!sSLPrefsDirty) {
+                if (fileChanged) {
+                    sSLPrefsCache = prefs;
+                    sSLPrefsCacheNeedsMigration = NO;
+                    SLPrefsCacheDidChange();
+                }
+                sSLPrefsCacheModificationTime = modificationTime;
+            }
+        });
+        SLPrefsUnlock(lockFile);
+    }
+
+    if (completions.count > 0) {
+        dispatch_async(dispatch_get_main_queue(), ^(void) {
+            for (void (^completion)(BOOL success, NSDictionary *previousPrefs, NSDictionary *writtenPrefs) in completions) {
+                completion(success, previousPrefs, prefs);
+            }
+        });
+    }
+}
+
+// writes any pending modifications to the preferences file immediately, blocking until the write has completed
++ (void)synchronizePrefs
+{
+    dispatch_sync([SLPrefsManager prefsIOQueue], ^{
+        [SLPrefsManager writePendingPrefs];
+    });
+}
+
+// Returns a copy of the given preferences that has been migrated to the current schema version.  This does not depend on the file system
+// or any state of the device (other than the holiday resources in the bundle), so that the migrations can be run against any preferences
+// that are loaded from a file.
++ (NSDictionary *)migratedPrefsForPrefs:(NSDictionary *)prefs
+{
+    NSInteger schemaVersion = [[prefs objectForKey:kSLSchemaVersionKey] integerValue];
+    if (prefs == nil || schemaVersion >= kSLPrefsSchemaVersion) {
+        return prefs;
+    }
+    NSMutableDictionary *migratedPrefs = (__bridge_transfer NSMutableDictionary *)CFPropertyListCreateDeepCopy(kCFAllocatorDefault, (__bridge CFPropertyListRef)prefs, kCFPropertyListMutableContainers);
+
+    // Version 2: As of Sleeper 6.0.4, custom skip dates are stored as strings instead of dates.  Convert any dates that are stored with the
+    // legacy key into strings and store the custom skip date strings sorted and without duplicates, which the readers rely on.
+    if (schemaVersion < 2) {
+        for (NSMutableDictionary *alarm in [migratedPrefs objectForKey:kSLAlarmsKey]) {
+            NSMutableDictionary *skipDates = [alarm isKindOfClass:[NSDictionary class]] ? [alarm objectForKey:kSLSkipDatesKey] : nil;
+            if (![skipDates isKindOfClass:[NSDictionary class]]) {
+                continue;
+            }
+
+            NSMutableSet *customSkipDates = [[NSMutableSet alloc] init];
+            for (id skipDateString in [skipDates objectForKey:kSLCustomSkipDateStringsKey]) {
+                if ([skipDateString isKindOfClass:[NSString class]]) {
+                    [customSkipDates addObject:skipDateString];
+                }
+            }
+            for (id skipDate in [skipDates objectForKey:kSLCustomSkipDatesKey]) {
+                if ([skipDate isKindOfClass:[NSDate class]]) {
+                    [customSkipDates addObject:[[SLPrefsManager plistDateFormatter] stringFromDate:skipDate]];
+                }
+            }
+            [skipDates setObject:[[customSkipDates allObjects] sortedArrayUsingSelector:@selector(compare:)] forKey:kSLCustomSkipDateStringsKey];
+            [skipDates removeObjectForKey:kSLCustomSkipDatesKey];
+        }
+    }
+
+    // Version 3: Holidays are selected by the stable IDs that are assigned when generating the holiday resources instead of by name, so
+    // that renaming a holiday does not lose the selection.  Convert the arrays of selected holiday names into a set of IDs per country.
+    if (schemaVersion < 3) {
+        for (NSMutableDictionary *alarm in [migratedPrefs objectForKey:kSLAlarmsKey]) {
+            NSMutableDictionary *skipDates = [alarm isKindOfClass:[NSDictionary class]] ? [alarm objectForKey:kSLSkipDatesKey] : nil;
+            NSDictionary *holidaySkipDates = [skipDates isKindOfClass:[NSDictionary class]] ? [skipDates objectForKey:kSLHolidaySkipDatesKey] : nil;
+            if (![holidaySkipDates isKindOfClass:[NSDictionary class]]) {
+                continue;
+            }
+
+            NSMutableDictionary *holidaySelections = [[NSMutableDictionary alloc] initWithCapacity:holidaySkipDates.count];
+            for (NSString *resourceName in holidaySkipDates) {
+                id selectedHolidays = [holidaySkipDates objectForKey:resourceName];
+                SLHolidaySelection holidaySelection = 0;
+                if ([selectedHolidays isKindOfClass:[NSArray class]]) {
+                    holidaySelection = [[SLHolidayManager sharedInstance] holidaySelectionForHolidayNames:selectedHolidays inResourceName:resourceName];
+                } else if ([selectedHolidays isKindOfClass:[NSNumber class]]) {
+                    holidaySelection = [selectedHolidays unsignedLongLongValue];
+                }
+                if (holidaySelection != 0) {
+                    [holidaySelections setObject:[NSNumber numberWithUnsignedLongLong:holidaySelection] forKey:resourceName];
+                }
+            }
+            [skipDates setObject:holidaySelections forKey:kSLHolidaySkipDatesKey];
+        }
+    }
+
+    [migratedPrefs setObject:[NSNumber numberWithInteger:kSLPrefsSchemaVersion] forKey:kSLSchemaVersionKey];
+    return (__bridge_transfer NSDictionary *)CFPropertyListCreateDeepCopy(kCFAllocatorDefault, (__bridge CFPropertyListRef)migratedPrefs, kCFPropertyListImmutable);
+}
+
+// Migrates the preferences file to the current schema version if needed (this must be called on the I/O queue).  The migration is
+// performed under a file lock so that only one of the processes that load the tweak rewrites the file.
++ (void)migratePrefsFile
+{
+    int lockFile = SLPrefsLock();
+
+    // another process might have already migrated the file while this process was waiting for the lock
+    NSDictionary *filePrefs = [[NSDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
+    if (filePrefs != nil && [[filePrefs objectForKey:kSLSchemaVersionKey] integerValue] < kSLPrefsSchemaVersion) {
+        [[SLPrefsManager migratedPrefsForPrefs:filePrefs] writeToFile:kSLSettingsFile atomically:YES];
+    }
+
+    SLPrefsUnlock(lockFile);
+
+    // load the migrated file the next time the preferences are read (unless they were modified in the meantime, in which case the
+    // pending write already contains the migrated preferences)
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        if (!sSLPrefsDirty) {
+            sSLPrefsCacheLoaded = NO;
+        }
+        sSLPrefsMigrationScheduled = NO;
+    });
+}
+
+// Streams the scalar preferences for the alarm with the given Id from the preferences file into the given record, but only if the
+// in-memory copy of the preferences would need to be loaded first.  Returns the status of the reader, or kSLPrefsReaderStatusReadError if
+// the file was not streamed.  The alarms are not changed by any of the schema migrations, so the file can be read even if it has not been
+// migrated yet.
++ (SLPrefsReaderStatus)streamAlarmRecord:(SLPrefsAlarmRecord *)alarmRecord forAlarmId:(NSString *)alarmId
+{
+    __block BOOL canReadFile = NO;
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        struct timespec modificationTime;
+        canReadFile = SLPrefsCacheNeedsReload(&modificationTime);
+    });
+    if (!canReadFile) {
+        return kSLPrefsReaderStatusReadError;
+    }
+    FILE *file = fopen([kSLSettingsFile fileSystemRepresentation], "rb");
+    if (file == NULL) {
+        return kSLPrefsReaderStatusNotFound;
+    }
+    SLPrefsReaderStatus status = SLPrefsReaderFindAlarm(file, [alarmId UTF8String], alarmRecord);
+    SLAccountingRecord(kSLAccountingMetricFileOpens, 1);
+    SLAccountingRecord(kSLAccountingMetricBytesRead, MAX(ftell(file), 0));
+    fclose(file);
+#ifdef DEBUG
+    // check the streamed alarm against the alarm in the in-memory copy of the preferences
+    if (status == kSLPrefsReaderStatusFound || status == kSLPrefsReaderStatusNotFound) {
+        NSDictionary *loadedAlarm = nil;
+        for (NSDictionary *alarm in [[SLPrefsManager cachedPrefs] objectForKey:kSLAlarmsKey]) {
+            if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
+                loadedAlarm = alarm;
+                break;
+            }
+        }
+        if ((loadedAlarm != nil) != (status == kSLPrefsReaderStatusFound) ||
+            (loadedAlarm != nil && ([[loadedAlarm objectForKey:kSLSnoozeHourKey] integerValue] != alarmRecord->snoozeTimeHour ||
+                                    [[loadedAlarm objectForKey:kSLSnoozeMinuteKey] integerValue] != alarmRecord->snoozeTimeMinute ||
+                                    [[loadedAlarm objectForKey:kSLSnoozeSecondKey] integerValue] != alarmRecord->snoozeTimeSecond ||
+                                    [[loadedAlarm objectForKey:kSLSkipEnabledKey] boolValue] != (alarmRecord->skipEnabled != 0) ||
+                                    [[loadedAlarm objectForKey:kSLSkipActivatedStatusKey] integerValue] != alarmRecord->skipActivatedStatus ||
+                                    [[loadedAlarm objectForKey:kSLAutoSetOptionKey] integerValue] != alarmRecord->autoSetOption ||
+                                    ([loadedAlarm objectForKey:kSLSkipDatesKey] != nil) != (alarmRecord->hasSkipDates != 0) ||
+                                    ([loadedAlarm objectForKey:kSLSkipProfileIdKey] != nil) != (alarmRecord->hasSkipProfileId != 0)))) {
+            NSLog(@"Sleeper: the streamed preferences for alarm %@ do not match the loaded preferences", alarmId);
+        }
+    }
+#endif
+    return status;
+}
+
+// Return an SLAlarmPrefs object with alarm information for a given alarm Id.  Return nil if no alarm is found.  Alarms that use a skip
+// profile are returned with the skip dates of the profile.
 + (SLAlarmPrefs *)alarmPrefsForAlarmId:(NSString *)alarmId
 {
+    SLAccountingEnter(kSLAccountingEntryPointAlarmPrefs);
+
+    // If the in-memory copy of the preferences would need to be loaded, stream the file for the single alarm instead.  The reader does not
+    // read the nested skip dates, so only alarms without any skip dates (or a skip profile) can be created from the streamed record, while
+    // the others (along with any file that the reader does not understand) load the in-memory copy.
+    SLPrefsAlarmRecord alarmRecord;
+    SLPrefsReaderStatus status = [SLPrefsManager streamAlarmRecord:&alarmRecord forAlarmId:alarmId];
+    if (status == kSLPrefsReaderStatusNotFound) {
+        return nil;
+    } else if (status == kSLPrefsReaderStatusFound && !alarmRecord.hasSkipDates && !alarmRecord.hasSkipProfileId) {
+        SLAlarmPrefs *alarmPrefs = [[SLAlarmPrefs alloc] init];
+        SLAccountingRecord(kSLAccountingMetricObjects, 1);
+        alarmPrefs.alarmId = alarmId;
+        alarmPrefs.snoozeTimeHour = (NSInteger)alarmRecord.snoozeTimeHour;
+        alarmPrefs.snoozeTimeMinute = (NSInteger)alarmRecord.snoozeTimeMinute;
+        alarmPrefs.snoozeTimeSecond = (NSInteger)alarmRecord.snoozeTimeSecond;
+        alarmPrefs.skipEnabled = alarmRecord.skipEnabled != 0;
+        alarmPrefs.skipTimeHour = (NSInteger)alarmRecord.skipTimeHour;
+        alarmPrefs.skipTimeMinute = (NSInteger)alarmRecord.skipTimeMinute;
+        alarmPrefs.skipTimeSecond = (NSInteger)alarmRecord.skipTimeSecond;
+        alarmPrefs.skipActivationStatus = (SLSkipActivatedStatus)alarmRecord.skipActivatedStatus;
+        alarmPrefs.autoSetOption = (SLAutoSetOption)alarmRecord.autoSetOption;
+        alarmPrefs.autoSetOffsetOption = (SLAutoSetOffsetOption)alarmRecord.autoSetOffsetOption;
+        alarmPrefs.autoSetOffsetHour = (NSInteger)alarmRecord.autoSetOffsetHour;
+        alarmPrefs.autoSetOffsetMinute = (NSInteger)alarmRecord.autoSetOffsetMinute;
+        alarmPrefs.customSkipDates = [[NSArray alloc] init];
+        alarmPrefs.holidaySkipDates = [[NSDictionary alloc] init];
+        alarmPrefs.skipRules = [[NSArray alloc] init];
+
+        // the alarm was not read from the in-memory copy of the preferences, so it does not have a generation
+        alarmPrefs.prefsGeneration = 0;
+        return alarmPrefs;
+    }
+
     // grab the preferences plist
-    NSDictionary *prefs = [[NSDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
+    NSUInteger prefsGeneration = 0;
+    NSDictionary *prefs = [SLPrefsManager cachedPrefsWithGeneration:&prefsGeneration];
     
     // if the alarm preferences exist, attempt to get the alarms
     if (prefs) {
@@ -61,6 +669,7 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
             if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
                 // create a preferences object for the given alarm
                 SLAlarmPrefs *alarmPrefs = [[SLAlarmPrefs alloc] init];
+                SLAccountingRecord(kSLAccountingMetricObjects, 1);
                 alarmPrefs.alarmId = alarmId;
                 alarmPrefs.snoozeTimeHour = [[alarm objectForKey:kSLSnoozeHourKey] integerValue];
                 alarmPrefs.snoozeTimeMinute = [[alarm objectForKey:kSLSnoozeMinuteKey] integerValue];
@@ -75,8 +684,14 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
                 alarmPrefs.autoSetOffsetHour = [[alarm objectForKey:kSLAutoSetOffsetHourKey] integerValue];
                 alarmPrefs.autoSetOffsetMinute = [[alarm objectForKey:kSLAutoSetOffsetMinuteKey] integerValue];
                 
-                // check to see if the prefs contain any of the skip dates options (added in v4.1.0)
+                // check to see if the prefs contain any of the skip dates options (added in v4.1.0), which are read from the skip profile
+                // if the alarm uses one
                 NSDictionary *skipDates = [alarm objectForKey:kSLSkipDatesKey];
+                NSDictionary *skipProfile = SLSkipProfileForId(prefs, [alarm objectForKey:kSLSkipProfileIdKey]);
+                if (skipProfile != nil) {
+                    alarmPrefs.skipProfileId = [skipProfile objectForKey:kSLSkipProfileIdKey];
+                    skipDates = [skipProfile objectForKey:kSLSkipDatesKey];
+                }
                 if (skipDates != nil) {
                     // initialize the two keys which should exist inside the skip dates.  If for some reason this key does not contain the
                     // subkeys for skip dates, create empty datasets
@@ -88,31 +703,32 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
                     if (alarmPrefs.holidaySkipDates == nil) {
                         alarmPrefs.holidaySkipDates = [[NSDictionary alloc] init];
                     }
+                    alarmPrefs.skipRules = [skipDates objectForKey:kSLSkipRulesKey];
+                    if (alarmPrefs.skipRules == nil) {
+                        alarmPrefs.skipRules = [[NSArray alloc] init];
+                    }
 
-                    // As of Sleeper 6.0.4, new custom skip dates will be stored as strings instead of dates.  To maintain compatibility with older
-                    // preference files, check the old custom skip date key to see if any previous dates exist and convert them to strings.
-                    NSArray *oldCustomSkipDates = [skipDates objectForKey:kSLCustomSkipDatesKey];
-                    if (oldCustomSkipDates.count > 0) {
-                        NSMutableArray *combinedCustomSkipDates = [[NSMutableArray alloc] initWithCapacity:alarmPrefs.customSkipDates.count + oldCustomSkipDates.count];
-                        for (NSDate *skipDate in oldCustomSkipDates) {
-                            [combinedCustomSkipDates addObject:[[SLPrefsManager plistDateFormatter] stringFromDate:skipDate]];
+                    // the custom skip dates are stored sorted, so any dates which occur in the past can be removed with a binary search
+                    NSUInteger numCustomSkipDates = alarmPrefs.customSkipDates.count;
+                    if (numCustomSkipDates > 0) {
+                        NSUInteger firstUpcomingIndex = [alarmPrefs.customSkipDates indexOfObject:SLSkipDateStringForDay([SLHolidayManager dayForDate:[SLClock now]])
+                                                                                    inSortedRange:NSMakeRange(0, numCustomSkipDates)
+                                                                                          options:NSBinarySearchingFirstEqual | NSBinarySearchingInsertionIndex
+                                                                                  usingComparator:^NSComparisonResult(NSString *skipDateString1, NSString *skipDateString2) {
+                            return [skipDateString1 compare:skipDateString2];
+                        }];
+                        if (firstUpcomingIndex > 0) {
+                            alarmPrefs.customSkipDates = [alarmPrefs.customSkipDates subarrayWithRange:NSMakeRange(firstUpcomingIndex, numCustomSkipDates - firstUpcomingIndex)];
                         }
-                        if (alarmPrefs.customSkipDates.count > 0) {
-                            [combinedCustomSkipDates addObjectsFromArray:alarmPrefs.customSkipDates];
-                        }
-                        alarmPrefs.customSkipDates = [combinedCustomSkipDates copy];
-                    }
-                    
-                    // use a predicate to remove any date strings which occur in the past
-                    if (alarmPrefs.customSkipDates.count > 0) {
-                        NSPredicate *oldDatePredicate = [NSPredicate predicateWithFormat:@"SELF >= %@", [[SLPrefsManager plistDateFormatter] stringFromDate:[NSDate date]]];
-                        alarmPrefs.customSkipDates = [alarmPrefs.customSkipDates filteredArrayUsingPredicate:oldDatePredicate];
                     }
                 } else {
                     alarmPrefs.customSkipDates = [[NSArray alloc] init];
                     alarmPrefs.holidaySkipDates = [[NSDictionary alloc] init];
+                    alarmPrefs.skipRules = [[NSArray alloc] init];
                 }
-                
+
+                // the generation must be set after the skip dates since modifying the skip dates resets the generation
+                alarmPrefs.prefsGeneration = prefsGeneration;
                 return alarmPrefs;
             }
         }
@@ -123,8 +739,15 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
 // returns whether or not the preferences file contains preferences for an alarm with the given alarm Id
 + (BOOL)prefsContainAlarmWithAlarmId:(NSString *)alarmId
 {
+    // if the in-memory copy of the preferences would need to be loaded, stream the file for the single alarm instead
+    SLPrefsAlarmRecord alarmRecord;
+    SLPrefsReaderStatus status = [SLPrefsManager streamAlarmRecord:&alarmRecord forAlarmId:alarmId];
+    if (status == kSLPrefsReaderStatusFound || status == kSLPrefsReaderStatusNotFound) {
+        return status == kSLPrefsReaderStatusFound;
+    }
+
     // grab the preferences plist
-    NSDictionary *prefs = [[NSDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
+    NSDictionary *prefs = [SLPrefsManager cachedPrefs];
     
     // if the alarm preferences exist, attempt to get the alarms
     if (prefs) {
@@ -141,185 +764,389 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
     return NO;
 }
 
-// save the specific alarm preferences object
+// Save the specific alarm preferences object.  If the alarm uses a skip profile, the skip dates are saved to the profile (updating every
+// alarm that uses the profile) instead of the alarm.
 + (void)saveAlarmPrefs:(SLAlarmPrefs *)alarmPrefs
 {
-    // grab the preferences plist
-    NSMutableDictionary *prefs = [[NSMutableDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
-    
-    // if no preferences exist, create a new mutable dictionary now
-    if (!prefs) {
-        prefs = [[NSMutableDictionary alloc] initWithCapacity:1];
-    }
-    
-    // array of dictionaries of all of the alarms
-    NSMutableArray *alarms = [prefs objectForKey:kSLAlarmsKey];
-    
-    // if the alarms do not exist in our preferences, create the alarms array now
-    NSMutableDictionary *alarmToSave = nil;
-    if (!alarms) {
-        alarms = [[NSMutableArray alloc] initWithCapacity:1];
-    } else {
-        // otherwise attempt to find the desired alarm in the array
-        for (NSMutableDictionary *alarm in alarms) {
-            if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmPrefs.alarmId]) {
-                // update the alarm dictionary with the values given
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.snoozeTimeHour]
-                          forKey:kSLSnoozeHourKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.snoozeTimeMinute]
-                          forKey:kSLSnoozeMinuteKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.snoozeTimeSecond]
-                          forKey:kSLSnoozeSecondKey];
-                [alarm setObject:[NSNumber numberWithBool:alarmPrefs.skipEnabled]
-                          forKey:kSLSkipEnabledKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.skipTimeHour]
-                          forKey:kSLSkipHourKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.skipTimeMinute]
-                          forKey:kSLSkipMinuteKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.skipTimeSecond]
-                          forKey:kSLSkipSecondKey];
-                [alarm setObject:[NSNumber numberWithInteger:kSLSkipActivatedStatusUnknown]
-                          forKey:kSLSkipActivatedStatusKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOption]
-                          forKey:kSLAutoSetOptionKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOffsetOption]
-                          forKey:kSLAutoSetOffsetOptionKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOffsetHour]
-                          forKey:kSLAutoSetOffsetHourKey];
-                [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOffsetMinute]
-                          forKey:kSLAutoSetOffsetMinuteKey];
-                [alarm setObject:@{kSLCustomSkipDateStringsKey:alarmPrefs.customSkipDates,
-                                   kSLHolidaySkipDatesKey:alarmPrefs.holidaySkipDates}
-                          forKey:kSLSkipDatesKey];
-                alarmToSave = alarm;
-                break;
+    [SLPrefsManager saveAlarmPrefs:alarmPrefs completion:nil];
+}
+
+// Saves the specific alarm preferences object asynchronously.  The saved preferences are immediately available to readers in this process,
+// while the write to the file system is coalesced with any other saves and performed on a background queue.  The optional completion
+// is invoked on the main queue once the preferences have been written.
++ (void)saveAlarmPrefs:(SLAlarmPrefs *)alarmPrefs completion:(void (^)(BOOL success))completion
+{
+    [SLPrefsManager modifyPrefsWithBlock:^BOOL(NSMutableDictionary *prefs) {
+        // array of dictionaries of all of the alarms
+        NSMutableArray *alarms = [prefs objectForKey:kSLAlarmsKey];
+
+        // if the alarms do not exist in our preferences, create the alarms array now
+        NSMutableDictionary *alarmToSave = nil;
+        if (!alarms) {
+            alarms = [[NSMutableArray alloc] initWithCapacity:1];
+        } else {
+            // otherwise attempt to find the desired alarm in the array
+            for (NSMutableDictionary *alarm in alarms) {
+                if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmPrefs.alarmId]) {
+                    // update the alarm dictionary with the values given
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.snoozeTimeHour]
+                              forKey:kSLSnoozeHourKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.snoozeTimeMinute]
+                              forKey:kSLSnoozeMinuteKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.snoozeTimeSecond]
+                              forKey:kSLSnoozeSecondKey];
+                    [alarm setObject:[NSNumber numberWithBool:alarmPrefs.skipEnabled]
+                              forKey:kSLSkipEnabledKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.skipTimeHour]
+                              forKey:kSLSkipHourKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.skipTimeMinute]
+                              forKey:kSLSkipMinuteKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.skipTimeSecond]
+                              forKey:kSLSkipSecondKey];
+                    [alarm setObject:[NSNumber numberWithInteger:kSLSkipActivatedStatusUnknown]
+                              forKey:kSLSkipActivatedStatusKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOption]
+                              forKey:kSLAutoSetOptionKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOffsetOption]
+                              forKey:kSLAutoSetOffsetOptionKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOffsetHour]
+                              forKey:kSLAutoSetOffsetHourKey];
+                    [alarm setObject:[NSNumber numberWithInteger:alarmPrefs.autoSetOffsetMinute]
+                              forKey:kSLAutoSetOffsetMinuteKey];
+                    alarmToSave = alarm;
+                    break;
+                }
             }
         }
-    }
-    
-    // check if the alarm was found, if not add a new one
-    if (!alarmToSave) {
-        // create a new alarm with the given attributes
-        alarmToSave = [NSMutableDictionary dictionaryWithObjectsAndKeys:alarmPrefs.alarmId, kSLAlarmIdKey,
-                      [NSNumber numberWithInteger:alarmPrefs.snoozeTimeHour], kSLSnoozeHourKey,
-                      [NSNumber numberWithInteger:alarmPrefs.snoozeTimeMinute], kSLSnoozeMinuteKey,
-                      [NSNumber numberWithInteger:alarmPrefs.snoozeTimeSecond], kSLSnoozeSecondKey,
-                      [NSNumber numberWithBool:alarmPrefs.skipEnabled], kSLSkipEnabledKey,
-                      [NSNumber numberWithInteger:alarmPrefs.skipTimeHour], kSLSkipHourKey,
-                      [NSNumber numberWithInteger:alarmPrefs.skipTimeMinute], kSLSkipMinuteKey,
-                      [NSNumber numberWithInteger:alarmPrefs.skipTimeSecond], kSLSkipSecondKey,
-                      [NSNumber numberWithInteger:kSLSkipActivatedStatusUnknown], kSLSkipActivatedStatusKey,
-                      [NSNumber numberWithInteger:alarmPrefs.autoSetOption], kSLAutoSetOptionKey,
-                      [NSNumber numberWithInteger:alarmPrefs.autoSetOffsetOption], kSLAutoSetOffsetOptionKey,
-                      [NSNumber numberWithInteger:alarmPrefs.autoSetOffsetHour], kSLAutoSetOffsetHourKey,
-                      [NSNumber numberWithInteger:alarmPrefs.autoSetOffsetMinute], kSLAutoSetOffsetMinuteKey,
-                      @{kSLCustomSkipDateStringsKey:alarmPrefs.customSkipDates, kSLHolidaySkipDatesKey:alarmPrefs.holidaySkipDates}, kSLSkipDatesKey,
-                      nil];
-
-        // add the object to the array
-        [alarms addObject:alarmToSave];
-    }
-    
-    // add the alarms array to the preferences dictionary
-    [prefs setObject:alarms forKey:kSLAlarmsKey];
-    
-    // write the updated preferences
-    if ([prefs writeToFile:kSLSettingsFile atomically:YES] && alarmPrefs.autoSetOption != kSLAutoSetOptionOff) {
-        // if the alarm has an auto-set option enabled, notify the auto-set manager upon saving the alarm
-        dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1.0 * NSEC_PER_SEC));
-        dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
-            [[NSDistributedNotificationCenter defaultCenter] postNotificationName:kSLAutoSetOptionsUpdatedNotification object:nil userInfo:alarmToSave];
-        });
-    }
+
+        // check if the alarm was found, if not add a new one
+        if (!alarmToSave) {
+            // create a new alarm with the given attributes
+            alarmToSave = [NSMutableDictionary dictionaryWithObjectsAndKeys:alarmPrefs.alarmId, kSLAlarmIdKey,
+                          [NSNumber numberWithInteger:alarmPrefs.snoozeTimeHour], kSLSnoozeHourKey,
+                          [NSNumber numberWithInteger:alarmPrefs.snoozeTimeMinute], kSLSnoozeMinuteKey,
+                          [NSNumber numberWithInteger:alarmPrefs.snoozeTimeSecond], kSLSnoozeSecondKey,
+                          [NSNumber numberWithBool:alarmPrefs.skipEnabled], kSLSkipEnabledKey,
+                          [NSNumber numberWithInteger:alarmPrefs.skipTimeHour], kSLSkipHourKey,
+                          [NSNumber numberWithInteger:alarmPrefs.skipTimeMinute], kSLSkipMinuteKey,
+                          [NSNumber numberWithInteger:alarmPrefs.skipTimeSecond], kSLSkipSecondKey,
+                          [NSNumber numberWithInteger:kSLSkipActivatedStatusUnknown], kSLSkipActivatedStatusKey,
+                          [NSNumber numberWithInteger:alarmPrefs.autoSetOption], kSLAutoSetOptionKey,
+                          [NSNumber numberWithInteger:alarmPrefs.autoSetOffsetOption], kSLAutoSetOffsetOptionKey,
+                          [NSNumber numberWithInteger:alarmPrefs.autoSetOffsetHour], kSLAutoSetOffsetHourKey,
+                          [NSNumber numberWithInteger:alarmPrefs.autoSetOffsetMinute], kSLAutoSetOffsetMinuteKey,
+                          nil];
+
+            // add the object to the array
+            [alarms addObject:alarmToSave];
+        }
+
+        // save the skip dates to the skip profile if the alarm uses one that still exists, otherwise save them with the alarm
+        NSDictionary *skipDates = @{kSLCustomSkipDateStringsKey:alarmPrefs.customSkipDates,
+                                    kSLHolidaySkipDatesKey:alarmPrefs.holidaySkipDates,
+                                    kSLSkipRulesKey:alarmPrefs.skipRules};
+        NSMutableDictionary *skipProfile = (NSMutableDictionary *)SLSkipProfileForId(prefs, alarmPrefs.skipProfileId);
+        if (skipProfile != nil) {
+            [skipProfile setObject:skipDates forKey:kSLSkipDatesKey];
+            [alarmToSave setObject:alarmPrefs.skipProfileId forKey:kSLSkipProfileIdKey];
+            [alarmToSave removeObjectForKey:kSLSkipDatesKey];
+        } else {
+            [alarmToSave setObject:skipDates forKey:kSLSkipDatesKey];
+            [alarmToSave removeObjectForKey:kSLSkipProfileIdKey];
+        }
+
+        // add the alarms array to the preferences dictionary
+        [prefs setObject:alarms forKey:kSLAlarmsKey];
+        return YES;
+    } completion:^(BOOL success, NSDictionary *previousPrefs, NSDictionary *writtenPrefs) {
+        // If the auto-set options of the alarm in the file differ from the options before the write (including when the auto-set option
+        // was turned off), signal the auto-set manager so that it can read the updated options from the preferences.
+        NSArray *previousAutoSetOptions = SLAutoSetOptionsForAlarmId(previousPrefs, alarmPrefs.alarmId);
+        if (success && ![previousAutoSetOptions isEqualToArray:SLAutoSetOptionsForAlarmId(writtenPrefs, alarmPrefs.alarmId)]) {
+            [SLAutoSetManager postAutoSetOptionsUpdated];
+        }
+        if (completion != nil) {
+            completion(success);
+        }
+    }];
 }
 
 // save the skip activation status for a given alarm
 + (void)setSkipActivatedStatusForAlarmId:(NSString *)alarmId
                      skipActivatedStatus:(SLSkipActivatedStatus)skipActivatedStatus
 {
-    // grab the preferences plist
-    NSMutableDictionary *prefs = [[NSMutableDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
-    
-    // if the clock preferences don't exist, create a new mutable dictionary now
-    if (!prefs) {
-        prefs = [[NSMutableDictionary alloc] initWithCapacity:1];
-    }
-    
-    // array of dictionaries of all of the alarms
-    NSMutableArray *alarms = [prefs objectForKey:kSLAlarmsKey];
-    
-    // if the alarms do not exist in our preferences, create the alarms array now
-    NSMutableDictionary *alarm = nil;
-    if (!alarms) {
-        alarms = [[NSMutableArray alloc] initWithCapacity:1];
-    } else {
-        // otherwise attempt to find the desired alarm in the array
-        for (alarm in alarms) {
-            if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
-                // update the alarm dictionary with the values given
-                [alarm setObject:[NSNumber numberWithInteger:skipActivatedStatus]
-                          forKey:kSLSkipActivatedStatusKey];
-                break;
+    [SLPrefsManager modifyPrefsWithBlock:^BOOL(NSMutableDictionary *prefs) {
+        // array of dictionaries of all of the alarms
+        NSMutableArray *alarms = [prefs objectForKey:kSLAlarmsKey];
+
+        // if the alarms do not exist in our preferences, create the alarms array now
+        NSMutableDictionary *alarm = nil;
+        if (!alarms) {
+            alarms = [[NSMutableArray alloc] initWithCapacity:1];
+        } else {
+            // otherwise attempt to find the desired alarm in the array
+            for (alarm in alarms) {
+                if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
+                    // update the alarm dictionary with the values given
+                    [alarm setObject:[NSNumber numberWithInteger:skipActivatedStatus]
+                              forKey:kSLSkipActivatedStatusKey];
+                    break;
+                }
             }
         }
-    }
-    
-    // check if the alarm was found, if so replace it
-    if (!alarm) {
-        // create a new alarm with the given attributes
-        NSDictionary *newAlarm = [NSDictionary dictionaryWithObjectsAndKeys:alarmId, kSLAlarmIdKey,
-                                  [NSNumber numberWithInteger:skipActivatedStatus],
-                                  kSLSkipActivatedStatusKey, nil];
-        
-        // add the object to the array
-        [alarms addObject:newAlarm];
-    }
-    
-    // add the alarms array to the preferences dictionary
-    [prefs setObject:alarms forKey:kSLAlarmsKey];
-    
-    // write the updated preferences
-    [prefs writeToFile:kSLSettingsFile atomically:YES];
+
+        // check if the alarm was found, if so replace it
+        if (!alarm) {
+            // create a new alarm with the given attributes
+            NSDictionary *newAlarm = [NSDictionary dictionaryWithObjectsAndKeys:alarmId, kSLAlarmIdKey,
+                                      [NSNumber numberWithInteger:skipActivatedStatus],
+                                      kSLSkipActivatedStatusKey, nil];
+
+            // add the object to the array
+            [alarms addObject:newAlarm];
+        }
+
+        // add the alarms array to the preferences dictionary
+        [prefs setObject:alarms forKey:kSLAlarmsKey];
+
+        return YES;
+    } completion:nil];
 }
 
 // delete an alarm from our settings
 + (void)deleteAlarmForAlarmId:(NSString *)alarmId
 {
-    // grab the preferences plist
-    NSMutableDictionary *prefs = [[NSMutableDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
-    
-    // only continue trying to delete the alarm if our preferences exist
-    if (prefs) {
+    [SLPrefsManager modifyPrefsWithBlock:^BOOL(NSMutableDictionary *prefs) {
         // array of dictionaries of all of the alarms
         NSMutableArray *alarms = [prefs objectForKey:kSLAlarmsKey];
-        
-        // only continue if any Alarms exist in the preferences
-        if (alarms) {
-            // iterate through all of the alarms until we find the one we desire
-            BOOL alarmFound = NO;
-            for (int i = 0; i < alarms.count; i++) {
-                // get the alarm at the given index
-                NSDictionary *alarm = [alarms objectAtIndex:i];
-                
-                // check if this is the desired alarm
-                if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
-                    // remove the alarm from the array
-                    [alarms removeObjectAtIndex:i];
-                    alarmFound = YES;
-                    break;
-                }
+
+        // iterate through all of the alarms until we find the one we desire
+        for (int i = 0; i < alarms.count; i++) {
+            // get the alarm at the given index
+            NSDictionary *alarm = [alarms objectAtIndex:i];
+
+            // check if this is the desired alarm, only updating the preferences if the alarm was found and deleted
+            if ([[alarm objectForKey:kSLAlarmIdKey] isEqualToString:alarmId]) {
+                [alarms removeObjectAtIndex:i];
+                return YES;
             }
-            
-            // if an alarm was found and deleted, then update the data source
-            if (alarmFound) {
-                // add the alarms array to the preferences dictionary
-                [prefs setObject:alarms forKey:kSLAlarmsKey];
-                
-                // write the updated preferences
-                [prefs writeToFile:kSLSettingsFile atomically:YES];
+        }
+        return NO;
+    } completion:nil];
+}
+
+// returns the alarm Ids for all of the alarms that are contained in the preferences file
++ (NSArray *)allAlarmIds
+{
+    NSMutableArray *alarmIds = [[NSMutableArray alloc] init];
+    NSDictionary *prefs = [SLPrefsManager cachedPrefs];
+    for (NSDictionary *alarm in [prefs objectForKey:kSLAlarmsKey]) {
+        NSString *alarmId = [alarm objectForKey:kSLAlarmIdKey];
+        if (alarmId != nil) {
+            [alarmIds addObject:alarmId];
+        }
+    }
+    return [alarmIds copy];
+}
+
+// Removes the alarms with the given alarm Ids from the preferences file in a single pass, along with any custom skip dates that have
+// passed, any skip rules that have ended, any empty holiday selections, and any skip profiles that are no longer used by an alarm.
+// Returns a dictionary with the number of records removed and the bytes reclaimed.
++ (NSDictionary *)performMaintenanceRemovingAlarmIds:(NSSet *)alarmIds
+{
+    // write any pending modifications first so that the size of the file before any maintenance is performed is accurate
+    [SLPrefsManager synchronizePrefs];
+    long long originalFileSize = [[[NSFileManager defaultManager] attributesOfItemAtPath:kSLSettingsFile error:nil] fileSize];
+
+    __block NSInteger removedAlarms = 0;
+    __block NSInteger removedSkipDates = 0;
+    __block NSInteger removedSkipProfiles = 0;
+    [SLPrefsManager modifyPrefsWithBlock:^BOOL(NSMutableDictionary *prefs) {
+        // the counts are reset since the block is invoked again if another process modified the file before it was written
+        removedAlarms = 0;
+        removedSkipDates = 0;
+        removedSkipProfiles = 0;
+        NSString *todayString = SLSkipDateStringForDay([SLHolidayManager dayForDate:[SLClock now]]);
+
+        NSArray *alarms = [prefs objectForKey:kSLAlarmsKey];
+        NSMutableArray *maintainedAlarms = [[NSMutableArray alloc] initWithCapacity:alarms.count];
+        NSMutableSet *usedSkipProfileIds = [[NSMutableSet alloc] init];
+        for (NSDictionary *alarm in alarms) {
+            // drop any alarm that no longer exists on the system
+            if ([alarmIds containsObject:[alarm objectForKey:kSLAlarmIdKey]]) {
+                ++removedAlarms;
+                continue;
+            }
+
+            NSString *skipProfileId = [alarm objectForKey:kSLSkipProfileIdKey];
+            if (skipProfileId != nil) {
+                [usedSkipProfileIds addObject:skipProfileId];
+            }
+
+            NSDictionary *skipDates = [alarm objectForKey:kSLSkipDatesKey];
+            if (skipDates == nil) {
+                [maintainedAlarms addObject:alarm];
+                continue;
+            }
+
+            NSMutableDictionary *maintainedAlarm = [alarm mutableCopy];
+            [maintainedAlarm setObject:SLMaintainedSkipDates(skipDates, todayString, &removedSkipDates) forKey:kSLSkipDatesKey];
+            [maintainedAlarms addObject:maintainedAlarm];
+        }
+
+        // remove the skip profiles that are no longer used by any alarm and maintain the skip dates of the remaining profiles
+        NSArray *skipProfiles = [prefs objectForKey:kSLSkipProfilesKey];
+        NSMutableArray *maintainedSkipProfiles = [[NSMutableArray alloc] initWithCapacity:skipProfiles.count];
+        for (NSDictionary *skipProfile in skipProfiles) {
+            if (![usedSkipProfileIds containsObject:[skipProfile objectForKey:kSLSkipProfileIdKey]]) {
+                ++removedSkipProfiles;
+                continue;
+            }
+
+            NSMutableDictionary *maintainedSkipProfile = [skipProfile mutableCopy];
+            [maintainedSkipProfile setObject:SLMaintainedSkipDates([skipProfile objectForKey:kSLSkipDatesKey], todayString, &removedSkipDates)
+                                      forKey:kSLSkipDatesKey];
+            [maintainedSkipProfiles addObject:maintainedSkipProfile];
+        }
+
+        // only write the preferences if something was actually removed
+        if (removedAlarms > 0 || removedSkipDates > 0 || removedSkipProfiles > 0) {
+            [prefs setObject:maintainedAlarms forKey:kSLAlarmsKey];
+            if (skipProfiles != nil) {
+                [prefs setObject:maintainedSkipProfiles forKey:kSLSkipProfilesKey];
+            }
+            return YES;
+        }
+        return NO;
+    } completion:nil];
+
+    // write the maintained preferences immediately to determine the number of bytes that were reclaimed
+    long long reclaimedBytes = 0;
+    if (removedAlarms > 0 || removedSkipDates > 0 || removedSkipProfiles > 0) {
+        [SLPrefsManager synchronizePrefs];
+        long long updatedFileSize = [[[NSFileManager defaultManager] attributesOfItemAtPath:kSLSettingsFile error:nil] fileSize];
+        reclaimedBytes = originalFileSize - updatedFileSize;
+    }
+
+    return @{kSLMaintenanceRemovedAlarmsKey:[NSNumber numberWithInteger:removedAlarms],
+             kSLMaintenanceRemovedSkipDatesKey:[NSNumber numberWithInteger:removedSkipDates],
+             kSLMaintenanceRemovedSkipProfilesKey:[NSNumber numberWithInteger:removedSkipProfiles],
+             kSLMaintenanceReclaimedBytesKey:[NSNumber numberWithLongLong:reclaimedBytes]};
+}
+
+// Builds the holiday index ahead of time for the holiday countries that are selected by any alarm or skip profile, so that the first skip
+// decision after the maintenance pass does not need to evaluate the holidays while the holiday manager is synchronized.
++ (void)prebuildHolidayIndex
+{
+    SLHolidaySelection holidaySelections[kSLHolidayCountryNumRegions];
+    memset(holidaySelections, 0, sizeof(holidaySelections));
+    NSDictionary *prefs = [SLPrefsManager cachedPrefs];
+    NSMutableArray *alarmsAndSkipProfiles = [[NSMutableArray alloc] init];
+    for (NSString *key in @[kSLAlarmsKey, kSLSkipProfilesKey]) {
+        NSArray *records = [prefs objectForKey:key];
+        if ([records isKindOfClass:[NSArray class]]) {
+            [alarmsAndSkipProfiles addObjectsFromArray:records];
+        }
+    }
+    for (NSDictionary *record in alarmsAndSkipProfiles) {
+        NSDictionary *skipDates = [record isKindOfClass:[NSDictionary class]] ? [record objectForKey:kSLSkipDatesKey] : nil;
+        NSDictionary *holidaySkipDates = [skipDates isKindOfClass:[NSDictionary class]] ? [skipDates objectForKey:kSLHolidaySkipDatesKey] : nil;
+        if (![holidaySkipDates isKindOfClass:[NSDictionary class]]) {
+            continue;
+        }
+        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
+            NSNumber *holidaySelection = [holidaySkipDates objectForKey:kSLHolidayCountryInfo[holidayCountry].resourceName];
+            if ([holidaySelection isKindOfClass:[NSNumber class]]) {
+                holidaySelections[holidayCountry] |= [holidaySelection unsignedLongLongValue];
             }
         }
     }
+    [[SLHolidayManager sharedInstance] prebuildHolidayIndexForHolidaySelections:holidaySelections];
+}
+
+// returns all of the skip profiles (dictionaries containing the Id, name, and skip dates of each profile) sorted by name
++ (NSArray *)allSkipProfiles
+{
+    NSArray *skipProfiles = [[SLPrefsManager cachedPrefs] objectForKey:kSLSkipProfilesKey];
+    return [skipProfiles sortedArrayUsingComparator:^NSComparisonResult(NSDictionary *skipProfile1, NSDictionary *skipProfile2) {
+        return [[skipProfile1 objectForKey:kSLSkipProfileNameKey] localizedCaseInsensitiveCompare:[skipProfile2 objectForKey:kSLSkipProfileNameKey]];
+    }];
+}
+
+// Creates a new skip profile with the given name and skip dates, returning the Id of the new profile.  Alarms are linked to the profile
+// by saving their preferences with the Id of the profile.
++ (NSString *)createSkipProfileWithName:(NSString *)name
+                        customSkipDates:(NSArray *)customSkipDates
+                       holidaySkipDates:(NSDictionary *)holidaySkipDates
+                              skipRules:(NSArray *)skipRules
+{
+    NSString *skipProfileId = [[NSUUID UUID] UUIDString];
+    NSDictionary *skipProfile = @{kSLSkipProfileIdKey:skipProfileId,
+                                  kSLSkipProfileNameKey:name,
+                                  kSLSkipDatesKey:@{kSLCustomSkipDateStringsKey:customSkipDates,
+                                                    kSLHolidaySkipDatesKey:holidaySkipDates,
+                                                    kSLSkipRulesKey:skipRules}};
+    [SLPrefsManager modifyPrefsWithBlock:^BOOL(NSMutableDictionary *prefs) {
+        NSMutableArray *skipProfiles = [prefs objectForKey:kSLSkipProfilesKey];
+        if (skipProfiles == nil) {
+            skipProfiles = [[NSMutableArray alloc] initWithCapacity:1];
+            [prefs setObject:skipProfiles forKey:kSLSkipProfilesKey];
+        }
+        [skipProfiles addObject:skipProfile];
+        return YES;
+    } completion:nil];
+    return skipProfileId;
+}
+
+// Returns the skip decision for the given skip profile and day that was made by any alarm that was loaded from the given generation of the
+// preferences, or nil if no decision has been made yet.  This allows a skip profile to be evaluated once per day for all of its alarms.
++ (NSNumber *)skipDecisionForSkipProfileId:(NSString *)skipProfileId onDay:(SLDay)day prefsGeneration:(NSUInteger)prefsGeneration
+{
+    __block NSNumber *skipDecision = nil;
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        if (prefsGeneration == sSLPrefsGeneration) {
+            skipDecision = [[sSLSkipProfileDecisions objectForKey:skipProfileId] objectForKey:[NSNumber numberWithInt:day]];
+        }
+    });
+    return skipDecision;
+}
+
+// saves the skip decision for the given skip profile and day, which is discarded if the preferences have changed since the given generation
++ (void)setSkipDecision:(BOOL)shouldSkip forSkipProfileId:(NSString *)skipProfileId onDay:(SLDay)day prefsGeneration:(NSUInteger)prefsGeneration
+{
+    // the caller does not need to wait for the decision to be saved, so only the lookup blocks on the state queue
+    dispatch_async([SLPrefsManager prefsStateQueue], ^{
+        if (prefsGeneration == sSLPrefsGeneration) {
+            NSMutableDictionary *skipProfileDecisions = [sSLSkipProfileDecisions objectForKey:skipProfileId];
+            if (skipProfileDecisions == nil) {
+                skipProfileDecisions = [[NSMutableDictionary alloc] init];
+                [sSLSkipProfileDecisions setObject:skipProfileDecisions forKey:skipProfileId];
+            }
+            [skipProfileDecisions setObject:[NSNumber numberWithBool:shouldSkip] forKey:[NSNumber numberWithInt:day]];
+        }
+    });
+}
+
+// Returns whether or not any alarm in the preferences uses an auto-set option.  This is summarized once for each generation of the
+// preferences, so it is cheap to call repeatedly.
++ (BOOL)hasAutoSetAlarms
+{
+    __block BOOL hasAutoSetAlarms = NO;
+    dispatch_sync([SLPrefsManager prefsStateQueue], ^{
+        SLReloadPrefsCacheIfNeeded();
+        if (sSLAutoSetSummaryGeneration != sSLPrefsGeneration) {
+            sSLAutoSetSummaryHasAlarms = NO;
+            for (NSDictionary *alarm in [sSLPrefsCache objectForKey:kSLAlarmsKey]) {
+                if ([[alarm objectForKey:kSLAutoSetOptionKey] integerValue] != kSLAutoSetOptionOff) {
+                    sSLAutoSetSummaryHasAlarms = YES;
+                    break;
+                }
+            }
+            sSLAutoSetSummaryGeneration = sSLPrefsGeneration;
+        }
+        hasAutoSetAlarms = sSLAutoSetSummaryHasAlarms;
+    });
+    return hasAutoSetAlarms;
 }
 
 // Provides the caller with a dictionary containing all of the auto-set alarms using the auto-set option as the key for the dictionary.
@@ -331,7 +1158,7 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
     NSDictionary *autoSetAlarms = nil;
 
     // grab the preferences plist
-    NSDictionary *prefs = [[NSDictionary alloc] initWithContentsOfFile:kSLSettingsFile];
+    NSDictionary *prefs = [SLPrefsManager cachedPrefs];
     
     // if the alarm preferences exist, attempt to get the alarms
     if (prefs) {
@@ -370,274 +1197,128 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
 }
 
 // Returns a dictionary that corresponds to the default holiday source for the given holiday resource name.
-// This function will also remove any dates which occurred in the past.
+// This function will only include the upcoming dates for each holiday, evaluated from the compiled holiday rules.
 + (NSDictionary *)holidayResourceForResourceName:(NSString *)resourceName
 {
-    NSMutableDictionary *holidayResource = nil;
-    NSString *resourcePath = [kSLSleeperBundle pathForResource:resourceName ofType:@"plist"];
-    if (resourcePath != nil) {
-        // load the list of holidays from the file system
-        holidayResource = [[NSMutableDictionary alloc] initWithContentsOfFile:resourcePath];
-
-        // iterate through the various holidays and dates to potentially remove dates which have passed
-        NSMutableArray *defaultHolidays = [holidayResource objectForKey:kSLHolidayHolidaysKey];
-        for (NSMutableDictionary *holiday in defaultHolidays) {
-            NSArray *dates = [holiday objectForKey:kSLHolidayDatesKey];
-
-            // use a predicate to remove any date strings which occur in the past
-            NSPredicate *oldDatePredicate = [NSPredicate predicateWithFormat:@"SELF >= %@", [[SLPrefsManager plistDateFormatter] stringFromDate:[NSDate date]]];
-            NSArray *newDates = [dates filteredArrayUsingPredicate:oldDatePredicate];
-            if (dates.count != newDates.count) {
-                [holiday setObject:newDates forKey:kSLHolidayDatesKey];
-            }
-        }
-        [holidayResource setObject:[defaultHolidays copy] forKey:kSLHolidayHolidaysKey];
-    }
-    return [holidayResource copy];
-}
-
-// Returns the first available skip date for the given holiday name and country.  This function will not take into consideration any passed dates.
-+ (NSDate *)firstSkipDateForHolidayName:(NSString *)holidayName inHolidayCountry:(SLHolidayCountry)holidayCountry
-{
-    // load the resource in the bundle to get the skip dates for the holidays selected
-    NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
-    NSString *resourcePath = [kSLSleeperBundle pathForResource:resourceName ofType:@"plist"];
-    if (resourcePath != nil) {
-        // load the list of holidays from the file system
-        NSDictionary *holidayResource = [[NSDictionary alloc] initWithContentsOfFile:resourcePath];
-        NSArray *holidays = [holidayResource objectForKey:kSLHolidayHolidaysKey];
-
-        // grab the first date for the matching holiday name (removing any that might have passed)
-        for (NSDictionary *holiday in holidays) {
-            // match the holiday based on the name
-            if ([holidayName isEqualToString:[holiday objectForKey:kSLHolidayNameKey]]) {
-                // get the dates for this holiday
-                NSArray *dates = [holiday objectForKey:kSLHolidayDatesKey];
-                for (NSString *dateString in dates) {
-                    NSDate *date = [[SLPrefsManager plistDateFormatter] dateFromString:(NSString *)dateString];
-                    NSComparisonResult dateComparison = [[NSCalendar currentCalendar] compareDate:date toDate:[NSDate date] toUnitGranularity:NSCalendarUnitDay];
-                    if (dateComparison == NSOrderedSame || dateComparison == NSOrderedDescending) {
-                        return date;
-                    }
-                }
-            }
-        }
-    }
-    return nil;
+    return [[SLHolidayManager sharedInstance] holidayResourceForResourceName:resourceName];
+}
+
+// Returns the first available skip date for any of the holidays in the given selection for a country, along with the name of that holiday.
+// This function will not take into consideration any passed dates.
++ (NSDate *)firstSkipDateForHolidaySelection:(SLHolidaySelection)holidaySelection
+                            inHolidayCountry:(SLHolidayCountry)holidayCountry
+                                 holidayName:(NSString **)holidayName
+{
+    return [[SLHolidayManager sharedInstance] firstDateForHolidaySelection:holidaySelection
+                                                            inResourceName:[SLPrefsManager resourceNameForHolidayCountry:holidayCountry]
+                                                             onOrAfterDate:[SLClock now]
+                                                               holidayName:holidayName];
 }
 
 // returns a corresponding country code for any given country
 + (NSString *)countryCodeForHolidayCountry:(SLHolidayCountry)country
 {
-    NSString *countryCode = nil;
-    switch (country) {
-        case kSLHolidayCountryArgentina:
-            countryCode = @"ar";
-            break;
-        case kSLHolidayCountryAruba:
-            countryCode = @"aw";
-            break;
-        case kSLHolidayCountryAustralia:
-            countryCode = @"au";
-            break;
-        case kSLHolidayCountryAustria:
-            countryCode = @"at";
-            break;
-        case kSLHolidayCountryBelarus:
-            countryCode = @"by";
-            break;
-        case kSLHolidayCountryBelgium:
-            countryCode = @"be";
-            break;
-        case kSLHolidayCountryBrazil:
-            countryCode = @"br";
-            break;
-        case kSLHolidayCountryBulgaria:
-            countryCode = @"bg";
-            break;
-        case kSLHolidayCountryCanada:
-            countryCode = @"ca";
-            break;
-        case kSLHolidayCountryChina:
-            countryCode = @"cn";
-            break;
-        case kSLHolidayCountryColombia:
-            countryCode = @"co";
-            break;
-        case kSLHolidayCountryCroatia:
-            countryCode = @"hr";
-            break;
-        case kSLHolidayCountryCzechia:
-            countryCode = @"cz";
-            break;
-        case kSLHolidayCountryDenmark:
-            countryCode = @"dk";
-            break;
-        case kSLHolidayCountryDominicanRepublic:
-            countryCode = @"do";
-            break;
-        case kSLHolidayCountryEgypt:
-            countryCode = @"eg";
-            break;
-        case kSLHolidayCountryEstonia:
-            countryCode = @"ee";
-            break;
-        case kSLHolidayCountryFinland:
-            countryCode = @"fi";
-            break;
-        case kSLHolidayCountryFrance:
-            countryCode = @"fra";
-            break;
-        case kSLHolidayCountryGermany:
-            countryCode = @"de";
-            break;
-        case kSLHolidayCountryHongKong:
-            countryCode = @"hk";
-            break;
-        case kSLHolidayCountryHungary:
-            countryCode = @"hu";
-            break;
-        case kSLHolidayCountryIceland:
-            countryCode = @"is";
-            break;
-        case kSLHolidayCountryIndia:
-            countryCode = @"ind";
-            break;
-        case kSLHolidayCountryIreland:
-            countryCode = @"ie";
-            break;
-        case kSLHolidayCountryIsrael:
-            countryCode = @"il";
-            break;
-        case kSLHolidayCountryItaly:
-            countryCode = @"it";
-            break;
-        case kSLHolidayCountryJapan:
-            countryCode = @"jp";
-            break;
-        case kSLHolidayCountryKenya:
-            countryCode = @"ke";
-            break;
-        case kSLHolidayCountryKorea:
-            countryCode = @"kr";
-            break;
-        case kSLHolidayCountryLithuania:
-            countryCode = @"lt";
-            break;
-        case kSLHolidayCountryLuxembourg:
-            countryCode = @"lu";
-            break;
-        case kSLHolidayCountryMexico:
-            countryCode = @"mx";
-            break;
-        case kSLHolidayCountryMorocco:
-            countryCode = @"ma";
-            break;
-        case kSLHolidayCountryNetherlands:
-            countryCode = @"nl";
-            break;
-        case kSLHolidayCountryNewZealand:
-            countryCode = @"nz";
-            break;
-        case kSLHolidayCountryNicaragua:
-            countryCode = @"ni";
-            break;
-        case kSLHolidayCountryNigeria:
-            countryCode = @"ng";
-            break;
-        case kSLHolidayCountryNorway:
-            countryCode = @"no";
-            break;
-        case kSLHolidayCountryParaguay:
-            countryCode = @"py";
-            break;
-        case kSLHolidayCountryPeru:
-            countryCode = @"pe";
-            break;
-        case kSLHolidayCountryPoland:
-            countryCode = @"pl";
-            break;
-        case kSLHolidayCountryPortugal:
-            countryCode = @"pt";
-            break;
-        case kSLHolidayCountryRussia:
-            countryCode = @"ru";
-            break;
-        case kSLHolidayCountrySerbia:
-            countryCode = @"rs";
-            break;
-        case kSLHolidayCountrySingapore:
-            countryCode = @"sg";
-            break;
-        case kSLHolidayCountrySlovakia:
-            countryCode = @"sk";
-            break;
-        case kSLHolidayCountrySlovenia:
-            countryCode = @"si";
-            break;
-        case kSLHolidayCountrySouthAfrica:
-            countryCode = @"za";
-            break;
-        case kSLHolidayCountrySpain:
-            countryCode = @"es";
-            break;
-        case kSLHolidayCountrySweden:
-            countryCode = @"se";
-            break;
-        case kSLHolidayCountrySwitzerland:
-            countryCode = @"ch";
-            break;
-        case kSLHolidayCountryTaiwan:
-            countryCode = @"tw";
-            break;
-        case kSLHolidayCountryTurkey:
-            countryCode = @"tr";
-            break;
-        case kSLHolidayCountryUkraine:
-            countryCode = @"ua";
-            break;
-        case kSLHolidayCountryUnitedKingdom:
-            countryCode = @"uk";
-            break;
-        case kSLHolidayCountryUnitedStates:
-            countryCode = @"us";
-            break;
-        case kSLHolidayCountryVietnam:
-            countryCode = @"vn";
-            break;
-        case kSLHolidayCountryNumCountries:
-            // this is in invalid country to provide, do nothing
-            break;
+    if (country >= 0 && country < kSLHolidayCountryNumRegions) {
+        return kSLHolidayCountryInfo[country].countryCode;
     }
-    return countryCode;
+    return nil;
 }
 
 // returns a string that corresponds to the resource name for a given holiday country
 + (NSString *)resourceNameForHolidayCountry:(SLHolidayCountry)country
 {
-    return [NSString stringWithFormat:@"%@_holidays", [SLPrefsManager countryCodeForHolidayCountry:country]];
+    if (country >= 0 && country < kSLHolidayCountryNumRegions) {
+        return kSLHolidayCountryInfo[country].resourceName;
+    }
+    return nil;
 }
 
 // returns a string that corresponds to the resource name for a given country code
 + (NSString *)resourceNameForCountryCode:(NSString *)countryCode
 {
-    return [NSString stringWithFormat:@"%@_holidays", countryCode];
+    return [SLPrefsManager resourceNameForHolidayCountry:SLHolidayCountryForCountryCode(countryCode)];
 }
 
-// returns the localized, friendly name to be displayed for the given country
+// returns the localized, friendly name to be displayed for the given country (or subdivision, which is displayed along with its country)
 + (NSString *)friendlyNameForHolidayCountry:(SLHolidayCountry)country
 {
     // Check to see if the string returned from displayNameForKey is nil.  This happens on iOS versions that are
     // deployed using Coolbooter for some odd reason.  Default to en_US locale in that situation.
+    if (country < 0 || country >= kSLHolidayCountryNumRegions) {
+        return nil;
+    }
+    SLHolidayCountry parentCountry = kSLHolidayCountryInfo[country].parentCountry;
     NSString *countryName = [[NSLocale currentLocale] displayNameForKey:NSLocaleCountryCode
-                                                                  value:[SLPrefsManager countryCodeForHolidayCountry:country]];
+                                                                  value:kSLHolidayCountryInfo[parentCountry].isoCountryCode];
     if (countryName == nil) {
         countryName = [[NSLocale localeWithLocaleIdentifier:@"en_US"] displayNameForKey:NSLocaleCountryCode
-                                                                                  value:[SLPrefsManager countryCodeForHolidayCountry:country]];
+                                                                                  value:kSLHolidayCountryInfo[parentCountry].isoCountryCode];
+    }
+
+    // the system locale does not have names for the subdivisions, so the name of the subdivision from the registry is used
+    if (kSLHolidayCountryInfo[country].subdivisionName != nil) {
+        countryName = [NSString stringWithFormat:@"%@ (%@)", countryName, kSLHolidayCountryInfo[country].subdivisionName];
     }
     return countryName;
 }
 
+// returns the name to be displayed for the given skip rule, which is either the name given to the rule or a description of the rule
++ (NSString *)friendlyNameForSkipRule:(NSDictionary *)skipRule
+{
+    NSString *name = [skipRule objectForKey:kSLSkipRuleNameKey];
+    if (name.length > 0) {
+        return name;
+    }
+
+    // the weekday symbols start on Sunday, while the weekdays for the rules start on Monday
+    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+    dateFormatter.locale = [NSLocale currentLocale];
+    NSArray *weekdaySymbols = dateFormatter.standaloneWeekdaySymbols;
+    NSString *type = [skipRule objectForKey:kSLSkipRuleTypeKey];
+    NSInteger interval = MAX([[skipRule objectForKey:kSLSkipRuleIntervalKey] integerValue], 1);
+    if ([type isEqualToString:kSLSkipRuleTypeWeeklyString]) {
+        NSInteger weekdays = [[skipRule objectForKey:kSLSkipRuleWeekdaysKey] integerValue];
+        NSMutableArray *weekdayNames = [[NSMutableArray alloc] initWithCapacity:7];
+        for (NSInteger weekday = kSLWeekdayMonday; weekday <= kSLWeekdaySunday; weekday++) {
+            if (weekdays & (1 << weekday)) {
+                [weekdayNames addObject:[weekdaySymbols objectAtIndex:(weekday + 1) % 7]];
+            }
+        }
+        NSString *weekdaysString = [weekdayNames componentsJoinedByString:@", "];
+        if (interval > 1) {
+            return kSLSkipRuleWeeklyIntervalString((long)interval, weekdaysString);
+        }
+        return kSLSkipRuleWeeklyString(weekdaysString);
+    } else if ([type isEqualToString:kSLSkipRuleTypeNthWeekdayString]) {
+        NSInteger weekday = [[skipRule objectForKey:kSLSkipRuleWeekdayKey] integerValue];
+        if (weekday < kSLWeekdayMonday || weekday > kSLWeekdaySunday) {
+            return nil;
+        }
+        NSString *weekdayString = [weekdaySymbols objectAtIndex:(weekday + 1) % 7];
+        NSInteger ordinal = [[skipRule objectForKey:kSLSkipRuleOrdinalKey] integerValue];
+        if (ordinal == kSLHolidayRuleLastOrdinal) {
+            if (interval > 1) {
+                return kSLSkipRuleLastWeekdayIntervalString(weekdayString, (long)interval);
+            }
+            return kSLSkipRuleLastWeekdayString(weekdayString);
+        }
+        if (interval > 1) {
+            return kSLSkipRuleNthWeekdayIntervalString(weekdayString, (long)ordinal, (long)interval);
+        }
+        return kSLSkipRuleNthWeekdayString(weekdayString, (long)ordinal);
+    } else if ([type isEqualToString:kSLSkipRuleTypeDateRangeString]) {
+        NSDate *startDate = [SLPrefsManager dateForSkipDateString:[skipRule objectForKey:kSLSkipRuleStartDateKey]];
+        NSDate *endDate = [SLPrefsManager dateForSkipDateString:[skipRule objectForKey:kSLSkipRuleEndDateKey]];
+        if (startDate == nil || endDate == nil) {
+            return nil;
+        }
+        dateFormatter.dateStyle = NSDateFormatterMediumStyle;
+        dateFormatter.timeStyle = NSDateFormatterNoStyle;
+        return kSLSkipRuleDateRangeString([dateFormatter stringFromDate:startDate], [dateFormatter stringFromDate:endDate]);
+    }
+    return nil;
+}
+
 // returns the localized, friendly name to be displayed for an auto-set option
 + (NSString *)friendlyNameForAutoSetOption:(SLAutoSetOption)autoSetOption
 {
@@ -674,15 +1355,79 @@ static NSDateFormatter *sSLSkipDatesPlistDateFormatter;
     return autoSetOffsetOptionName;
 }
 
+// Merges the all-day events from the iCalendar file at the given path into the given sorted custom skip date strings, returning nil if
+// the file could not be imported.
++ (NSArray *)customSkipDateStrings:(NSArray *)customSkipDateStrings
+     byImportingCalendarFileAtPath:(NSString *)path
+                  numImportedDates:(NSInteger *)numImportedDates
+{
+    FILE *file = fopen([path fileSystemRepresentation], "r");
+    if (file == NULL) {
+        return nil;
+    }
+
+    // only import the days from today onward, since any passed dates would be removed from the preferences anyway
+    SLDay today = [SLHolidayManager dayForDate:[SLClock now]];
+    SLDay *days = NULL;
+    size_t numDays = 0;
+    SLCalendarImportStatus status = SLCalendarImportDaysFromFile(file, today, today + kSLCalendarImportMaxDays - 1, &days, &numDays);
+    fclose(file);
+    if (status != kSLCalendarImportStatusSuccess) {
+        free(days);
+        return nil;
+    }
+
+    // both lists are sorted (the skip date strings sort in the same order as the days), so they can be merged in a single pass
+    NSMutableArray *mergedSkipDateStrings = [[NSMutableArray alloc] initWithCapacity:customSkipDateStrings.count + numDays];
+    NSUInteger skipDateIndex = 0;
+    size_t dayIndex = 0;
+    NSInteger numNewDates = 0;
+    NSString *importedSkipDateString = nil;
+    while (skipDateIndex < customSkipDateStrings.count || dayIndex < numDays) {
+        if (importedSkipDateString == nil && dayIndex < numDays) {
+            importedSkipDateString = SLSkipDateStringForDay(days[dayIndex]);
+        }
+        NSString *skipDateString = skipDateIndex < customSkipDateStrings.count ? [customSkipDateStrings objectAtIndex:skipDateIndex] : nil;
+
+        NSComparisonResult comparison = NSOrderedAscending;
+        if (skipDateString == nil) {
+            comparison = NSOrderedDescending;
+        } else if (importedSkipDateString != nil) {
+            comparison = [skipDateString compare:importedSkipDateString];
+        }
+
+        if (comparison == NSOrderedAscending) {
+            [mergedSkipDateStrings addObject:skipDateString];
+            skipDateIndex++;
+        } else {
+            // an imported date that already exists is only included once
+            [mergedSkipDateStrings addObject:importedSkipDateString];
+            if (comparison == NSOrderedSame) {
+                skipDateIndex++;
+            } else {
+                numNewDates++;
+            }
+            importedSkipDateString = nil;
+            dayIndex++;
+        }
+    }
+    free(days);
+
+    if (numImportedDates != NULL) {
+        *numImportedDates = numNewDates;
+    }
+    return [mergedSkipDateStrings copy];
+}
+
 // Returns a string that represents a date that is going to be skipped.  If showRelativeString is enabled,
 // a relative string is shown instead (i.e. Today, Tomorrow)
 + (NSString *)skipDateStringForDate:(NSDate *)date showRelativeString:(BOOL)showRelativeString
 {
     // check to see if a relative string can be shown instead of the date string
     if (showRelativeString) {
-        if ([[NSCalendar currentCalendar] isDateInToday:date]) {
+        if ([[SLClock calendar] isDateInToday:date]) {
             return kSLTodayString;
-        } else if ([[NSCalendar currentCalendar] isDateInTomorrow:date]) {
+        } else if ([[SLClock calendar] isDateInTomorrow:date]) {
             return kSLTomorrowString;
         }
     }
@@ -0,0 +1,818 @@
+//
+//  SLPrefsReader.c
+//  Portable streaming reader that finds the preferences for a single alarm in the XML or binary preferences file.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLPrefsReader.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <sys/types.h>
+
+// the number of bytes that are read from an XML file at a time
+#define kSLPrefsReadBufferSize          16384
+
+// the maximum length of an element name or dictionary key that is read, where any longer names or keys are not part of the schema
+#define kSLPrefsMaxNameLength           64
+
+// the maximum length of the character data of a number that is read
+#define kSLPrefsMaxNumberLength         64
+
+// the magic bytes (including the version) at the start of a binary property list and the length of the trailer at the end of one
+#define kSLPrefsBinaryMagic             "bplist00"
+#define kSLPrefsBinaryMagicLength       8
+#define kSLPrefsBinaryTrailerLength     32
+
+// the object types of a binary property list (the high nibble of the marker of each object)
+#define kSLPrefsBinaryTypeSimple        0x0
+#define kSLPrefsBinaryTypeInteger       0x1
+#define kSLPrefsBinaryTypeReal          0x2
+#define kSLPrefsBinaryTypeASCIIString   0x5
+#define kSLPrefsBinaryTypeUTF16String   0x6
+#define kSLPrefsBinaryTypeUTF8String    0x7
+#define kSLPrefsBinaryTypeArray         0xA
+#define kSLPrefsBinaryTypeDictionary    0xD
+
+// the values of the simple objects in a binary property list that represent booleans
+#define kSLPrefsBinaryFalse             0x8
+#define kSLPrefsBinaryTrue              0x9
+
+// maps a key of an alarm dictionary to the field of the record that it is read into
+typedef struct SLPrefsAlarmField {
+    const char *key;
+    size_t offset;
+} SLPrefsAlarmField;
+
+// the scalar fields of an alarm that are read into the record
+static const SLPrefsAlarmField kSLPrefsAlarmFields[] = {
+    {kSLPrefsReaderSnoozeHourKey,           offsetof(SLPrefsAlarmRecord, snoozeTimeHour)},
+    {kSLPrefsReaderSnoozeMinuteKey,         offsetof(SLPrefsAlarmRecord, snoozeTimeMinute)},
+    {kSLPrefsReaderSnoozeSecondKey,         offsetof(SLPrefsAlarmRecord, snoozeTimeSecond)},
+    {kSLPrefsReaderSkipEnabledKey,          offsetof(SLPrefsAlarmRecord, skipEnabled)},
+    {kSLPrefsReaderSkipHourKey,             offsetof(SLPrefsAlarmRecord, skipTimeHour)},
+    {kSLPrefsReaderSkipMinuteKey,           offsetof(SLPrefsAlarmRecord, skipTimeMinute)},
+    {kSLPrefsReaderSkipSecondKey,           offsetof(SLPrefsAlarmRecord, skipTimeSecond)},
+    {kSLPrefsReaderSkipActivatedStatusKey,  offsetof(SLPrefsAlarmRecord, skipActivatedStatus)},
+    {kSLPrefsReaderAutoSetOptionKey,        offsetof(SLPrefsAlarmRecord, autoSetOption)},
+    {kSLPrefsReaderAutoSetOffsetOptionKey,  offsetof(SLPrefsAlarmRecord, autoSetOffsetOption)},
+    {kSLPrefsReaderAutoSetOffsetHourKey,    offsetof(SLPrefsAlarmRecord, autoSetOffsetHour)},
+    {kSLPrefsReaderAutoSetOffsetMinuteKey,  offsetof(SLPrefsAlarmRecord, autoSetOffsetMinute)}
+};
+
+// returns the field of the given record that the value for the given key is read into, or NULL if the key is not a scalar field
+static int64_t *SLPrefsAlarmRecordFieldForKey(SLPrefsAlarmRecord *record, const char *key)
+{
+    for (size_t i = 0; i < sizeof(kSLPrefsAlarmFields) / sizeof(kSLPrefsAlarmFields[0]); i++) {
+        if (strcmp(kSLPrefsAlarmFields[i].key, key) == 0) {
+            return (int64_t *)((char *)record + kSLPrefsAlarmFields[i].offset);
+        }
+    }
+    return NULL;
+}
+
+// records the presence of the given key in the record for any of the nested values that are not read
+static void SLPrefsAlarmRecordNoteKey(SLPrefsAlarmRecord *record, const char *key)
+{
+    if (strcmp(key, kSLPrefsReaderSkipDatesKey) == 0) {
+        record->hasSkipDates = 1;
+    } else if (strcmp(key, kSLPrefsReaderSkipProfileIdKey) == 0) {
+        record->hasSkipProfileId = 1;
+    }
+}
+
+// appends the UTF-8 encoding of the given code point to the given string, returning 0 if there is not enough room
+static int SLPrefsAppendUTF8(char *string, size_t size, size_t *length, uint32_t codePoint)
+{
+    char bytes[4];
+    size_t numBytes = 0;
+    if (codePoint < 0x80) {
+        bytes[numBytes++] = (char)codePoint;
+    } else if (codePoint < 0x800) {
+        bytes[numBytes++] = (char)(0xC0 | (codePoint >> 6));
+        bytes[numBytes++] = (char)(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        bytes[numBytes++] = (char)(0xE0 | (codePoint >> 12));
+        bytes[numBytes++] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[numBytes++] = (char)(0x80 | (codePoint & 0x3F));
+    } else {
+        bytes[numBytes++] = (char)(0xF0 | (codePoint >> 18));
+        bytes[numBytes++] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        bytes[numBytes++] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[numBytes++] = (char)(0x80 | (codePoint & 0x3F));
+    }
+    if (*length + numBytes >= size) {
+        return 0;
+    }
+    memcpy(string + *length, bytes, numBytes);
+    *length += numBytes;
+    string[*length] = '\0';
+    return 1;
+}
+
+// buffered reader that is used to stream an XML property list
+typedef struct SLPrefsXMLReader {
+    FILE *file;
+    size_t position;
+    size_t length;
+    int error;
+    unsigned char buffer[kSLPrefsReadBufferSize];
+} SLPrefsXMLReader;
+
+// an element tag that was read from an XML property list
+typedef struct SLPrefsXMLTag {
+    char name[kSLPrefsMaxNameLength];
+    // set for an end tag (i.e. </dict>)
+    int isEnd;
+    // set for an empty element tag (i.e. <true/>)
+    int isEmpty;
+} SLPrefsXMLTag;
+
+// returns the next byte from the file, or EOF at the end of the file or if the file could not be read
+static int SLPrefsXMLNextByte(SLPrefsXMLReader *reader)
+{
+    if (reader->position == reader->length) {
+        reader->length = fread(reader->buffer, 1, kSLPrefsReadBufferSize, reader->file);
+        reader->position = 0;
+        if (reader->length == 0) {
+            if (ferror(reader->file)) {
+                reader->error = 1;
+            }
+            return EOF;
+        }
+    }
+    return reader->buffer[reader->position++];
+}
+
+// Skips past the given terminator (which is at most 3 characters long), optionally appending the skipped characters (without the
+// terminator) to the given text.  Returns 0 if the end of the file is reached first.
+static int SLPrefsXMLSkipPast(SLPrefsXMLReader *reader, const char *terminator, char *text, size_t textSize, size_t *textLength, int *truncated)
+{
+    size_t terminatorLength = strlen(terminator);
+    char window[4] = {0};
+    for (;;) {
+        int c = SLPrefsXMLNextByte(reader);
+        if (c == EOF) {
+            return 0;
+        }
+        memmove(window, window + 1, 2);
+        window[2] = (char)c;
+        if (memcmp(window + 3 - terminatorLength, terminator, terminatorLength) == 0) {
+            // remove the rest of the terminator that was already appended to the text
+            if (text != NULL && !*truncated) {
+                *textLength -= terminatorLength - 1;
+                text[*textLength] = '\0';
+            }
+            return 1;
+        }
+        if (text != NULL) {
+            if (*textLength + 1 < textSize) {
+                text[(*textLength)++] = (char)c;
+                text[*textLength] = '\0';
+            } else {
+                *truncated = 1;
+            }
+        }
+    }
+}
+
+// decodes the predefined and numeric character references in the given text in place
+static void SLPrefsXMLDecodeText(char *text)
+{
+    size_t readIndex = 0;
+    size_t writeIndex = 0;
+    while (text[readIndex] != '\0') {
+        char *reference = text + readIndex;
+        char *end = reference[0] == '&' ? strchr(reference, ';') : NULL;
+        if (end == NULL) {
+            text[writeIndex++] = text[readIndex++];
+            continue;
+        }
+
+        size_t referenceLength = end - reference + 1;
+        uint32_t codePoint = 0;
+        if (strncmp(reference, "&amp;", referenceLength) == 0) {
+            codePoint = '&';
+        } else if (strncmp(reference, "&lt;", referenceLength) == 0) {
+            codePoint = '<';
+        } else if (strncmp(reference, "&gt;", referenceLength) == 0) {
+            codePoint = '>';
+        } else if (strncmp(reference, "&quot;", referenceLength) == 0) {
+            codePoint = '"';
+        } else if (strncmp(reference, "&apos;", referenceLength) == 0) {
+            codePoint = '\'';
+        } else if (reference[1] == '#') {
+            codePoint = (uint32_t)(reference[2] == 'x' ? strtoul(reference + 3, NULL, 16) : strtoul(reference + 2, NULL, 10));
+        }
+
+        // a reference always takes at least as many bytes as its encoding, so the text can be decoded in place
+        size_t encodedLength = 0;
+        char encoded[5];
+        if (codePoint == 0 || codePoint > 0x10FFFF || !SLPrefsAppendUTF8(encoded, sizeof(encoded), &encodedLength, codePoint)) {
+            text[writeIndex++] = text[readIndex++];
+            continue;
+        }
+        memcpy(text + writeIndex, encoded, encodedLength);
+        writeIndex += encodedLength;
+        readIndex += referenceLength;
+    }
+    text[writeIndex] = '\0';
+}
+
+// Reads the next element tag, skipping any processing instructions, comments, and declarations.  The character data before the tag
+// (including any CDATA sections) is decoded into the given text if one is given.  Returns 0 if the end of the file is reached first.
+static int SLPrefsXMLNextTag(SLPrefsXMLReader *reader, SLPrefsXMLTag *tag, char *text, size_t textSize, int *truncated)
+{
+    size_t textLength = 0;
+    int textTruncated = 0;
+    if (text != NULL) {
+        text[0] = '\0';
+    }
+
+    for (;;) {
+        int c = SLPrefsXMLNextByte(reader);
+        if (c == EOF) {
+            return 0;
+        }
+        if (c != '<') {
+            if (text != NULL) {
+                if (textLength + 1 < textSize) {
+                    text[textLength++] = (char)c;
+                    text[textLength] = '\0';
+                } else {
+                    textTruncated = 1;
+                }
+            }
+            continue;
+        }
+
+        c = SLPrefsXMLNextByte(reader);
+        if (c == '?') {
+            if (!SLPrefsXMLSkipPast(reader, "?>", NULL, 0, NULL, NULL)) {
+                return 0;
+            }
+            continue;
+        } else if (c == '!') {
+            int first = SLPrefsXMLNextByte(reader);
+            int second = SLPrefsXMLNextByte(reader);
+            if (first == '-' && second == '-') {
+                if (!SLPrefsXMLSkipPast(reader, "-->", NULL, 0, NULL, NULL)) {
+                    return 0;
+                }
+            } else if (first == '[' && second == 'C') {
+                // the rest of the CDATA section opening ("DATA[") is skipped before its contents are appended to the text
+                for (int i = 0; i < 5; i++) {
+                    if (SLPrefsXMLNextByte(reader) == EOF) {
+                        return 0;
+                    }
+                }
+                if (!SLPrefsXMLSkipPast(reader, "]]>", text, textSize, &textLength, &textTruncated)) {
+                    return 0;
+                }
+            } else if (second != '>' && !SLPrefsXMLSkipPast(reader, ">", NULL, 0, NULL, NULL)) {
+                return 0;
+            }
+            continue;
+        }
+
+        // read the name of the element, ignoring any attributes
+        tag->isEnd = 0;
+        tag->isEmpty = 0;
+        if (c == '/') {
+            tag->isEnd = 1;
+            c = SLPrefsXMLNextByte(reader);
+        }
+        size_t nameLength = 0;
+        while (c != EOF && c != '>' && c != '/' && !isspace(c)) {
+            if (nameLength + 1 < sizeof(tag->name)) {
+                tag->name[nameLength++] = (char)c;
+            }
+            c = SLPrefsXMLNextByte(reader);
+        }
+        tag->name[nameLength] = '\0';
+        int previous = 0;
+        while (c != '>') {
+            if (c == EOF) {
+                return 0;
+            }
+            previous = c;
+            c = SLPrefsXMLNextByte(reader);
+        }
+        tag->isEmpty = previous == '/';
+
+        if (text != NULL) {
+            SLPrefsXMLDecodeText(text);
+        }
+        if (truncated != NULL) {
+            *truncated = textTruncated;
+        }
+        return 1;
+    }
+}
+
+// skips the rest of the value that starts with the given tag (including any nested values), returning 0 if the file is invalid
+static int SLPrefsXMLSkipValue(SLPrefsXMLReader *reader, const SLPrefsXMLTag *startTag)
+{
+    if (startTag->isEmpty) {
+        return 1;
+    }
+
+    SLPrefsXMLTag tag;
+    int depth = 1;
+    while (depth > 0) {
+        if (!SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL)) {
+            return 0;
+        }
+        if (tag.isEnd) {
+            --depth;
+        } else if (!tag.isEmpty) {
+            ++depth;
+        }
+    }
+    return 1;
+}
+
+// reads the character data of the element that starts with the given tag, returning 0 if the element is not a simple value
+static int SLPrefsXMLReadText(SLPrefsXMLReader *reader, const SLPrefsXMLTag *startTag, char *text, size_t textSize, int *truncated)
+{
+    *truncated = 0;
+    if (startTag->isEmpty) {
+        text[0] = '\0';
+        return 1;
+    }
+
+    SLPrefsXMLTag tag;
+    return SLPrefsXMLNextTag(reader, &tag, text, textSize, truncated) && tag.isEnd;
+}
+
+// reads the number or boolean that starts with the given tag into the given value, where any other values are skipped
+static int SLPrefsXMLReadInteger(SLPrefsXMLReader *reader, const SLPrefsXMLTag *startTag, int64_t *value)
+{
+    char text[kSLPrefsMaxNumberLength];
+    int truncated = 0;
+    if (strcmp(startTag->name, "true") == 0 || strcmp(startTag->name, "false") == 0) {
+        *value = startTag->name[0] == 't';
+        return SLPrefsXMLSkipValue(reader, startTag);
+    } else if (strcmp(startTag->name, "integer") == 0) {
+        if (!SLPrefsXMLReadText(reader, startTag, text, sizeof(text), &truncated)) {
+            return 0;
+        }
+        *value = strtoll(text, NULL, 10);
+        return 1;
+    } else if (strcmp(startTag->name, "real") == 0) {
+        if (!SLPrefsXMLReadText(reader, startTag, text, sizeof(text), &truncated)) {
+            return 0;
+        }
+        *value = (int64_t)strtod(text, NULL);
+        return 1;
+    }
+    return SLPrefsXMLSkipValue(reader, startTag);
+}
+
+// Reads the alarm dictionary that was just started into the given record.  Returns 1 if the alarm has the given Id or 0 if it does not (in
+// which case the rest of the dictionary is skipped as soon as the Id is read), or -1 if the file is invalid.
+static int SLPrefsXMLReadAlarm(SLPrefsXMLReader *reader, const char *alarmId, SLPrefsAlarmRecord *record)
+{
+    memset(record, 0, sizeof(SLPrefsAlarmRecord));
+    int matched = 0;
+    char key[kSLPrefsMaxNameLength];
+    char value[kSLPrefsReaderMaxStringLength + 1];
+    SLPrefsXMLTag tag;
+    for (;;) {
+        // read the next key (or the end of the dictionary) along with the tag that starts the value
+        int truncated = 0;
+        if (!SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL)) {
+            return -1;
+        }
+        if (tag.isEnd) {
+            return matched;
+        }
+        if (strcmp(tag.name, "key") != 0 || !SLPrefsXMLReadText(reader, &tag, key, sizeof(key), &truncated) ||
+            !SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL) || tag.isEnd) {
+            return -1;
+        }
+
+        int64_t *field = NULL;
+        if (strcmp(key, kSLPrefsReaderAlarmIdKey) == 0) {
+            int isString = strcmp(tag.name, "string") == 0;
+            if (isString && !SLPrefsXMLReadText(reader, &tag, value, sizeof(value), &truncated)) {
+                return -1;
+            }
+            if (!isString || truncated || strcmp(value, alarmId) != 0) {
+                // skip the rest of the dictionary (along with the value if it was not read) without reading any other values
+                SLPrefsXMLTag dictionaryTag = {"dict", 0, 0};
+                if ((!isString && !SLPrefsXMLSkipValue(reader, &tag)) || !SLPrefsXMLSkipValue(reader, &dictionaryTag)) {
+                    return -1;
+                }
+                return 0;
+            }
+            matched = 1;
+        } else if (!truncated && (field = SLPrefsAlarmRecordFieldForKey(record, key)) != NULL) {
+            if (!SLPrefsXMLReadInteger(reader, &tag, field)) {
+                return -1;
+            }
+        } else {
+            SLPrefsAlarmRecordNoteKey(record, key);
+            if (!SLPrefsXMLSkipValue(reader, &tag)) {
+                return -1;
+            }
+        }
+    }
+}
+
+// finds the alarm with the given Id in the XML property list that is being read by the given reader
+static SLPrefsReaderStatus SLPrefsXMLFindAlarm(SLPrefsXMLReader *reader, const char *alarmId, SLPrefsAlarmRecord *record)
+{
+    // find the root dictionary of the property list
+    SLPrefsXMLTag tag;
+    do {
+        if (!SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL)) {
+            return kSLPrefsReaderStatusInvalidFile;
+        }
+    } while (tag.isEnd || strcmp(tag.name, "plist") != 0);
+    if (!SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL) || tag.isEnd || strcmp(tag.name, "dict") != 0) {
+        return kSLPrefsReaderStatusInvalidFile;
+    }
+    if (tag.isEmpty) {
+        return kSLPrefsReaderStatusNotFound;
+    }
+
+    char key[kSLPrefsMaxNameLength];
+    for (;;) {
+        int truncated = 0;
+        if (!SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL)) {
+            return kSLPrefsReaderStatusInvalidFile;
+        }
+        if (tag.isEnd) {
+            return kSLPrefsReaderStatusNotFound;
+        }
+        if (strcmp(tag.name, "key") != 0 || !SLPrefsXMLReadText(reader, &tag, key, sizeof(key), &truncated) ||
+            !SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL) || tag.isEnd) {
+            return kSLPrefsReaderStatusInvalidFile;
+        }
+
+        // any other values in the root dictionary are skipped
+        if (truncated || strcmp(key, kSLPrefsReaderAlarmsKey) != 0 || strcmp(tag.name, "array") != 0 || tag.isEmpty) {
+            if (!SLPrefsXMLSkipValue(reader, &tag)) {
+                return kSLPrefsReaderStatusInvalidFile;
+            }
+            continue;
+        }
+
+        // the file only contains a single array of alarms, so the reading can stop once the end of the array is reached
+        for (;;) {
+            if (!SLPrefsXMLNextTag(reader, &tag, NULL, 0, NULL)) {
+                return kSLPrefsReaderStatusInvalidFile;
+            }
+            if (tag.isEnd) {
+                return kSLPrefsReaderStatusNotFound;
+            }
+            if (strcmp(tag.name, "dict") == 0 && !tag.isEmpty) {
+                int result = SLPrefsXMLReadAlarm(reader, alarmId, record);
+                if (result > 0) {
+                    return kSLPrefsReaderStatusFound;
+                } else if (result < 0) {
+                    return kSLPrefsReaderStatusInvalidFile;
+                }
+            } else if (!SLPrefsXMLSkipValue(reader, &tag)) {
+                return kSLPrefsReaderStatusInvalidFile;
+            }
+        }
+    }
+}
+
+// reader that is used to read the objects from a binary property list, which only reads the objects that are needed from the file
+typedef struct SLPrefsBinaryReader {
+    FILE *file;
+    size_t offsetIntSize;
+    size_t objectRefSize;
+    uint64_t numObjects;
+    uint64_t topObject;
+    uint64_t offsetTableOffset;
+    int error;
+} SLPrefsBinaryReader;
+
+// reads the big-endian, unsigned integer of the given size (1 to 8 bytes) at the given position in the file
+static int SLPrefsBinaryReadUInt(SLPrefsBinaryReader *reader, uint64_t position, size_t size, uint64_t *value)
+{
+    unsigned char bytes[8];
+    if (size == 0 || size > sizeof(bytes) || fseeko(reader->file, (off_t)position, SEEK_SET) != 0 ||
+        fread(bytes, 1, size, reader->file) != size) {
+        if (ferror(reader->file)) {
+            reader->error = 1;
+        }
+        return 0;
+    }
+
+    *value = 0;
+    for (size_t i = 0; i < size; i++) {
+        *value = (*value << 8) | bytes[i];
+    }
+    return 1;
+}
+
+// Reads the marker of the given object, returning the type, the number of elements (for strings and containers) or the low nibble of the
+// marker (for any other objects), and the position of the data of the object.
+static int SLPrefsBinaryReadObject(SLPrefsBinaryReader *reader, uint64_t objectRef, int *type, uint64_t *count, uint64_t *dataPosition)
+{
+    uint64_t offset;
+    uint64_t marker;
+    if (objectRef >= reader->numObjects ||
+        !SLPrefsBinaryReadUInt(reader, reader->offsetTableOffset + objectRef * reader->offsetIntSize, reader->offsetIntSize, &offset) ||
+        offset < kSLPrefsBinaryMagicLength || offset >= reader->offsetTableOffset || !SLPrefsBinaryReadUInt(reader, offset, 1, &marker)) {
+        return 0;
+    }
+
+    *type = (int)(marker >> 4);
+    *count = marker & 0xF;
+    *dataPosition = offset + 1;
+
+    // strings and containers with 15 or more elements store the number of elements as an integer object after the marker
+    int hasCount = *type == kSLPrefsBinaryTypeASCIIString || *type == kSLPrefsBinaryTypeUTF16String ||
+                   *type == kSLPrefsBinaryTypeUTF8String || *type == kSLPrefsBinaryTypeArray || *type == kSLPrefsBinaryTypeDictionary;
+    if (hasCount && *count == 0xF) {
+        uint64_t countMarker;
+        if (!SLPrefsBinaryReadUInt(reader, *dataPosition, 1, &countMarker) || (countMarker >> 4) != kSLPrefsBinaryTypeInteger ||
+            (countMarker & 0xF) > 3) {
+            return 0;
+        }
+        size_t countSize = (size_t)1 << (countMarker & 0xF);
+        if (!SLPrefsBinaryReadUInt(reader, *dataPosition + 1, countSize, count)) {
+            return 0;
+        }
+        *dataPosition += 1 + countSize;
+    }
+    return *dataPosition <= reader->offsetTableOffset;
+}
+
+// reads the given object reference from the references that start at the given position
+static int SLPrefsBinaryReadRef(SLPrefsBinaryReader *reader, uint64_t position, uint64_t index, uint64_t *objectRef)
+{
+    return SLPrefsBinaryReadUInt(reader, position + index * reader->objectRefSize, reader->objectRefSize, objectRef);
+}
+
+// returns whether or not the references of a container with the given number of elements (or keys and values) are within the objects
+static int SLPrefsBinaryContainerFits(SLPrefsBinaryReader *reader, uint64_t dataPosition, uint64_t count, uint64_t numRefsPerElement)
+{
+    return count <= (reader->offsetTableOffset - dataPosition) / (reader->objectRefSize * numRefsPerElement);
+}
+
+// reads the given string object as a UTF-8 string, returning 0 if the object is not a string or does not fit in the given string
+static int SLPrefsBinaryReadString(SLPrefsBinaryReader *reader, uint64_t objectRef, char *string, size_t size)
+{
+    int type;
+    uint64_t count;
+    uint64_t dataPosition;
+    if (!SLPrefsBinaryReadObject(reader, objectRef, &type, &count, &dataPosition)) {
+        return 0;
+    }
+
+    if (type == kSLPrefsBinaryTypeASCIIString || type == kSLPrefsBinaryTypeUTF8String) {
+        if (count >= size || fseeko(reader->file, (off_t)dataPosition, SEEK_SET) != 0 ||
+            fread(string, 1, (size_t)count, reader->file) != count) {
+            return 0;
+        }
+        string[count] = '\0';
+        return 1;
+    } else if (type == kSLPrefsBinaryTypeUTF16String) {
+        // every UTF-16 code unit takes at least one byte in UTF-8, so any longer strings can be rejected before reading them
+        if (count >= size || fseeko(reader->file, (off_t)dataPosition, SEEK_SET) != 0) {
+            return 0;
+        }
+        size_t length = 0;
+        string[0] = '\0';
+        for (uint64_t i = 0; i < count; i++) {
+            int high = fgetc(reader->file);
+            int low = fgetc(reader->file);
+            if (high == EOF || low == EOF) {
+                return 0;
+            }
+            uint32_t codePoint = ((uint32_t)high << 8) | (uint32_t)low;
+
+            // combine any surrogate pairs into a single code point
+            if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 1 < count) {
+                int nextHigh = fgetc(reader->file);
+                int nextLow = fgetc(reader->file);
+                if (nextHigh == EOF || nextLow == EOF) {
+                    return 0;
+                }
+                uint32_t lowSurrogate = ((uint32_t)nextHigh << 8) | (uint32_t)nextLow;
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                ++i;
+            }
+            if (!SLPrefsAppendUTF8(string, size, &length, codePoint)) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
+
+// reads the given number or boolean object into the given value, where any other objects are ignored
+static int SLPrefsBinaryReadInteger(SLPrefsBinaryReader *reader, uint64_t objectRef, int64_t *value)
+{
+    int type;
+    uint64_t info;
+    uint64_t dataPosition;
+    uint64_t bits;
+    if (!SLPrefsBinaryReadObject(reader, objectRef, &type, &info, &dataPosition)) {
+        return 0;
+    }
+
+    if (type == kSLPrefsBinaryTypeSimple) {
+        if (info == kSLPrefsBinaryFalse || info == kSLPrefsBinaryTrue) {
+            *value = info == kSLPrefsBinaryTrue;
+        }
+    } else if (type == kSLPrefsBinaryTypeInteger) {
+        // integers of 8 bytes are signed, while the 16 byte integers are only used for values that do not fit in a signed integer
+        if (info > 4 || !SLPrefsBinaryReadUInt(reader, dataPosition + (info == 4 ? 8 : 0), info == 4 ? 8 : (size_t)1 << info, &bits)) {
+            return 0;
+        }
+        *value = (int64_t)bits;
+    } else if (type == kSLPrefsBinaryTypeReal) {
+        if (info == 2) {
+            float real;
+            uint32_t realBits;
+            if (!SLPrefsBinaryReadUInt(reader, dataPosition, sizeof(realBits), &bits)) {
+                return 0;
+            }
+            realBits = (uint32_t)bits;
+            memcpy(&real, &realBits, sizeof(real));
+            *value = (int64_t)real;
+        } else if (info == 3) {
+            double real;
+            if (!SLPrefsBinaryReadUInt(reader, dataPosition, sizeof(bits), &bits)) {
+                return 0;
+            }
+            memcpy(&real, &bits, sizeof(real));
+            *value = (int64_t)real;
+        }
+    }
+    return 1;
+}
+
+// finds the value for the given key in the given dictionary object, returning 1 if the key was found
+static int SLPrefsBinaryDictionaryValue(SLPrefsBinaryReader *reader, uint64_t dictionaryRef, const char *key, uint64_t *valueRef)
+{
+    int type;
+    uint64_t count;
+    uint64_t dataPosition;
+    if (!SLPrefsBinaryReadObject(reader, dictionaryRef, &type, &count, &dataPosition) || type != kSLPrefsBinaryTypeDictionary ||
+        !SLPrefsBinaryContainerFits(reader, dataPosition, count, 2)) {
+        return 0;
+    }
+
+    char dictionaryKey[kSLPrefsMaxNameLength];
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t keyRef;
+        if (!SLPrefsBinaryReadRef(reader, dataPosition, i, &keyRef)) {
+            return 0;
+        }
+        if (SLPrefsBinaryReadString(reader, keyRef, dictionaryKey, sizeof(dictionaryKey)) && strcmp(dictionaryKey, key) == 0) {
+            return SLPrefsBinaryReadRef(reader, dataPosition, count + i, valueRef);
+        }
+    }
+    return 0;
+}
+
+// reads every scalar value of the given alarm dictionary object into the given record
+static int SLPrefsBinaryReadAlarm(SLPrefsBinaryReader *reader, uint64_t alarmRef, SLPrefsAlarmRecord *record)
+{
+    int type;
+    uint64_t count;
+    uint64_t dataPosition;
+    if (!SLPrefsBinaryReadObject(reader, alarmRef, &type, &count, &dataPosition) || type != kSLPrefsBinaryTypeDictionary ||
+        !SLPrefsBinaryContainerFits(reader, dataPosition, count, 2)) {
+        return 0;
+    }
+
+    memset(record, 0, sizeof(SLPrefsAlarmRecord));
+    char key[kSLPrefsMaxNameLength];
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t keyRef;
+        uint64_t valueRef;
+        if (!SLPrefsBinaryReadRef(reader, dataPosition, i, &keyRef)) {
+            return 0;
+        }
+        if (!SLPrefsBinaryReadString(reader, keyRef, key, sizeof(key))) {
+            continue;
+        }
+
+        int64_t *field = SLPrefsAlarmRecordFieldForKey(record, key);
+        if (field != NULL) {
+            if (!SLPrefsBinaryReadRef(reader, dataPosition, count + i, &valueRef) || !SLPrefsBinaryReadInteger(reader, valueRef, field)) {
+                return 0;
+            }
+        } else {
+            SLPrefsAlarmRecordNoteKey(record, key);
+        }
+    }
+    return 1;
+}
+
+// finds the alarm with the given Id in the binary property list that is being read by the given reader
+static SLPrefsReaderStatus SLPrefsBinaryFindAlarm(SLPrefsBinaryReader *reader, const char *alarmId, SLPrefsAlarmRecord *record)
+{
+    // read the trailer at the end of the file, which describes where the objects are
+    unsigned char trailer[kSLPrefsBinaryTrailerLength];
+    if (fseeko(reader->file, 0, SEEK_END) != 0) {
+        reader->error = 1;
+        return kSLPrefsReaderStatusReadError;
+    }
+    off_t fileSize = ftello(reader->file);
+    if (fileSize < kSLPrefsBinaryMagicLength + kSLPrefsBinaryTrailerLength ||
+        fseeko(reader->file, fileSize - kSLPrefsBinaryTrailerLength, SEEK_SET) != 0 ||
+        fread(trailer, 1, sizeof(trailer), reader->file) != sizeof(trailer)) {
+        return kSLPrefsReaderStatusInvalidFile;
+    }
+    reader->offsetIntSize = trailer[6];
+    reader->objectRefSize = trailer[7];
+    reader->numObjects = 0;
+    reader->topObject = 0;
+    reader->offsetTableOffset = 0;
+    for (int i = 0; i < 8; i++) {
+        reader->numObjects = (reader->numObjects << 8) | trailer[8 + i];
+        reader->topObject = (reader->topObject << 8) | trailer[16 + i];
+        reader->offsetTableOffset = (reader->offsetTableOffset << 8) | trailer[24 + i];
+    }
+    uint64_t objectTableEnd = (uint64_t)fileSize - kSLPrefsBinaryTrailerLength;
+    if (reader->offsetIntSize == 0 || reader->offsetIntSize > 8 || reader->objectRefSize == 0 || reader->objectRefSize > 8 ||
+        reader->offsetTableOffset < kSLPrefsBinaryMagicLength || reader->offsetTableOffset > objectTableEnd ||
+        reader->numObjects > (objectTableEnd - reader->offsetTableOffset) / reader->offsetIntSize) {
+        return kSLPrefsReaderStatusInvalidFile;
+    }
+
+    // find the array of alarms in the root dictionary
+    int type;
+    uint64_t count;
+    uint64_t dataPosition;
+    uint64_t alarmsRef;
+    if (!SLPrefsBinaryDictionaryValue(reader, reader->topObject, kSLPrefsReaderAlarmsKey, &alarmsRef)) {
+        return reader->error ? kSLPrefsReaderStatusReadError : kSLPrefsReaderStatusNotFound;
+    }
+    if (!SLPrefsBinaryReadObject(reader, alarmsRef, &type, &count, &dataPosition) || type != kSLPrefsBinaryTypeArray ||
+        !SLPrefsBinaryContainerFits(reader, dataPosition, count, 1)) {
+        return reader->error ? kSLPrefsReaderStatusReadError : kSLPrefsReaderStatusInvalidFile;
+    }
+
+    // only the Id of each alarm is read until the alarm is found
+    char otherAlarmId[kSLPrefsReaderMaxStringLength + 1];
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t alarmRef;
+        uint64_t alarmIdRef;
+        if (!SLPrefsBinaryReadRef(reader, dataPosition, i, &alarmRef)) {
+            return reader->error ? kSLPrefsReaderStatusReadError : kSLPrefsReaderStatusInvalidFile;
+        }
+        if (SLPrefsBinaryDictionaryValue(reader, alarmRef, kSLPrefsReaderAlarmIdKey, &alarmIdRef) &&
+            SLPrefsBinaryReadString(reader, alarmIdRef, otherAlarmId, sizeof(otherAlarmId)) && strcmp(otherAlarmId, alarmId) == 0) {
+            if (!SLPrefsBinaryReadAlarm(reader, alarmRef, record)) {
+                return reader->error ? kSLPrefsReaderStatusReadError : kSLPrefsReaderStatusInvalidFile;
+            }
+            return kSLPrefsReaderStatusFound;
+        }
+    }
+    return reader->error ? kSLPrefsReaderStatusReadError : kSLPrefsReaderStatusNotFound;
+}
+
+// Finds the alarm with the given (UTF-8) alarm Id in the given XML or binary property list file and reads its scalar preferences into the
+// given record.  The file is read with a fixed amount of memory, where the other alarms are skipped without creating any objects and the
+// reading stops as soon as the alarm is found.
+SLPrefsReaderStatus SLPrefsReaderFindAlarm(FILE *file, const char *alarmId, SLPrefsAlarmRecord *record)
+{
+    if (file == NULL || alarmId == NULL || record == NULL || strlen(alarmId) > kSLPrefsReaderMaxStringLength) {
+        return kSLPrefsReaderStatusInvalidFile;
+    }
+    memset(record, 0, sizeof(SLPrefsAlarmRecord));
+
+    // the format of the file is determined by the magic bytes at the start of the file
+    char magic[kSLPrefsBinaryMagicLength];
+    size_t magicLength = fread(magic, 1, sizeof(magic), file);
+    if (ferror(file)) {
+        return kSLPrefsReaderStatusReadError;
+    }
+    if (magicLength == kSLPrefsBinaryMagicLength && memcmp(magic, kSLPrefsBinaryMagic, kSLPrefsBinaryMagicLength) == 0) {
+        SLPrefsBinaryReader reader;
+        memset(&reader, 0, sizeof(reader));
+        reader.file = file;
+        return SLPrefsBinaryFindAlarm(&reader, alarmId, record);
+    }
+
+    // the XML reader is large enough that it is allocated rather than placed on the stack
+    SLPrefsXMLReader *reader = calloc(1, sizeof(SLPrefsXMLReader));
+    if (reader == NULL) {
+        return kSLPrefsReaderStatusReadError;
+    }
+    reader->file = file;
+    memcpy(reader->buffer, magic, magicLength);
+    reader->length = magicLength;
+    SLPrefsReaderStatus status = SLPrefsXMLFindAlarm(reader, alarmId, record);
+    if (status == kSLPrefsReaderStatusInvalidFile && reader->error) {
+        status = kSLPrefsReaderStatusReadError;
+    }
+    free(reader);
+    return status;
+}
@@ -0,0 +1,80 @@
+//
+//  SLPrefsReader.h
+//  Portable streaming reader that finds the preferences for a single alarm in the XML or binary preferences file.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLPrefsReader_h
+#define SLPrefsReader_h
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the maximum length of an alarm Id (in UTF-8 bytes) that can be found by the reader
+#define kSLPrefsReaderMaxStringLength   255
+
+// the keys from the preferences file that are read (these must match the keys that are defined in SLPrefsManager.h)
+#define kSLPrefsReaderAlarmsKey                 "Alarms"
+#define kSLPrefsReaderAlarmIdKey                "alarmId"
+#define kSLPrefsReaderSnoozeHourKey             "snoozeTimeHour"
+#define kSLPrefsReaderSnoozeMinuteKey           "snoozeTimeMinute"
+#define kSLPrefsReaderSnoozeSecondKey           "snoozeTimeSecond"
+#define kSLPrefsReaderSkipEnabledKey            "skipEnabled"
+#define kSLPrefsReaderSkipHourKey               "skipTimeHour"
+#define kSLPrefsReaderSkipMinuteKey             "skipTimeMinute"
+#define kSLPrefsReaderSkipSecondKey             "skipTimeSecond"
+#define kSLPrefsReaderSkipActivatedStatusKey    "skipActivatedStatus"
+#define kSLPrefsReaderAutoSetOptionKey          "autoSetOption"
+#define kSLPrefsReaderAutoSetOffsetOptionKey    "autoSetOffsetOption"
+#define kSLPrefsReaderAutoSetOffsetHourKey      "autoSetOffsetHour"
+#define kSLPrefsReaderAutoSetOffsetMinuteKey    "autoSetOffsetMinute"
+#define kSLPrefsReaderSkipDatesKey              "skipDates"
+#define kSLPrefsReaderSkipProfileIdKey          "skipProfileId"
+
+// the results of reading the preferences file
+typedef enum SLPrefsReaderStatus {
+    // the alarm was found and its preferences were read
+    kSLPrefsReaderStatusFound,
+    // the file was read, but it does not contain the alarm
+    kSLPrefsReaderStatusNotFound,
+    // the file is not a property list that the reader understands (or the alarm Id is too long)
+    kSLPrefsReaderStatusInvalidFile,
+    // the file could not be read
+    kSLPrefsReaderStatusReadError
+} SLPrefsReaderStatus;
+
+// The scalar preferences for a single alarm.  Any values that are missing from the file are 0, while booleans are read as 0 or 1.  The
+// nested skip dates are not read, although the record indicates whether or not the alarm has them (or uses a skip profile).
+typedef struct SLPrefsAlarmRecord {
+    int64_t snoozeTimeHour;
+    int64_t snoozeTimeMinute;
+    int64_t snoozeTimeSecond;
+    int64_t skipEnabled;
+    int64_t skipTimeHour;
+    int64_t skipTimeMinute;
+    int64_t skipTimeSecond;
+    int64_t skipActivatedStatus;
+    int64_t autoSetOption;
+    int64_t autoSetOffsetOption;
+    int64_t autoSetOffsetHour;
+    int64_t autoSetOffsetMinute;
+    int hasSkipDates;
+    int hasSkipProfileId;
+} SLPrefsAlarmRecord;
+
+// Finds the alarm with the given (UTF-8) alarm Id in the given XML or binary property list file and reads its scalar preferences into the
+// given record.  The file is read with a fixed amount of memory, where the other alarms are skipped without creating any objects and the
+// reading stops as soon as the alarm is found.
+SLPrefsReaderStatus SLPrefsReaderFindAlarm(FILE *file, const char *alarmId, SLPrefsAlarmRecord *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLPrefsReader_h */
@@ -0,0 +1,111 @@
+//
+//  SLSkipRules.c
+//  Portable evaluation of the recurring skip rules that can be configured for an alarm.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLSkipRules.h"
+#include <stdlib.h>
+
+// performs a floor division (rounding towards negative infinity) which is needed for days prior to the start of a rule
+static int32_t SLSkipRuleFloorDivide(int32_t a, int32_t b)
+{
+    return (a >= 0) ? a / b : (a - b + 1) / b;
+}
+
+// compares two day numbers for a binary search
+static int SLSkipRuleCompareDays(const void *lhs, const void *rhs)
+{
+    SLDay lhsDay = *(const SLDay *)lhs;
+    SLDay rhsDay = *(const SLDay *)rhs;
+    return (lhsDay > rhsDay) - (lhsDay < rhsDay);
+}
+
+// parses a skip date string from the preferences (i.e. "2026-10-19") into a day number, returning 0 if the string is not a valid date
+int SLSkipRuleParseDateString(const char *dateString, SLDay *day)
+{
+    int32_t values[3] = {0, 0, 0};
+    int32_t numDigits[3] = {0, 0, 0};
+    int component = 0;
+    for (const char *c = dateString; c != NULL && *c != '\0'; c++) {
+        if (*c >= '0' && *c <= '9' && numDigits[component] < 4) {
+            values[component] = values[component] * 10 + (*c - '0');
+            numDigits[component]++;
+        } else if (*c == '-' && component < 2) {
+            component++;
+        } else {
+            return 0;
+        }
+    }
+    if (component != 2 || numDigits[0] != 4 || values[1] < 1 || values[1] > 12 || values[2] < 1 || values[2] > SLDaysInMonth(values[0], values[1])) {
+        return 0;
+    }
+    *day = SLDayFromCivil(values[0], values[1], values[2]);
+    return 1;
+}
+
+// returns whether or not the given skip rule occurs on the given day, which is evaluated without expanding the rule
+int SLSkipRuleOccursOnDay(const SLSkipRule *rule, SLDay day)
+{
+    if (day < rule->startDay || day > rule->endDay) {
+        return 0;
+    }
+
+    int32_t interval = rule->interval > 0 ? rule->interval : 1;
+    switch (rule->type) {
+        case kSLSkipRuleTypeWeekly: {
+            SLWeekday weekday = SLWeekdayForDay(day);
+            if (!(rule->weekdays & (1 << weekday))) {
+                return 0;
+            }
+            // count the weeks (starting on Monday) between the week of the start day and the week of the given day
+            SLDay weekStartDay = day - (SLDay)weekday;
+            SLDay firstWeekStartDay = rule->startDay - (SLDay)SLWeekdayForDay(rule->startDay);
+            return SLSkipRuleFloorDivide(weekStartDay - firstWeekStartDay, kSLWeekdayNumWeekdays) % interval == 0;
+        }
+        case kSLSkipRuleTypeNthWeekday: {
+            if (SLWeekdayForDay(day) != rule->weekday) {
+                return 0;
+            }
+            int32_t year, month, dayOfMonth;
+            int32_t startYear, startMonth;
+            SLCivilFromDay(day, &year, &month, &dayOfMonth);
+            SLCivilFromDay(rule->startDay, &startYear, &startMonth, NULL);
+            if (((year - startYear) * 12 + (month - startMonth)) % interval != 0) {
+                return 0;
+            }
+            if (rule->ordinal == kSLHolidayRuleLastOrdinal) {
+                return dayOfMonth + kSLWeekdayNumWeekdays > SLDaysInMonth(year, month);
+            }
+            return (dayOfMonth - 1) / kSLWeekdayNumWeekdays + 1 == rule->ordinal;
+        }
+        case kSLSkipRuleTypeDateRange:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Finds the first day on or after the given day (searching at most kSLSkipRuleMaxSearchDays) that the given skip rule occurs on,
+// ignoring any of the given sorted excluded days.  Returns 0 if the rule does not occur again.
+int SLSkipRuleNextDay(const SLSkipRule *rule, SLDay day, const SLDay *excludedDays, size_t numExcludedDays, SLDay *nextDay)
+{
+    if (day < rule->startDay) {
+        day = rule->startDay;
+    }
+    SLDay lastDay = rule->endDay;
+    if (lastDay - day >= kSLSkipRuleMaxSearchDays) {
+        lastDay = day + kSLSkipRuleMaxSearchDays - 1;
+    }
+
+    for (; day <= lastDay; day++) {
+        if (SLSkipRuleOccursOnDay(rule, day) &&
+            (numExcludedDays == 0 || bsearch(&day, excludedDays, numExcludedDays, sizeof(SLDay), SLSkipRuleCompareDays) == NULL)) {
+            *nextDay = day;
+            return 1;
+        }
+    }
+    return 0;
+}
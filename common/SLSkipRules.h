@@ -0,0 +1,63 @@
+//
+//  SLSkipRules.h
+//  Portable evaluation of the recurring skip rules that can be configured for an alarm.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLSkipRules_h
+#define SLSkipRules_h
+
+#include "SLHolidayRules.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the day that is used as the end of a skip rule that does not end
+#define kSLSkipRuleNoEndDay             INT32_MAX
+
+// the maximum number of days that are searched when finding the next day that a skip rule occurs
+#define kSLSkipRuleMaxSearchDays        (366 * 10)
+
+// the types of recurring skip rules (these must match the type strings that are stored in the preferences)
+typedef enum SLSkipRuleType {
+    // the rule occurs on particular weekdays of every nth week, counting from the week of the start day
+    kSLSkipRuleTypeWeekly,
+    // the rule occurs on the nth (or last) weekday of every nth month, counting from the month of the start day
+    kSLSkipRuleTypeNthWeekday,
+    // the rule occurs on every day from the start day through the end day
+    kSLSkipRuleTypeDateRange
+} SLSkipRuleType;
+
+// a single compiled skip rule, which has the same size regardless of how many days the rule occurs on
+typedef struct SLSkipRule {
+    SLSkipRuleType type;
+    // the first and last days (inclusive) that the rule can occur on
+    SLDay startDay;
+    SLDay endDay;
+    // the number of weeks (weekly rules) or months (nth weekday rules) between each occurrence
+    int32_t interval;
+    // a mask of the weekdays that a weekly rule occurs on (using the SLWeekday values as bit positions)
+    uint8_t weekdays;
+    // the weekday and ordinal (1-5 or kSLHolidayRuleLastOrdinal) that an nth weekday rule occurs on
+    SLWeekday weekday;
+    int32_t ordinal;
+} SLSkipRule;
+
+// parses a skip date string from the preferences (i.e. "2026-10-19") into a day number, returning 0 if the string is not a valid date
+int SLSkipRuleParseDateString(const char *dateString, SLDay *day);
+
+// returns whether or not the given skip rule occurs on the given day, which is evaluated without expanding the rule
+int SLSkipRuleOccursOnDay(const SLSkipRule *rule, SLDay day);
+
+// Finds the first day on or after the given day (searching at most kSLSkipRuleMaxSearchDays) that the given skip rule occurs on,
+// ignoring any of the given sorted excluded days.  Returns 0 if the rule does not occur again.
+int SLSkipRuleNextDay(const SLSkipRule *rule, SLDay day, const SLDay *excludedDays, size_t numExcludedDays, SLDay *nextDay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLSkipRules_h */
@@ -1,44 +1,37 @@
 //
 //  SLSpringBoard.x
-//  Hooks into the SpringBoard application to run our singleton process that will potentially monitor changes to timers.
+//  Hooks into the SpringBoard application to run our singleton processes that will potentially monitor changes to timers and maintain the preferences.
 //
 //  Created by Joshua Seltzer on 7/2/2020.
 //
 //
 
 #import <Foundation/Foundation.h>
-#import <Foundation/NSDistributedNotificationCenter.h>
 #import "../common/SLCompatibilityHelper.h"
 #import "../common/SLAutoSetManager.h"
+#import "../common/SLMaintenanceManager.h"
 
-%hook SpringBoard
+@class UIApplication;
 
-// called whenever an auto-set alarm needs to be updated
-%new
-- (void)SLAutoSetOptionsUpdated:(NSNotification *)notification
-{
-    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        // notify the auto-set manager that an alarm has updated auto-set options
-        [[SLAutoSetManager sharedInstance] updateAutoSetAlarm:[notification userInfo]];
-    });
-}
+%hook SpringBoard
 
 - (void)applicationDidFinishLaunching:(UIApplication *)application
 {
     %orig;
 
-    // create the auto-set manager instance to potentially monitor changes to alarms
-    [SLAutoSetManager sharedInstance];
+    // create the maintenance manager instance to periodically remove orphaned alarms and expired skip dates
+    [SLMaintenanceManager sharedInstance];
 
-    // observe changes from the auto-set manager to update alarms with updated auto-set options
-    [[NSDistributedNotificationCenter defaultCenter] addObserver:self selector:@selector(SLAutoSetOptionsUpdated:) name:kSLAutoSetOptionsUpdatedNotification object:nil];
+    // the auto-set feature is only available for particular versions
+    if ([SLCompatibilityHelper canHaveAutoSet]) {
+        // start the auto-set manager after SpringBoard has settled to potentially monitor changes to alarms (the manager observes the
+        // updates to the auto-set options on its own)
+        [[SLAutoSetManager sharedInstance] startDeferred];
+    }
 }
 
 %end
 
 %ctor {
-    // only initialize this file for particular versions
-    if ([SLCompatibilityHelper canHaveAutoSet]) {
-        %init();
-    }
+    %init();
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+//
+//  SLCompatibilityHelper+UserInterface.h
+//  User interface functions that maintain system compatibility between different iOS versions.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import "../SLCompatibilityHelper.h"
+
+// The user interface functions are kept out of the core library so that processes without any user interface (i.e. mobiletimerd) do
+// not load the colors, images, and alert controller customizations.  These are only available to the user interface tweak and to
+// SpringBoard, which loads the user interface support library when it starts.
+@interface SLCompatibilityHelper (UserInterface)
+
+// returns the picker view's background color, which will depend on the iOS version
++ (UIColor *)pickerViewBackgroundColor;
+
+// returns the color of the standard labels used throughout the tweak
++ (UIColor *)defaultLabelColor;
+
+// returns the color of the destructive labels used throughout the tweak
++ (UIColor *)destructiveLabelColor;
+
+// iOS 13: returns the background color used for cells used in the various views
++ (UIColor *)tableViewCellBackgroundColor;
+
+// iOS 10, iOS 11, iOS 12, iOS 13: returns the cell selection background color for cells
++ (UIColor *)tableViewCellSelectedBackgroundColor;
+
+// modifies an alert controller's subviews appropriately if necessary for the current version of iOS
++ (void)updateSubviewsForAlertController:(UIAlertController *)alertController;
+
+// uses the appearance API to modify the look and feel of a UIAlertController's various views for the current version of iOS
++ (void)updateDefaultUIAlertControllerAppearance;
+
+// returns the checkmark image used to indicate selection throughout the UI
++ (UIImage *)checkmarkImage;
+
+// returns the "open in" image
++ (UIImage *)openInImage;
+
+// navigates the user to the Weather application
++ (void)openWeatherApplication;
+
+// returns an NSBundle object corresponding to the SleepHealthUI Private Framework
++ (NSBundle *)sleepHealthUIBundle;
+
+@end
@@ -0,0 +1,261 @@
+//
+//  SLCompatibilityHelper+UserInterface.m
+//  User interface functions that maintain system compatibility between different iOS versions.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#import "SLCompatibilityHelper+UserInterface.h"
+#import "../SLPrefsManager.h"
+#import <objc/runtime.h>
+
+// the name of the image files as it exists in the bundle
+#define kSLCheckmarkImageName           @"checkmark"
+#define kSLOpenInImageName              @"open_in"
+
+@interface LSApplicationWorkspace : NSObject
+
+// returns the default app workspace for the device (i.e. shared instance)
++ (id)defaultWorkspace;
+
+// opens the application on the device corresponding to the given bundle identifier
+- (BOOL)openApplicationWithBundleID:(NSString *)bundleId;
+
+@end
+
+// define an extension to UIView to allow for customization of a UIAlertController's background colors using associated objects
+@interface UIView (AssociatedObject)
+
+@property (nonatomic, strong) id subviewsBackgroundColor;
+
+@end
+
+@implementation UIView (AssociatedObject)
+@dynamic subviewsBackgroundColor;
+
+- (id)subviewsBackgroundColor
+{
+    return objc_getAssociatedObject(self, @selector(subviewsBackgroundColor));
+}
+- (void)setSubviewsBackgroundColor:(id)color
+{
+    objc_setAssociatedObject(self, @selector(subviewsBackgroundColor), color, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    for (UIView *subview in self.subviews) {
+        subview.backgroundColor = color;
+    }
+}
+
+@end
+
+// define some static color objects that will be used throughout the UI
+static UIColor *sSLPickerViewBackgroundColor = nil;
+static UIColor *sSLDefaultLabelColor = nil;
+static UIColor *sSLDestructiveLabelColor = nil;
+static UIColor *sSLTableViewCellBackgroundColor = nil;
+static UIColor *sSLTableViewCellSelectedBackgroundColor = nil;
+static UIColor *sSLAlertControllerDarkBackgroundColor = nil;
+static UIColor *sSLAlertControllerDarkLineSeparatorColor = nil;
+
+// keep a single, static instance of the UIImages used throughout the UI
+static UIImage *sSLCheckmarkImage;
+static UIImage *sSLOpenInImage;
+
+// define the path for the bundle corresponding to the SleepHealthUI PrivateFramework (introduced with iOS 14)
+static NSString *const kSLSleepHealthUIPrivateFrameworkPath = @"/System/Library/PrivateFrameworks/SleepHealthUI.framework";
+
+@implementation SLCompatibilityHelper (UserInterface)
+
+// returns the picker view's background color, which will depend on the iOS version
++ (UIColor *)pickerViewBackgroundColor
+{
+    // check the version of iOS that the device is running to determine which color to pick
+    if (!sSLPickerViewBackgroundColor) {
+        if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13) {
+            if (@available(iOS 13.0, *)) {
+                // use the new system grouped background color if available
+                sSLPickerViewBackgroundColor = [UIColor systemGroupedBackgroundColor];
+            } else {
+                // fallback to the color that was extracted from the time picker
+                sSLPickerViewBackgroundColor = [UIColor colorWithRed:0.109804 green:0.109804 blue:0.117647 alpha:1.0];
+            }
+        } else if (kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
+            sSLPickerViewBackgroundColor = [UIColor blackColor];
+        } else {
+            sSLPickerViewBackgroundColor = [UIColor whiteColor];
+        }
+    }
+
+    return sSLPickerViewBackgroundColor;
+}
+
+// returns the color of the standard labels used throughout the tweak
++ (UIColor *)defaultLabelColor
+{
+    // check the version of iOS that the device is running to determine which color to pick
+    if (!sSLDefaultLabelColor) {
+        if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13 || kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
+            sSLDefaultLabelColor = [UIColor whiteColor];
+        } else {
+            sSLDefaultLabelColor = [UIColor blackColor];
+        }
+    }
+    
+    return sSLDefaultLabelColor;
+}
+
+// returns the color of the destructive labels used throughout the tweak
++ (UIColor *)destructiveLabelColor
+{
+    if (!sSLDestructiveLabelColor) {
+        sSLDestructiveLabelColor = [UIColor colorWithRed:1.0
+                                                   green:0.231373
+                                                    blue:0.188235
+                                                   alpha:1.0];
+    }
+    return sSLDestructiveLabelColor;
+}
+
+// iOS 13: returns the background color used for cells used in the various views
++ (UIColor *)tableViewCellBackgroundColor
+{
+    if (!sSLTableViewCellBackgroundColor) {
+        if (@available(iOS 13.0, *)) {
+            sSLTableViewCellBackgroundColor = [UIColor secondarySystemGroupedBackgroundColor];
+        } else {
+            sSLTableViewCellBackgroundColor = [UIColor colorWithRed:0.172549 green:0.172549 blue:0.180392 alpha:1.0];
+        }
+    }
+    return sSLTableViewCellBackgroundColor;
+}
+
+// returns the cell selection background color for cells
++ (UIColor *)tableViewCellSelectedBackgroundColor
+{
+    if (!sSLTableViewCellSelectedBackgroundColor) {
+        if (kSLSystemVersioniOS14 || kSLSystemVersioniOS13) {
+            if (@available(iOS 13.0, *)) {
+                sSLTableViewCellSelectedBackgroundColor = [UIColor quaternaryLabelColor];
+            } else {
+                sSLTableViewCellSelectedBackgroundColor = [UIColor colorWithRed:0.922 green:0.922 blue:0.961 alpha:0.180];
+            }
+        } else {
+            sSLTableViewCellSelectedBackgroundColor = [UIColor colorWithRed:52.0 / 255.0
+                                                                      green:52.0 / 255.0
+                                                                       blue:52.0 / 255.0
+                                                                      alpha:1.0];
+        }
+    }
+    return sSLTableViewCellSelectedBackgroundColor;
+}
+
+// iOS 10, iOS 11, iOS 12: returns the custom background color applied to some of the subviews contained in a UIAlertController to mimic the dark appearance
+// Note this is not necessary in iOS 13 since the alert controller uses the native dark mode APIs
++ (UIColor *)alertControllerDarkBackgroundColor
+{
+    if (!sSLAlertControllerDarkBackgroundColor) {
+        sSLAlertControllerDarkBackgroundColor = [UIColor colorWithRed:41.0 / 255.0
+                                                                green:41.0 / 255.0
+                                                                 blue:41.0 / 255.0
+                                                                alpha:1.0];
+    }
+    return sSLAlertControllerDarkBackgroundColor;
+}
+
+// iOS 10, iOS 11, iOS 12: returns the custom background color for the line separators that are used in UIAlertControllers
+// Note this is not necessary in iOS 13 since the alert controller uses the native dark mode APIs
++ (UIColor *)alertControllerDarkLineSeparatorColor
+{
+    if (!sSLAlertControllerDarkLineSeparatorColor) {
+        sSLAlertControllerDarkLineSeparatorColor = [UIColor colorWithRed:101.0 / 255.0
+                                                                   green:101.0 / 255.0
+                                                                    blue:101.0 / 255.0
+                                                                   alpha:1.0];
+    }
+    return sSLAlertControllerDarkLineSeparatorColor;
+}
+
+// modifies an alert controller's subviews appropriately if necessary for the current version of iOS
++ (void)updateSubviewsForAlertController:(UIAlertController *)alertController
+{
+    // iterate through the alert controller's subviews to set the background color of the action buttons (not including the cancel buttons)
+    UIView *firstSubview = alertController.view.subviews.firstObject;
+    if (firstSubview != nil && firstSubview.subviews.count > 0) {
+        UIView *secondSubview = firstSubview.subviews.firstObject;
+        for (UIView *subview in secondSubview.subviews) {
+            subview.backgroundColor = [SLCompatibilityHelper alertControllerDarkBackgroundColor];
+        }
+    }
+
+    // for alert styles of UIAlertController, update the title and message font color
+    if (alertController.preferredStyle == UIAlertControllerStyleAlert) {
+        // modify the title and message text with the correct foreground color
+        NSMutableAttributedString *modifiedTitle = [[NSMutableAttributedString alloc] initWithString:alertController.title];
+        [modifiedTitle addAttribute:NSForegroundColorAttributeName value:[SLCompatibilityHelper defaultLabelColor] range:NSMakeRange(0, alertController.title.length)];
+        [modifiedTitle addAttribute:NSFontAttributeName value:[UIFont boldSystemFontOfSize:17.0] range:NSMakeRange(0, alertController.title.length)];
+        [alertController setValue:modifiedTitle forKey:@"attributedTitle"];
+        NSMutableAttributedString *modifiedMessage = [[NSMutableAttributedString alloc] initWithString:alertController.message];
+        [modifiedMessage addAttribute:NSForegroundColorAttributeName value:[SLCompatibilityHelper defaultLabelColor] range:NSMakeRange(0, alertController.message.length)];
+        [modifiedMessage addAttribute:NSFontAttributeName value:[UIFont systemFontOfSize:13.0] range:NSMakeRange(0, alertController.message.length)];
+        [alertController setValue:modifiedMessage forKey:@"attributedMessage"];
+    }
+}
+
+// Uses the appearance API to modify the look and feel of a UIAlertController's various views for the current version of iOS
+// This method will take care of coloring the header of the alert (only for action sheet alerts), the cancel button, and the separator lines
++ (void)updateDefaultUIAlertControllerAppearance
+{
+    // modify the header view of an alert controller (only applicable to UIAlertControllerStyleActionSheet)
+    ((UIView *)[NSClassFromString(@"_UIInterfaceActionGroupHeaderScrollView") appearance]).subviewsBackgroundColor = [SLCompatibilityHelper alertControllerDarkBackgroundColor];
+    
+    // modify the cancel button's background view
+    ((UIView *)[NSClassFromString(@"_UIAlertControlleriOSActionSheetCancelBackgroundView") appearance]).subviewsBackgroundColor = [SLCompatibilityHelper alertControllerDarkBackgroundColor];
+
+    // modify the colors of various views to display the selection of the action correctly
+    ((UIView *)[NSClassFromString(@"_UIBlendingHighlightView") appearanceWhenContainedIn:NSClassFromString(@"_UIInterfaceActionCustomViewRepresentationView"), nil]).backgroundColor = [SLCompatibilityHelper tableViewCellSelectedBackgroundColor];
+    ((UIView *)[NSClassFromString(@"_UIBlendingHighlightView") appearanceWhenContainedIn:NSClassFromString(@"_UIAlertControlleriOSActionSheetCancelBackgroundView"), nil]).alpha = 0.92;
+    ((UIView *)[NSClassFromString(@"_UIBlendingHighlightView") appearanceWhenContainedIn:NSClassFromString(@"_UIInterfaceActionCustomViewRepresentationView"), nil]).subviewsBackgroundColor = [UIColor clearColor];
+
+    // modify the separator line colors
+    ((UIView *)[NSClassFromString(@"_UIInterfaceActionItemSeparatorView_iOS") appearance]).backgroundColor = [SLCompatibilityHelper alertControllerDarkLineSeparatorColor];
+    ((UIView *)[NSClassFromString(@"_UIInterfaceActionItemSeparatorView_iOS") appearance]).subviewsBackgroundColor = [UIColor clearColor];
+}
+
+// returns the checkmark image used to indicate selection throughout the UI
++ (UIImage *)checkmarkImage
+{
+    if (!sSLCheckmarkImage) {
+        sSLCheckmarkImage = [[UIImage imageNamed:kSLCheckmarkImageName
+                                        inBundle:kSLSleeperBundle
+                   compatibleWithTraitCollection:nil] imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
+    }
+    return sSLCheckmarkImage;
+}
+
+// returns the "open in" image
++ (UIImage *)openInImage
+{
+    if (!sSLOpenInImage) {
+        sSLOpenInImage = [[UIImage imageNamed:kSLOpenInImageName
+                                     inBundle:kSLSleeperBundle
+                compatibleWithTraitCollection:nil] imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
+    }
+    return sSLOpenInImage;
+}
+
+// navigates the user to the Weather application
++ (void)openWeatherApplication
+{
+    LSApplicationWorkspace *appWorkspace = [objc_getClass("LSApplicationWorkspace") defaultWorkspace];
+    if (appWorkspace != nil && [appWorkspace respondsToSelector:@selector(openApplicationWithBundleID:)]) {
+        [appWorkspace openApplicationWithBundleID:kSLWeatherAppBundleId];
+    }
+}
+
+// returns an NSBundle object corresponding to the SleepHealthUI Private Framework
++ (NSBundle *)sleepHealthUIBundle
+{
+    return [NSBundle bundleWithPath:kSLSleepHealthUIPrivateFrameworkPath];
+}
+
+@end
@@ -6,7 +6,8 @@
 //
 //
 
-#import "SLCommonHeaders.h"
+#import <UIKit/UIKit.h>
+#import "../SLCommonHeaders.h"
 
 // a system alert item
 @interface SBAlertItem : NSObject
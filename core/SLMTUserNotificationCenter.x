@@ -9,6 +9,7 @@
 #import "../common/SLPrefsManager.h"
 #import "../common/SLAlarmPrefs.h"
 #import "../common/SLCompatibilityHelper.h"
+#import "../common/SLAuditLog.h"
 
 // trigger object which signifies why an alarm was fired
 @interface MTTrigger : NSObject
@@ -60,8 +61,12 @@
         // get the sleeper alarm preferences for this alarm
         SLAlarmPrefs *alarmPrefs = [SLPrefsManager alarmPrefsForAlarmId:sleeperAlarmId];
         if (alarmPrefs) {
-            // only activate the actual alarm if we should not be skipping this alarm
-            if (![alarmPrefs shouldSkipToday]) {
+            // only activate the actual alarm if we should not be skipping this alarm (recording the decision in the audit log)
+            SLAuditCause cause;
+            BOOL shouldSkip = [alarmPrefs shouldSkipTodayWithCause:&cause];
+            SLAuditLogAppend(kSLAuditHookSetSpecificContent, [sleeperAlarmId UTF8String], shouldSkip ? kSLAuditDecisionSkip : kSLAuditDecisionFire,
+                             cause);
+            if (!shouldSkip) {
                 %orig;
             }
 
@@ -71,6 +76,8 @@
                                              skipActivatedStatus:kSLSkipActivatedStatusUnknown];
             }
         } else {
+            SLAuditCause cause = {kSLAuditReasonNoPrefs, 0, 0};
+            SLAuditLogAppend(kSLAuditHookSetSpecificContent, [sleeperAlarmId UTF8String], kSLAuditDecisionFire, cause);
             %orig;
         }
     } else {
@@ -6,8 +6,10 @@
 //
 //
 
-#import "../common/SLSkipAlarmAlertItem.h"
+#import "../common/ui/SLSkipAlarmAlertItem.h"
 #import "../common/SLCompatibilityHelper.h"
+#import "../common/SLClock.h"
+#import "../common/SLAccounting.h"
 
 %hook SBLockScreenViewControllerBase
 
@@ -15,15 +17,16 @@
 - (void)prepareForUIUnlock
 {
     %orig;
+    SLAccountingEnter(kSLAccountingEntryPointUnlockScan);
 
     // check first to see if an existing skip alarm alert is being shown
     SBAlertItemsController *alertItemsController = (SBAlertItemsController *)[objc_getClass("SBAlertItemsController") sharedInstance];
     if (![alertItemsController hasAlertOfClass:objc_getClass("SLSkipAlarmAlertItem")]) {
         // get dates for today and tomorrow so we can properly determine if any of those alarms need to be skipped
-        NSDate *today = [NSDate date];
+        NSDate *today = [SLClock now];
         NSDateComponents *dateComponents = [[NSDateComponents alloc] init];
         dateComponents.day = 1;
-        NSCalendar *calendar = [NSCalendar currentCalendar];
+        NSCalendar *calendar = [SLClock calendar];
         NSDate *tomorrow = [calendar dateByAddingComponents:dateComponents toDate:[calendar startOfDayForDate:today] options:0];
 
         // get the list of next alarms for today and tomorrow from the alarm manager
@@ -54,11 +57,14 @@
             // after a slight delay, show an alert that will ask the user to skip the alarm on the main thread
             dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC));
             dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
-                // create and display the custom alert item
-                SLSkipAlarmAlertItem *alert = [[objc_getClass("SLSkipAlarmAlertItem") alloc] initWithTitle:alarmTitle
-                                                                                                   alarmId:alarmId
-                                                                                              nextFireDate:nextFireDate];
-                [alertItemsController activateAlertItem:alert animated:YES];
+                // create and display the custom alert item, which loads the user interface support library the first time it is shown
+                Class skipAlarmAlertItemClass = [SLCompatibilityHelper skipAlarmAlertItemClass];
+                if (skipAlarmAlertItemClass != nil) {
+                    SLSkipAlarmAlertItem *alert = [[skipAlarmAlertItemClass alloc] initWithTitle:alarmTitle
+                                                                                         alarmId:alarmId
+                                                                                    nextFireDate:nextFireDate];
+                    [alertItemsController activateAlertItem:alert animated:YES];
+                }
             });
         }
     }
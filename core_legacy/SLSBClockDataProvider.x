@@ -8,6 +8,7 @@
 
 #import "../common/SLCompatibilityHelper.h"
 #import "../common/SLPrefsManager.h"
+#import "../common/SLAuditLog.h"
 
 %group iOS10iOS11
 
@@ -27,8 +28,12 @@
         // get the sleeper alarm preferences for this alarm
         SLAlarmPrefs *alarmPrefs = [SLPrefsManager alarmPrefsForAlarmId:alarmId];
         if (alarmPrefs) {
-            // only activate the actual alarm if we should not be skipping this alarm
-            if (![alarmPrefs shouldSkipToday]) {
+            // only activate the actual alarm if we should not be skipping this alarm (recording the decision in the audit log)
+            SLAuditCause cause;
+            BOOL shouldSkip = [alarmPrefs shouldSkipTodayWithCause:&cause];
+            SLAuditLogAppend(kSLAuditHookPublishBulletin, [alarmId UTF8String], shouldSkip ? kSLAuditDecisionSkip : kSLAuditDecisionFire,
+                             cause);
+            if (!shouldSkip) {
                 %orig;
             }
 
@@ -38,6 +43,8 @@
                                             skipActivatedStatus:kSLSkipActivatedStatusUnknown];
             }
         } else {
+            SLAuditCause cause = {kSLAuditReasonNoPrefs, 0, 0};
+            SLAuditLogAppend(kSLAuditHookPublishBulletin, [alarmId UTF8String], kSLAuditDecisionFire, cause);
             %orig;
         }
     } else {
@@ -67,8 +74,12 @@
         // get the sleeper alarm preferences for this alarm
         SLAlarmPrefs *alarmPrefs = [SLPrefsManager alarmPrefsForAlarmId:alarmId];
         if (alarmPrefs) {
-            // check to see if this alarm should be skipped
-            if ([alarmPrefs shouldSkipToday]) {
+            // check to see if this alarm should be skipped (recording the decision in the audit log)
+            SLAuditCause cause;
+            BOOL shouldSkip = [alarmPrefs shouldSkipTodayWithCause:&cause];
+            SLAuditLogAppend(kSLAuditHookPublishBulletinLegacy, [alarmId UTF8String], shouldSkip ? kSLAuditDecisionSkip : kSLAuditDecisionFire,
+                             cause);
+            if (shouldSkip) {
                 // grab the alarm that we are going to ask to skip from the shared alarm manager
                 AlarmManager *alarmManager = (AlarmManager *)[objc_getClass("AlarmManager") sharedManager];
                 [alarmManager loadAlarms];
@@ -87,6 +98,8 @@
                                             skipActivatedStatus:kSLSkipActivatedStatusUnknown];
             }
         } else {
+            SLAuditCause cause = {kSLAuditReasonNoPrefs, 0, 0};
+            SLAuditLogAppend(kSLAuditHookPublishBulletinLegacy, [alarmId UTF8String], kSLAuditDecisionFire, cause);
             %orig;
         }
     } else {
@@ -6,8 +6,9 @@
 //
 //
 
-#import "../common/SLSkipAlarmAlertItem.h"
+#import "../common/ui/SLSkipAlarmAlertItem.h"
 #import "../common/SLCompatibilityHelper.h"
+#import "../common/SLClock.h"
 
 %hook SBLockScreenManager
 
@@ -44,15 +45,18 @@
                     dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.1 * NSEC_PER_SEC));
                     dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
                         // get the fire date of the alarm we are going to display
-                        NSDate *nextTriggerDate = [((UNLegacyNotificationTrigger *)nextAlarmNotificationRequest.trigger) _nextTriggerDateAfterDate:[NSDate date]
+                        NSDate *nextTriggerDate = [((UNLegacyNotificationTrigger *)nextAlarmNotificationRequest.trigger) _nextTriggerDateAfterDate:[SLClock now]
                                                                                                                                 withRequestedDate:nil
                                                                                                                                 defaultTimeZone:[NSTimeZone localTimeZone]];
                         
-                        // create and display the custom alert item
-                        SLSkipAlarmAlertItem *alert = [[objc_getClass("SLSkipAlarmAlertItem") alloc] initWithTitle:[SLCompatibilityHelper alarmTitleForAlarm:alarm]
-                                                                                                        alarmId:alarmId
-                                                                                                    nextFireDate:nextTriggerDate];
-                        [alertItemsController activateAlertItem:alert animated:YES];
+                        // create and display the custom alert item, which loads the user interface support library the first time it is shown
+                        Class skipAlarmAlertItemClass = [SLCompatibilityHelper skipAlarmAlertItemClass];
+                        if (skipAlarmAlertItemClass != nil) {
+                            SLSkipAlarmAlertItem *alert = [[skipAlarmAlertItemClass alloc] initWithTitle:[SLCompatibilityHelper alarmTitleForAlarm:alarm]
+                                                                                                 alarmId:alarmId
+                                                                                            nextFireDate:nextTriggerDate];
+                            [alertItemsController activateAlertItem:alert animated:YES];
+                        }
                     });
                 }
             }
@@ -6,8 +6,9 @@
 //
 //
 
-#import "../common/SLSkipAlarmAlertItem.h"
+#import "../common/ui/SLSkipAlarmAlertItem.h"
 #import "../common/SLCompatibilityHelper.h"
+#import "../common/SLClock.h"
 
 %hook SBLockScreenViewController
 
@@ -39,14 +40,17 @@
             dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.1 * NSEC_PER_SEC));
             dispatch_after(popTime, dispatch_get_main_queue(), ^(void) {
                 // get the fire date of the alarm we are going to display
-                NSDate *alarmFireDate = [nextAlarmNotification nextFireDateAfterDate:[NSDate date]
+                NSDate *alarmFireDate = [nextAlarmNotification nextFireDateAfterDate:[SLClock now]
                                                                        localTimeZone:[NSTimeZone localTimeZone]];
                 
-                // create and display the custom alert item
-                SLSkipAlarmAlertItem *alert = [[objc_getClass("SLSkipAlarmAlertItem") alloc] initWithTitle:[SLCompatibilityHelper alarmTitleForAlarm:alarm]
-                                                                                                   alarmId:alarmId
-                                                                                              nextFireDate:alarmFireDate];
-                [alertItemsController activateAlertItem:alert animated:YES];
+                // create and display the custom alert item, which loads the user interface support library the first time it is shown
+                Class skipAlarmAlertItemClass = [SLCompatibilityHelper skipAlarmAlertItemClass];
+                if (skipAlarmAlertItemClass != nil) {
+                    SLSkipAlarmAlertItem *alert = [[skipAlarmAlertItemClass alloc] initWithTitle:[SLCompatibilityHelper alarmTitleForAlarm:alarm]
+                                                                                         alarmId:alarmId
+                                                                                    nextFireDate:alarmFireDate];
+                    [alertItemsController activateAlertItem:alert animated:YES];
+                }
             });
         }
     }
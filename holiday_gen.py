@@ -3,8 +3,8 @@
 import sys
 import os
 import re
+import glob
 import datetime
-import holidays
 import plistlib
 
 # years which will be generated for any given country
@@ -12,8 +12,9 @@ START_YEAR = 2023
 END_YEAR = 2050
 
 # constants used to modify holidays upon generation
-OBSERVED_TEXT = "(Observed)"
-THANKSGIVING_TEXT = "Thanksgiving"
+OBSERVED_PATTERN = re.compile(r"\s*\(observed\)", re.IGNORECASE)
+HOLIDAY_NAME_SEPARATOR = "; "
+THANKSGIVING_TEXT = "Thanksgiving Day"
 DAY_AFTER_THANKSGIVING_TEXT = "Day After Thanksgiving"
 MARTIN_LUTHER_KING_JR_TEXT = "Martin Luther King, Jr. Day"
 CHRISTMAS_DAY_TEXT = "Christmas Day"
@@ -24,123 +25,836 @@ NEW_YEARS_EVE_TEXT = "New Year's Eve"
 # path to the Sleeper bundle which is used to store the holidays and localized strings
 SLEEPER_BUNDLE_PATH = "layout/Library/Application Support/Sleeper.bundle"
 
+# path to the fixtures of the host tests, which contain the dates that each holiday resource was compiled from
+HOLIDAY_FIXTURES_PATH = "tests/fixtures/holidays"
+
+# paths to the generated registry of holiday countries that is compiled into the tweak
+COUNTRY_REGISTRY_HEADER_PATH = "common/SLHolidayCountries.h"
+COUNTRY_REGISTRY_SOURCE_PATH = "common/SLHolidayCountries.m"
+
+# The countries that are available to choose from for the holiday selection, in the order of the holiday country enum.  Each country
+# lists the name used for the enum, the code used for the holiday resource, and the ISO 3166-1 code that is used by the system locale.
+# The resource codes do not always match the ISO codes since they were named after the holidays library that generated them.
+HOLIDAY_COUNTRIES = [
+    ("Argentina", "ar", "AR"),
+    ("Aruba", "aw", "AW"),
+    ("Australia", "au", "AU"),
+    ("Austria", "at", "AT"),
+    ("Belarus", "by", "BY"),
+    ("Belgium", "be", "BE"),
+    ("Brazil", "br", "BR"),
+    ("Bulgaria", "bg", "BG"),
+    ("Canada", "ca", "CA"),
+    ("China", "cn", "CN"),
+    ("Colombia", "co", "CO"),
+    ("Croatia", "hr", "HR"),
+    ("Czechia", "cz", "CZ"),
+    ("Denmark", "dk", "DK"),
+    ("DominicanRepublic", "do", "DO"),
+    ("Egypt", "eg", "EG"),
+    ("Estonia", "ee", "EE"),
+    ("Finland", "fi", "FI"),
+    ("France", "fra", "FR"),
+    ("Germany", "de", "DE"),
+    ("HongKong", "hk", "HK"),
+    ("Hungary", "hu", "HU"),
+    ("Iceland", "is", "IS"),
+    ("India", "ind", "IN"),
+    ("Ireland", "ie", "IE"),
+    ("Israel", "il", "IL"),
+    ("Italy", "it", "IT"),
+    ("Japan", "jp", "JP"),
+    ("Kenya", "ke", "KE"),
+    ("Korea", "kr", "KR"),
+    ("Lithuania", "lt", "LT"),
+    ("Luxembourg", "lu", "LU"),
+    ("Mexico", "mx", "MX"),
+    ("Morocco", "ma", "MA"),
+    ("Netherlands", "nl", "NL"),
+    ("NewZealand", "nz", "NZ"),
+    ("Nicaragua", "ni", "NI"),
+    ("Nigeria", "ng", "NG"),
+    ("Norway", "no", "NO"),
+    ("Paraguay", "py", "PY"),
+    ("Peru", "pe", "PE"),
+    ("Poland", "pl", "PL"),
+    ("Portugal", "pt", "PT"),
+    ("Russia", "ru", "RU"),
+    ("Serbia", "rs", "RS"),
+    ("Singapore", "sg", "SG"),
+    ("Slovakia", "sk", "SK"),
+    ("Slovenia", "si", "SI"),
+    ("SouthAfrica", "za", "ZA"),
+    ("Spain", "es", "ES"),
+    ("Sweden", "se", "SE"),
+    ("Switzerland", "ch", "CH"),
+    ("Taiwan", "tw", "TW"),
+    ("Turkey", "tr", "TR"),
+    ("Ukraine", "ua", "UA"),
+    ("UnitedKingdom", "uk", "GB"),
+    ("UnitedStates", "us", "US"),
+    ("Vietnam", "vn", "VN"),
+]
+
+# The subdivisions (states, provinces, Länder, or cantons) that are available to choose from for the holiday selection, keyed by the
+# resource code of the country that they belong to.  Each subdivision lists the code used by the holidays library (which is also the
+# ISO 3166-2 code without the country prefix) and the name that is displayed for the subdivision.  A subdivision only stores the holidays
+# that differ from the holidays of its country, which are compared with the holiday resource of the country that is already in the bundle
+# ("holiday_gen.py US all").
+HOLIDAY_SUBDIVISIONS = {
+    "au": [("ACT", "Australian Capital Territory"), ("NSW", "New South Wales"), ("NT", "Northern Territory"), ("QLD", "Queensland"),
+           ("SA", "South Australia"), ("TAS", "Tasmania"), ("VIC", "Victoria"), ("WA", "Western Australia")],
+    "ch": [("AG", "Aargau"), ("AI", "Appenzell Innerrhoden"), ("AR", "Appenzell Ausserrhoden"), ("BE", "Bern"), ("BL", "Basel-Landschaft"),
+           ("BS", "Basel-Stadt"), ("FR", "Fribourg"), ("GE", "Geneva"), ("GL", "Glarus"), ("GR", "Graubünden"), ("JU", "Jura"),
+           ("LU", "Lucerne"), ("NE", "Neuchâtel"), ("NW", "Nidwalden"), ("OW", "Obwalden"), ("SG", "St. Gallen"), ("SH", "Schaffhausen"),
+           ("SO", "Solothurn"), ("SZ", "Schwyz"), ("TG", "Thurgau"), ("TI", "Ticino"), ("UR", "Uri"), ("VD", "Vaud"), ("VS", "Valais"),
+           ("ZG", "Zug"), ("ZH", "Zurich")],
+    "de": [("BB", "Brandenburg"), ("BE", "Berlin"), ("BW", "Baden-Württemberg"), ("BY", "Bavaria"), ("HB", "Bremen"), ("HE", "Hesse"),
+           ("HH", "Hamburg"), ("MV", "Mecklenburg-Vorpommern"), ("NI", "Lower Saxony"), ("NW", "North Rhine-Westphalia"),
+           ("RP", "Rhineland-Palatinate"), ("SH", "Schleswig-Holstein"), ("SL", "Saarland"), ("SN", "Saxony"), ("ST", "Saxony-Anhalt"),
+           ("TH", "Thuringia")],
+    "us": [("AK", "Alaska"), ("AL", "Alabama"), ("AR", "Arkansas"), ("AZ", "Arizona"), ("CA", "California"), ("CO", "Colorado"),
+           ("CT", "Connecticut"), ("DC", "District of Columbia"), ("DE", "Delaware"), ("FL", "Florida"), ("GA", "Georgia"), ("HI", "Hawaii"),
+           ("IA", "Iowa"), ("ID", "Idaho"), ("IL", "Illinois"), ("IN", "Indiana"), ("KS", "Kansas"), ("KY", "Kentucky"), ("LA", "Louisiana"),
+           ("MA", "Massachusetts"), ("MD", "Maryland"), ("ME", "Maine"), ("MI", "Michigan"), ("MN", "Minnesota"), ("MO", "Missouri"),
+           ("MS", "Mississippi"), ("MT", "Montana"), ("NC", "North Carolina"), ("ND", "North Dakota"), ("NE", "Nebraska"),
+           ("NH", "New Hampshire"), ("NJ", "New Jersey"), ("NM", "New Mexico"), ("NV", "Nevada"), ("NY", "New York"), ("OH", "Ohio"),
+           ("OK", "Oklahoma"), ("OR", "Oregon"), ("PA", "Pennsylvania"), ("RI", "Rhode Island"), ("SC", "South Carolina"),
+           ("SD", "South Dakota"), ("TN", "Tennessee"), ("TX", "Texas"), ("UT", "Utah"), ("VA", "Virginia"), ("VT", "Vermont"),
+           ("WA", "Washington"), ("WI", "Wisconsin"), ("WV", "West Virginia"), ("WY", "Wyoming")],
+}
+
+# Names that holidays were previously generated with for each resource code, mapped to the name that the holiday is generated with now.
+# When a holiday is renamed (i.e. by a fixup in generate_additional_holidays or by an update to the holidays library), add the old name
+# here so that the renamed holiday keeps the ID that was assigned to it and any selections made with the old name can be migrated.
+HOLIDAY_NAME_ALIASES = {
+    "au": {"Anzac Day": "ANZAC Day"},
+    "ch": {"Neujahrestag": "Neujahrstag"},
+    "us": {"Martin Luther King, Jr. Day": "Martin Luther King Jr. Day", "Thanksgiving": "Thanksgiving Day"},
+}
+
 # names of the keys that will be used when creating the plist
+VERSION_KEY = "version"
 DATE_CREATED_KEY = "dateCreated"
 HOLIDAYS_KEY = "holidays"
+ALIASES_KEY = "aliases"
+ID_KEY = "id"
 NAME_KEY = "name"
 DATES_KEY = "dates"
+TYPE_KEY = "type"
+MONTH_KEY = "month"
+DAY_KEY = "day"
+WEEKDAY_KEY = "weekday"
+ORDINAL_KEY = "ordinal"
+OFFSET_KEY = "offset"
+OBSERVED_KEY = "observed"
+ADDED_KEY = "added"
+REMOVED_KEY = "removed"
+PARENT_KEY = "parent"
+EXCLUDED_KEY = "excluded"
+
+# Version of the compiled holiday rule format (version 1 being the legacy list of dates for each holiday and version 2 being the rules
+# without holiday IDs).
+HOLIDAY_FORMAT_VERSION = 3
+
+# the version of the compiled holiday rule format that first included the rules
+HOLIDAY_RULES_FORMAT_VERSION = 2
+
+# The number of holiday IDs that can be assigned for a single country or subdivision (the selections are stored as a 64-bit set of IDs).
+# The holidays of a subdivision have their own IDs, so the holidays that only exist in the subdivisions never use the IDs of the country.
+MAX_HOLIDAY_IDS = 64
+
+# The number of holidays of a country that a subdivision can exclude without replacing them with a regional holiday of the same name
+# before the generator assumes that the names of the country and the subdivision did not match.  Holidays that are replaced with the same
+# name are only observed on different dates (i.e. a subdivision that moves a holiday on a weekend to the following Monday).  Valais does
+# not observe any of the five Easter and Pentecost holidays that are listed for Switzerland.
+MAX_EXCLUDED_HOLIDAYS = 5
+
+# the rule types that can be used to describe a holiday (these must match SLHolidayRuleType)
+RULE_TYPE_DATES = "dates"
+RULE_TYPE_FIXED = "fixed"
+RULE_TYPE_NTH_WEEKDAY = "nthWeekday"
+RULE_TYPE_WEEKDAY_ON_OR_AFTER = "weekdayOnOrAfter"
+RULE_TYPE_WEEKDAY_ON_OR_BEFORE = "weekdayOnOrBefore"
+RULE_TYPE_EASTER = "easter"
+RULE_TYPE_ORTHODOX_EASTER = "orthodoxEaster"
+
+# the marker used in the observed shifts to indicate that a holiday is not observed when falling on that weekday
+NOT_OBSERVED_MARKER = "x"
+
+# the maximum number of days that an observed holiday will be moved from the actual date
+MAX_OBSERVED_SHIFT = 3
+
+# the maximum number of exceptions (added or removed dates) that a rule can have before it is stored as a table of dates
+MAX_RULE_EXCEPTIONS = 2
 
 # entry point for creating the holidays for a particular country
 def gen_country_holidays(country_code):
     print("Generating holiday plist file for \"{0}\" from years {1} to {2}.".format(country_code, START_YEAR, END_YEAR))
+    holiday_map = generate_holiday_map(country_code)
+    write_country_holidays(country_code, holiday_map)
+
+    resource_code = country_code.lower()
+    if subdivision_plist_file_paths(resource_code):
+        print("Regenerate the subdivisions of \"{0}\" with \"{0} all\" so that they are compared with the new holidays.".format(country_code))
+
+    # the holiday counts in the registry need to be updated with the new resource
+    if resource_code in [code for _, code, _ in HOLIDAY_COUNTRIES]:
+        write_country_registry()
+    else:
+        print("Add \"{0}\" to the holiday countries and regenerate the country registry with \"-r\".".format(country_code))
+    print("Holiday list generation completed for \"{0}\" from years {1} to {2}.".format(country_code, START_YEAR, END_YEAR))
+
+# compiles the holidays in the given holiday map for a country and writes them to its plist, returning the compiled holidays (with IDs)
+def write_country_holidays(country_code, holiday_map):
+    # compile the holidays into rules, only considering dates which have not yet passed
+    today = datetime.date.today()
+    compiled_holidays = [compile_holiday(name, dates, START_YEAR, END_YEAR - 1, today) for name, dates in holiday_map.items()]
+
+    # write the final plist to file, keeping the IDs of any holidays that were previously generated
+    resource_code = country_code.lower()
+    plist_file_path = os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(resource_code))
+    aliases = assign_holiday_ids(plist_file_path, resource_code, compiled_holidays)
+    write_holiday_plist(plist_file_path, compiled_holidays, aliases)
+    write_holiday_fixture(resource_code, compiled_holidays, holiday_map, today, datetime.date(END_YEAR - 1, 12, 31))
+    print("Wrote results to file: {0}".format(plist_file_path))
+    return compiled_holidays
+
+# Entry point for creating the holidays for the given subdivisions of a particular country.  The subdivisions are compared with the
+# holiday resource of the country that is already in the bundle, which is never regenerated here since the users of the country have
+# selected its holidays by ID (a newer version of the holidays library can drop or move holidays of the country).  Only the holidays that
+# differ from the holidays of the country are written for a subdivision, along with the IDs of the holidays of the country that are not
+# observed in the subdivision.  The holidays of a subdivision have their own IDs, which are separate from the IDs of the country (and of
+# the other subdivisions), so selecting a holiday of the country from a subdivision selects it for the country.
+def gen_subdivision_holidays(country_code, subdivision_codes):
+    resource_code = country_code.lower()
+    parent_plist_file_path = os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(resource_code))
+    if not os.path.exists(parent_plist_file_path):
+        print("Generate the holidays of \"{0}\" before its subdivisions, exiting.".format(country_code))
+        exit(1)
+    with open(parent_plist_file_path, 'rb') as fp:
+        parent_holidays = plistlib.load(fp).get(HOLIDAYS_KEY, [])
+
+    # The holidays of the country are compared by the dates that their rules generate which have not yet passed.  The country can still
+    # use a name that the holidays library has since renamed, so the current name of each holiday is also matched.
+    today = datetime.date.today()
+    years = range(START_YEAR, END_YEAR)
+    end = datetime.date(END_YEAR - 1, 12, 31)
+    parent_dates = {holiday[NAME_KEY]:{date for date in holiday_dates(holiday, years, today) if date <= end} for holiday in parent_holidays}
+    parent_ids = {holiday[NAME_KEY]:holiday[ID_KEY] for holiday in parent_holidays}
+    renamed_parent_names = {HOLIDAY_NAME_ALIASES.get(resource_code, {}).get(name, name):name for name in parent_ids}
+
+    for subdivision_code in subdivision_codes:
+        print("Generating holiday plist file for \"{0}-{1}\" from years {2} to {3}.".format(country_code, subdivision_code, START_YEAR, END_YEAR))
+        holiday_map = generate_holiday_map(country_code, subdivision_code)
+
+        regional_holidays = []
+        observed_names = set()
+        for name, dates in holiday_map.items():
+            parent_name = renamed_parent_names.get(name, name)
+            if parent_dates.get(parent_name) == {date for date in dates if date >= today and date <= end}:
+                observed_names.add(parent_name)
+            else:
+                regional_holidays.append(compile_holiday(name, dates, START_YEAR, END_YEAR - 1, today))
 
-    # define the high-level plist file and holiday mapping which will be generated for this country
-    country_holidays = []
+        # a holiday of the country that occurs on different dates in the subdivision is excluded and replaced with a regional holiday
+        excluded_names = sorted(name for name in parent_ids if name not in observed_names)
+        excluded_ids = sorted(parent_ids[name] for name in excluded_names)
+        print("The subdivision has {0} regional holidays and does not observe {1} of the holidays of the country: {2}".format(
+              len(regional_holidays), len(excluded_ids), ", ".join(excluded_names)))
+
+        # Most of the holidays of a country are observed in every subdivision, so a large number of excluded holidays (or a regional name
+        # that still contains the observed text or the separator) means that the names of the country and the subdivision did not match.
+        regional_names = {holiday[NAME_KEY] for holiday in regional_holidays}
+        unmatched_names = [name for name in excluded_names if name not in regional_names and
+                           HOLIDAY_NAME_ALIASES.get(resource_code, {}).get(name) not in regional_names]
+        if len(unmatched_names) > MAX_EXCLUDED_HOLIDAYS:
+            print("The subdivision does not observe {0} of the {1} holidays of the country, which is more than expected, exiting.".format(
+                  len(unmatched_names), len(parent_ids)))
+            exit(1)
+        malformed_names = [name for name in regional_names if OBSERVED_PATTERN.search(name) or HOLIDAY_NAME_SEPARATOR.strip() in name]
+        if malformed_names:
+            print("The names of the regional holidays were not normalized ({0}), exiting.".format(", ".join(malformed_names)))
+            exit(1)
+
+        subdivision_resource_code = "{0}_{1}".format(resource_code, subdivision_code.lower())
+        plist_file_path = os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(subdivision_resource_code))
+        aliases = assign_holiday_ids(plist_file_path, subdivision_resource_code, regional_holidays)
+        write_holiday_plist(plist_file_path, regional_holidays, aliases, parent="{0}_holidays".format(resource_code), excluded_ids=excluded_ids)
+        write_holiday_fixture(subdivision_resource_code, regional_holidays, holiday_map, today, datetime.date(END_YEAR - 1, 12, 31))
+        print("Wrote results to file: {0}".format(plist_file_path))
+
+        if subdivision_code.upper() not in [code for code, _ in HOLIDAY_SUBDIVISIONS.get(resource_code, [])]:
+            print("Add \"{0}\" to the subdivisions of \"{1}\" and regenerate the country registry with \"-r\".".format(subdivision_code, country_code))
+
+    # the holiday counts and subdivisions in the registry need to be updated with the new resources
+    write_country_registry()
+    print("Holiday list generation completed for the subdivisions of \"{0}\" from years {1} to {2}.".format(country_code, START_YEAR, END_YEAR))
+
+# generates a map of each holiday name to the dates that it occurs on for a country (or one of its subdivisions) over all of the years
+def generate_holiday_map(country_code, subdivision_code=None):
+    import holidays
+
+    # define the holiday mapping which will be generated for this country, along with each of the individual holidays (date and name)
     holiday_map = {}
+    split_holidays = []
 
     # iterate through each year one by one
     years = list(range(START_YEAR, END_YEAR))
     for year in years:
         # generate the list of holidays for the given country code (if valid) for the iterated year
         try:
-            global holidays_for_year
-            exec("holidays_for_year = holidays.{0}(observed=True, expand=False, years=[{1}])".format(country_code, year), globals())
+            if subdivision_code is not None:
+                holidays_for_year = getattr(holidays, country_code)(subdiv=subdivision_code, observed=True, expand=False, years=[year])
+            else:
+                holidays_for_year = getattr(holidays, country_code)(observed=True, expand=False, years=[year])
         except AttributeError:
             print("Entered invalid country code, exiting.")
             exit(1)
+        except NotImplementedError:
+            print("Entered invalid subdivision code, exiting.")
+            exit(1)
 
         if year == START_YEAR:
             print(holidays_for_year)
             print("This country has {0} holidays.".format(len(holidays_for_year)))
 
-        # iterate through the generated holidays to potentially remove holidays
-        holidays_to_remove = []
-        for date, name in holidays_for_year.items():
-            # mark any non-observed holidays for removal
-            if OBSERVED_TEXT in name:
-                holiday_to_remove = name.replace(OBSERVED_TEXT, "").strip()
-                holidays_to_remove.append(holiday_to_remove)
-                print("Attempting to remove holiday \"{0}\" since this is an observed holiday in {1}.".format(holiday_to_remove, year))
-        holidays_for_year = {date:name.replace(OBSERVED_TEXT, "").strip() for date, name in holidays_for_year.items() if name not in holidays_to_remove or date.weekday() < 5}
+        # Split the combined names into a list of the individual holidays (the holidays library combines the holidays on the same date
+        # into a single name), removing some extra text in between brackets from each name.  The names are only split on the separator
+        # that the library uses to combine them, since some of the names contain commas.
+        for date, combined_names in sorted(holidays_for_year.items()):
+            combined_names = re.sub(r"\[.*?\]", "", combined_names)
+            split_holidays.extend((date, name.strip()) for name in combined_names.split(HOLIDAY_NAME_SEPARATOR) if name.strip())
 
-        if year == START_YEAR:
-            print("After removing observed holidays, this country has {0} holidays.".format(len(holidays_for_year)))
+    # Remove the actual dates of the holidays that fall on a weekend and are observed on a nearby date instead.  This is done for all of
+    # the years at once since a holiday can be observed in the previous year (i.e. New Year's Day on a Saturday).
+    observed_holidays = {(date, OBSERVED_PATTERN.sub("", name).strip()) for date, name in split_holidays if OBSERVED_PATTERN.search(name)}
+    def is_replaced_by_observed(date, name):
+        return date.weekday() >= 5 and any((date + datetime.timedelta(days=offset), name) in observed_holidays
+                                           for offset in range(-MAX_OBSERVED_SHIFT, MAX_OBSERVED_SHIFT + 1))
+    num_holidays = len(split_holidays)
+    split_holidays = [(date, OBSERVED_PATTERN.sub("", name).strip()) for date, name in split_holidays
+                      if OBSERVED_PATTERN.search(name) or not is_replaced_by_observed(date, name)]
+    print("Removed {0} holidays that are observed on another date.".format(num_holidays - len(split_holidays)))
 
+    for year in years:
         # add additional holidays for particular countries
-        holidays_for_year.update(generate_additional_holidays(country_code, year, holidays_for_year))
-
-        # final pass of the holidays for the given year to add them to the plist
-        for date, combined_names in sorted(holidays_for_year.items()):
-            # remove some extra text in between brackets from the name
-            combined_names = re.sub(r"\[.*?\]", "", combined_names)
+        holidays_for_year = generate_additional_holidays(country_code, year, [(date, name) for date, name in split_holidays if date.year == year])
 
-            # check to see if the name needs to be split (the holidays library will combine the same dates with a combined name)
-            for name in combined_names.split(', '):
-                # remove any additional leading and trailing whitespace
-                name = name.strip()
-
-                # update the holiday map with the added holiday
-                date_time = datetime.datetime.combine(date, datetime.time(0, 0)).astimezone(datetime.timezone.utc)
-                dates = holiday_map.get(name)
-                if not dates:
-                    dates = [date_time]
-                elif date_time not in dates:
-                    dates.append(date_time)
-                holiday_map.update({name:dates})
-
-    # get the current datetime in UTC timezone
-    now = datetime.datetime.now().astimezone(datetime.timezone.utc)
-
-    # generate the plist
-    for name in holiday_map.keys():
-        # get all of the parts for the dictionary that will be added to the plist
-        dates = holiday_map.get(name)
-
-        # convert the datetime objects to date strings and remove any past dates
-        date_strings = []
-        for date in dates:
-            if date >= now:
-                date_strings.append(date.strftime('%Y-%m-%d'))
-
-        # add a new entry to the plist
-        country_holidays.append({NAME_KEY:name, DATES_KEY:date_strings})
-
-    # create the root of the plist
-    plist_root = {DATE_CREATED_KEY:now, "holidays":country_holidays}
-
-    # write the final plist to file
-    plist_file_path = os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(country_code.lower()))
-    with open(plist_file_path, 'wb') as fp:
-        plistlib.dump(plist_root, fp, sort_keys=False)
+        # final pass of the holidays for the given year to add them to the holiday map
+        for date, name in sorted(holidays_for_year):
+            dates = holiday_map.setdefault(name, [])
+            if date not in dates:
+                dates.append(date)
 
-    print("Wrote results to file: {0}".format(plist_file_path))
-    print("Holiday list generation completed for \"{0}\" from years {1} to {2}.".format(country_code, START_YEAR, END_YEAR))
+    return holiday_map
 
-# creates new holidays for particular countries
+# returns the given list of the holidays (date and name) for a year along with the additional holidays for particular countries
 def generate_additional_holidays(country_code, year, holidays_for_year):
-    new_holidays = {}
+    new_holidays = []
 
     if country_code == 'US':
         # add new holidays which have different dates each year
-        for date, name in holidays_for_year.items():
-            if THANKSGIVING_TEXT in name:
+        for date, name in holidays_for_year:
+            if name == THANKSGIVING_TEXT:
                 print("Adding additional holiday, \"{0}\" for {1}.".format(DAY_AFTER_THANKSGIVING_TEXT, year))
-                new_holidays.update({date + datetime.timedelta(days=1):DAY_AFTER_THANKSGIVING_TEXT})
+                new_holidays.append((date + datetime.timedelta(days=1), DAY_AFTER_THANKSGIVING_TEXT))
 
-            if MARTIN_LUTHER_KING_JR_TEXT in name:
+            if name == MARTIN_LUTHER_KING_JR_TEXT:
                 print("Fixing Martin Luther King Jr. Day")
-                new_holidays.update({date:"Martin Luther King Jr. Day"})
+                name = "Martin Luther King Jr. Day"
+            new_holidays.append((date, name))
 
         # add New Year's Eve and Christmas Eve which are static each year
-        print("Adding additional holiday, \"{0}\" for {1}.".format(CHRISTMAS_EVE_TEXT, year))
-        print("Adding additional holiday, \"{0}\" for {1}.".format(NEW_YEARS_EVE_TEXT, year))
-        new_holidays.update({datetime.date(year, 12, 24):CHRISTMAS_EVE_TEXT, datetime.date(year, 12, 31):NEW_YEARS_EVE_TEXT})
+        for date, name in [(datetime.date(year, 12, 24), CHRISTMAS_EVE_TEXT), (datetime.date(year, 12, 31), NEW_YEARS_EVE_TEXT)]:
+            if (date, name) not in new_holidays:
+                print("Adding additional holiday, \"{0}\" for {1}.".format(name, year))
+                new_holidays.append((date, name))
+        return new_holidays
+
+    return holidays_for_year
+
+# recompiles a legacy (version 1) plist that was generated with a list of dates for each holiday into the rule format
+def recompile_legacy_country_holidays(plist_file_path):
+    with open(plist_file_path, 'rb') as fp:
+        plist_root = plistlib.load(fp)
+
+    # nothing needs to be done if this file was already compiled
+    version = plist_root.get(VERSION_KEY, 1)
+    if version >= HOLIDAY_FORMAT_VERSION:
+        print("Skipping {0} since it is already compiled.".format(plist_file_path))
+        return
+
+    # files that already contain rules only need to have the holiday IDs assigned
+    resource_code = os.path.basename(plist_file_path).replace("_holidays.plist", "")
+    if version >= HOLIDAY_RULES_FORMAT_VERSION:
+        compiled_holidays = plist_root.get(HOLIDAYS_KEY, [])
+        aliases = assign_holiday_ids(plist_file_path, resource_code, compiled_holidays)
+        write_holiday_plist(plist_file_path, compiled_holidays, aliases)
+        print("Assigned IDs to {0} ({1} holidays).".format(plist_file_path, len(compiled_holidays)))
+        return
+
+    # the legacy files had all passed dates removed, so only compare the rules from the earliest date that remains
+    legacy_holidays = plist_root.get(HOLIDAYS_KEY, [])
+    holiday_map = {holiday[NAME_KEY]:[parse_date(date_string) for date_string in holiday[DATES_KEY]] for holiday in legacy_holidays}
+    all_dates = [date for dates in holiday_map.values() for date in dates]
+    cutoff = min(all_dates) if all_dates else datetime.date.today()
+
+    compiled_holidays = [compile_holiday(name, dates, START_YEAR, END_YEAR - 1, cutoff) for name, dates in holiday_map.items()]
+    aliases = assign_holiday_ids(plist_file_path, resource_code, compiled_holidays)
+    write_holiday_plist(plist_file_path, compiled_holidays, aliases)
+    write_holiday_fixture(resource_code, compiled_holidays, holiday_map, cutoff, legacy_fixture_end(all_dates, cutoff))
+    print("Recompiled {0} ({1} holidays, {2} stored as dates).".format(plist_file_path, len(compiled_holidays), sum(1 for holiday in compiled_holidays if holiday[TYPE_KEY] == RULE_TYPE_DATES)))
+
+# Returns the last date that the fixture of a legacy table of dates can check.  The legacy tables were generated one holiday year at a time,
+# so they leave out the days at the end of their final year that the next year's holidays are observed on (e.g. New Year's Day observed on
+# December 31), and they are only complete through their last date.
+def legacy_fixture_end(all_dates, cutoff):
+    if not all_dates:
+        return cutoff
+    last_date = max(all_dates)
+    return min(last_date, datetime.date(last_date.year, 12, 31) - datetime.timedelta(days=MAX_OBSERVED_SHIFT))
+
+# returns the IDs of the holidays in the plist at the given path (if it exists) keyed by name, including the previous names in the aliases
+def load_holiday_ids(plist_file_path):
+    holiday_ids = {}
+    if os.path.exists(plist_file_path):
+        with open(plist_file_path, 'rb') as fp:
+            plist_root = plistlib.load(fp)
+        holiday_ids.update(plist_root.get(ALIASES_KEY, {}))
+        for holiday in plist_root.get(HOLIDAYS_KEY, []):
+            if ID_KEY in holiday:
+                holiday_ids[holiday[NAME_KEY]] = holiday[ID_KEY]
+    return holiday_ids
+
+# returns the plist paths for the subdivisions of the given country resource code that have been generated
+def subdivision_plist_file_paths(resource_code):
+    return sorted(glob.glob(os.path.join(SLEEPER_BUNDLE_PATH, "{0}_*_holidays.plist".format(resource_code))))
+
+# Assigns a stable ID to each of the compiled holidays for the given resource code, which is saved with the holiday selections instead of
+# the name of the holiday.  Holidays keep the ID from the existing plist at the given path (matching either the current name, a previous
+# name from the existing aliases, or a renamed holiday from HOLIDAY_NAME_ALIASES).  New holidays are given the next unused ID and IDs are
+# never reused.  Returns the aliases to write with the plist, mapping every previous name of a holiday to its ID.
+def assign_holiday_ids(plist_file_path, resource_code, compiled_holidays):
+    existing_ids = load_holiday_ids(plist_file_path)
+
+    # find the previous names for each of the holidays that have been renamed
+    renamed_holidays = {}
+    for previous_name, name in HOLIDAY_NAME_ALIASES.get(resource_code, {}).items():
+        renamed_holidays.setdefault(name, []).append(previous_name)
+
+    # assign the existing IDs before creating any new IDs so that a new holiday can never take the ID of an existing holiday
+    names = [holiday[NAME_KEY] for holiday in compiled_holidays]
+    holiday_ids = {}
+    for name in names:
+        for candidate_name in [name] + renamed_holidays.get(name, []):
+            if candidate_name in existing_ids and existing_ids[candidate_name] not in holiday_ids.values():
+                holiday_ids[name] = existing_ids[candidate_name]
+                break
+    next_id = max(list(existing_ids.values()) + list(holiday_ids.values()) + [-1]) + 1
+    for name in names:
+        if name not in holiday_ids:
+            print("Assigning ID {0} to new holiday \"{1}\".".format(next_id, name))
+            holiday_ids[name] = next_id
+            next_id = next_id + 1
+    if next_id > MAX_HOLIDAY_IDS:
+        print("Cannot assign more than {0} holiday IDs for \"{1}\", exiting.".format(MAX_HOLIDAY_IDS, resource_code))
+        exit(1)
+
+    # the ID is written first so that it is easy to find when reading the plist
+    for i, holiday in enumerate(compiled_holidays):
+        compiled_holidays[i] = dict([(ID_KEY, holiday_ids[holiday[NAME_KEY]])] + [(key, value) for key, value in holiday.items() if key != ID_KEY])
+
+    # keep every previous name (including the names of any removed holidays) so that their IDs are never reassigned
+    aliases = {name:holiday_id for name, holiday_id in existing_ids.items() if name not in holiday_ids}
+    for name, previous_names in renamed_holidays.items():
+        for previous_name in previous_names:
+            if name in holiday_ids:
+                aliases.setdefault(previous_name, holiday_ids[name])
+    return dict(sorted(aliases.items()))
+
+# Writes the compiled holidays to the given path, along with the previous names for any of the holidays.  A subdivision also writes the
+# resource name of its country and the IDs of the holidays of the country that are not observed in the subdivision.
+def write_holiday_plist(plist_file_path, compiled_holidays, aliases, parent=None, excluded_ids=None):
+    plist_root = {VERSION_KEY:HOLIDAY_FORMAT_VERSION,
+                  DATE_CREATED_KEY:datetime.datetime.now(datetime.timezone.utc).replace(microsecond=0),
+                  HOLIDAYS_KEY:compiled_holidays,
+                  ALIASES_KEY:aliases}
+    if parent is not None:
+        plist_root[PARENT_KEY] = parent
+        plist_root[EXCLUDED_KEY] = excluded_ids
+    with open(plist_file_path, 'wb') as fp:
+        plistlib.dump(plist_root, fp, sort_keys=False)
+
+# Writes the dates that the given compiled holidays were compiled from (from the cutoff through the end) to the fixture of the resource,
+# which the host tests use to check the rules in the plist day-for-day.  Each holiday is written on its own line (in the order of the plist) as the ID,
+# the name, and the dates, separated by tabs.
+def write_holiday_fixture(resource_code, compiled_holidays, holiday_map, cutoff, end):
+    lines = ["# the dates that {0}_holidays.plist was compiled from, which are generated by holiday_gen.py".format(resource_code),
+             "range\t{0}\t{1}".format(format_date(cutoff), format_date(end))]
+    for holiday in compiled_holidays:
+        dates = sorted(date for date in holiday_map[holiday[NAME_KEY]] if date >= cutoff and date <= end)
+        lines.append("{0}\t{1}\t{2}".format(holiday[ID_KEY], holiday[NAME_KEY], " ".join(format_date(date) for date in dates)))
+
+    os.makedirs(HOLIDAY_FIXTURES_PATH, exist_ok=True)
+    with open(os.path.join(HOLIDAY_FIXTURES_PATH, "{0}_holidays.txt".format(resource_code)), 'w', encoding='utf-8') as fp:
+        fp.write("\n".join(lines) + "\n")
+
+# Returns the regions of the holiday country enum in order, where the subdivisions which have been generated are added after the countries.
+# Each region is listed as the enum name, resource code, ISO code, number of holidays, parent enum name, and subdivision name.
+def holiday_regions():
+    regions = []
+    for enum_name, resource_code, iso_code in HOLIDAY_COUNTRIES:
+        with open(os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(resource_code)), 'rb') as fp:
+            holiday_count = len(plistlib.load(fp).get(HOLIDAYS_KEY, []))
+        regions.append((enum_name, resource_code, iso_code, holiday_count, enum_name, None))
+    for parent_enum_name, parent_resource_code, parent_iso_code in HOLIDAY_COUNTRIES:
+        subdivisions = HOLIDAY_SUBDIVISIONS.get(parent_resource_code, [])
+        if not subdivisions:
+            continue
+        with open(os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(parent_resource_code)), 'rb') as fp:
+            parent_ids = [holiday[ID_KEY] for holiday in plistlib.load(fp).get(HOLIDAYS_KEY, []) if ID_KEY in holiday]
+        for subdivision_code, subdivision_name in subdivisions:
+            resource_code = "{0}_{1}".format(parent_resource_code, subdivision_code.lower())
+            plist_file_path = os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(resource_code))
+            if not os.path.exists(plist_file_path):
+                continue
+            with open(plist_file_path, 'rb') as fp:
+                plist_root = plistlib.load(fp)
+            inherited_ids = [holiday_id for holiday_id in parent_ids if holiday_id not in plist_root.get(EXCLUDED_KEY, [])]
+            regions.append(("{0}{1}".format(parent_enum_name, subdivision_code.upper()), resource_code,
+                            "{0}-{1}".format(parent_iso_code, subdivision_code.upper()), len(inherited_ids) + len(plist_root.get(HOLIDAYS_KEY, [])),
+                            parent_enum_name, subdivision_name))
+    return regions
+
+# Writes the registry of holiday countries that is compiled into the tweak.  The registry contains the holiday country enum along with
+# a table of the codes, resource names, and number of holidays for each country so that the tweak never needs to build these at runtime.
+# The subdivisions which have been generated are added to the end of the enum, along with the country that they belong to.
+def write_country_registry():
+    regions = holiday_regions()
+    num_countries = len(HOLIDAY_COUNTRIES)
+
+    # the reverse lookup table contains both the resource codes and the ISO codes, sorted so that it can be searched
+    lookup_codes = {}
+    for enum_name, resource_code, iso_code, _, _, _ in regions:
+        lookup_codes.setdefault(resource_code.lower(), enum_name)
+        lookup_codes.setdefault(iso_code.lower(), enum_name)
+
+    header_lines = ["//",
+                    "//  SLHolidayCountries.h",
+                    "//  The registry of the holiday countries that are available to choose from for the holiday selection.",
+                    "//",
+                    "//  This file is generated by holiday_gen.py (\"holiday_gen.py -r\").  Do not edit it directly.",
+                    "//",
+                    "",
+                    "#import <Foundation/Foundation.h>",
+                    "",
+                    "// enum that defines the rows countries that are available to choose from for the holiday selection",
+                    "typedef enum SLHolidayCountry : NSInteger {"]
+    header_lines += ["    kSLHolidayCountry{0},".format(region[0]) for region in regions[:num_countries]]
+    header_lines += ["    kSLHolidayCountryNumCountries,",
+                     "    // the subdivisions of the holiday countries, which only store the holidays that differ from the holidays of their country"]
+    if len(regions) > num_countries:
+        header_lines += ["    kSLHolidayCountry{0} = kSLHolidayCountryNumCountries,".format(regions[num_countries][0])]
+        header_lines += ["    kSLHolidayCountry{0},".format(region[0]) for region in regions[num_countries + 1:]]
+        header_lines += ["    kSLHolidayCountryNumRegions"]
+    else:
+        header_lines += ["    kSLHolidayCountryNumRegions = kSLHolidayCountryNumCountries"]
+    header_lines += ["} SLHolidayCountry;",
+                     "",
+                     "// the number of holiday IDs that can be assigned for a single holiday country",
+                     "#define kSLHolidayMaxHolidayIds         {0}".format(MAX_HOLIDAY_IDS),
+                     "",
+                     "// the stable ID that is assigned to a holiday by holiday_gen.py, which is unique within a holiday country",
+                     "typedef uint8_t SLHolidayId;",
+                     "",
+                     "// a set of the selected holiday IDs for a single holiday country, using each holiday ID as a bit position",
+                     "typedef uint64_t SLHolidaySelection;",
+                     "",
+                     "// returns the holiday selection that only contains the given holiday ID",
+                     "#define SLHolidaySelectionForHolidayId(holidayId)   (((SLHolidaySelection)1) << (holidayId))",
+                     "",
+                     "// the information for a single holiday country",
+                     "typedef struct SLHolidayCountryInfo {",
+                     "    // the code that is used to name the holiday resource for the country",
+                     "    __unsafe_unretained NSString *countryCode;",
+                     "    // the ISO 3166-1 code for the country that is used by the system locale",
+                     "    __unsafe_unretained NSString *isoCountryCode;",
+                     "    // the name of the holiday resource for the country in the Sleeper bundle",
+                     "    __unsafe_unretained NSString *resourceName;",
+                     "    // the number of holidays that are available for the country (including the holidays that a subdivision shares with its country)",
+                     "    NSInteger numHolidays;",
+                     "    // the country that a subdivision belongs to (or the country itself)",
+                     "    SLHolidayCountry parentCountry;",
+                     "    // the name that is displayed for a subdivision (or nil for the country itself)",
+                     "    __unsafe_unretained NSString *subdivisionName;",
+                     "} SLHolidayCountryInfo;",
+                     "",
+                     "// the information for each of the holiday countries and subdivisions (indexed by the holiday country)",
+                     "extern const SLHolidayCountryInfo kSLHolidayCountryInfo[kSLHolidayCountryNumRegions];",
+                     "",
+                     "// Returns the holiday country or subdivision for the given resource code or ISO code (case insensitive), or kSLHolidayCountryNumRegions",
+                     "// if no holiday country exists for the code.",
+                     "SLHolidayCountry SLHolidayCountryForCountryCode(NSString *countryCode);",
+                     ""]
+
+    source_lines = ["//",
+                    "//  SLHolidayCountries.m",
+                    "//  The registry of the holiday countries that are available to choose from for the holiday selection.",
+                    "//",
+                    "//  This file is generated by holiday_gen.py (\"holiday_gen.py -r\").  Do not edit it directly.",
+                    "//",
+                    "",
+                    "#import \"SLHolidayCountries.h\"",
+                    "",
+                    "// an entry in the table that is used to look up the holiday country for a given code",
+                    "typedef struct SLHolidayCountryCodeEntry {",
+                    "    __unsafe_unretained NSString *code;",
+                    "    SLHolidayCountry holidayCountry;",
+                    "} SLHolidayCountryCodeEntry;",
+                    "",
+                    "const SLHolidayCountryInfo kSLHolidayCountryInfo[kSLHolidayCountryNumRegions] = {"]
+    source_lines += ["    {{@\"{0}\", @\"{1}\", @\"{0}_holidays\", {2}, kSLHolidayCountry{3}, {4}}},".format(
+                         resource_code, iso_code, holiday_count, parent_enum_name, "@\"{0}\"".format(subdivision_name) if subdivision_name is not None else "nil")
+                     for _, resource_code, iso_code, holiday_count, parent_enum_name, subdivision_name in regions]
+    source_lines += ["};",
+                     "",
+                     "// the lowercase resource codes and ISO codes for each holiday country and subdivision, sorted by code",
+                     "static const SLHolidayCountryCodeEntry kSLHolidayCountryCodes[] = {"]
+    source_lines += ["    {{@\"{0}\", kSLHolidayCountry{1}}},".format(code, enum_name) for code, enum_name in sorted(lookup_codes.items())]
+    source_lines += ["};",
+                     "",
+                     "// Returns the holiday country or subdivision for the given resource code or ISO code (case insensitive), or kSLHolidayCountryNumRegions",
+                     "// if no holiday country exists for the code.",
+                     "SLHolidayCountry SLHolidayCountryForCountryCode(NSString *countryCode)",
+                     "{",
+                     "    if (countryCode.length > 0) {",
+                     "        // binary search the sorted codes, which avoids creating a lowercase copy of the given code",
+                     "        size_t low = 0;",
+                     "        size_t high = sizeof(kSLHolidayCountryCodes) / sizeof(kSLHolidayCountryCodes[0]);",
+                     "        while (low < high) {",
+                     "            size_t mid = low + (high - low) / 2;",
+                     "            NSComparisonResult result = [kSLHolidayCountryCodes[mid].code caseInsensitiveCompare:countryCode];",
+                     "            if (result == NSOrderedSame) {",
+                     "                return kSLHolidayCountryCodes[mid].holidayCountry;",
+                     "            } else if (result == NSOrderedAscending) {",
+                     "                low = mid + 1;",
+                     "            } else {",
+                     "                high = mid;",
+                     "            }",
+                     "        }",
+                     "    }",
+                     "    return kSLHolidayCountryNumRegions;",
+                     "}",
+                     ""]
+
+    with open(COUNTRY_REGISTRY_HEADER_PATH, 'w', encoding='utf-8') as fp:
+        fp.write("\n".join(header_lines))
+    with open(COUNTRY_REGISTRY_SOURCE_PATH, 'w', encoding='utf-8') as fp:
+        fp.write("\n".join(source_lines))
+    print("Wrote the registry of {0} holiday countries and {1} subdivisions to {2} and {3}.".format(num_countries, len(regions) - num_countries,
+                                                                                                 COUNTRY_REGISTRY_HEADER_PATH, COUNTRY_REGISTRY_SOURCE_PATH))
+
+# Compiles the dates for a single holiday into the most compact rule that reproduces every date on or after the cutoff,
+# day-for-day, for the given range of years.  Holidays that do not follow a rule (i.e. lunar calendars) are stored as a table of dates.
+def compile_holiday(name, dates, first_year, last_year, cutoff):
+    expected = {date for date in dates if date >= cutoff}
+    years = range(first_year, last_year + 1)
+
+    # find the candidate rule with the fewest differences to the expected dates, preferring the simplest rules first
+    best_rule = None
+    best_added = None
+    best_removed = None
+    for rule in candidate_rules(expected, years, cutoff):
+        generated = {date for date in expand_rule(rule, years) if date >= cutoff}
+        added = expected - generated
+        removed = generated - expected
+        if best_rule is None or len(added) + len(removed) < len(best_added) + len(best_removed):
+            best_rule, best_added, best_removed = rule, added, removed
+            if not added and not removed:
+                break
+
+    # only use the rule if it reproduces the dates with a small number of exceptions
+    num_exceptions = len(best_added) + len(best_removed) if best_rule is not None else None
+    if best_rule is None or num_exceptions > MAX_RULE_EXCEPTIONS or num_exceptions * 10 > len(expected):
+        print("Storing \"{0}\" as a table of {1} dates.".format(name, len(expected)))
+        return {NAME_KEY:name, TYPE_KEY:RULE_TYPE_DATES, DATES_KEY:[format_date(date) for date in sorted(expected)]}
+
+    compiled = {NAME_KEY:name}
+    compiled.update(best_rule)
+    if best_added:
+        compiled[ADDED_KEY] = [format_date(date) for date in sorted(best_added)]
+    if best_removed:
+        compiled[REMOVED_KEY] = [format_date(date) for date in sorted(best_removed)]
+    return compiled
+
+# yields all of the rules which could potentially describe the given dates, ordered from the simplest to the most complex
+def candidate_rules(expected, years, cutoff):
+    if not expected:
+        return
+
+    # fixed dates are tried first, starting with the most common month and day
+    month_days = {}
+    for date in expected:
+        month_days[(date.month, date.day)] = month_days.get((date.month, date.day), 0) + 1
+    common_month_days = [month_day for month_day, _ in sorted(month_days.items(), key=lambda item: -item[1])]
+    for (month, day) in common_month_days:
+        yield {TYPE_KEY:RULE_TYPE_FIXED, MONTH_KEY:month, DAY_KEY:day}
+
+    # the nth (or last) weekday of a particular month
+    for month in sorted({date.month for date in expected}):
+        for weekday in range(7):
+            for ordinal in (1, 2, 3, 4, 5, -1):
+                yield {TYPE_KEY:RULE_TYPE_NTH_WEEKDAY, MONTH_KEY:month, WEEKDAY_KEY:weekday, ORDINAL_KEY:ordinal}
+
+    # the first weekday on or after (or on or before) a particular date
+    for (month, day) in sorted(month_days.keys()):
+        for weekday in range(7):
+            yield {TYPE_KEY:RULE_TYPE_WEEKDAY_ON_OR_AFTER, MONTH_KEY:month, DAY_KEY:day, WEEKDAY_KEY:weekday}
+            yield {TYPE_KEY:RULE_TYPE_WEEKDAY_ON_OR_BEFORE, MONTH_KEY:month, DAY_KEY:day, WEEKDAY_KEY:weekday}
+
+    # dates which are relative to either the western or orthodox Easter
+    for rule_type, easter_function in ((RULE_TYPE_EASTER, western_easter), (RULE_TYPE_ORTHODOX_EASTER, orthodox_easter)):
+        for offset in sorted({(date - easter_function(date.year)).days for date in expected}):
+            yield {TYPE_KEY:rule_type, OFFSET_KEY:offset}
+
+    # fixed dates which are moved when they fall on particular weekdays (i.e. observed on the following Monday)
+    for (month, day) in common_month_days:
+        observed = infer_observed_shifts(month, day, expected, years, cutoff)
+        if observed is not None:
+            yield {TYPE_KEY:RULE_TYPE_FIXED, MONTH_KEY:month, DAY_KEY:day, OBSERVED_KEY:observed}
+
+# Infers how a fixed date holiday is observed when it falls on each day of the week.  The observed shifts are returned as
+# a comma-separated string (Monday first) of the number of days the holiday is moved, or None if the holiday is never moved.
+def infer_observed_shifts(month, day, expected, years, cutoff):
+    votes = [{} for _ in range(7)]
+    for year in years:
+        date = safe_date(year, month, day)
+        if date is None or date < cutoff - datetime.timedelta(days=MAX_OBSERVED_SHIFT):
+            continue
+
+        # find the closest expected date to the actual date of the holiday
+        shift = NOT_OBSERVED_MARKER
+        for offset in sorted(range(-MAX_OBSERVED_SHIFT, MAX_OBSERVED_SHIFT + 1), key=abs):
+            if date + datetime.timedelta(days=offset) in expected:
+                shift = offset
+                break
+        votes[date.weekday()][shift] = votes[date.weekday()].get(shift, 0) + 1
+
+    # use the most common shift for each weekday
+    shifts = [max(vote.items(), key=lambda item: item[1])[0] if vote else 0 for vote in votes]
+    if all(shift == 0 for shift in shifts):
+        return None
+    return ",".join(str(shift) for shift in shifts)
+
+# returns the set of dates on or after the cutoff for a compiled holiday from a plist (either a table of dates or a rule with exceptions)
+def holiday_dates(holiday, years, cutoff):
+    if holiday[TYPE_KEY] == RULE_TYPE_DATES:
+        dates = {parse_date(date_string) for date_string in holiday.get(DATES_KEY, [])}
+    else:
+        dates = set(expand_rule(holiday, years))
+        dates = (dates | {parse_date(date_string) for date_string in holiday.get(ADDED_KEY, [])}) - {parse_date(date_string) for date_string in holiday.get(REMOVED_KEY, [])}
+    return {date for date in dates if date >= cutoff}
+
+# expands a rule into the dates that it generates for the given years (this must match SLHolidayRuleOccurrencesInYear)
+def expand_rule(rule, years):
+    observed = rule.get(OBSERVED_KEY)
+    shifts = observed.split(",") if observed else None
+    for year in years:
+        date = rule_date_for_year(rule, year)
+        if date is None:
+            continue
+        if shifts:
+            shift = shifts[date.weekday()]
+            if shift == NOT_OBSERVED_MARKER:
+                continue
+            date = date + datetime.timedelta(days=int(shift))
+        yield date
+
+# returns the date of a rule for a given year (before any observed shift is applied)
+def rule_date_for_year(rule, year):
+    rule_type = rule[TYPE_KEY]
+    if rule_type == RULE_TYPE_FIXED:
+        return safe_date(year, rule[MONTH_KEY], rule[DAY_KEY])
+    elif rule_type == RULE_TYPE_NTH_WEEKDAY:
+        return nth_weekday(year, rule[MONTH_KEY], rule[WEEKDAY_KEY], rule[ORDINAL_KEY])
+    elif rule_type == RULE_TYPE_WEEKDAY_ON_OR_AFTER:
+        date = safe_date(year, rule[MONTH_KEY], rule[DAY_KEY])
+        return date + datetime.timedelta(days=(rule[WEEKDAY_KEY] - date.weekday()) % 7) if date else None
+    elif rule_type == RULE_TYPE_WEEKDAY_ON_OR_BEFORE:
+        date = safe_date(year, rule[MONTH_KEY], rule[DAY_KEY])
+        return date - datetime.timedelta(days=(date.weekday() - rule[WEEKDAY_KEY]) % 7) if date else None
+    elif rule_type == RULE_TYPE_EASTER:
+        return western_easter(year) + datetime.timedelta(days=rule[OFFSET_KEY])
+    elif rule_type == RULE_TYPE_ORTHODOX_EASTER:
+        return orthodox_easter(year) + datetime.timedelta(days=rule[OFFSET_KEY])
+    return None
+
+# returns the nth weekday (Monday being 0) of a given month, or the last weekday of the month if the ordinal is -1
+def nth_weekday(year, month, weekday, ordinal):
+    if ordinal > 0:
+        date = datetime.date(year, month, 1)
+        date = date + datetime.timedelta(days=(weekday - date.weekday()) % 7 + 7 * (ordinal - 1))
+        return date if date.month == month else None
+    next_month = datetime.date(year + 1, 1, 1) if month == 12 else datetime.date(year, month + 1, 1)
+    date = next_month - datetime.timedelta(days=1)
+    return date - datetime.timedelta(days=(date.weekday() - weekday) % 7)
+
+# returns the date of the western (Gregorian) Easter for a given year
+def western_easter(year):
+    a = year % 19
+    b = year // 100
+    c = year % 100
+    d = (19 * a + b - b // 4 - ((b - (b + 8) // 25 + 1) // 3) + 15) % 30
+    e = (32 + 2 * (b % 4) + 2 * (c // 4) - d - (c % 4)) % 7
+    f = d + e - 7 * ((a + 11 * d + 22 * e) // 451) + 114
+    return datetime.date(year, f // 31, f % 31 + 1)
+
+# returns the date of the orthodox (Julian) Easter for a given year, converted to the Gregorian calendar
+def orthodox_easter(year):
+    d = (19 * (year % 19) + 15) % 30
+    e = (2 * (year % 4) + 4 * (year % 7) - d + 34) % 7
+    f = d + e + 114
+    julian_days = year // 100 - year // 400 - 2
+    return datetime.date(year, f // 31, f % 31 + 1) + datetime.timedelta(days=julian_days)
+
+# returns a date for the given components, or None if the date does not exist (i.e. February 29)
+def safe_date(year, month, day):
+    try:
+        return datetime.date(year, month, day)
+    except ValueError:
+        return None
+
+# converts a date string from the plist to a date object
+def parse_date(date_string):
+    return datetime.datetime.strptime(date_string, '%Y-%m-%d').date()
+
+# converts a date object to a string for the plist
+def format_date(date):
+    return date.strftime('%Y-%m-%d')
 
-    return new_holidays
-  
 if __name__== "__main__":
-    if len(sys.argv) == 2:
-        # generate the plist 
+    if len(sys.argv) == 2 and sys.argv[1] == "-r":
+        # regenerate the registry of holiday countries from the holiday resources
+        write_country_registry()
+    elif len(sys.argv) == 2:
+        # generate the plist
         gen_country_holidays(sys.argv[1])
+    elif len(sys.argv) == 3 and sys.argv[1] == "-c":
+        # recompile legacy plists into the rule format (use "all" to recompile every plist in the bundle)
+        if sys.argv[2] == "all":
+            plist_file_paths = sorted(glob.glob(os.path.join(SLEEPER_BUNDLE_PATH, "*_holidays.plist")))
+        else:
+            plist_file_paths = [os.path.join(SLEEPER_BUNDLE_PATH, "{0}_holidays.plist".format(sys.argv[2].lower()))]
+        for plist_file_path in plist_file_paths:
+            recompile_legacy_country_holidays(plist_file_path)
+        write_country_registry()
+    elif len(sys.argv) == 3:
+        # generate the plist for a subdivision of a country (use "all" to generate every subdivision of the country)
+        if sys.argv[2] == "all":
+            subdivision_codes = [code for code, _ in HOLIDAY_SUBDIVISIONS.get(sys.argv[1].lower(), [])]
+        else:
+            subdivision_codes = [sys.argv[2]]
+        gen_subdivision_holidays(sys.argv[1], subdivision_codes)
     else:
-        print("Incorrect usage! Please supply a valid country code.")
\ No newline at end of file
+        print("Incorrect usage! Please supply a valid country code (and optionally a subdivision code).")
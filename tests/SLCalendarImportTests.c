@@ -0,0 +1,194 @@
+//
+//  SLCalendarImportTests.c
+//  Checks the days that are imported from the iCalendar fixtures along with the limits of the streaming parser.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include "SLTest.h"
+#include "SLCalendarImport.h"
+#include "SLSkipRules.h"
+
+// the directory of the calendar fixtures, where each calendar has a text file with the same name that lists the days that it imports
+#define kSLTestCalendarFixturesPath kSLTestFixturesPath "/calendars"
+
+// the maximum number of days that are expected from a single calendar fixture
+#define kSLTestMaxCalendarDays      256
+
+// the number of single day events that are written to the calendar that is larger than the read buffer of the parser
+#define kSLTestNumStreamedEvents    2000
+
+// returns the day number for the given date, or a check fails and 0 is returned if the date can not be parsed
+static SLDay SLTestDayFromDateString(const char *dateString)
+{
+    SLDay day = 0;
+    SLTestCheck(SLSkipRuleParseDateString(dateString, &day), "\"%s\" is not a valid date", dateString);
+    return day;
+}
+
+// imports the days from the given calendar file, returning the status (the days must be freed by the caller)
+static SLCalendarImportStatus SLTestImportDays(FILE *file, SLDay fromDay, SLDay toDay, SLDay **days, size_t *numDays)
+{
+    rewind(file);
+    return SLCalendarImportDaysFromFile(file, fromDay, toDay, days, numDays);
+}
+
+// Checks the calendar fixture with the given name against the range, status, and days that are listed in its text file, where each line
+// of the text file is a field name followed by its tab separated values.
+static void SLTestCalendarFixture(const char *calendarName)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s.txt", kSLTestCalendarFixturesPath, calendarName);
+    FILE *expectations = fopen(path, "r");
+    snprintf(path, sizeof(path), "%s/%s.ics", kSLTestCalendarFixturesPath, calendarName);
+    FILE *calendar = fopen(path, "rb");
+    SLTestCheck(expectations != NULL && calendar != NULL, "the fixture for %s could not be read", calendarName);
+    if (expectations == NULL || calendar == NULL) {
+        if (expectations != NULL) {
+            fclose(expectations);
+        }
+        if (calendar != NULL) {
+            fclose(calendar);
+        }
+        return;
+    }
+
+    SLDay fromDay = 0;
+    SLDay toDay = -1;
+    SLCalendarImportStatus expectedStatus = kSLCalendarImportStatusSuccess;
+    SLDay expectedDays[kSLTestMaxCalendarDays];
+    size_t numExpectedDays = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    while (getline(&line, &lineCapacity, expectations) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0') {
+            continue;
+        }
+        char *field = strtok(line, "\t");
+        if (strcmp(field, "range") == 0) {
+            char *fromDateString = strtok(NULL, "\t");
+            char *toDateString = strtok(NULL, "\t");
+            SLTestCheck(fromDateString != NULL && toDateString != NULL, "%s has an invalid range", calendarName);
+            if (fromDateString != NULL && toDateString != NULL) {
+                fromDay = SLTestDayFromDateString(fromDateString);
+                toDay = SLTestDayFromDateString(toDateString);
+            }
+        } else if (strcmp(field, "status") == 0) {
+            char *statusString = strtok(NULL, "\t");
+            expectedStatus = statusString != NULL && strcmp(statusString, "invalid") == 0 ? kSLCalendarImportStatusInvalidFile : kSLCalendarImportStatusSuccess;
+        } else if (strcmp(field, "days") == 0) {
+            for (char *dateString = strtok(NULL, "\t "); dateString != NULL && numExpectedDays < kSLTestMaxCalendarDays; dateString = strtok(NULL, " ")) {
+                expectedDays[numExpectedDays++] = SLTestDayFromDateString(dateString);
+            }
+        }
+    }
+    free(line);
+    fclose(expectations);
+
+    SLDay *days = NULL;
+    size_t numDays = 0;
+    SLCalendarImportStatus status = SLTestImportDays(calendar, fromDay, toDay, &days, &numDays);
+    fclose(calendar);
+    SLTestCheck(status == expectedStatus, "%s was imported with status %d instead of %d", calendarName, status, expectedStatus);
+
+    // report the first day that differs, which is enough to find the event that was imported incorrectly
+    size_t i = 0;
+    while (i < numDays && i < numExpectedDays && days[i] == expectedDays[i]) {
+        i++;
+    }
+    int32_t year = 0, month = 0, dayOfMonth = 0;
+    int isMissing = i < numExpectedDays && (i >= numDays || expectedDays[i] < days[i]);
+    if (i < numDays || i < numExpectedDays) {
+        SLCivilFromDay(isMissing ? expectedDays[i] : days[i], &year, &month, &dayOfMonth);
+    }
+    SLTestCheck(i == numDays && i == numExpectedDays, "%s %s %04d-%02d-%02d", calendarName,
+                isMissing ? "did not import" : "should not import", year, month, dayOfMonth);
+    free(days);
+}
+
+// checks that the days of an import are limited to kSLCalendarImportMaxDays and that empty ranges do not import any days
+static void SLTestImportLimits(void)
+{
+    FILE *calendar = tmpfile();
+    SLTestCheck(calendar != NULL, "the temporary calendar could not be created");
+    if (calendar == NULL) {
+        return;
+    }
+    fputs("BEGIN:VCALENDAR\nBEGIN:VEVENT\nDTSTART;VALUE=DATE:20000101\nRRULE:FREQ=DAILY\nEND:VEVENT\nEND:VCALENDAR\n", calendar);
+
+    SLDay fromDay = SLDayFromCivil(2026, 10, 19);
+    SLDay *days = NULL;
+    size_t numDays = 0;
+    SLCalendarImportStatus status = SLTestImportDays(calendar, fromDay, fromDay + 10 * 366, &days, &numDays);
+    SLTestCheck(status == kSLCalendarImportStatusSuccess && numDays == kSLCalendarImportMaxDays && days[0] == fromDay &&
+                days[numDays - 1] == fromDay + kSLCalendarImportMaxDays - 1, "a daily event imported %zu days instead of %d", numDays,
+                kSLCalendarImportMaxDays);
+    free(days);
+
+    status = SLTestImportDays(calendar, fromDay, fromDay - 1, &days, &numDays);
+    SLTestCheck(status == kSLCalendarImportStatusSuccess && numDays == 0 && days == NULL, "an empty range imported %zu days", numDays);
+    free(days);
+    fclose(calendar);
+}
+
+// checks that a calendar which is many times larger than the read buffer of the parser is streamed completely
+static void SLTestStreamedCalendar(void)
+{
+    FILE *calendar = tmpfile();
+    SLTestCheck(calendar != NULL, "the temporary calendar could not be created");
+    if (calendar == NULL) {
+        return;
+    }
+
+    // every other event is timed, so only the events on even days are imported
+    SLDay firstDay = SLDayFromCivil(2026, 1, 1);
+    fputs("BEGIN:VCALENDAR\r\nVERSION:2.0\r\n", calendar);
+    for (int i = 0; i < kSLTestNumStreamedEvents; i++) {
+        int32_t year, month, dayOfMonth;
+        SLCivilFromDay(firstDay + i / 2, &year, &month, &dayOfMonth);
+        fprintf(calendar, "BEGIN:VEVENT\r\nUID:event-%d\r\nSUMMARY:A summary that is long enough to make the calendar larger than the "
+                "read buffer\r\nDTSTART%s%04d%02d%02d%s\r\nEND:VEVENT\r\n", i, i % 2 == 0 ? ";VALUE=DATE:" : ":", year, month, dayOfMonth,
+                i % 2 == 0 ? "" : "T120000Z");
+    }
+    fputs("END:VCALENDAR\r\n", calendar);
+
+    SLDay *days = NULL;
+    size_t numDays = 0;
+    SLCalendarImportStatus status = SLTestImportDays(calendar, firstDay, firstDay + kSLCalendarImportMaxDays - 1, &days, &numDays);
+    SLTestCheck(status == kSLCalendarImportStatusSuccess && numDays == kSLTestNumStreamedEvents / 2 &&
+                days[numDays - 1] == firstDay + kSLTestNumStreamedEvents / 2 - 1, "the streamed calendar imported %zu days instead of %d",
+                numDays, kSLTestNumStreamedEvents / 2);
+    free(days);
+    fclose(calendar);
+}
+
+int main(void)
+{
+    SLTestImportLimits();
+    SLTestStreamedCalendar();
+
+    size_t numCalendars = 0;
+    DIR *fixtures = opendir(kSLTestCalendarFixturesPath);
+    SLTestCheck(fixtures != NULL, "%s could not be opened", kSLTestCalendarFixturesPath);
+    for (struct dirent *entry = fixtures != NULL ? readdir(fixtures) : NULL; entry != NULL; entry = readdir(fixtures)) {
+        size_t length = strlen(entry->d_name);
+        if (length > strlen(".ics") && strcmp(entry->d_name + length - strlen(".ics"), ".ics") == 0) {
+            char calendarName[256];
+            snprintf(calendarName, sizeof(calendarName), "%.*s", (int)(length - strlen(".ics")), entry->d_name);
+            SLTestCalendarFixture(calendarName);
+            numCalendars++;
+        }
+    }
+    if (fixtures != NULL) {
+        closedir(fixtures);
+    }
+    SLTestCheck(numCalendars > 0, "no calendar fixtures were found");
+    return SLTestFinish("SLCalendarImportTests");
+}
@@ -0,0 +1,820 @@
+//
+//  SLDifferentialTests.c
+//  Compares the optimized skip decisions against a straightforward reference that expands the holiday fixtures into date strings.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "SLTest.h"
+#include "SLTestHolidays.h"
+#include "SLTestSkipDates.h"
+
+// the number of random cases that are run along with the seed that they are generated from, which can be replaced with the
+// SL_DIFFERENTIAL_CASES and SL_DIFFERENTIAL_SEED environment variables to run more cases or to replay a reported seed
+#define kSLDifferentialTestNumCases             5000
+#define kSLDifferentialTestSeed                 20261019ULL
+
+// the number of days after the start of the fixtures that the clock is randomly set to
+#define kSLDifferentialTestClockDays            360
+
+// the number of days after the clock that the skip decisions are checked
+#define kSLDifferentialTestDateDays             300
+
+// the number of seconds after or before midnight that are favored when picking a random time of day
+#define kSLDifferentialTestMidnightSeconds      90
+
+// the maximum number of each part of a random case
+#define kSLDifferentialTestMaxCustomSkipDates   5
+#define kSLDifferentialTestMaxHolidayCountries  2
+#define kSLDifferentialTestMaxSkipRules         2
+#define kSLDifferentialTestMaxExceptions        3
+
+// the skip activated status of an alarm that was skipped from the popup (this must match kSLSkipActivatedStatusActivated)
+#define kSLDifferentialTestSkipActivated        1
+
+// the directory of the time zone database that the time zones of the cases are loaded from
+#define kSLDifferentialTestZoneInfoPath         "/usr/share/zoneinfo"
+
+// the length of a date string (yyyy-MM-dd) including the terminator
+#define kSLDateStringLength                     11
+
+// The time zones that the cases are run in, which cover both hemispheres of daylight saving time, offsets that are not whole hours, and
+// both sides of the date line.
+static const char *const kSLDifferentialTestTimeZoneNames[] = {
+    "UTC", "America/New_York", "America/Los_Angeles", "America/St_Johns", "America/Sao_Paulo", "America/Santiago", "Europe/London",
+    "Europe/Berlin", "Africa/Cairo", "Asia/Tehran", "Asia/Kolkata", "Asia/Kathmandu", "Asia/Tokyo", "Australia/Adelaide",
+    "Australia/Sydney", "Australia/Lord_Howe", "Pacific/Chatham", "Pacific/Auckland", "Pacific/Kiritimati", "Pacific/Pago_Pago"
+};
+#define kSLDifferentialTestNumTimeZones (sizeof(kSLDifferentialTestTimeZoneNames) / sizeof(kSLDifferentialTestTimeZoneNames[0]))
+
+// a random skip rule, which is kept in the form that it is stored in the preferences
+typedef struct SLDifferentialTestSkipRule {
+    const char *type;
+    char startDate[kSLDateStringLength];
+    char endDate[kSLDateStringLength];
+    int hasEndDate;
+    long long interval;
+    long long weekdays;
+    long long weekday;
+    long long ordinal;
+    char exceptions[kSLDifferentialTestMaxExceptions][kSLDateStringLength];
+    size_t numExceptions;
+} SLDifferentialTestSkipRule;
+
+// A random case that contains the alarm preferences (custom skip dates, holiday selections, and skip rules), the time zone, the current
+// time, and the time that the skip decision is made for.  The custom skip dates are sorted like they are in the preferences.
+typedef struct SLDifferentialTestCase {
+    const char *timeZoneName;
+    time_t now;
+    time_t date;
+    int skipEnabled;
+    int skipActivatedStatus;
+    char customSkipDates[kSLDifferentialTestMaxCustomSkipDates][kSLDateStringLength];
+    size_t numCustomSkipDates;
+    SLTestHolidaySelection holidaySelections[kSLDifferentialTestMaxHolidayCountries];
+    size_t numHolidaySelections;
+    SLDifferentialTestSkipRule skipRules[kSLDifferentialTestMaxSkipRules];
+    size_t numSkipRules;
+} SLDifferentialTestCase;
+
+// The fixture of every holiday resource along with its name.  The reference never reads the compiled holiday resources.
+static char **sSLDifferentialTestResourceNames;
+static SLTestHolidayFixture **sSLDifferentialTestFixtures;
+static size_t sSLDifferentialTestNumResources;
+
+// the first and last days that every holiday fixture covers, which the clock and the skip decisions are kept within
+static SLDay sSLDifferentialTestFirstDay;
+static SLDay sSLDifferentialTestLastDay;
+
+// the holiday calendar that the optimized logic evaluates the compiled holiday resources with
+static SLTestHolidayCalendar *sSLDifferentialTestCalendar;
+
+// returns the next random number for the given state (splitmix64), which is used so that a seed can be replayed
+static uint64_t SLDifferentialTestRandom(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// returns a random number from 0 up to (but not including) the given upper bound
+static long long SLDifferentialTestRandomUniform(uint64_t *state, long long upperBound)
+{
+    return upperBound > 0 ? (long long)(SLDifferentialTestRandom(state) % (uint64_t)upperBound) : 0;
+}
+
+// makes the given time zone the local time zone of the test process
+static void SLDifferentialTestSetTimeZone(const char *timeZoneName)
+{
+    setenv("TZ", timeZoneName, 1);
+    tzset();
+}
+
+// writes the date string (yyyy-MM-dd) for the given day number to the given buffer
+static void SLDifferentialTestDateStringForDay(SLDay day, char *dateString)
+{
+    int32_t year, month, dayOfMonth;
+    SLCivilFromDay(day, &year, &month, &dayOfMonth);
+    snprintf(dateString, kSLDateStringLength, "%04d-%02d-%02d", (int)year, (int)month, (int)dayOfMonth);
+}
+
+// returns the day number of the given time in the local time zone, which is how the optimized logic finds the day of a date
+static SLDay SLDifferentialTestDayForTime(time_t time)
+{
+    struct tm local;
+    localtime_r(&time, &local);
+    return SLDayFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+// Returns the local time at the start of the given day (or the first time of the day if it does not start at midnight) along with the
+// start of the next day.
+static time_t SLDifferentialTestStartOfDay(SLDay day, time_t *startOfNextDay)
+{
+    int32_t year, month, dayOfMonth;
+    SLCivilFromDay(day, &year, &month, &dayOfMonth);
+    struct tm local = {0};
+    local.tm_year = year - 1900;
+    local.tm_mon = month - 1;
+    local.tm_mday = dayOfMonth;
+    local.tm_isdst = -1;
+    time_t startOfDay = mktime(&local);
+    if (startOfNextDay != NULL) {
+        memset(&local, 0, sizeof(local));
+        local.tm_year = year - 1900;
+        local.tm_mon = month - 1;
+        local.tm_mday = dayOfMonth + 1;
+        local.tm_isdst = -1;
+        *startOfNextDay = mktime(&local);
+    }
+    return startOfDay;
+}
+
+// Returns a random time on the given day in the local time zone.  The first and last seconds of the day are favored since the day
+// boundaries are where the optimized logic is most likely to differ.
+static time_t SLDifferentialTestRandomTimeOnDay(uint64_t *state, SLDay day)
+{
+    time_t startOfNextDay;
+    time_t startOfDay = SLDifferentialTestStartOfDay(day, &startOfNextDay);
+    switch (SLDifferentialTestRandomUniform(state, 3)) {
+        case 0:
+            return startOfDay + SLDifferentialTestRandomUniform(state, kSLDifferentialTestMidnightSeconds);
+        case 1:
+            return startOfNextDay - 1 - SLDifferentialTestRandomUniform(state, kSLDifferentialTestMidnightSeconds);
+        default:
+            return startOfDay + SLDifferentialTestRandomUniform(state, startOfNextDay - startOfDay);
+    }
+}
+
+// returns the fixture of the holiday resource with the given name, or NULL if the resource has no fixture
+static const SLTestHolidayFixture *SLDifferentialTestFixtureForResourceName(const char *resourceName)
+{
+    for (size_t i = 0; i < sSLDifferentialTestNumResources; i++) {
+        if (strcmp(sSLDifferentialTestResourceNames[i], resourceName) == 0) {
+            return sSLDifferentialTestFixtures[i];
+        }
+    }
+    return NULL;
+}
+
+// reads the fixture of the holiday resource with the given name, narrowing the range of days that every fixture covers
+static void SLDifferentialTestLoadHolidayFixture(const char *resourceName, void *context)
+{
+    (void)context;
+    SLTestHolidayFixture *fixture = SLTestHolidayFixtureRead(resourceName);
+    SLTestCheck(fixture != NULL, "the fixture of %s could not be read", resourceName);
+    char **resourceNames = realloc(sSLDifferentialTestResourceNames, (sSLDifferentialTestNumResources + 1) * sizeof(char *));
+    SLTestHolidayFixture **fixtures = realloc(sSLDifferentialTestFixtures, (sSLDifferentialTestNumResources + 1) * sizeof(SLTestHolidayFixture *));
+    if (resourceNames != NULL) {
+        sSLDifferentialTestResourceNames = resourceNames;
+    }
+    if (fixtures != NULL) {
+        sSLDifferentialTestFixtures = fixtures;
+    }
+    if (fixture == NULL || resourceNames == NULL || fixtures == NULL) {
+        SLTestHolidayFixtureFree(fixture);
+        return;
+    }
+    if (sSLDifferentialTestNumResources == 0 || fixture->firstDay > sSLDifferentialTestFirstDay) {
+        sSLDifferentialTestFirstDay = fixture->firstDay;
+    }
+    if (sSLDifferentialTestNumResources == 0 || fixture->lastDay < sSLDifferentialTestLastDay) {
+        sSLDifferentialTestLastDay = fixture->lastDay;
+    }
+    sSLDifferentialTestResourceNames[sSLDifferentialTestNumResources] = strdup(resourceName);
+    sSLDifferentialTestFixtures[sSLDifferentialTestNumResources++] = fixture;
+}
+
+// frees the fixtures that were loaded by SLDifferentialTestLoadHolidayFixture
+static void SLDifferentialTestFreeHolidayFixtures(void)
+{
+    for (size_t i = 0; i < sSLDifferentialTestNumResources; i++) {
+        free(sSLDifferentialTestResourceNames[i]);
+        SLTestHolidayFixtureFree(sSLDifferentialTestFixtures[i]);
+    }
+    free(sSLDifferentialTestResourceNames);
+    free(sSLDifferentialTestFixtures);
+}
+
+// Reference: parses the given date string into a time at midnight UTC with the C library, returning 0 if it is not a valid date
+static int SLReferenceTimeForDateString(const char *dateString, time_t *time)
+{
+    int year, month, dayOfMonth;
+    char extra;
+    if (sscanf(dateString, "%4d-%2d-%2d%c", &year, &month, &dayOfMonth, &extra) != 3) {
+        return 0;
+    }
+    struct tm utc = {0};
+    utc.tm_year = year - 1900;
+    utc.tm_mon = month - 1;
+    utc.tm_mday = dayOfMonth;
+    *time = timegm(&utc);
+    return utc.tm_year == year - 1900 && utc.tm_mon == month - 1 && utc.tm_mday == dayOfMonth;
+}
+
+// Reference: returns the date string that is the given number of days after the given date string, using the C library in UTC
+static void SLReferenceDateStringByAddingDays(const char *dateString, long days, char *result)
+{
+    time_t time = 0;
+    SLReferenceTimeForDateString(dateString, &time);
+    time += days * 24 * 60 * 60;
+    struct tm utc;
+    gmtime_r(&time, &utc);
+    strftime(result, kSLDateStringLength, "%Y-%m-%d", &utc);
+}
+
+// Reference: returns the date string of the given time in the local time zone, formatted by the C library
+static void SLReferenceDateStringForTime(time_t time, char *dateString)
+{
+    struct tm local;
+    localtime_r(&time, &local);
+    strftime(dateString, kSLDateStringLength, "%Y-%m-%d", &local);
+}
+
+// Reference: returns the date string of the given day number from a fixture, which is counted in days from January 1, 1970
+static void SLReferenceDateStringForFixtureDay(SLDay day, char *dateString)
+{
+    time_t time = (time_t)day * 24 * 60 * 60;
+    struct tm utc;
+    gmtime_r(&time, &utc);
+    strftime(dateString, kSLDateStringLength, "%Y-%m-%d", &utc);
+}
+
+// Reference: returns whether or not the given skip rule occurs on the given date string by interpreting the rule with the calendar of the
+// C library in UTC, rather than with the day arithmetic of the compiled skip rules.
+static int SLReferenceSkipRuleOccursOnDateString(const SLDifferentialTestSkipRule *skipRule, const char *dateString)
+{
+    if (strcmp(dateString, skipRule->startDate) < 0 || (skipRule->hasEndDate && strcmp(dateString, skipRule->endDate) > 0)) {
+        return 0;
+    }
+    for (size_t i = 0; i < skipRule->numExceptions; i++) {
+        if (strcmp(dateString, skipRule->exceptions[i]) == 0) {
+            return 0;
+        }
+    }
+
+    time_t time = 0, startTime = 0;
+    SLReferenceTimeForDateString(dateString, &time);
+    SLReferenceTimeForDateString(skipRule->startDate, &startTime);
+    struct tm date, startDate;
+    gmtime_r(&time, &date);
+    gmtime_r(&startTime, &startDate);
+    long long interval = skipRule->interval > 1 ? skipRule->interval : 1;
+
+    // the weekdays of a rule start on Monday, while the weekdays of the C library start on Sunday
+    int weekday = (date.tm_wday + 6) % kSLWeekdayNumWeekdays;
+    if (strcmp(skipRule->type, kSLTestSkipRuleTypeWeeklyString) == 0) {
+        if (!(skipRule->weekdays & (1 << weekday))) {
+            return 0;
+        }
+        time_t weekStartTime = time - weekday * 24 * 60 * 60;
+        time_t firstWeekStartTime = startTime - ((startDate.tm_wday + 6) % kSLWeekdayNumWeekdays) * 24 * 60 * 60;
+        return ((weekStartTime - firstWeekStartTime) / (7 * 24 * 60 * 60)) % interval == 0;
+    } else if (strcmp(skipRule->type, kSLTestSkipRuleTypeNthWeekdayString) == 0) {
+        if (weekday != skipRule->weekday || ((date.tm_year - startDate.tm_year) * 12 + date.tm_mon - startDate.tm_mon) % interval != 0) {
+            return 0;
+        }
+        if (skipRule->ordinal == kSLHolidayRuleLastOrdinal) {
+            time_t nextWeekTime = time + kSLWeekdayNumWeekdays * 24 * 60 * 60;
+            struct tm nextWeekDate;
+            gmtime_r(&nextWeekTime, &nextWeekDate);
+            return nextWeekDate.tm_mon != date.tm_mon;
+        }
+        return (date.tm_mday - 1) / kSLWeekdayNumWeekdays + 1 == skipRule->ordinal;
+    }
+    return strcmp(skipRule->type, kSLTestSkipRuleTypeDateRangeString) == 0;
+}
+
+// Reference: finds the first date string on or after the given date string that the skip rule occurs on (searching as many days as the
+// compiled skip rules), returning 0 if the rule does not occur again
+static int SLReferenceFirstDateStringForSkipRule(const SLDifferentialTestSkipRule *skipRule, const char *dateString, char *firstDateString)
+{
+    const char *searchStartDateString = strcmp(dateString, skipRule->startDate) < 0 ? skipRule->startDate : dateString;
+    for (long i = 0; i < kSLSkipRuleMaxSearchDays; i++) {
+        char searchDateString[kSLDateStringLength];
+        SLReferenceDateStringByAddingDays(searchStartDateString, i, searchDateString);
+        if (skipRule->hasEndDate && strcmp(searchDateString, skipRule->endDate) > 0) {
+            break;
+        }
+        if (SLReferenceSkipRuleOccursOnDateString(skipRule, searchDateString)) {
+            strcpy(firstDateString, searchDateString);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Reference: finds the first date string on or after the given date string (through the last day of the fixtures) of any of the holidays
+// in the given selection from the fixture of the resource, along with the name of that holiday.  Returns 0 if none of them occur again.
+static int SLReferenceFirstDateStringForHolidaySelection(const SLTestHolidaySelection *holidaySelection, const char *todayString,
+                                                         char *firstDateString, const char **holidayName)
+{
+    char lastDateString[kSLDateStringLength];
+    SLReferenceDateStringForFixtureDay(sSLDifferentialTestLastDay, lastDateString);
+    const SLTestHolidayFixture *fixture = SLDifferentialTestFixtureForResourceName(holidaySelection->resourceName);
+    int isFound = 0;
+    for (size_t i = 0; fixture != NULL && i < fixture->numHolidays; i++) {
+        const SLTestFixtureHoliday *holiday = &fixture->holidays[i];
+        if (holiday->holidayId < 0 || holiday->holidayId >= kSLTestMaxHolidayIds ||
+            !(holidaySelection->holidaySelection & (1ULL << holiday->holidayId))) {
+            continue;
+        }
+        for (size_t j = 0; j < holiday->numDays; j++) {
+            char dateString[kSLDateStringLength];
+            SLReferenceDateStringForFixtureDay(holiday->days[j], dateString);
+            if (strcmp(dateString, todayString) >= 0) {
+                if (strcmp(dateString, lastDateString) <= 0 && (!isFound || strcmp(dateString, firstDateString) < 0)) {
+                    strcpy(firstDateString, dateString);
+                    *holidayName = holiday->name;
+                    isFound = 1;
+                }
+                break;
+            }
+        }
+    }
+    return isFound;
+}
+
+// Reference: determines whether or not the alarm in the given case should be skipped on the date of the case by comparing the date against
+// every custom skip date, every date of the selected holidays, and every day of the skip rules
+static int SLReferenceShouldSkip(const SLDifferentialTestCase *testCase)
+{
+    if (!testCase->skipEnabled) {
+        return 0;
+    } else if (testCase->skipActivatedStatus == kSLDifferentialTestSkipActivated) {
+        return 1;
+    }
+
+    // the custom skip dates are days in the local time zone
+    char dateString[kSLDateStringLength];
+    SLReferenceDateStringForTime(testCase->date, dateString);
+    for (size_t i = 0; i < testCase->numCustomSkipDates; i++) {
+        if (strcmp(testCase->customSkipDates[i], dateString) == 0) {
+            return 1;
+        }
+    }
+
+    for (size_t i = 0; i < testCase->numHolidaySelections; i++) {
+        const SLTestHolidayFixture *fixture = SLDifferentialTestFixtureForResourceName(testCase->holidaySelections[i].resourceName);
+        for (size_t j = 0; fixture != NULL && j < fixture->numHolidays; j++) {
+            const SLTestFixtureHoliday *holiday = &fixture->holidays[j];
+            if (holiday->holidayId < 0 || holiday->holidayId >= kSLTestMaxHolidayIds ||
+                !(testCase->holidaySelections[i].holidaySelection & (1ULL << holiday->holidayId))) {
+                continue;
+            }
+            for (size_t k = 0; k < holiday->numDays; k++) {
+                char holidayDateString[kSLDateStringLength];
+                SLReferenceDateStringForFixtureDay(holiday->days[k], holidayDateString);
+                if (strcmp(holidayDateString, dateString) == 0) {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < testCase->numSkipRules; i++) {
+        if (SLReferenceSkipRuleOccursOnDateString(&testCase->skipRules[i], dateString)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Reference: writes an explanation of why the alarm in the given case will be skipped to the given buffer by finding the first date of each
+// kind of skip date separately
+static void SLReferenceSkipReasonExplanation(const SLDifferentialTestCase *testCase, char *explanation, size_t size)
+{
+    int length = snprintf(explanation, size, "popup=%d", testCase->skipActivatedStatus == kSLDifferentialTestSkipActivated);
+    if (testCase->numCustomSkipDates > 0) {
+        length += snprintf(explanation + length, size - length, " date=%s", testCase->customSkipDates[0]);
+    }
+
+    // ties between holidays are broken by the order of the holiday selections, then the order of the holidays in each resource
+    char todayString[kSLDateStringLength];
+    SLReferenceDateStringForTime(testCase->now, todayString);
+    char firstHolidayDateString[kSLDateStringLength];
+    const char *firstHolidayName = NULL;
+    for (size_t i = 0; i < testCase->numHolidaySelections; i++) {
+        char holidayDateString[kSLDateStringLength];
+        const char *holidayName = NULL;
+        if (SLReferenceFirstDateStringForHolidaySelection(&testCase->holidaySelections[i], todayString, holidayDateString, &holidayName) &&
+            (firstHolidayName == NULL || strcmp(holidayDateString, firstHolidayDateString) < 0)) {
+            strcpy(firstHolidayDateString, holidayDateString);
+            firstHolidayName = holidayName;
+        }
+    }
+    if (firstHolidayName != NULL) {
+        length += snprintf(explanation + length, size - length, " holiday=%s (%s)", firstHolidayDateString, firstHolidayName);
+    }
+
+    char firstSkipRuleDateString[kSLDateStringLength];
+    long firstSkipRuleIndex = -1;
+    for (size_t i = 0; i < testCase->numSkipRules; i++) {
+        char skipRuleDateString[kSLDateStringLength];
+        if (SLReferenceFirstDateStringForSkipRule(&testCase->skipRules[i], todayString, skipRuleDateString) &&
+            (firstSkipRuleIndex < 0 || strcmp(skipRuleDateString, firstSkipRuleDateString) < 0)) {
+            strcpy(firstSkipRuleDateString, skipRuleDateString);
+            firstSkipRuleIndex = (long)i;
+        }
+    }
+    if (firstSkipRuleIndex >= 0) {
+        snprintf(explanation + length, size - length, " rule=%s (%ld)", firstSkipRuleDateString, firstSkipRuleIndex);
+    }
+}
+
+// compiles the alarm preferences of the given case into the given skip dates, returning 0 if any of them could not be compiled
+static int SLDifferentialTestCompileCase(const SLDifferentialTestCase *testCase, SLTestSkipDates *skipDates)
+{
+    memset(skipDates, 0, sizeof(SLTestSkipDates));
+    for (size_t i = 0; i < testCase->numCustomSkipDates; i++) {
+        if (!SLTestSkipDatesAddCustomSkipDateString(skipDates, testCase->customSkipDates[i])) {
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < testCase->numHolidaySelections; i++) {
+        if (!SLTestSkipDatesAddHolidaySelection(skipDates, testCase->holidaySelections[i].resourceName, testCase->holidaySelections[i].holidaySelection)) {
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < testCase->numSkipRules; i++) {
+        const SLDifferentialTestSkipRule *skipRule = &testCase->skipRules[i];
+        SLSkipRule compiledSkipRule;
+        const char *exceptionStrings[kSLDifferentialTestMaxExceptions];
+        for (size_t j = 0; j < skipRule->numExceptions; j++) {
+            exceptionStrings[j] = skipRule->exceptions[j];
+        }
+        if (!SLTestCompileSkipRule(skipRule->type, skipRule->startDate, skipRule->hasEndDate ? skipRule->endDate : NULL, skipRule->interval,
+                                   skipRule->weekdays, skipRule->weekday, skipRule->ordinal, &compiledSkipRule) ||
+            !SLTestSkipDatesAddSkipRule(skipDates, &compiledSkipRule, exceptionStrings, skipRule->numExceptions)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Returns a random case whose current time and date of the decision are kept within the range of the holiday fixtures.  The local time
+// zone of the test process is set to the time zone of the case.
+static void SLDifferentialTestRandomCase(uint64_t *state, SLDifferentialTestCase *testCase)
+{
+    memset(testCase, 0, sizeof(SLDifferentialTestCase));
+    testCase->timeZoneName = kSLDifferentialTestTimeZoneNames[SLDifferentialTestRandomUniform(state, kSLDifferentialTestNumTimeZones)];
+    SLDifferentialTestSetTimeZone(testCase->timeZoneName);
+    testCase->now = SLDifferentialTestRandomTimeOnDay(state, sSLDifferentialTestFirstDay +
+                                                      (SLDay)SLDifferentialTestRandomUniform(state, kSLDifferentialTestClockDays));
+    SLDay today = SLDifferentialTestDayForTime(testCase->now);
+
+    // the custom skip dates, the dates of the selected holidays, and the exceptions to the skip rules are more likely to be chosen for the
+    // skip decision
+    SLDay candidateDays[kSLDifferentialTestMaxCustomSkipDates + kSLDifferentialTestMaxHolidayCountries * 3 +
+                        kSLDifferentialTestMaxSkipRules * kSLDifferentialTestMaxExceptions];
+    size_t numCandidateDays = 0;
+    long long numCustomSkipDates = SLDifferentialTestRandomUniform(state, kSLDifferentialTestMaxCustomSkipDates);
+    for (long long i = 0; i < numCustomSkipDates; i++) {
+        SLDay day = today - 10 + (SLDay)SLDifferentialTestRandomUniform(state, kSLDifferentialTestDateDays + 10);
+        char dateString[kSLDateStringLength];
+        SLDifferentialTestDateStringForDay(day, dateString);
+        candidateDays[numCandidateDays++] = day;
+
+        // the custom skip dates are unique and sorted
+        size_t index = 0;
+        while (index < testCase->numCustomSkipDates && strcmp(testCase->customSkipDates[index], dateString) < 0) {
+            index++;
+        }
+        if (index < testCase->numCustomSkipDates && strcmp(testCase->customSkipDates[index], dateString) == 0) {
+            continue;
+        }
+        memmove(testCase->customSkipDates[index + 1], testCase->customSkipDates[index],
+                (testCase->numCustomSkipDates - index) * kSLDateStringLength);
+        strcpy(testCase->customSkipDates[index], dateString);
+        testCase->numCustomSkipDates++;
+    }
+
+    long long numHolidayCountries = SLDifferentialTestRandomUniform(state, kSLDifferentialTestMaxHolidayCountries + 1);
+    for (long long i = 0; i < numHolidayCountries; i++) {
+        size_t resourceIndex = (size_t)SLDifferentialTestRandomUniform(state, (long long)sSLDifferentialTestNumResources);
+        const char *resourceName = sSLDifferentialTestResourceNames[resourceIndex];
+        const SLTestHolidayFixture *fixture = sSLDifferentialTestFixtures[resourceIndex];
+        SLTestHolidaySelection *holidaySelection = NULL;
+        for (size_t j = 0; j < testCase->numHolidaySelections; j++) {
+            if (strcmp(testCase->holidaySelections[j].resourceName, resourceName) == 0) {
+                holidaySelection = &testCase->holidaySelections[j];
+            }
+        }
+        if (holidaySelection == NULL) {
+            holidaySelection = &testCase->holidaySelections[testCase->numHolidaySelections++];
+            snprintf(holidaySelection->resourceName, sizeof(holidaySelection->resourceName), "%s", resourceName);
+            holidaySelection->holidaySelection = 0;
+        }
+        long long numHolidays = fixture->numHolidays > 0 ? SLDifferentialTestRandomUniform(state, 3) + 1 : 0;
+        for (long long j = 0; j < numHolidays; j++) {
+            const SLTestFixtureHoliday *holiday = &fixture->holidays[SLDifferentialTestRandomUniform(state, (long long)fixture->numHolidays)];
+            if (holiday->holidayId >= 0 && holiday->holidayId < kSLTestMaxHolidayIds) {
+                holidaySelection->holidaySelection |= 1ULL << holiday->holidayId;
+                if (holiday->numDays > 0) {
+                    candidateDays[numCandidateDays++] = holiday->days[SLDifferentialTestRandomUniform(state, (long long)holiday->numDays)];
+                }
+            }
+        }
+        if (holidaySelection->holidaySelection == 0) {
+            testCase->numHolidaySelections--;
+        }
+    }
+
+    long long numSkipRules = SLDifferentialTestRandomUniform(state, kSLDifferentialTestMaxSkipRules + 1);
+    for (long long i = 0; i < numSkipRules; i++) {
+        SLDifferentialTestSkipRule *skipRule = &testCase->skipRules[testCase->numSkipRules++];
+        SLDay startDay = today - 400 + (SLDay)SLDifferentialTestRandomUniform(state, 460);
+        SLDay endDay = startDay + (SLDay)SLDifferentialTestRandomUniform(state, 700);
+        switch (SLDifferentialTestRandomUniform(state, 3)) {
+            case 0:
+                skipRule->type = kSLTestSkipRuleTypeWeeklyString;
+                skipRule->weekdays = SLDifferentialTestRandomUniform(state, (1 << kSLWeekdayNumWeekdays) - 1) + 1;
+                skipRule->interval = SLDifferentialTestRandomUniform(state, 4) + 1;
+                break;
+            case 1: {
+                long long ordinal = SLDifferentialTestRandomUniform(state, 6);
+                skipRule->type = kSLTestSkipRuleTypeNthWeekdayString;
+                skipRule->weekday = SLDifferentialTestRandomUniform(state, kSLWeekdayNumWeekdays);
+                skipRule->ordinal = ordinal == 0 ? kSLHolidayRuleLastOrdinal : ordinal;
+                skipRule->interval = SLDifferentialTestRandomUniform(state, 12) + 1;
+                break;
+            }
+            default:
+                // date ranges are kept short and close to the current date so that they are likely to be checked
+                skipRule->type = kSLTestSkipRuleTypeDateRangeString;
+                startDay = today - 30 + (SLDay)SLDifferentialTestRandomUniform(state, 230);
+                endDay = startDay + (SLDay)SLDifferentialTestRandomUniform(state, 60);
+                break;
+        }
+        SLDifferentialTestDateStringForDay(startDay, skipRule->startDate);
+        if (strcmp(skipRule->type, kSLTestSkipRuleTypeDateRangeString) == 0 || SLDifferentialTestRandomUniform(state, 2) == 0) {
+            SLDifferentialTestDateStringForDay(endDay, skipRule->endDate);
+            skipRule->hasEndDate = 1;
+        }
+        long long numExceptions = SLDifferentialTestRandomUniform(state, kSLDifferentialTestMaxExceptions + 1);
+        for (long long j = 0; j < numExceptions; j++) {
+            SLDay exceptionDay = today + (SLDay)SLDifferentialTestRandomUniform(state, 60);
+            SLDifferentialTestDateStringForDay(exceptionDay, skipRule->exceptions[skipRule->numExceptions++]);
+            candidateDays[numCandidateDays++] = exceptionDay;
+        }
+    }
+
+    // pick the day of the skip decision from the candidates (as long as it is upcoming) or from the upcoming days
+    SLDay day = today + (SLDay)SLDifferentialTestRandomUniform(state, kSLDifferentialTestDateDays);
+    if (numCandidateDays > 0 && SLDifferentialTestRandomUniform(state, 3) == 0) {
+        SLDay candidateDay = candidateDays[SLDifferentialTestRandomUniform(state, (long long)numCandidateDays)];
+        if (candidateDay >= today && candidateDay <= today + kSLDifferentialTestDateDays) {
+            day = candidateDay;
+        }
+    }
+    testCase->date = SLDifferentialTestRandomTimeOnDay(state, day);
+    testCase->skipEnabled = SLDifferentialTestRandomUniform(state, 4) != 0;
+    testCase->skipActivatedStatus = (int)SLDifferentialTestRandomUniform(state, 3);
+}
+
+// Writes a description of the first difference between the optimized logic and the reference logic for the given case to the given
+// buffer, returning 0 if the case matches.  The local time zone of the test process is set to the time zone of the case.
+static int SLDifferentialTestDifferenceForCase(const SLDifferentialTestCase *testCase, char *difference, size_t size)
+{
+    SLDifferentialTestSetTimeZone(testCase->timeZoneName);
+    static SLTestSkipDates skipDates;
+    if (!SLDifferentialTestCompileCase(testCase, &skipDates)) {
+        snprintf(difference, size, "the skip dates could not be compiled");
+        return 1;
+    }
+
+    // the optimized logic makes the decision for the day of the date (like shouldSkipOnDate: does)
+    int shouldSkip = testCase->skipEnabled && (testCase->skipActivatedStatus == kSLDifferentialTestSkipActivated ||
+                                               SLTestSkipDatesReasonOnDay(&skipDates, sSLDifferentialTestCalendar,
+                                                                          SLDifferentialTestDayForTime(testCase->date)) != kSLTestSkipReasonNone);
+    int referenceShouldSkip = SLReferenceShouldSkip(testCase);
+    if (shouldSkip != referenceShouldSkip) {
+        snprintf(difference, size, "the skip decision was %d instead of %d", shouldSkip, referenceShouldSkip);
+        return 1;
+    }
+
+    // the explanation is compared by the dates and names that it lists rather than by the localized strings
+    SLDay today = SLDifferentialTestDayForTime(testCase->now);
+    SLTestSkipExplanation skipExplanation;
+    SLTestSkipDatesExplanation(&skipDates, sSLDifferentialTestCalendar, today, sSLDifferentialTestLastDay, &skipExplanation);
+    char explanation[256];
+    char dateString[kSLDateStringLength];
+    int length = snprintf(explanation, sizeof(explanation), "popup=%d", testCase->skipActivatedStatus == kSLDifferentialTestSkipActivated);
+    if (skipExplanation.hasCustomSkipDay) {
+        SLDifferentialTestDateStringForDay(skipExplanation.customSkipDay, dateString);
+        length += snprintf(explanation + length, sizeof(explanation) - length, " date=%s", dateString);
+    }
+    if (skipExplanation.hasHoliday) {
+        SLDifferentialTestDateStringForDay(skipExplanation.holidayDay, dateString);
+        length += snprintf(explanation + length, sizeof(explanation) - length, " holiday=%s (%s)", dateString, skipExplanation.holidayName);
+    }
+    if (skipExplanation.hasSkipRule) {
+        SLDifferentialTestDateStringForDay(skipExplanation.skipRuleDay, dateString);
+        snprintf(explanation + length, sizeof(explanation) - length, " rule=%s (%zu)", dateString, skipExplanation.skipRuleIndex);
+    }
+    char referenceExplanation[256];
+    SLReferenceSkipReasonExplanation(testCase, referenceExplanation, sizeof(referenceExplanation));
+    if (strcmp(explanation, referenceExplanation) != 0) {
+        snprintf(difference, size, "the skip explanation was \"%s\" instead of \"%s\"", explanation, referenceExplanation);
+        return 1;
+    }
+
+    // the first holiday of each selection is also shown on its own when the holidays are edited
+    char todayString[kSLDateStringLength];
+    SLReferenceDateStringForTime(testCase->now, todayString);
+    for (size_t i = 0; i < testCase->numHolidaySelections; i++) {
+        const SLTestHolidaySelection *holidaySelection = &testCase->holidaySelections[i];
+        SLDay holidayDay;
+        const char *holidayName = NULL;
+        int isFound = SLTestHolidayCalendarFirstDay(sSLDifferentialTestCalendar, holidaySelection->resourceName, holidaySelection->holidaySelection,
+                                                    today, sSLDifferentialTestLastDay, &holidayDay, &holidayName);
+        char referenceDateString[kSLDateStringLength];
+        const char *referenceHolidayName = NULL;
+        int isReferenceFound = SLReferenceFirstDateStringForHolidaySelection(holidaySelection, todayString, referenceDateString,
+                                                                             &referenceHolidayName);
+        if (isFound) {
+            SLDifferentialTestDateStringForDay(holidayDay, dateString);
+        }
+        if (isFound != isReferenceFound || (isFound && (strcmp(dateString, referenceDateString) != 0 || strcmp(holidayName, referenceHolidayName) != 0))) {
+            snprintf(difference, size, "the first holiday of %s was %s (%s) instead of %s (%s)", holidaySelection->resourceName,
+                     isFound ? dateString : "none", isFound ? holidayName : "", isReferenceFound ? referenceDateString : "none",
+                     isReferenceFound ? referenceHolidayName : "");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// writes a description of the given case to standard error, which is printed along with a case that does not match
+static void SLDifferentialTestPrintCase(const SLDifferentialTestCase *testCase)
+{
+    SLDifferentialTestSetTimeZone(testCase->timeZoneName);
+    char nowString[64], dateString[64];
+    struct tm local;
+    strftime(nowString, sizeof(nowString), "%Y-%m-%d %H:%M:%S %z", localtime_r(&testCase->now, &local));
+    strftime(dateString, sizeof(dateString), "%Y-%m-%d %H:%M:%S %z", localtime_r(&testCase->date, &local));
+    fprintf(stderr, "  timeZone=%s now=%s date=%s skipEnabled=%d skipActivatedStatus=%d\n", testCase->timeZoneName, nowString, dateString,
+            testCase->skipEnabled, testCase->skipActivatedStatus);
+    for (size_t i = 0; i < testCase->numCustomSkipDates; i++) {
+        fprintf(stderr, "  customSkipDate=%s\n", testCase->customSkipDates[i]);
+    }
+    for (size_t i = 0; i < testCase->numHolidaySelections; i++) {
+        fprintf(stderr, "  holidaySkipDates[%s]=%llu\n", testCase->holidaySelections[i].resourceName,
+                (unsigned long long)testCase->holidaySelections[i].holidaySelection);
+    }
+    for (size_t i = 0; i < testCase->numSkipRules; i++) {
+        const SLDifferentialTestSkipRule *skipRule = &testCase->skipRules[i];
+        fprintf(stderr, "  skipRule[%zu] type=%s startDate=%s endDate=%s interval=%lld weekdays=%lld weekday=%lld ordinal=%lld exceptions=",
+                i, skipRule->type, skipRule->startDate, skipRule->hasEndDate ? skipRule->endDate : "none", skipRule->interval,
+                skipRule->weekdays, skipRule->weekday, skipRule->ordinal);
+        for (size_t j = 0; j < skipRule->numExceptions; j++) {
+            fprintf(stderr, "%s%s", j > 0 ? "," : "", skipRule->exceptions[j]);
+        }
+        fputc('\n', stderr);
+    }
+}
+
+// Shrinks the given case (which does not match the reference logic) one step at a time for as long as the smaller case still does not
+// match, where each step removes a single custom skip date, holiday, skip rule, or exception.
+static void SLDifferentialTestShrinkCase(SLDifferentialTestCase *testCase, char *difference, size_t size)
+{
+    int didShrink = 1;
+    while (didShrink) {
+        didShrink = 0;
+        SLDifferentialTestCase smallerCase;
+        for (size_t i = 0; !didShrink && i < testCase->numCustomSkipDates; i++) {
+            smallerCase = *testCase;
+            memmove(smallerCase.customSkipDates[i], smallerCase.customSkipDates[i + 1], (smallerCase.numCustomSkipDates - i - 1) * kSLDateStringLength);
+            smallerCase.numCustomSkipDates--;
+            didShrink = SLDifferentialTestDifferenceForCase(&smallerCase, difference, size);
+        }
+        for (size_t i = 0; !didShrink && i < testCase->numHolidaySelections; i++) {
+            for (int holidayId = 0; !didShrink && holidayId < kSLTestMaxHolidayIds; holidayId++) {
+                if (!(testCase->holidaySelections[i].holidaySelection & (1ULL << holidayId))) {
+                    continue;
+                }
+                smallerCase = *testCase;
+                smallerCase.holidaySelections[i].holidaySelection &= ~(1ULL << holidayId);
+                if (smallerCase.holidaySelections[i].holidaySelection == 0) {
+                    memmove(&smallerCase.holidaySelections[i], &smallerCase.holidaySelections[i + 1],
+                            (smallerCase.numHolidaySelections - i - 1) * sizeof(SLTestHolidaySelection));
+                    smallerCase.numHolidaySelections--;
+                }
+                didShrink = SLDifferentialTestDifferenceForCase(&smallerCase, difference, size);
+            }
+        }
+        for (size_t i = 0; !didShrink && i < testCase->numSkipRules; i++) {
+            smallerCase = *testCase;
+            memmove(&smallerCase.skipRules[i], &smallerCase.skipRules[i + 1], (smallerCase.numSkipRules - i - 1) * sizeof(SLDifferentialTestSkipRule));
+            smallerCase.numSkipRules--;
+            didShrink = SLDifferentialTestDifferenceForCase(&smallerCase, difference, size);
+
+            for (size_t j = 0; !didShrink && j < testCase->skipRules[i].numExceptions; j++) {
+                smallerCase = *testCase;
+                SLDifferentialTestSkipRule *skipRule = &smallerCase.skipRules[i];
+                memmove(skipRule->exceptions[j], skipRule->exceptions[j + 1], (skipRule->numExceptions - j - 1) * kSLDateStringLength);
+                skipRule->numExceptions--;
+                didShrink = SLDifferentialTestDifferenceForCase(&smallerCase, difference, size);
+            }
+        }
+        if (didShrink) {
+            *testCase = smallerCase;
+        }
+    }
+
+    // the difference of the shrunk case is described again since the last smaller case that was tried might have matched
+    SLDifferentialTestDifferenceForCase(testCase, difference, size);
+}
+
+// returns the value of the given environment variable as an unsigned number, or the given default value if it is not set
+static uint64_t SLDifferentialTestEnvironmentValue(const char *name, uint64_t defaultValue)
+{
+    const char *value = getenv(name);
+    return value != NULL && value[0] != '\0' ? strtoull(value, NULL, 10) : defaultValue;
+}
+
+// runs the random cases, shrinking any case that does not match the reference logic to a minimal reproduction
+static void SLDifferentialTestRun(void)
+{
+    uint64_t numCases = SLDifferentialTestEnvironmentValue("SL_DIFFERENTIAL_CASES", kSLDifferentialTestNumCases);
+    uint64_t seed = SLDifferentialTestEnvironmentValue("SL_DIFFERENTIAL_SEED", kSLDifferentialTestSeed);
+    uint64_t state = seed;
+    uint64_t numSkipped = 0;
+    sSLDifferentialTestCalendar = SLTestHolidayCalendarCreate();
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0; i < numCases; i++) {
+        SLDifferentialTestCase testCase;
+        SLDifferentialTestRandomCase(&state, &testCase);
+        char difference[1024];
+        int isDifferent = SLDifferentialTestDifferenceForCase(&testCase, difference, sizeof(difference));
+        if (isDifferent) {
+            SLDifferentialTestShrinkCase(&testCase, difference, sizeof(difference));
+        }
+        SLTestCheck(!isDifferent, "case %llu with seed %llu does not match the reference logic: %s", (unsigned long long)i,
+                    (unsigned long long)seed, difference);
+        if (isDifferent) {
+            SLDifferentialTestPrintCase(&testCase);
+        }
+        numSkipped += SLReferenceShouldSkip(&testCase);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("SLDifferentialTests: %llu case(s) with seed %llu (%llu skipped) in %.2f s with %zu holiday year(s) evaluated\n",
+           (unsigned long long)numCases, (unsigned long long)seed, (unsigned long long)numSkipped,
+           (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9, SLTestHolidayCalendarNumEvaluatedYears(sSLDifferentialTestCalendar));
+    SLTestHolidayCalendarFree(sSLDifferentialTestCalendar);
+}
+
+// The optimized logic is the portable part of libSleeper that SLAlarmPrefs delegates to (the compiled holiday resources and skip rules),
+// while the reference only uses the holiday fixtures and the calendar of the C library.
+int main(void)
+{
+    // every time zone must be in the time zone database, since an unknown time zone is silently treated as UTC
+    for (size_t i = 0; i < kSLDifferentialTestNumTimeZones; i++) {
+        char path[256];
+        struct stat fileStatus;
+        snprintf(path, sizeof(path), "%s/%s", kSLDifferentialTestZoneInfoPath, kSLDifferentialTestTimeZoneNames[i]);
+        SLTestCheck(stat(path, &fileStatus) == 0, "the %s time zone is not in %s", kSLDifferentialTestTimeZoneNames[i], kSLDifferentialTestZoneInfoPath);
+    }
+
+    size_t numResources = SLTestEnumerateHolidayFixtures(SLDifferentialTestLoadHolidayFixture, NULL);
+    SLTestCheck(numResources > 0 && sSLDifferentialTestNumResources == numResources, "the fixtures in %s could not be read",
+                kSLTestHolidayFixturesPath);
+    if (numResources > 0 && sSLDifferentialTestNumResources == numResources) {
+        char firstDateString[kSLDateStringLength], lastDateString[kSLDateStringLength];
+        SLDifferentialTestDateStringForDay(sSLDifferentialTestFirstDay, firstDateString);
+        SLDifferentialTestDateStringForDay(sSLDifferentialTestLastDay, lastDateString);
+        SLTestCheck(sSLDifferentialTestFirstDay + kSLDifferentialTestClockDays + kSLDifferentialTestDateDays <= sSLDifferentialTestLastDay,
+                    "the holiday fixtures only cover %s through %s", firstDateString, lastDateString);
+        SLDifferentialTestRun();
+    }
+    SLDifferentialTestFreeHolidayFixtures();
+    return SLTestFinish("SLDifferentialTests");
+}
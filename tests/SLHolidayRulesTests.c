@@ -0,0 +1,232 @@
+//
+//  SLHolidayRulesTests.c
+//  Checks the calendar arithmetic and the compiled holiday rules in the bundle against the dates that they were compiled from.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include "SLTest.h"
+#include "SLTestPlist.h"
+#include "SLTestHolidays.h"
+#include "SLHolidayRules.h"
+#include "SLSkipRules.h"
+
+// the fixture that lists the holiday IDs that the names of the original holiday resources were migrated to
+#define kSLTestBaselineHolidayIdsPath   kSLTestHolidayFixturesPath "/baseline_holiday_ids.txt"
+
+// returns the day number for the given date, or a check fails and 0 is returned if the date can not be parsed
+static SLDay SLTestDayFromDateString(const char *dateString)
+{
+    SLDay day = 0;
+    SLTestCheck(SLSkipRuleParseDateString(dateString, &day), "\"%s\" is not a valid date", dateString);
+    return day;
+}
+
+// checks the day number conversions, weekdays, month lengths, and Easter dates against known values
+static void SLTestCalendarArithmetic(void)
+{
+    SLTestCheck(SLDayFromCivil(1970, 1, 1) == 0, "January 1, 1970 is not day 0");
+    SLTestCheck(SLDayFromCivil(2000, 3, 1) == 11017, "March 1, 2000 is not day 11017");
+    SLTestCheck(SLDayFromCivil(1969, 12, 31) == -1, "December 31, 1969 is not day -1");
+    SLTestCheck(SLWeekdayForDay(0) == kSLWeekdayThursday, "January 1, 1970 is not a Thursday");
+    SLTestCheck(SLWeekdayForDay(-1) == kSLWeekdayWednesday, "December 31, 1969 is not a Wednesday");
+    SLTestCheck(SLWeekdayForDay(SLDayFromCivil(2026, 10, 19)) == kSLWeekdayMonday, "October 19, 2026 is not a Monday");
+
+    // every day from 1900 through 2199 must convert back to the same date
+    for (SLDay day = SLDayFromCivil(1900, 1, 1); day < SLDayFromCivil(2200, 1, 1); day++) {
+        int32_t year, month, dayOfMonth;
+        SLCivilFromDay(day, &year, &month, &dayOfMonth);
+        if (SLDayFromCivil(year, month, dayOfMonth) != day || dayOfMonth < 1 || dayOfMonth > SLDaysInMonth(year, month)) {
+            SLTestCheck(0, "day %d converted to %04d-%02d-%02d", day, year, month, dayOfMonth);
+            break;
+        }
+    }
+
+    SLTestCheck(SLDaysInMonth(2024, 2) == 29, "February 2024 does not have 29 days");
+    SLTestCheck(SLDaysInMonth(2100, 2) == 28, "February 2100 does not have 28 days");
+    SLTestCheck(SLDaysInMonth(2000, 2) == 29, "February 2000 does not have 29 days");
+    SLTestCheck(SLDaysInMonth(2026, 4) == 30, "April 2026 does not have 30 days");
+
+    static const char *const westernEasters[] = {"1818-03-22", "2024-03-31", "2025-04-20", "2026-04-05", "2038-04-25", "2285-03-22"};
+    for (size_t i = 0; i < sizeof(westernEasters) / sizeof(westernEasters[0]); i++) {
+        SLDay day = SLTestDayFromDateString(westernEasters[i]);
+        int32_t year;
+        SLCivilFromDay(day, &year, NULL, NULL);
+        SLTestCheck(SLWesternEasterForYear(year) == day, "the western Easter of %d is not %s", year, westernEasters[i]);
+    }
+    static const char *const orthodoxEasters[] = {"2023-04-16", "2024-05-05", "2025-04-20", "2026-04-12", "2030-04-28"};
+    for (size_t i = 0; i < sizeof(orthodoxEasters) / sizeof(orthodoxEasters[0]); i++) {
+        SLDay day = SLTestDayFromDateString(orthodoxEasters[i]);
+        int32_t year;
+        SLCivilFromDay(day, &year, NULL, NULL);
+        SLTestCheck(SLOrthodoxEasterForYear(year) == day, "the orthodox Easter of %d is not %s", year, orthodoxEasters[i]);
+    }
+
+    SLHolidayRule rule;
+    memset(&rule, 0, sizeof(rule));
+    SLTestCheck(SLHolidayRuleParseObserved(&rule, "0,0,0,0,0,-1,x") && rule.observed[kSLWeekdaySaturday] == -1 &&
+                rule.observed[kSLWeekdaySunday] == kSLHolidayRuleNotObserved, "the observed shifts were not parsed");
+    SLTestCheck(!SLHolidayRuleParseObserved(&rule, "0,0,0,0,0,-1") && rule.observed[kSLWeekdaySaturday] == 0,
+                "too few observed shifts were parsed");
+    SLTestCheck(!SLHolidayRuleParseObserved(&rule, "0,0,0,0,0,1,1,1"), "too many observed shifts were parsed");
+}
+
+// Checks every holiday in the holiday resource with the given name against the dates in its fixture, day-for-day within the range of the
+// fixture.  Every holiday in the resource must be listed in the fixture (and the other way around) with a unique ID that can be selected.
+static void SLTestHolidayResource(const char *resourceName, void *context)
+{
+    (void)context;
+    SLTestPlistNode *resource = SLTestHolidayResourceRead(resourceName);
+    SLTestCheck(resource != NULL, "%s could not be read from the bundle", resourceName);
+    SLTestHolidayFixture *fixture = SLTestHolidayFixtureRead(resourceName);
+    SLTestCheck(fixture != NULL, "the fixture of %s could not be read", resourceName);
+    SLDay *days = malloc(kSLTestMaxHolidayDays * sizeof(SLDay));
+    if (resource == NULL || fixture == NULL || days == NULL) {
+        free(days);
+        SLTestHolidayFixtureFree(fixture);
+        SLTestPlistFree(resource);
+        return;
+    }
+
+    int hasRules = SLTestHolidayResourceHasRules(resource);
+    const SLTestPlistNode *holidays = SLTestPlistObjectForKey(resource, "holidays");
+    uint64_t fixtureHolidayIds = 0;
+    for (size_t holidayIndex = 0; holidayIndex < fixture->numHolidays; holidayIndex++) {
+        const SLTestFixtureHoliday *fixtureHoliday = &fixture->holidays[holidayIndex];
+        long long holidayId = fixtureHoliday->holidayId;
+        const SLTestPlistNode *holiday = SLTestHolidayForId(holidays, holidayId);
+        SLTestCheck(holiday != NULL, "%s does not contain holiday %lld from the fixture", resourceName, holidayId);
+        if (holiday == NULL) {
+            continue;
+        }
+        const SLTestPlistNode *name = SLTestPlistObjectForKey(holiday, "name");
+        SLTestCheck(name != NULL && strcmp(name->text, fixtureHoliday->name) == 0, "%s holiday %lld is not named \"%s\"", resourceName,
+                    holidayId, fixtureHoliday->name);
+        SLTestCheck(holidayId >= 0 && holidayId < kSLTestMaxHolidayIds && !(fixtureHolidayIds & (1ULL << holidayId)),
+                    "%s holiday %lld does not have a unique ID that can be selected", resourceName, holidayId);
+        if (holidayId >= 0 && holidayId < kSLTestMaxHolidayIds) {
+            fixtureHolidayIds |= 1ULL << holidayId;
+        }
+
+        size_t numDays = SLTestDaysForHoliday(holiday, hasRules, fixture->firstDay, fixture->lastDay, days, kSLTestMaxHolidayDays);
+        if (numDays > kSLTestMaxHolidayDays) {
+            SLTestCheck(0, "%s holiday %lld (%s) is invalid or occurs on too many days", resourceName, holidayId, fixtureHoliday->name);
+            continue;
+        }
+
+        // report the first day that differs, which is enough to find the rule or exception that is wrong
+        const SLDay *expectedDays = fixtureHoliday->days;
+        size_t numExpectedDays = fixtureHoliday->numDays;
+        size_t i = 0;
+        while (i < numDays && i < numExpectedDays && days[i] == expectedDays[i]) {
+            i++;
+        }
+        int32_t year = 0, month = 0, dayOfMonth = 0;
+        int isMissing = i < numExpectedDays && (i >= numDays || expectedDays[i] < days[i]);
+        if (i < numDays || i < numExpectedDays) {
+            SLCivilFromDay(isMissing ? expectedDays[i] : days[i], &year, &month, &dayOfMonth);
+        }
+        SLTestCheck(i == numDays && i == numExpectedDays, "%s holiday %lld (%s) %s %04d-%02d-%02d", resourceName, holidayId,
+                    fixtureHoliday->name, isMissing ? "does not occur on" : "should not occur on", year, month, dayOfMonth);
+    }
+
+    // every holiday in the resource must be checked by the fixture
+    for (size_t i = 0; holidays != NULL && i < holidays->numChildren; i++) {
+        const SLTestPlistNode *holidayId = SLTestPlistObjectForKey(&holidays->children[i], "id");
+        SLTestCheck(holidayId != NULL && holidayId->integer >= 0 && holidayId->integer < kSLTestMaxHolidayIds &&
+                    (fixtureHolidayIds & (1ULL << holidayId->integer)), "%s holiday %zu is not in the fixture", resourceName, i);
+    }
+
+    free(days);
+    SLTestHolidayFixtureFree(fixture);
+    SLTestPlistFree(resource);
+}
+
+// Checks that every holiday ID that the names of the original holiday resources were migrated to (which users may have selected) still
+// resolves to a holiday with a rule in its resource, either with the original name or with the original name kept in the aliases.
+static void SLTestBaselineHolidayIds(void)
+{
+    FILE *fixture = fopen(kSLTestBaselineHolidayIdsPath, "r");
+    SLTestCheck(fixture != NULL, "%s could not be read", kSLTestBaselineHolidayIdsPath);
+    if (fixture == NULL) {
+        return;
+    }
+
+    char resourceName[256] = "";
+    SLTestPlistNode *resource = NULL;
+    size_t numHolidayIds = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    while (getline(&line, &lineCapacity, fixture) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0') {
+            continue;
+        }
+        char *fields[3] = {line, NULL, NULL};
+        for (int i = 1; i < 3 && fields[i - 1] != NULL; i++) {
+            char *tab = strchr(fields[i - 1], '\t');
+            if (tab != NULL) {
+                *tab = '\0';
+                fields[i] = tab + 1;
+            }
+        }
+        if (fields[2] == NULL) {
+            SLTestCheck(0, "%s has an invalid line", kSLTestBaselineHolidayIdsPath);
+            continue;
+        }
+
+        // the lines are grouped by resource, so each resource is only read once
+        if (strcmp(resourceName, fields[0]) != 0) {
+            SLTestPlistFree(resource);
+            snprintf(resourceName, sizeof(resourceName), "%s", fields[0]);
+            resource = SLTestHolidayResourceRead(resourceName);
+            SLTestCheck(resource != NULL, "%s could not be read from the bundle", resourceName);
+        }
+        long long holidayId = strtoll(fields[1], NULL, 10);
+        const SLTestPlistNode *holiday = SLTestHolidayForId(SLTestPlistObjectForKey(resource, "holidays"), holidayId);
+        SLTestCheck(holiday != NULL && SLTestPlistObjectForKey(holiday, "type") != NULL, "%s holiday %lld (%s) no longer resolves to a holiday",
+                    resourceName, holidayId, fields[2]);
+        if (holiday == NULL) {
+            continue;
+        }
+        const SLTestPlistNode *name = SLTestPlistObjectForKey(holiday, "name");
+        const SLTestPlistNode *alias = SLTestPlistObjectForKey(SLTestPlistObjectForKey(resource, "aliases"), fields[2]);
+        SLTestCheck((name != NULL && strcmp(name->text, fields[2]) == 0) || (alias != NULL && alias->integer == holidayId),
+                    "%s holiday %lld was renamed from \"%s\" without an alias", resourceName, holidayId, fields[2]);
+        numHolidayIds++;
+    }
+    SLTestCheck(numHolidayIds > 0, "%s does not list any holiday IDs", kSLTestBaselineHolidayIdsPath);
+
+    SLTestPlistFree(resource);
+    free(line);
+    fclose(fixture);
+}
+
+int main(void)
+{
+    SLTestCalendarArithmetic();
+    SLTestBaselineHolidayIds();
+
+    // check every resource that has a fixture, which must be every holiday resource in the bundle
+    size_t numResources = SLTestEnumerateHolidayFixtures(SLTestHolidayResource, NULL);
+    SLTestCheck(numResources > 0, "%s could not be opened", kSLTestHolidayFixturesPath);
+
+    size_t numBundleResources = 0;
+    DIR *bundle = opendir(kSLTestSleeperBundlePath);
+    SLTestCheck(bundle != NULL, "%s could not be opened", kSLTestSleeperBundlePath);
+    for (struct dirent *entry = bundle != NULL ? readdir(bundle) : NULL; entry != NULL; entry = readdir(bundle)) {
+        size_t length = strlen(entry->d_name);
+        numBundleResources += length > strlen("_holidays.plist") && strcmp(entry->d_name + length - strlen("_holidays.plist"), "_holidays.plist") == 0;
+    }
+    if (bundle != NULL) {
+        closedir(bundle);
+    }
+    SLTestCheck(numResources == numBundleResources, "%zu of the %zu holiday resources have a fixture", numResources, numBundleResources);
+    return SLTestFinish("SLHolidayRulesTests");
+}
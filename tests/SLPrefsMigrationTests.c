@@ -0,0 +1,284 @@
+//
+//  SLPrefsMigrationTests.c
+//  Checks the preferences fixtures for each schema version against a reference of the schema migrations.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "SLTest.h"
+#include "SLTestPlist.h"
+#include "SLTestHolidays.h"
+#include "SLHolidayRules.h"
+#include "SLSkipRules.h"
+#include "SLPrefsReader.h"
+
+// the directory of the preferences fixtures, where each file is named for its schema version (i.e. v1.plist)
+#define kSLTestPrefsFixturesPath    kSLTestFixturesPath "/prefs"
+
+// the current schema version of the preferences (this must match kSLPrefsSchemaVersion in SLPrefsManager.h)
+#define kSLTestPrefsSchemaVersion   3
+
+// the keys of the preferences that are changed by the migrations (these must match the keys that are defined in SLPrefsManager.h)
+#define kSLTestSchemaVersionKey             "schemaVersion"
+#define kSLTestCustomSkipDatesKey           "customSkipDates"
+#define kSLTestCustomSkipDateStringsKey     "customSkipDateStrings"
+#define kSLTestHolidaySkipDatesKey          "holidaySkipDates"
+
+// the maximum number of custom skip dates that a single alarm in the fixtures can have
+#define kSLTestMaxCustomSkipDates   64
+
+// returns the preferences fixture for the given schema version, or NULL if it could not be read
+static SLTestPlistNode *SLTestPrefsForSchemaVersion(int schemaVersion)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/v%d.plist", kSLTestPrefsFixturesPath, schemaVersion);
+    SLTestPlistNode *prefs = SLTestPlistRead(path);
+    SLTestCheck(prefs != NULL && prefs->type == kSLTestPlistTypeDictionary, "%s could not be read", path);
+    return prefs;
+}
+
+// returns whether or not the given objects are equal, where the values of dictionaries are compared regardless of the order of their keys
+static int SLTestPlistNodesEqual(const SLTestPlistNode *lhs, const SLTestPlistNode *rhs)
+{
+    if (lhs == NULL || rhs == NULL || lhs->type != rhs->type || lhs->numChildren != rhs->numChildren || lhs->integer != rhs->integer ||
+        (lhs->text == NULL) != (rhs->text == NULL) || (lhs->text != NULL && lhs->type != kSLTestPlistTypeInteger && strcmp(lhs->text, rhs->text) != 0)) {
+        return lhs == rhs;
+    }
+    for (size_t i = 0; i < lhs->numChildren; i++) {
+        const SLTestPlistNode *rhsChild = lhs->type == kSLTestPlistTypeDictionary ? SLTestPlistObjectForKey(rhs, lhs->children[i].key) :
+                                                                                    &rhs->children[i];
+        if (!SLTestPlistNodesEqual(&lhs->children[i], rhsChild)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Reference: returns the day that the given legacy skip date (a local midnight stored as a UTC date, i.e. "2026-12-25T05:00:00Z") falls on
+// in the time zone that the tests are run with, or 0 if the date could not be parsed
+static int SLReferenceDayForLegacyDate(const char *dateText, SLDay *day)
+{
+    struct tm components;
+    memset(&components, 0, sizeof(components));
+    if (sscanf(dateText, "%d-%d-%dT%d:%d:%dZ", &components.tm_year, &components.tm_mon, &components.tm_mday, &components.tm_hour,
+               &components.tm_min, &components.tm_sec) != 6) {
+        return 0;
+    }
+    components.tm_year -= 1900;
+    components.tm_mon -= 1;
+    time_t time = timegm(&components);
+    struct tm localComponents;
+    if (localtime_r(&time, &localComponents) == NULL) {
+        return 0;
+    }
+    *day = SLDayFromCivil(localComponents.tm_year + 1900, localComponents.tm_mon + 1, localComponents.tm_mday);
+    return 1;
+}
+
+// Reference: returns the selection of the given holiday names in the holiday resource with the given name from the bundle, where a name
+// is found in the aliases of the resource first and then in the names of its holidays (names that are not found are dropped)
+static uint64_t SLReferenceHolidaySelection(const SLTestPlistNode *holidayNames, const char *resourceName)
+{
+    SLTestPlistNode *resource = SLTestHolidayResourceRead(resourceName);
+    SLTestCheck(resource != NULL, "%s could not be read from the bundle", resourceName);
+    const SLTestPlistNode *holidays = SLTestPlistObjectForKey(resource, "holidays");
+    const SLTestPlistNode *aliases = SLTestPlistObjectForKey(resource, "aliases");
+    uint64_t holidaySelection = 0;
+    for (size_t i = 0; resource != NULL && i < holidayNames->numChildren; i++) {
+        const SLTestPlistNode *holidayName = &holidayNames->children[i];
+        if (holidayName->type != kSLTestPlistTypeString) {
+            continue;
+        }
+        const SLTestPlistNode *aliasedHolidayId = SLTestPlistObjectForKey(aliases, holidayName->text);
+        if (aliasedHolidayId != NULL && aliasedHolidayId->integer >= 0 && aliasedHolidayId->integer < kSLTestMaxHolidayIds) {
+            holidaySelection |= 1ULL << aliasedHolidayId->integer;
+            continue;
+        }
+        for (size_t j = 0; holidays != NULL && j < holidays->numChildren; j++) {
+            const SLTestPlistNode *name = SLTestPlistObjectForKey(&holidays->children[j], "name");
+            const SLTestPlistNode *holidayId = SLTestPlistObjectForKey(&holidays->children[j], "id");
+            if (name != NULL && strcmp(name->text, holidayName->text) == 0 && holidayId != NULL && holidayId->integer >= 0 &&
+                holidayId->integer < kSLTestMaxHolidayIds) {
+                holidaySelection |= 1ULL << holidayId->integer;
+                break;
+            }
+        }
+    }
+    SLTestPlistFree(resource);
+    return holidaySelection;
+}
+
+// compares two date strings for sorting
+static int SLTestCompareStrings(const void *lhs, const void *rhs)
+{
+    return strcmp(*(const char *const *)lhs, *(const char *const *)rhs);
+}
+
+// Reference (version 2): checks that the custom skip date strings of the migrated skip dates are the sorted date strings of the original
+// skip dates (both the legacy dates and the strings) without duplicates, and that the legacy dates were removed
+static void SLReferenceCheckCustomSkipDates(const SLTestPlistNode *skipDates, const SLTestPlistNode *migratedSkipDates, const char *description)
+{
+    char dateStrings[kSLTestMaxCustomSkipDates][11];
+    const char *sortedDateStrings[kSLTestMaxCustomSkipDates];
+    size_t numDateStrings = 0;
+    const SLTestPlistNode *customSkipDateStrings = SLTestPlistObjectForKey(skipDates, kSLTestCustomSkipDateStringsKey);
+    for (size_t i = 0; customSkipDateStrings != NULL && i < customSkipDateStrings->numChildren && numDateStrings < kSLTestMaxCustomSkipDates; i++) {
+        if (customSkipDateStrings->children[i].type == kSLTestPlistTypeString) {
+            snprintf(dateStrings[numDateStrings++], sizeof(dateStrings[0]), "%s", customSkipDateStrings->children[i].text);
+        }
+    }
+    const SLTestPlistNode *customSkipDates = SLTestPlistObjectForKey(skipDates, kSLTestCustomSkipDatesKey);
+    for (size_t i = 0; customSkipDates != NULL && i < customSkipDates->numChildren && numDateStrings < kSLTestMaxCustomSkipDates; i++) {
+        SLDay day;
+        if (customSkipDates->children[i].type == kSLTestPlistTypeDate && SLReferenceDayForLegacyDate(customSkipDates->children[i].text, &day)) {
+            int32_t year, month, dayOfMonth;
+            SLCivilFromDay(day, &year, &month, &dayOfMonth);
+            snprintf(dateStrings[numDateStrings++], sizeof(dateStrings[0]), "%04d-%02d-%02d", year, month, dayOfMonth);
+        }
+    }
+    for (size_t i = 0; i < numDateStrings; i++) {
+        sortedDateStrings[i] = dateStrings[i];
+    }
+    qsort(sortedDateStrings, numDateStrings, sizeof(sortedDateStrings[0]), SLTestCompareStrings);
+
+    const SLTestPlistNode *migratedDateStrings = SLTestPlistObjectForKey(migratedSkipDates, kSLTestCustomSkipDateStringsKey);
+    size_t numMigratedDateStrings = 0;
+    int isEqual = migratedDateStrings != NULL && migratedDateStrings->type == kSLTestPlistTypeArray;
+    for (size_t i = 0; isEqual && i < numDateStrings; i++) {
+        if (i > 0 && strcmp(sortedDateStrings[i], sortedDateStrings[i - 1]) == 0) {
+            continue;
+        }
+        isEqual = numMigratedDateStrings < migratedDateStrings->numChildren &&
+                  strcmp(migratedDateStrings->children[numMigratedDateStrings++].text, sortedDateStrings[i]) == 0;
+    }
+    SLTestCheck(isEqual && numMigratedDateStrings == migratedDateStrings->numChildren, "%s has the wrong custom skip date strings", description);
+    SLTestCheck(SLTestPlistObjectForKey(migratedSkipDates, kSLTestCustomSkipDatesKey) == NULL, "%s kept the legacy custom skip dates", description);
+}
+
+// Reference (version 3): checks that the holidays that are selected by name in the original skip dates are selected by their IDs in the
+// migrated skip dates, where the countries without any selected holidays are removed
+static void SLReferenceCheckHolidaySkipDates(const SLTestPlistNode *skipDates, const SLTestPlistNode *migratedSkipDates, const char *description)
+{
+    const SLTestPlistNode *holidaySkipDates = SLTestPlistObjectForKey(skipDates, kSLTestHolidaySkipDatesKey);
+    const SLTestPlistNode *migratedHolidaySkipDates = SLTestPlistObjectForKey(migratedSkipDates, kSLTestHolidaySkipDatesKey);
+    if (holidaySkipDates == NULL || holidaySkipDates->type != kSLTestPlistTypeDictionary) {
+        SLTestCheck(SLTestPlistNodesEqual(holidaySkipDates, migratedHolidaySkipDates), "%s changed invalid holiday skip dates", description);
+        return;
+    }
+
+    size_t numSelections = 0;
+    for (size_t i = 0; i < holidaySkipDates->numChildren; i++) {
+        const SLTestPlistNode *selectedHolidays = &holidaySkipDates->children[i];
+        uint64_t holidaySelection = 0;
+        if (selectedHolidays->type == kSLTestPlistTypeArray) {
+            holidaySelection = SLReferenceHolidaySelection(selectedHolidays, selectedHolidays->key);
+        } else if (selectedHolidays->type == kSLTestPlistTypeInteger) {
+            holidaySelection = (uint64_t)selectedHolidays->integer;
+        }
+        const SLTestPlistNode *migratedSelection = SLTestPlistObjectForKey(migratedHolidaySkipDates, selectedHolidays->key);
+        if (holidaySelection != 0) {
+            numSelections++;
+            SLTestCheck(migratedSelection != NULL && migratedSelection->type == kSLTestPlistTypeInteger &&
+                        (uint64_t)migratedSelection->integer == holidaySelection, "%s selects %s %s instead of %llu", description,
+                        selectedHolidays->key, migratedSelection != NULL ? migratedSelection->text : "(nothing)", (unsigned long long)holidaySelection);
+        } else {
+            SLTestCheck(migratedSelection == NULL, "%s kept %s without any selected holidays", description, selectedHolidays->key);
+        }
+    }
+    SLTestCheck(migratedHolidaySkipDates != NULL && migratedHolidaySkipDates->numChildren == numSelections,
+                "%s has the wrong number of holiday countries", description);
+}
+
+// Reference: checks that the given alarm was migrated from the given schema version, where only the skip dates are changed
+static void SLReferenceCheckMigratedAlarm(const SLTestPlistNode *alarm, const SLTestPlistNode *migratedAlarm, int schemaVersion,
+                                          const char *description)
+{
+    const SLTestPlistNode *skipDates = SLTestPlistObjectForKey(alarm, kSLPrefsReaderSkipDatesKey);
+    if (alarm->type != kSLTestPlistTypeDictionary || skipDates == NULL || skipDates->type != kSLTestPlistTypeDictionary) {
+        SLTestCheck(SLTestPlistNodesEqual(alarm, migratedAlarm), "%s was changed", description);
+        return;
+    }
+
+    SLTestCheck(migratedAlarm != NULL && migratedAlarm->numChildren == alarm->numChildren, "%s has the wrong keys", description);
+    for (size_t i = 0; i < alarm->numChildren; i++) {
+        if (skipDates != &alarm->children[i]) {
+            SLTestCheck(SLTestPlistNodesEqual(&alarm->children[i], SLTestPlistObjectForKey(migratedAlarm, alarm->children[i].key)),
+                        "%s changed %s", description, alarm->children[i].key);
+        }
+    }
+
+    const SLTestPlistNode *migratedSkipDates = SLTestPlistObjectForKey(migratedAlarm, kSLPrefsReaderSkipDatesKey);
+    if (schemaVersion < 2) {
+        SLReferenceCheckCustomSkipDates(skipDates, migratedSkipDates, description);
+    } else {
+        SLTestCheck(SLTestPlistNodesEqual(SLTestPlistObjectForKey(skipDates, kSLTestCustomSkipDateStringsKey),
+                                          SLTestPlistObjectForKey(migratedSkipDates, kSLTestCustomSkipDateStringsKey)),
+                    "%s changed the custom skip date strings", description);
+    }
+    if (schemaVersion < 3) {
+        SLReferenceCheckHolidaySkipDates(skipDates, migratedSkipDates, description);
+    } else {
+        SLTestCheck(SLTestPlistNodesEqual(SLTestPlistObjectForKey(skipDates, kSLTestHolidaySkipDatesKey),
+                                          SLTestPlistObjectForKey(migratedSkipDates, kSLTestHolidaySkipDatesKey)),
+                    "%s changed the holiday skip dates", description);
+    }
+}
+
+// Checks that the fixture of the current schema version is what the fixture of every older schema version migrates to, which covers both
+// migrating through every version at once and migrating a file that was already partially migrated.  The holiday names are resolved with
+// the holiday resources in the bundle, so a change to the resources that would select different holidays after migrating is caught here.
+// The legacy skip dates in the version 1 fixture are local midnights in the time zone that the tests are run with.
+static void SLTestMigrations(void)
+{
+    SLTestPlistNode *currentPrefs = SLTestPrefsForSchemaVersion(kSLTestPrefsSchemaVersion);
+    const SLTestPlistNode *currentSchemaVersion = SLTestPlistObjectForKey(currentPrefs, kSLTestSchemaVersionKey);
+    SLTestCheck(currentSchemaVersion != NULL && currentSchemaVersion->integer == kSLTestPrefsSchemaVersion,
+                "the fixture for the current version has the wrong schema version");
+    const SLTestPlistNode *currentAlarms = SLTestPlistObjectForKey(currentPrefs, kSLPrefsReaderAlarmsKey);
+
+    for (int schemaVersion = 1; currentPrefs != NULL && schemaVersion < kSLTestPrefsSchemaVersion; schemaVersion++) {
+        SLTestPlistNode *prefs = SLTestPrefsForSchemaVersion(schemaVersion);
+        if (prefs == NULL) {
+            continue;
+        }
+
+        // preferences files without a schema version are version 1
+        const SLTestPlistNode *prefsSchemaVersion = SLTestPlistObjectForKey(prefs, kSLTestSchemaVersionKey);
+        SLTestCheck(schemaVersion > 1 ? prefsSchemaVersion != NULL && prefsSchemaVersion->integer == schemaVersion : prefsSchemaVersion == NULL,
+                    "the fixture for version %d has the wrong schema version", schemaVersion);
+
+        // only the schema version and the alarms are changed by the migrations
+        SLTestCheck(currentPrefs->numChildren == prefs->numChildren + (prefsSchemaVersion == NULL), "migrating version %d changed the keys",
+                    schemaVersion);
+        for (size_t i = 0; i < prefs->numChildren; i++) {
+            const char *key = prefs->children[i].key;
+            if (strcmp(key, kSLTestSchemaVersionKey) != 0 && strcmp(key, kSLPrefsReaderAlarmsKey) != 0) {
+                SLTestCheck(SLTestPlistNodesEqual(&prefs->children[i], SLTestPlistObjectForKey(currentPrefs, key)), "migrating version %d changed %s",
+                            schemaVersion, key);
+            }
+        }
+
+        const SLTestPlistNode *alarms = SLTestPlistObjectForKey(prefs, kSLPrefsReaderAlarmsKey);
+        SLTestCheck(alarms != NULL && currentAlarms != NULL && alarms->numChildren == currentAlarms->numChildren,
+                    "migrating version %d changed the number of alarms", schemaVersion);
+        for (size_t i = 0; alarms != NULL && currentAlarms != NULL && i < alarms->numChildren && i < currentAlarms->numChildren; i++) {
+            char description[64];
+            snprintf(description, sizeof(description), "alarm %zu of version %d", i, schemaVersion);
+            SLReferenceCheckMigratedAlarm(&alarms->children[i], &currentAlarms->children[i], schemaVersion, description);
+        }
+        SLTestPlistFree(prefs);
+    }
+    SLTestPlistFree(currentPrefs);
+}
+
+int main(void)
+{
+    SLTestMigrations();
+    return SLTestFinish("SLPrefsMigrationTests");
+}
@@ -0,0 +1,126 @@
+//
+//  SLPrefsReaderBenchmark.c
+//  Compares finding a single alarm with the streaming preferences reader against parsing the whole preferences file.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "SLTest.h"
+#include "SLTestPlist.h"
+#include "SLPrefsReader.h"
+
+// the template of the path of the preferences file that is measured, which is written to a temporary file
+#define kSLBenchmarkPrefsPathTemplate   "/tmp/SLPrefsReaderBenchmark.XXXXXX"
+
+// the number of alarms in the preferences that are measured, which matches a heavy user of the tweak
+#define kSLBenchmarkNumAlarms       2000
+
+// the number of times each lookup is repeated
+#define kSLBenchmarkNumLookups      50
+
+// Writes XML preferences with the given number of alarms to a new temporary file, each of which has skip dates and holidays.  The path of
+// the file is written to the given path template, and 0 is returned if the file could not be written.
+static int SLBenchmarkWritePrefs(char *pathTemplate, int numAlarms)
+{
+    int fileDescriptor = mkstemp(pathTemplate);
+    FILE *file = fileDescriptor >= 0 ? fdopen(fileDescriptor, "w") : NULL;
+    if (file == NULL) {
+        if (fileDescriptor >= 0) {
+            close(fileDescriptor);
+        }
+        return 0;
+    }
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<plist version=\"1.0\">\n<dict>\n\t<key>schemaVersion</key>\n\t<integer>3</integer>\n"
+          "\t<key>Alarms</key>\n\t<array>\n", file);
+    for (int i = 0; i < numAlarms; i++) {
+        fprintf(file, "\t\t<dict>\n\t\t\t<key>alarmId</key>\n\t\t\t<string>%08X-0000-4000-8000-%012d</string>\n"
+                "\t\t\t<key>snoozeTimeMinute</key>\n\t\t\t<integer>%d</integer>\n\t\t\t<key>skipEnabled</key>\n\t\t\t<true/>\n"
+                "\t\t\t<key>skipDates</key>\n\t\t\t<dict>\n\t\t\t\t<key>customSkipDateStrings</key>\n\t\t\t\t<array>\n", i, i, i % 60);
+        for (int month = 1; month <= 10; month++) {
+            fprintf(file, "\t\t\t\t\t<string>2027-%02d-%02d</string>\n", month, i % 28 + 1);
+        }
+        fputs("\t\t\t\t</array>\n\t\t\t\t<key>holidaySkipDates</key>\n\t\t\t\t<dict>\n\t\t\t\t\t<key>us_holidays</key>\n"
+              "\t\t\t\t\t<integer>4609</integer>\n\t\t\t\t</dict>\n\t\t\t</dict>\n\t\t</dict>\n", file);
+    }
+    fputs("\t</array>\n</dict>\n</plist>\n", file);
+    return fclose(file) == 0;
+}
+
+// returns whether or not parsing the whole file finds the alarm with the given Id with the expected snooze time (or does not find it)
+static int SLBenchmarkParseLookup(const char *path, const char *alarmId, int shouldFind)
+{
+    SLTestPlistNode *prefs = SLTestPlistRead(path);
+    const SLTestPlistNode *alarms = SLTestPlistObjectForKey(prefs, kSLPrefsReaderAlarmsKey);
+    int isFound = 0;
+    int isCorrect = alarms != NULL && !shouldFind;
+    for (size_t i = 0; alarms != NULL && i < alarms->numChildren && !isFound; i++) {
+        const SLTestPlistNode *alarmIdNode = SLTestPlistObjectForKey(&alarms->children[i], kSLPrefsReaderAlarmIdKey);
+        if (alarmIdNode != NULL && strcmp(alarmIdNode->text, alarmId) == 0) {
+            const SLTestPlistNode *snoozeMinute = SLTestPlistObjectForKey(&alarms->children[i], kSLPrefsReaderSnoozeMinuteKey);
+            isFound = 1;
+            isCorrect = shouldFind && snoozeMinute != NULL && snoozeMinute->integer == (kSLBenchmarkNumAlarms - 1) % 60;
+        }
+    }
+    SLTestPlistFree(prefs);
+    return isCorrect;
+}
+
+// returns whether or not the streaming reader finds the alarm with the given Id with the expected snooze time (or does not find it)
+static int SLBenchmarkReaderLookup(const char *path, const char *alarmId, int shouldFind)
+{
+    FILE *file = fopen(path, "rb");
+    SLPrefsAlarmRecord record;
+    SLPrefsReaderStatus status = file != NULL ? SLPrefsReaderFindAlarm(file, alarmId, &record) : kSLPrefsReaderStatusReadError;
+    if (file != NULL) {
+        fclose(file);
+    }
+    return shouldFind ? status == kSLPrefsReaderStatusFound && record.snoozeTimeMinute == (kSLBenchmarkNumAlarms - 1) % 60 :
+                        status == kSLPrefsReaderStatusNotFound;
+}
+
+// returns the number of milliseconds that the given lookup takes, averaged over the number of lookups
+static double SLBenchmarkMeasure(int (*lookup)(const char *, const char *, int), const char *path, const char *alarmId, int shouldFind,
+                                 const char *description)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < kSLBenchmarkNumLookups; i++) {
+        if (!lookup(path, alarmId, shouldFind)) {
+            SLTestCheck(0, "%s returned the wrong result for %s", description, alarmId);
+            break;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0) / kSLBenchmarkNumLookups;
+}
+
+// Measures finding the last alarm and a missing alarm in the XML preferences with both a full parse of the file and the reader.  The full
+// parse stands in for loading the preferences with Foundation, which reads every alarm into objects before any of them can be found.
+int main(void)
+{
+    char path[] = kSLBenchmarkPrefsPathTemplate;
+    if (!SLBenchmarkWritePrefs(path, kSLBenchmarkNumAlarms)) {
+        SLTestCheck(0, "%s could not be written", path);
+        return SLTestFinish("SLPrefsReaderBenchmark");
+    }
+    char lastAlarmId[64];
+    snprintf(lastAlarmId, sizeof(lastAlarmId), "%08X-0000-4000-8000-%012d", kSLBenchmarkNumAlarms - 1, kSLBenchmarkNumAlarms - 1);
+    const char *const alarmIds[] = {lastAlarmId, "missing"};
+    for (size_t i = 0; i < sizeof(alarmIds) / sizeof(alarmIds[0]); i++) {
+        int shouldFind = alarmIds[i] == lastAlarmId;
+        double parseMilliseconds = SLBenchmarkMeasure(SLBenchmarkParseLookup, path, alarmIds[i], shouldFind, "parsing the file");
+        double readerMilliseconds = SLBenchmarkMeasure(SLBenchmarkReaderLookup, path, alarmIds[i], shouldFind,
+                                                       "SLPrefsReaderFindAlarm");
+        printf("SLPrefsReaderBenchmark: XML %s: full parse %.3f ms, reader %.3f ms\n", shouldFind ? "last alarm" : "missing alarm",
+               parseMilliseconds, readerMilliseconds);
+    }
+    remove(path);
+    return SLTestFinish("SLPrefsReaderBenchmark");
+}
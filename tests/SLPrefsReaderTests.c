@@ -0,0 +1,215 @@
+//
+//  SLPrefsReaderTests.c
+//  Checks the streaming preferences reader against the corpus of XML and binary preferences files and measures a large file.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <time.h>
+#include "SLTest.h"
+#include "SLPrefsReader.h"
+
+// the directory of the corpus, where each preferences file has a text file with the same name that lists the expected results
+// (written by gen_prefs_reader_corpus.py)
+#define kSLTestPrefsReaderCorpusPath    kSLTestFixturesPath "/prefs_reader"
+
+// the number of alarms that are written to the large preferences file, which matches a heavy user of the tweak
+#define kSLTestNumLargeFileAlarms       2000
+
+// the number of times each lookup in the large preferences file is repeated when measuring it
+#define kSLTestNumLargeFileLookups      20
+
+// the names of the fields of the record, in the order that they are listed in the expectations
+static const char *const kSLTestRecordFieldNames[] = {"snoozeTimeHour", "snoozeTimeMinute", "snoozeTimeSecond", "skipEnabled",
+                                                      "skipTimeHour", "skipTimeMinute", "skipTimeSecond", "skipActivatedStatus",
+                                                      "autoSetOption", "autoSetOffsetOption", "autoSetOffsetHour", "autoSetOffsetMinute",
+                                                      "hasSkipDates", "hasSkipProfileId"};
+
+// returns the values of the given record in the order of kSLTestRecordFieldNames
+static void SLTestRecordValues(const SLPrefsAlarmRecord *record, int64_t *values)
+{
+    int64_t recordValues[] = {record->snoozeTimeHour, record->snoozeTimeMinute, record->snoozeTimeSecond, record->skipEnabled,
+                              record->skipTimeHour, record->skipTimeMinute, record->skipTimeSecond, record->skipActivatedStatus,
+                              record->autoSetOption, record->autoSetOffsetOption, record->autoSetOffsetHour, record->autoSetOffsetMinute,
+                              record->hasSkipDates, record->hasSkipProfileId};
+    memcpy(values, recordValues, sizeof(recordValues));
+}
+
+// returns the name of the given status as it is written in the expectations
+static const char *SLTestStatusName(SLPrefsReaderStatus status)
+{
+    switch (status) {
+        case kSLPrefsReaderStatusFound:
+            return "found";
+        case kSLPrefsReaderStatusNotFound:
+            return "notFound";
+        case kSLPrefsReaderStatusInvalidFile:
+            return "invalid";
+        case kSLPrefsReaderStatusReadError:
+            return "readError";
+    }
+    return "unknown";
+}
+
+// Checks a single expectation line (the status, alarm Id, and the expected fields of the record, separated by tabs) against the given
+// preferences file.  The file is reopened for each alarm since the reader is always given a file that was just opened.
+static void SLTestExpectation(const char *path, char *line)
+{
+    // the alarm Id can be empty, so the fields are split without collapsing adjacent tabs
+    char *fields[2 + sizeof(kSLTestRecordFieldNames) / sizeof(kSLTestRecordFieldNames[0])];
+    size_t numFields = 0;
+    for (char *field = line; field != NULL && numFields < sizeof(fields) / sizeof(fields[0]); numFields++) {
+        fields[numFields] = field;
+        field = strchr(field, '\t');
+        if (field != NULL) {
+            *field++ = '\0';
+        }
+    }
+    if (numFields < 2) {
+        SLTestCheck(0, "%s has an invalid expectation", path);
+        return;
+    }
+
+    FILE *file = fopen(path, "rb");
+    SLTestCheck(file != NULL, "%s could not be opened", path);
+    if (file == NULL) {
+        return;
+    }
+    SLPrefsAlarmRecord record;
+    SLPrefsReaderStatus status = SLPrefsReaderFindAlarm(file, fields[1], &record);
+    fclose(file);
+    SLTestCheck(strcmp(SLTestStatusName(status), fields[0]) == 0, "%s: finding \"%.40s\" returned %s instead of %s", path, fields[1],
+                SLTestStatusName(status), fields[0]);
+
+    // every listed field must match the record
+    int64_t values[sizeof(kSLTestRecordFieldNames) / sizeof(kSLTestRecordFieldNames[0])];
+    SLTestRecordValues(&record, values);
+    for (size_t i = 2; status == kSLPrefsReaderStatusFound && i < numFields; i++) {
+        char *separator = strchr(fields[i], '=');
+        size_t fieldIndex = 0;
+        while (separator != NULL && fieldIndex < sizeof(values) / sizeof(values[0]) &&
+               (strncmp(kSLTestRecordFieldNames[fieldIndex], fields[i], (size_t)(separator - fields[i])) != 0 ||
+                kSLTestRecordFieldNames[fieldIndex][separator - fields[i]] != '\0')) {
+            fieldIndex++;
+        }
+        if (separator == NULL || fieldIndex == sizeof(values) / sizeof(values[0])) {
+            SLTestCheck(0, "%s has an invalid field \"%s\"", path, fields[i]);
+            continue;
+        }
+        long long expectedValue = strtoll(separator + 1, NULL, 10);
+        SLTestCheck(values[fieldIndex] == expectedValue, "%s: %s of \"%s\" is %lld instead of %lld", path, kSLTestRecordFieldNames[fieldIndex],
+                    fields[1], (long long)values[fieldIndex], expectedValue);
+    }
+}
+
+// checks every expectation that is listed for the preferences file in the corpus with the given name
+static void SLTestCorpusFile(const char *fileName)
+{
+    char path[1024];
+    char expectationsPath[1024];
+    snprintf(path, sizeof(path), "%s/%s", kSLTestPrefsReaderCorpusPath, fileName);
+    snprintf(expectationsPath, sizeof(expectationsPath), "%s/%.*s.txt", kSLTestPrefsReaderCorpusPath, (int)(strlen(fileName) - strlen(".plist")),
+             fileName);
+    FILE *expectations = fopen(expectationsPath, "r");
+    SLTestCheck(expectations != NULL, "%s could not be read", expectationsPath);
+    if (expectations == NULL) {
+        return;
+    }
+
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    while (getline(&line, &lineCapacity, expectations) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] != '#' && line[0] != '\0') {
+            SLTestExpectation(path, line);
+        }
+    }
+    free(line);
+    fclose(expectations);
+}
+
+// returns the number of milliseconds that it takes to find the given alarm in the given file, averaged over a number of lookups
+static double SLTestMeasureLookup(FILE *file, const char *alarmId, SLPrefsReaderStatus expectedStatus)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < kSLTestNumLargeFileLookups; i++) {
+        SLPrefsAlarmRecord record;
+        rewind(file);
+        SLPrefsReaderStatus status = SLPrefsReaderFindAlarm(file, alarmId, &record);
+        if (status != expectedStatus) {
+            SLTestCheck(0, "finding %s in the large file returned %s", alarmId, SLTestStatusName(status));
+            break;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0) / kSLTestNumLargeFileLookups;
+}
+
+// Writes an XML preferences file with many alarms (each with skip dates, like a heavy user of the tweak) and checks that the first and last
+// alarms are found across the many refills of the read buffer.  The time that each lookup takes is printed for comparison between builds.
+static void SLTestLargeFile(void)
+{
+    FILE *file = tmpfile();
+    SLTestCheck(file != NULL, "the large preferences file could not be created");
+    if (file == NULL) {
+        return;
+    }
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<plist version=\"1.0\">\n<dict>\n\t<key>Alarms</key>\n\t<array>\n", file);
+    for (int i = 0; i < kSLTestNumLargeFileAlarms; i++) {
+        fprintf(file, "\t\t<dict>\n\t\t\t<key>alarmId</key>\n\t\t\t<string>%08X-0000-4000-8000-%012d</string>\n"
+                "\t\t\t<key>skipDates</key>\n\t\t\t<dict>\n\t\t\t\t<key>customSkipDateStrings</key>\n\t\t\t\t<array>\n", i, i);
+        for (int j = 0; j < 10; j++) {
+            fprintf(file, "\t\t\t\t\t<string>2027-%02d-%02d</string>\n", j + 1, i % 28 + 1);
+        }
+        fprintf(file, "\t\t\t\t</array>\n\t\t\t\t<key>holidaySkipDates</key>\n\t\t\t\t<dict>\n\t\t\t\t\t<key>us_holidays</key>\n"
+                "\t\t\t\t\t<integer>4609</integer>\n\t\t\t\t</dict>\n\t\t\t</dict>\n\t\t\t<key>snoozeTimeMinute</key>\n"
+                "\t\t\t<integer>%d</integer>\n\t\t\t<key>skipEnabled</key>\n\t\t\t<true/>\n\t\t</dict>\n", i % 60);
+    }
+    fputs("\t</array>\n</dict>\n</plist>\n", file);
+    long fileSize = ftell(file);
+
+    char firstAlarmId[64];
+    char lastAlarmId[64];
+    snprintf(firstAlarmId, sizeof(firstAlarmId), "%08X-0000-4000-8000-%012d", 0, 0);
+    snprintf(lastAlarmId, sizeof(lastAlarmId), "%08X-0000-4000-8000-%012d", kSLTestNumLargeFileAlarms - 1, kSLTestNumLargeFileAlarms - 1);
+    SLPrefsAlarmRecord record;
+    rewind(file);
+    SLTestCheck(SLPrefsReaderFindAlarm(file, lastAlarmId, &record) == kSLPrefsReaderStatusFound &&
+                record.snoozeTimeMinute == (kSLTestNumLargeFileAlarms - 1) % 60 && record.skipEnabled == 1 && record.hasSkipDates == 1,
+                "the last alarm in the large file was not read");
+
+    double firstMilliseconds = SLTestMeasureLookup(file, firstAlarmId, kSLPrefsReaderStatusFound);
+    double lastMilliseconds = SLTestMeasureLookup(file, lastAlarmId, kSLPrefsReaderStatusFound);
+    double missMilliseconds = SLTestMeasureLookup(file, "missing", kSLPrefsReaderStatusNotFound);
+    printf("SLPrefsReaderTests: %d alarms (%ld KB): first %.3f ms, last %.3f ms, missing %.3f ms\n", kSLTestNumLargeFileAlarms,
+           fileSize / 1024, firstMilliseconds, lastMilliseconds, missMilliseconds);
+    fclose(file);
+}
+
+int main(void)
+{
+    size_t numFiles = 0;
+    DIR *corpus = opendir(kSLTestPrefsReaderCorpusPath);
+    SLTestCheck(corpus != NULL, "%s could not be opened", kSLTestPrefsReaderCorpusPath);
+    for (struct dirent *entry = corpus != NULL ? readdir(corpus) : NULL; entry != NULL; entry = readdir(corpus)) {
+        size_t length = strlen(entry->d_name);
+        if (length > strlen(".plist") && strcmp(entry->d_name + length - strlen(".plist"), ".plist") == 0) {
+            SLTestCorpusFile(entry->d_name);
+            numFiles++;
+        }
+    }
+    if (corpus != NULL) {
+        closedir(corpus);
+    }
+    SLTestCheck(numFiles > 0, "no preferences files were found in the corpus");
+
+    SLTestLargeFile();
+    return SLTestFinish("SLPrefsReaderTests");
+}
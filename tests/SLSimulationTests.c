@@ -0,0 +1,464 @@
+//
+//  SLSimulationTests.c
+//  Replays more than a year of alarm fires, snoozes, unlock prompts, and auto-set recomputations against a synthetic preferences file
+//  with a simulated clock, checking the skip decisions and reporting the work that each simulated day performs.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "SLTest.h"
+#include "SLTestPlist.h"
+#include "SLTestHolidays.h"
+#include "SLTestSkipDates.h"
+#include "SLPrefsReader.h"
+
+// The time zone of the simulated clock, which has daylight saving time and is far enough from the time zone that the tests are run with
+// that a day that is computed in the wrong time zone lands on a different day.
+#define kSLSimulationTimeZoneName       "Australia/Sydney"
+
+// the offset from UTC of the simulated time zone at the start of the simulation, which confirms that the time zone was loaded
+#define kSLSimulationStartUTCOffset     (11 * 60 * 60)
+
+// the first day of the simulation along with the number of days that are simulated (which crosses a year rollover)
+#define kSLSimulationStartYear          2027
+#define kSLSimulationStartMonth         1
+#define kSLSimulationStartDay           1
+#define kSLSimulationNumDays            400
+
+// the number of alarms in the synthetic preferences, where every third alarm uses the shared skip profile
+#define kSLSimulationNumAlarms          30
+
+// the number of days between each change to the preferences while the simulation is running
+#define kSLSimulationChangeInterval     30
+
+// the holiday resource and the holidays that the alarms without a skip profile select (New Year's Day, Thanksgiving Day, and Christmas Day)
+#define kSLSimulationHolidayResourceName    "us_holidays"
+#define kSLSimulationHolidaySelection       4609ULL
+
+// the weekday of the skip rule of the shared skip profile (the weekdays of a rule start on Monday, so this is Saturday)
+#define kSLSimulationRuleWeekday        5
+
+// the weekday of the skip rule as it is counted by the C library (which starts on Sunday)
+#define kSLSimulationRuleTmWeekday      6
+
+// the Id and name of the shared skip profile, along with the keys of the skip profiles in the preferences
+#define kSLSimulationSkipProfileId      "SIMULATED-PROFILE"
+#define kSLSimulationSkipProfileName    "Simulated"
+#define kSLSimulationSkipProfilesKey    "skipProfiles"
+#define kSLSimulationSkipProfileNameKey "name"
+
+// the auto-set option that is stored for the alarms that are automatically set to the sunrise
+#define kSLSimulationAutoSetSunrise     1
+
+// the template of the path of the preferences file that is simulated, which is written to a temporary file
+#define kSLSimulationPrefsPathTemplate  "/tmp/SLSimulationTests.XXXXXX"
+
+// the suffix that is added to the path of the test to get the path of the per-day report
+#define kSLSimulationReportSuffix       ".tsv"
+
+// the days of the simulation, which are computed with the C library in the simulated time zone (independently of the day numbers)
+typedef struct SLSimulationDay {
+    char dateString[11];
+    int tmWeekday;
+    time_t midnight;
+    time_t morning;
+} SLSimulationDay;
+
+// The preferences as the tweak sees them, which are only parsed again when the file changes.  The skip dates of every alarm are compiled
+// when the preferences are parsed (an alarm with a skip profile is compiled from the skip dates of the profile).
+typedef struct SLSimulationPrefs {
+    const char *path;
+    struct stat fileStatus;
+    int isLoaded;
+    SLTestSkipDates skipDates[kSLSimulationNumAlarms];
+    int hasSkipDates[kSLSimulationNumAlarms];
+    unsigned long numParses;
+    unsigned long numLookups;
+} SLSimulationPrefs;
+
+// compares two day numbers for searching
+static int SLSimulationCompareDays(const void *lhs, const void *rhs)
+{
+    SLDay lhsDay = *(const SLDay *)lhs;
+    SLDay rhsDay = *(const SLDay *)rhs;
+    return (lhsDay > rhsDay) - (lhsDay < rhsDay);
+}
+
+// writes the alarm Id for the alarm at the given index to the given buffer
+static void SLSimulationAlarmId(int alarmIndex, char *alarmId, size_t size)
+{
+    snprintf(alarmId, size, "SIMULATED-ALARM-%02d", alarmIndex);
+}
+
+// returns whether or not the alarm at the given index uses the shared skip profile
+static int SLSimulationUsesSkipProfile(int alarmIndex)
+{
+    return alarmIndex % 3 == 0;
+}
+
+// Computes the days of the simulation with mktime, which normalizes the day of the month past the end of each month and finds the local
+// time of each alarm across the daylight saving time transitions.  Returns 0 if the simulated time zone could not be loaded.
+static int SLSimulationComputeDays(SLSimulationDay *days)
+{
+    setenv("TZ", kSLSimulationTimeZoneName, 1);
+    tzset();
+    for (int i = 0; i < kSLSimulationNumDays; i++) {
+        struct tm local = {0};
+        local.tm_year = kSLSimulationStartYear - 1900;
+        local.tm_mon = kSLSimulationStartMonth - 1;
+        local.tm_mday = kSLSimulationStartDay + i;
+        local.tm_isdst = -1;
+        days[i].midnight = mktime(&local);
+        if (i == 0 && local.tm_gmtoff != kSLSimulationStartUTCOffset) {
+            return 0;
+        }
+        strftime(days[i].dateString, sizeof(days[i].dateString), "%Y-%m-%d", &local);
+        days[i].tmWeekday = local.tm_wday;
+
+        local.tm_hour = 7;
+        local.tm_isdst = -1;
+        days[i].morning = mktime(&local);
+    }
+    return 1;
+}
+
+// writes the given custom skip days (indexes into the days of the simulation) as an array of custom skip date strings
+static void SLSimulationWriteCustomSkipDates(FILE *file, const SLSimulationDay *days, const unsigned char *customSkipDays, const char *indent)
+{
+    fprintf(file, "%s<key>" kSLTestCustomSkipDateStringsKey "</key>\n%s<array>\n", indent, indent);
+    for (int i = 0; i < kSLSimulationNumDays; i++) {
+        if (customSkipDays[i]) {
+            fprintf(file, "%s\t<string>%s</string>\n", indent, days[i].dateString);
+        }
+    }
+    fprintf(file, "%s</array>\n", indent);
+}
+
+// Writes the synthetic preferences to a temporary file that replaces the preferences file, like the preferences manager does.  Each alarm
+// without a skip profile skips its own custom skip dates and the selected holidays, while the shared skip profile has its own custom skip
+// dates and skips every Saturday.  Returns 0 if the file could not be written.
+static int SLSimulationWritePrefs(const char *path, const SLSimulationDay *days, unsigned char customSkipDays[][kSLSimulationNumDays],
+                                  const unsigned char *profileSkipDays)
+{
+    char temporaryPath[1024];
+    snprintf(temporaryPath, sizeof(temporaryPath), "%s.XXXXXX", path);
+    int fileDescriptor = mkstemp(temporaryPath);
+    FILE *file = fileDescriptor >= 0 ? fdopen(fileDescriptor, "w") : NULL;
+    if (file == NULL) {
+        if (fileDescriptor >= 0) {
+            close(fileDescriptor);
+        }
+        return 0;
+    }
+
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<plist version=\"1.0\">\n<dict>\n\t<key>schemaVersion</key>\n\t<integer>3</integer>\n"
+          "\t<key>" kSLPrefsReaderAlarmsKey "</key>\n\t<array>\n", file);
+    for (int alarmIndex = 0; alarmIndex < kSLSimulationNumAlarms; alarmIndex++) {
+        char alarmId[64];
+        SLSimulationAlarmId(alarmIndex, alarmId, sizeof(alarmId));
+        fprintf(file, "\t\t<dict>\n\t\t\t<key>" kSLPrefsReaderAlarmIdKey "</key>\n\t\t\t<string>%s</string>\n"
+                "\t\t\t<key>" kSLPrefsReaderSnoozeMinuteKey "</key>\n\t\t\t<integer>%d</integer>\n"
+                "\t\t\t<key>" kSLPrefsReaderSkipEnabledKey "</key>\n\t\t\t<true/>\n"
+                "\t\t\t<key>" kSLPrefsReaderAutoSetOptionKey "</key>\n\t\t\t<integer>%d</integer>\n", alarmId, alarmIndex % 60,
+                alarmIndex % 10 == 1 ? kSLSimulationAutoSetSunrise : 0);
+        if (SLSimulationUsesSkipProfile(alarmIndex)) {
+            fputs("\t\t\t<key>" kSLPrefsReaderSkipProfileIdKey "</key>\n\t\t\t<string>" kSLSimulationSkipProfileId "</string>\n", file);
+        } else {
+            fputs("\t\t\t<key>" kSLPrefsReaderSkipDatesKey "</key>\n\t\t\t<dict>\n", file);
+            SLSimulationWriteCustomSkipDates(file, days, customSkipDays[alarmIndex], "\t\t\t\t");
+            fprintf(file, "\t\t\t\t<key>" kSLTestHolidaySkipDatesKey "</key>\n\t\t\t\t<dict>\n\t\t\t\t\t<key>" kSLSimulationHolidayResourceName
+                    "</key>\n\t\t\t\t\t<integer>%llu</integer>\n\t\t\t\t</dict>\n\t\t\t\t<key>" kSLTestSkipRulesKey "</key>\n\t\t\t\t<array/>\n"
+                    "\t\t\t</dict>\n", kSLSimulationHolidaySelection);
+        }
+        fputs("\t\t</dict>\n", file);
+    }
+
+    fputs("\t</array>\n\t<key>" kSLSimulationSkipProfilesKey "</key>\n\t<array>\n\t\t<dict>\n\t\t\t<key>" kSLPrefsReaderSkipProfileIdKey
+          "</key>\n\t\t\t<string>" kSLSimulationSkipProfileId "</string>\n\t\t\t<key>" kSLSimulationSkipProfileNameKey "</key>\n\t\t\t<string>"
+          kSLSimulationSkipProfileName "</string>\n\t\t\t<key>" kSLPrefsReaderSkipDatesKey "</key>\n\t\t\t<dict>\n", file);
+    SLSimulationWriteCustomSkipDates(file, days, profileSkipDays, "\t\t\t\t");
+    fprintf(file, "\t\t\t\t<key>" kSLTestHolidaySkipDatesKey "</key>\n\t\t\t\t<dict/>\n\t\t\t\t<key>" kSLTestSkipRulesKey "</key>\n"
+            "\t\t\t\t<array>\n\t\t\t\t\t<dict>\n\t\t\t\t\t\t<key>" kSLTestSkipRuleTypeKey "</key>\n\t\t\t\t\t\t<string>"
+            kSLTestSkipRuleTypeWeeklyString "</string>\n\t\t\t\t\t\t<key>" kSLTestSkipRuleStartDateKey "</key>\n"
+            "\t\t\t\t\t\t<string>%s</string>\n\t\t\t\t\t\t<key>" kSLTestSkipRuleIntervalKey "</key>\n\t\t\t\t\t\t<integer>1</integer>\n"
+            "\t\t\t\t\t\t<key>" kSLTestSkipRuleWeekdaysKey "</key>\n\t\t\t\t\t\t<integer>%d</integer>\n\t\t\t\t\t</dict>\n\t\t\t\t</array>\n"
+            "\t\t\t</dict>\n\t\t</dict>\n\t</array>\n</dict>\n</plist>\n", days[0].dateString, 1 << kSLSimulationRuleWeekday);
+    if (fclose(file) != 0 || rename(temporaryPath, path) != 0) {
+        remove(temporaryPath);
+        return 0;
+    }
+    return 1;
+}
+
+// returns the skip profile with the given Id from the given preferences, or NULL if the preferences do not contain the profile
+static const SLTestPlistNode *SLSimulationSkipProfile(const SLTestPlistNode *root, const char *skipProfileId)
+{
+    const SLTestPlistNode *skipProfiles = SLTestPlistObjectForKey(root, kSLSimulationSkipProfilesKey);
+    for (size_t i = 0; skipProfiles != NULL && i < skipProfiles->numChildren; i++) {
+        const SLTestPlistNode *profileId = SLTestPlistObjectForKey(&skipProfiles->children[i], kSLPrefsReaderSkipProfileIdKey);
+        if (profileId != NULL && strcmp(profileId->text, skipProfileId) == 0) {
+            return &skipProfiles->children[i];
+        }
+    }
+    return NULL;
+}
+
+// Parses the preferences file and compiles the skip dates of every alarm if the file has changed since the preferences were last parsed,
+// which stands in for the cache of the preferences manager.  Returns 0 if the preferences could not be read.
+static int SLSimulationLoadPrefsIfNeeded(SLSimulationPrefs *prefs)
+{
+    struct stat fileStatus;
+    if (stat(prefs->path, &fileStatus) != 0) {
+        return 0;
+    }
+    if (prefs->isLoaded && fileStatus.st_ino == prefs->fileStatus.st_ino && fileStatus.st_size == prefs->fileStatus.st_size &&
+        fileStatus.st_mtim.tv_sec == prefs->fileStatus.st_mtim.tv_sec && fileStatus.st_mtim.tv_nsec == prefs->fileStatus.st_mtim.tv_nsec) {
+        return 1;
+    }
+
+    SLTestPlistNode *root = SLTestPlistRead(prefs->path);
+    const SLTestPlistNode *alarms = SLTestPlistObjectForKey(root, kSLPrefsReaderAlarmsKey);
+    prefs->numParses++;
+    prefs->isLoaded = alarms != NULL;
+    memset(prefs->hasSkipDates, 0, sizeof(prefs->hasSkipDates));
+    for (size_t i = 0; alarms != NULL && i < alarms->numChildren; i++) {
+        const SLTestPlistNode *alarm = &alarms->children[i];
+        const SLTestPlistNode *alarmId = SLTestPlistObjectForKey(alarm, kSLPrefsReaderAlarmIdKey);
+        int alarmIndex = -1;
+        if (alarmId == NULL || sscanf(alarmId->text, "SIMULATED-ALARM-%d", &alarmIndex) != 1 || alarmIndex < 0 ||
+            alarmIndex >= kSLSimulationNumAlarms) {
+            continue;
+        }
+
+        // an alarm with a skip profile uses the skip dates of the profile rather than its own
+        const SLTestPlistNode *skipProfileId = SLTestPlistObjectForKey(alarm, kSLPrefsReaderSkipProfileIdKey);
+        const SLTestPlistNode *skipDates = SLTestPlistObjectForKey(alarm, kSLPrefsReaderSkipDatesKey);
+        if (skipProfileId != NULL) {
+            skipDates = SLTestPlistObjectForKey(SLSimulationSkipProfile(root, skipProfileId->text), kSLPrefsReaderSkipDatesKey);
+        }
+        prefs->hasSkipDates[alarmIndex] = skipDates != NULL && SLTestSkipDatesFromPlist(skipDates, &prefs->skipDates[alarmIndex]);
+    }
+    SLTestPlistFree(root);
+    prefs->fileStatus = fileStatus;
+    return prefs->isLoaded;
+}
+
+// reads the scalar preferences for the alarm at the given index with the streaming reader, returning 0 if the alarm was not found
+static int SLSimulationReadAlarm(SLSimulationPrefs *prefs, int alarmIndex, SLPrefsAlarmRecord *record)
+{
+    char alarmId[64];
+    SLSimulationAlarmId(alarmIndex, alarmId, sizeof(alarmId));
+    FILE *file = fopen(prefs->path, "rb");
+    SLPrefsReaderStatus status = file != NULL ? SLPrefsReaderFindAlarm(file, alarmId, record) : kSLPrefsReaderStatusReadError;
+    if (file != NULL) {
+        fclose(file);
+    }
+    prefs->numLookups++;
+    return status == kSLPrefsReaderStatusFound;
+}
+
+// returns the day of the given time in the simulated time zone, which is how the tweak finds the day of a date
+static SLDay SLSimulationDayForTime(time_t time)
+{
+    struct tm local;
+    localtime_r(&time, &local);
+    return SLDayFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+// returns the reason that the alarm at the given index is skipped at the given time, loading the preferences like the tweak does
+static SLTestSkipReason SLSimulationSkipReason(SLSimulationPrefs *prefs, SLTestHolidayCalendar *calendar, int alarmIndex, time_t time,
+                                               int *isFound)
+{
+    SLPrefsAlarmRecord record;
+    *isFound = SLSimulationReadAlarm(prefs, alarmIndex, &record) && SLSimulationLoadPrefsIfNeeded(prefs) && prefs->hasSkipDates[alarmIndex];
+    if (!*isFound || !record.skipEnabled) {
+        return kSLTestSkipReasonNone;
+    }
+    return SLTestSkipDatesReasonOnDay(&prefs->skipDates[alarmIndex], calendar, SLSimulationDayForTime(time));
+}
+
+// Fires every alarm on the given day of the simulation at the given time, checking the skip decision against the expected decision.
+// Alarms that are not skipped are snoozed, which reads the preferences of the alarm again for the snooze time.  Returns the number of
+// alarms that were skipped.
+static int SLSimulationFireAlarms(SLSimulationPrefs *prefs, SLTestHolidayCalendar *calendar, const SLSimulationDay *day, int dayIndex,
+                                  time_t fireTime, unsigned char customSkipDays[][kSLSimulationNumDays], const unsigned char *profileSkipDays,
+                                  const unsigned char *holidayDays)
+{
+    int numSkipped = 0;
+    for (int alarmIndex = 0; alarmIndex < kSLSimulationNumAlarms; alarmIndex++) {
+        int expectedSkip;
+        if (SLSimulationUsesSkipProfile(alarmIndex)) {
+            expectedSkip = profileSkipDays[dayIndex] || day->tmWeekday == kSLSimulationRuleTmWeekday;
+        } else {
+            expectedSkip = customSkipDays[alarmIndex][dayIndex] || holidayDays[dayIndex];
+        }
+
+        int isFound;
+        int shouldSkip = SLSimulationSkipReason(prefs, calendar, alarmIndex, fireTime, &isFound) != kSLTestSkipReasonNone;
+        SLTestCheck(isFound && shouldSkip == expectedSkip, "SIMULATED-ALARM-%02d fired at %s (%ld) was %s instead of %s", alarmIndex,
+                    day->dateString, (long)fireTime, shouldSkip ? "skipped" : "not skipped", expectedSkip ? "skipped" : "not skipped");
+        if (shouldSkip) {
+            numSkipped++;
+        } else {
+            SLPrefsAlarmRecord record;
+            SLTestCheck(SLSimulationReadAlarm(prefs, alarmIndex, &record) && record.snoozeTimeMinute == alarmIndex % 60,
+                        "SIMULATED-ALARM-%02d was snoozed for the wrong time on %s", alarmIndex, day->dateString);
+        }
+    }
+    return numSkipped;
+}
+
+// Prompts to skip the alarms that fire at the given time when the device is unlocked at the given time, checking that each alarm that will
+// be skipped has an explanation that lists the reason that it will be skipped.
+static void SLSimulationUnlockPrompt(SLSimulationPrefs *prefs, SLTestHolidayCalendar *calendar, const SLSimulationDay *day, time_t unlockTime,
+                                     time_t fireTime)
+{
+    SLDay today = SLSimulationDayForTime(unlockTime);
+    SLDay fireDay = SLSimulationDayForTime(fireTime);
+    for (int alarmIndex = 0; alarmIndex < kSLSimulationNumAlarms; alarmIndex++) {
+        int isFound;
+        SLTestSkipReason skipReason = SLSimulationSkipReason(prefs, calendar, alarmIndex, fireTime, &isFound);
+        if (skipReason == kSLTestSkipReasonNone) {
+            continue;
+        }
+
+        // the holiday and skip rule that cause the skip are upcoming, so they are listed unless another one comes before the alarm fires
+        SLTestSkipExplanation explanation;
+        SLTestSkipDatesExplanation(&prefs->skipDates[alarmIndex], calendar, today, fireDay, &explanation);
+        int hasReason = (skipReason == kSLTestSkipReasonCustomDate && explanation.hasCustomSkipDay) ||
+                        (skipReason == kSLTestSkipReasonHoliday && explanation.hasHoliday && explanation.holidayDay >= today &&
+                         explanation.holidayDay <= fireDay && explanation.holidayName[0] != '\0') ||
+                        (skipReason == kSLTestSkipReasonSkipRule && explanation.hasSkipRule && explanation.skipRuleDay >= today &&
+                         explanation.skipRuleDay <= fireDay);
+        SLTestCheck(hasReason, "SIMULATED-ALARM-%02d has no skip explanation for %s", alarmIndex, day->dateString);
+    }
+}
+
+// Replays every simulated day: the unlock prompt the evening before, the auto-set recomputation, the alarms that fire right after
+// midnight and in the morning, and a change to the preferences once every kSLSimulationChangeInterval days.  A line is written to the
+// given report for every day with the work that was performed on that day.
+static void SLSimulation(const char *path, FILE *report)
+{
+    static SLSimulationDay days[kSLSimulationNumDays];
+    static unsigned char customSkipDays[kSLSimulationNumAlarms][kSLSimulationNumDays];
+    static unsigned char profileSkipDays[kSLSimulationNumDays];
+    static unsigned char holidayDays[kSLSimulationNumDays];
+    static SLSimulationPrefs prefs;
+    if (!SLSimulationComputeDays(days)) {
+        SLTestCheck(0, "the %s time zone could not be loaded", kSLSimulationTimeZoneName);
+        return;
+    }
+
+    // the expected holidays come from the dates that the resource was compiled from rather than from the compiled resource
+    SLTestHolidayFixture *fixture = SLTestHolidayFixtureRead(kSLSimulationHolidayResourceName);
+    SLTestCheck(fixture != NULL, "the fixture of %s could not be read", kSLSimulationHolidayResourceName);
+    for (size_t i = 0; fixture != NULL && i < fixture->numHolidays; i++) {
+        const SLTestFixtureHoliday *holiday = &fixture->holidays[i];
+        if (holiday->holidayId < 0 || holiday->holidayId >= kSLTestMaxHolidayIds || !(kSLSimulationHolidaySelection & (1ULL << holiday->holidayId))) {
+            continue;
+        }
+        for (int dayIndex = 0; dayIndex < kSLSimulationNumDays; dayIndex++) {
+            SLDay day;
+            if (SLSkipRuleParseDateString(days[dayIndex].dateString, &day) &&
+                bsearch(&day, holiday->days, holiday->numDays, sizeof(SLDay), SLSimulationCompareDays) != NULL) {
+                holidayDays[dayIndex] = 1;
+            }
+        }
+    }
+    SLTestHolidayFixtureFree(fixture);
+
+    for (int dayIndex = 5; dayIndex < kSLSimulationNumDays; dayIndex += 17) {
+        profileSkipDays[dayIndex] = 1;
+    }
+    int numAutoSetAlarms = 0;
+    for (int alarmIndex = 0; alarmIndex < kSLSimulationNumAlarms; alarmIndex++) {
+        for (int dayIndex = alarmIndex % 11; !SLSimulationUsesSkipProfile(alarmIndex) && dayIndex < kSLSimulationNumDays; dayIndex += 11) {
+            customSkipDays[alarmIndex][dayIndex] = 1;
+        }
+        numAutoSetAlarms += alarmIndex % 10 == 1;
+    }
+    if (!SLSimulationWritePrefs(path, days, customSkipDays, profileSkipDays)) {
+        SLTestCheck(0, "%s could not be written", path);
+        return;
+    }
+
+    prefs.path = path;
+    SLTestHolidayCalendar *calendar = SLTestHolidayCalendarCreate();
+    fputs("day\tprefsParses\treaderLookups\tskippedAlarms\tholidayYears\n", report);
+    unsigned long maxDailyParses = 0;
+    int numSkipped = 0;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int dayIndex = 0; dayIndex < kSLSimulationNumDays; dayIndex++) {
+        const SLSimulationDay *day = &days[dayIndex];
+        unsigned long numParses = prefs.numParses;
+        unsigned long numLookups = prefs.numLookups;
+
+        // the unlock prompt is shown the evening before, while the time of day changes across the daylight saving time transitions
+        SLSimulationUnlockPrompt(&prefs, calendar, day, day->morning - 10 * 60 * 60, day->morning);
+
+        int numFound = 0;
+        for (int alarmIndex = 0; alarmIndex < kSLSimulationNumAlarms; alarmIndex++) {
+            SLPrefsAlarmRecord record;
+            numFound += SLSimulationReadAlarm(&prefs, alarmIndex, &record) && record.autoSetOption == kSLSimulationAutoSetSunrise;
+        }
+        SLTestCheck(numFound == numAutoSetAlarms, "%d of the %d auto-set alarms were found on %s", numFound, numAutoSetAlarms, day->dateString);
+
+        int numDailySkipped = SLSimulationFireAlarms(&prefs, calendar, day, dayIndex, day->midnight + 30, customSkipDays, profileSkipDays, holidayDays);
+        numDailySkipped += SLSimulationFireAlarms(&prefs, calendar, day, dayIndex, day->morning, customSkipDays, profileSkipDays, holidayDays);
+        numSkipped += numDailySkipped;
+
+        // skip the next day for one of the alarms, which changes the preferences that the following days are loaded from
+        if (dayIndex % kSLSimulationChangeInterval == 0 && dayIndex + 1 < kSLSimulationNumDays) {
+            customSkipDays[1][dayIndex + 1] = 1;
+            SLTestCheck(SLSimulationWritePrefs(path, days, customSkipDays, profileSkipDays), "%s could not be written", path);
+        }
+
+        unsigned long dailyParses = prefs.numParses - numParses;
+        maxDailyParses = dailyParses > maxDailyParses ? dailyParses : maxDailyParses;
+        fprintf(report, "%s\t%lu\t%lu\t%d\t%zu\n", day->dateString, dailyParses, prefs.numLookups - numLookups, numDailySkipped,
+                SLTestHolidayCalendarNumEvaluatedYears(calendar));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    SLTestHolidayCalendarFree(calendar);
+
+    // the preferences are only parsed again after they change, which happens at most once a day
+    SLTestCheck(maxDailyParses <= 1, "the preferences were parsed %lu times in a single day", maxDailyParses);
+    SLTestCheck(numSkipped > 0, "none of the alarms were skipped");
+    printf("SLSimulationTests: simulated %d days of %d alarms in %.2f s with %lu parse(s), %lu reader lookup(s), and %d skipped fire(s)\n",
+           kSLSimulationNumDays, kSLSimulationNumAlarms, (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9, prefs.numParses,
+           prefs.numLookups, numSkipped);
+}
+
+// The simulation writes its preferences to a temporary file and its per-day report next to the test, so it runs from any build directory.
+// Only the portable parts of libSleeper are simulated: the preferences are read with the streaming reader and the skip decisions are made
+// with the compiled holiday resources and skip rules, while the expected decisions come from the fixtures and the C library calendar.
+int main(int argc, char *argv[])
+{
+    char path[] = kSLSimulationPrefsPathTemplate;
+    int fileDescriptor = mkstemp(path);
+    char reportPath[1024];
+    snprintf(reportPath, sizeof(reportPath), "%s" kSLSimulationReportSuffix, argc > 0 ? argv[0] : "SLSimulationTests");
+    FILE *report = fopen(reportPath, "w");
+    SLTestCheck(fileDescriptor >= 0 && report != NULL, "%s or %s could not be written", path, reportPath);
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+        if (report != NULL) {
+            SLSimulation(path, report);
+            printf("SLSimulationTests: the work for each day is in %s\n", reportPath);
+        }
+        remove(path);
+    }
+    if (report != NULL) {
+        fclose(report);
+    }
+    return SLTestFinish("SLSimulationTests");
+}
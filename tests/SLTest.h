@@ -0,0 +1,42 @@
+//
+//  SLTest.h
+//  Minimal checks that are shared by the host tests.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLTest_h
+#define SLTest_h
+
+#include <stdio.h>
+
+// the paths of the fixtures and of the Sleeper bundle, relative to the tests directory that the tests are run from
+#define kSLTestFixturesPath         "fixtures"
+#define kSLTestSleeperBundlePath    "../layout/Library/Application Support/Sleeper.bundle"
+
+// The number of checks that have been run by the test, along with the number of those that failed.  The support files of the tests only
+// include this header for the paths, so the counters are not used by them.
+static int sSLTestNumChecks __attribute__((unused)) = 0;
+static int sSLTestNumFailures __attribute__((unused)) = 0;
+
+// checks the given condition, printing the given message (a format string and its arguments) along with the location if it is false
+#define SLTestCheck(condition, ...)                                             \
+    do {                                                                        \
+        sSLTestNumChecks++;                                                     \
+        if (!(condition)) {                                                     \
+            sSLTestNumFailures++;                                               \
+            fprintf(stderr, "%s:%d: check failed: ", __FILE__, __LINE__);       \
+            fprintf(stderr, __VA_ARGS__);                                       \
+            fputc('\n', stderr);                                                \
+        }                                                                       \
+    } while (0)
+
+// prints the results of the test with the given name, returning the exit status of the test
+static inline int SLTestFinish(const char *testName)
+{
+    printf("%s: %d check(s), %d failure(s)\n", testName, sSLTestNumChecks, sSLTestNumFailures);
+    return sSLTestNumFailures > 0 ? 1 : 0;
+}
+
+#endif /* SLTest_h */
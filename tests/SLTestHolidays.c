@@ -0,0 +1,437 @@
+//
+//  SLTestHolidays.c
+//  Reads the holiday fixtures and evaluates the compiled holiday resources in the bundle for the host tests.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#define _GNU_SOURCE
+#include "SLTestHolidays.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include "SLSkipRules.h"
+
+// splits the given line into the given number of tab separated fields, where any fields that are missing are NULL
+static void SLTestSplitFields(char *line, char **fields, int numFields)
+{
+    fields[0] = line;
+    for (int i = 1; i < numFields; i++) {
+        char *tab = fields[i - 1] != NULL ? strchr(fields[i - 1], '\t') : NULL;
+        if (tab != NULL) {
+            *tab = '\0';
+            fields[i] = tab + 1;
+        } else {
+            fields[i] = NULL;
+        }
+    }
+}
+
+// compares two day numbers for sorting
+static int SLTestCompareDays(const void *lhs, const void *rhs)
+{
+    SLDay lhsDay = *(const SLDay *)lhs;
+    SLDay rhsDay = *(const SLDay *)rhs;
+    return (lhsDay > rhsDay) - (lhsDay < rhsDay);
+}
+
+// reads the fixture of the holiday resource with the given name
+SLTestHolidayFixture *SLTestHolidayFixtureRead(const char *resourceName)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s.txt", kSLTestHolidayFixturesPath, resourceName);
+    FILE *file = fopen(path, "r");
+    SLTestHolidayFixture *fixture = file != NULL ? calloc(1, sizeof(SLTestHolidayFixture)) : NULL;
+    if (fixture == NULL) {
+        if (file != NULL) {
+            fclose(file);
+        }
+        return NULL;
+    }
+
+    int isValid = 1;
+    int hasRange = 0;
+    size_t holidayCapacity = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    while (isValid && getline(&line, &lineCapacity, file) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0') {
+            continue;
+        }
+
+        // the range line comes first and lists the first and last days (inclusive) that the dates were compiled for
+        char *fields[3];
+        SLTestSplitFields(line, fields, 3);
+        if (strcmp(fields[0], "range") == 0) {
+            isValid = fields[2] != NULL && SLSkipRuleParseDateString(fields[1], &fixture->firstDay) &&
+                      SLSkipRuleParseDateString(fields[2], &fixture->lastDay) && fixture->firstDay <= fixture->lastDay;
+            hasRange = 1;
+            continue;
+        }
+
+        // every other line lists the ID, name, and dates of a holiday
+        if (fields[1] == NULL) {
+            isValid = 0;
+            break;
+        }
+        if (fixture->numHolidays == holidayCapacity) {
+            holidayCapacity = holidayCapacity > 0 ? holidayCapacity * 2 : 16;
+            SLTestFixtureHoliday *holidays = realloc(fixture->holidays, holidayCapacity * sizeof(SLTestFixtureHoliday));
+            if (holidays == NULL) {
+                isValid = 0;
+                break;
+            }
+            fixture->holidays = holidays;
+        }
+        SLTestFixtureHoliday *holiday = &fixture->holidays[fixture->numHolidays++];
+        memset(holiday, 0, sizeof(SLTestFixtureHoliday));
+        holiday->holidayId = strtoll(fields[0], NULL, 10);
+        holiday->name = strdup(fields[1]);
+        holiday->days = malloc(kSLTestMaxHolidayDays * sizeof(SLDay));
+        isValid = holiday->name != NULL && holiday->days != NULL;
+        for (char *dateString = strtok(fields[2] != NULL ? fields[2] : (char *)"", " "); isValid && dateString != NULL;
+             dateString = strtok(NULL, " ")) {
+            isValid = holiday->numDays < kSLTestMaxHolidayDays && SLSkipRuleParseDateString(dateString, &holiday->days[holiday->numDays++]);
+        }
+        if (isValid) {
+            qsort(holiday->days, holiday->numDays, sizeof(SLDay), SLTestCompareDays);
+        }
+    }
+    free(line);
+    fclose(file);
+
+    if (!isValid || !hasRange) {
+        SLTestHolidayFixtureFree(fixture);
+        return NULL;
+    }
+    return fixture;
+}
+
+// frees the given fixture that was returned by SLTestHolidayFixtureRead
+void SLTestHolidayFixtureFree(SLTestHolidayFixture *fixture)
+{
+    if (fixture == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < fixture->numHolidays; i++) {
+        free(fixture->holidays[i].name);
+        free(fixture->holidays[i].days);
+    }
+    free(fixture->holidays);
+    free(fixture);
+}
+
+// calls the given function with the name of every holiday resource that has a fixture
+size_t SLTestEnumerateHolidayFixtures(void (*function)(const char *resourceName, void *context), void *context)
+{
+    DIR *fixtures = opendir(kSLTestHolidayFixturesPath);
+    if (fixtures == NULL) {
+        return 0;
+    }
+    size_t numResources = 0;
+    size_t suffixLength = strlen(kSLTestHolidayFixtureSuffix);
+    for (struct dirent *entry = readdir(fixtures); entry != NULL; entry = readdir(fixtures)) {
+        size_t length = strlen(entry->d_name);
+        if (length > suffixLength && strcmp(entry->d_name + length - suffixLength, kSLTestHolidayFixtureSuffix) == 0) {
+            char resourceName[256];
+            snprintf(resourceName, sizeof(resourceName), "%.*s_holidays", (int)(length - suffixLength), entry->d_name);
+            function(resourceName, context);
+            numResources++;
+        }
+    }
+    closedir(fixtures);
+    return numResources;
+}
+
+// reads the holiday resource with the given name from the bundle
+SLTestPlistNode *SLTestHolidayResourceRead(const char *resourceName)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s.plist", kSLTestSleeperBundlePath, resourceName);
+    return SLTestPlistRead(path);
+}
+
+// returns whether or not the given holiday resource contains rules
+int SLTestHolidayResourceHasRules(const SLTestPlistNode *resource)
+{
+    const SLTestPlistNode *version = SLTestPlistObjectForKey(resource, "version");
+    return version != NULL && version->integer >= kSLTestHolidayRulesVersion;
+}
+
+// returns the holiday with the given ID in the given array of holidays from a resource
+const SLTestPlistNode *SLTestHolidayForId(const SLTestPlistNode *holidays, long long holidayId)
+{
+    for (size_t i = 0; holidays != NULL && i < holidays->numChildren; i++) {
+        const SLTestPlistNode *holidayIdNode = SLTestPlistObjectForKey(&holidays->children[i], "id");
+        if (holidayIdNode != NULL && holidayIdNode->integer == holidayId) {
+            return &holidays->children[i];
+        }
+    }
+    return NULL;
+}
+
+// returns the rule type for the type string of a compiled holiday (this must match +[SLHolidayManager ruleTypeForTypeString:])
+static SLHolidayRuleType SLTestRuleTypeForTypeString(const char *typeString)
+{
+    static const struct {
+        const char *typeString;
+        SLHolidayRuleType type;
+    } ruleTypes[] = {{"fixed", kSLHolidayRuleTypeFixed}, {"nthWeekday", kSLHolidayRuleTypeNthWeekday},
+                     {"weekdayOnOrAfter", kSLHolidayRuleTypeWeekdayOnOrAfter}, {"weekdayOnOrBefore", kSLHolidayRuleTypeWeekdayOnOrBefore},
+                     {"easter", kSLHolidayRuleTypeEaster}, {"orthodoxEaster", kSLHolidayRuleTypeOrthodoxEaster}};
+    for (size_t i = 0; typeString != NULL && i < sizeof(ruleTypes) / sizeof(ruleTypes[0]); i++) {
+        if (strcmp(typeString, ruleTypes[i].typeString) == 0) {
+            return ruleTypes[i].type;
+        }
+    }
+    return kSLHolidayRuleTypeDates;
+}
+
+// returns the integer for the given key of the given holiday, or 0 if the holiday does not have the key
+static int32_t SLTestIntegerForKey(const SLTestPlistNode *holiday, const char *key)
+{
+    const SLTestPlistNode *value = SLTestPlistObjectForKey(holiday, key);
+    return value != NULL ? (int32_t)value->integer : 0;
+}
+
+// returns whether or not the given array of date strings contains the given day
+static int SLTestDateStringsContainDay(const SLTestPlistNode *dateStrings, SLDay day)
+{
+    for (size_t i = 0; dateStrings != NULL && i < dateStrings->numChildren; i++) {
+        SLDay dateStringDay;
+        if (SLSkipRuleParseDateString(dateStrings->children[i].text, &dateStringDay) && dateStringDay == day) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// populates the given array with the sorted days that a compiled holiday from the bundle occurs on within the given range (inclusive)
+size_t SLTestDaysForHoliday(const SLTestPlistNode *holiday, int hasRules, SLDay firstDay, SLDay lastDay, SLDay *days, size_t capacity)
+{
+    SLHolidayRule rule;
+    memset(&rule, 0, sizeof(rule));
+    if (hasRules) {
+        const SLTestPlistNode *type = SLTestPlistObjectForKey(holiday, "type");
+        rule.type = SLTestRuleTypeForTypeString(type != NULL ? type->text : NULL);
+        rule.month = SLTestIntegerForKey(holiday, "month");
+        rule.day = SLTestIntegerForKey(holiday, "day");
+        rule.weekday = (SLWeekday)SLTestIntegerForKey(holiday, "weekday");
+        rule.ordinal = SLTestIntegerForKey(holiday, "ordinal");
+        rule.offset = SLTestIntegerForKey(holiday, "offset");
+        const SLTestPlistNode *observed = SLTestPlistObjectForKey(holiday, "observed");
+        if (observed != NULL && !SLHolidayRuleParseObserved(&rule, observed->text)) {
+            return kSLTestInvalidHoliday;
+        }
+    }
+    const SLTestPlistNode *removedDateStrings = SLTestPlistObjectForKey(holiday, "removed");
+    const SLTestPlistNode *addedDateStrings = SLTestPlistObjectForKey(holiday, rule.type == kSLHolidayRuleTypeDates ? "dates" : "added");
+
+    size_t numDays = 0;
+    int32_t firstYear, lastYear;
+    SLCivilFromDay(firstDay, &firstYear, NULL, NULL);
+    SLCivilFromDay(lastDay, &lastYear, NULL, NULL);
+    for (int32_t year = firstYear; year <= lastYear; year++) {
+        SLDay ruleDays[kSLHolidayRuleMaxOccurrences];
+        size_t numRuleDays = SLHolidayRuleOccurrencesInYear(&rule, year, ruleDays, kSLHolidayRuleMaxOccurrences);
+        for (size_t i = 0; i < numRuleDays; i++) {
+            if (ruleDays[i] >= firstDay && ruleDays[i] <= lastDay && !SLTestDateStringsContainDay(removedDateStrings, ruleDays[i])) {
+                if (numDays == capacity) {
+                    return capacity + 1;
+                }
+                days[numDays++] = ruleDays[i];
+            }
+        }
+    }
+    for (size_t i = 0; addedDateStrings != NULL && i < addedDateStrings->numChildren; i++) {
+        SLDay day;
+        if (!SLSkipRuleParseDateString(addedDateStrings->children[i].text, &day)) {
+            return kSLTestInvalidHoliday;
+        }
+        int isDuplicate = 0;
+        for (size_t j = 0; j < numDays && !isDuplicate; j++) {
+            isDuplicate = days[j] == day;
+        }
+        if (day >= firstDay && day <= lastDay && !isDuplicate) {
+            if (numDays == capacity) {
+                return capacity + 1;
+            }
+            days[numDays++] = day;
+        }
+    }
+
+    qsort(days, numDays, sizeof(SLDay), SLTestCompareDays);
+    return numDays;
+}
+
+// a single day that a holiday occurs on, along with the index of the holiday in its resource
+typedef struct SLTestHolidayOccurrence {
+    SLDay day;
+    size_t holidayIndex;
+} SLTestHolidayOccurrence;
+
+// the occurrences of every holiday of a resource within a single year, sorted by day and then by the order of the holidays
+typedef struct SLTestHolidayYear {
+    int32_t year;
+    SLTestHolidayOccurrence *occurrences;
+    size_t numOccurrences;
+} SLTestHolidayYear;
+
+// a resource that was read from the bundle, along with the years that have been evaluated
+typedef struct SLTestHolidayCalendarResource {
+    char *resourceName;
+    SLTestPlistNode *resource;
+    SLTestHolidayYear *years;
+    size_t numYears;
+} SLTestHolidayCalendarResource;
+
+struct SLTestHolidayCalendar {
+    SLTestHolidayCalendarResource *resources;
+    size_t numResources;
+};
+
+// creates an empty holiday calendar
+SLTestHolidayCalendar *SLTestHolidayCalendarCreate(void)
+{
+    return calloc(1, sizeof(SLTestHolidayCalendar));
+}
+
+// frees the given holiday calendar
+void SLTestHolidayCalendarFree(SLTestHolidayCalendar *calendar)
+{
+    if (calendar == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < calendar->numResources; i++) {
+        SLTestHolidayCalendarResource *resource = &calendar->resources[i];
+        for (size_t j = 0; j < resource->numYears; j++) {
+            free(resource->years[j].occurrences);
+        }
+        free(resource->years);
+        free(resource->resourceName);
+        SLTestPlistFree(resource->resource);
+    }
+    free(calendar->resources);
+    free(calendar);
+}
+
+// returns the number of years of any resource that the given calendar has evaluated
+size_t SLTestHolidayCalendarNumEvaluatedYears(const SLTestHolidayCalendar *calendar)
+{
+    size_t numYears = 0;
+    for (size_t i = 0; i < calendar->numResources; i++) {
+        numYears += calendar->resources[i].numYears;
+    }
+    return numYears;
+}
+
+// compares two occurrences by day and then by the order of the holidays
+static int SLTestCompareOccurrences(const void *lhs, const void *rhs)
+{
+    const SLTestHolidayOccurrence *lhsOccurrence = lhs;
+    const SLTestHolidayOccurrence *rhsOccurrence = rhs;
+    if (lhsOccurrence->day != rhsOccurrence->day) {
+        return (lhsOccurrence->day > rhsOccurrence->day) - (lhsOccurrence->day < rhsOccurrence->day);
+    }
+    return (lhsOccurrence->holidayIndex > rhsOccurrence->holidayIndex) - (lhsOccurrence->holidayIndex < rhsOccurrence->holidayIndex);
+}
+
+// returns the resource with the given name from the calendar, reading it from the bundle if needed (or NULL if it could not be read)
+static SLTestHolidayCalendarResource *SLTestHolidayCalendarResourceForName(SLTestHolidayCalendar *calendar, const char *resourceName)
+{
+    for (size_t i = 0; i < calendar->numResources; i++) {
+        if (strcmp(calendar->resources[i].resourceName, resourceName) == 0) {
+            return calendar->resources[i].resource != NULL ? &calendar->resources[i] : NULL;
+        }
+    }
+    SLTestHolidayCalendarResource *resources = realloc(calendar->resources, (calendar->numResources + 1) * sizeof(SLTestHolidayCalendarResource));
+    if (resources == NULL) {
+        return NULL;
+    }
+    calendar->resources = resources;
+    SLTestHolidayCalendarResource *resource = &calendar->resources[calendar->numResources++];
+    memset(resource, 0, sizeof(SLTestHolidayCalendarResource));
+    resource->resourceName = strdup(resourceName);
+    resource->resource = SLTestHolidayResourceRead(resourceName);
+    return resource->resourceName != NULL && resource->resource != NULL ? resource : NULL;
+}
+
+// returns the occurrences of every holiday of the given resource in the given year, evaluating the year if it has not been evaluated yet
+static const SLTestHolidayYear *SLTestHolidayCalendarYear(SLTestHolidayCalendarResource *resource, int32_t year)
+{
+    for (size_t i = 0; i < resource->numYears; i++) {
+        if (resource->years[i].year == year) {
+            return &resource->years[i];
+        }
+    }
+    SLTestHolidayYear *years = realloc(resource->years, (resource->numYears + 1) * sizeof(SLTestHolidayYear));
+    if (years == NULL) {
+        return NULL;
+    }
+    resource->years = years;
+    SLTestHolidayYear *holidayYear = &resource->years[resource->numYears++];
+    memset(holidayYear, 0, sizeof(SLTestHolidayYear));
+    holidayYear->year = year;
+
+    int hasRules = SLTestHolidayResourceHasRules(resource->resource);
+    const SLTestPlistNode *holidays = SLTestPlistObjectForKey(resource->resource, "holidays");
+    SLDay days[kSLTestMaxHolidayDays];
+    for (size_t i = 0; holidays != NULL && i < holidays->numChildren; i++) {
+        size_t numDays = SLTestDaysForHoliday(&holidays->children[i], hasRules, SLDayFromCivil(year, 1, 1), SLDayFromCivil(year, 12, 31), days,
+                                              kSLTestMaxHolidayDays);
+        if (numDays > kSLTestMaxHolidayDays) {
+            continue;
+        }
+        SLTestHolidayOccurrence *occurrences = realloc(holidayYear->occurrences,
+                                                       (holidayYear->numOccurrences + numDays + 1) * sizeof(SLTestHolidayOccurrence));
+        if (occurrences == NULL) {
+            break;
+        }
+        holidayYear->occurrences = occurrences;
+        for (size_t j = 0; j < numDays; j++) {
+            holidayYear->occurrences[holidayYear->numOccurrences++] = (SLTestHolidayOccurrence){days[j], i};
+        }
+    }
+    qsort(holidayYear->occurrences, holidayYear->numOccurrences, sizeof(SLTestHolidayOccurrence), SLTestCompareOccurrences);
+    return holidayYear;
+}
+
+// finds the first day within the given range that any of the selected holidays of the resource with the given name occur on
+int SLTestHolidayCalendarFirstDay(SLTestHolidayCalendar *calendar, const char *resourceName, uint64_t holidaySelection, SLDay firstDay,
+                                  SLDay lastDay, SLDay *day, const char **holidayName)
+{
+    SLTestHolidayCalendarResource *resource = SLTestHolidayCalendarResourceForName(calendar, resourceName);
+    if (resource == NULL || holidaySelection == 0 || firstDay > lastDay) {
+        return 0;
+    }
+    const SLTestPlistNode *holidays = SLTestPlistObjectForKey(resource->resource, "holidays");
+    int32_t firstYear, lastYear;
+    SLCivilFromDay(firstDay, &firstYear, NULL, NULL);
+    SLCivilFromDay(lastDay, &lastYear, NULL, NULL);
+    for (int32_t year = firstYear; year <= lastYear; year++) {
+        const SLTestHolidayYear *holidayYear = SLTestHolidayCalendarYear(resource, year);
+        for (size_t i = 0; holidayYear != NULL && i < holidayYear->numOccurrences; i++) {
+            const SLTestHolidayOccurrence *occurrence = &holidayYear->occurrences[i];
+            if (occurrence->day < firstDay) {
+                continue;
+            } else if (occurrence->day > lastDay) {
+                return 0;
+            }
+            const SLTestPlistNode *holiday = &holidays->children[occurrence->holidayIndex];
+            const SLTestPlistNode *holidayId = SLTestPlistObjectForKey(holiday, "id");
+            if (holidayId != NULL && holidayId->integer >= 0 && holidayId->integer < kSLTestMaxHolidayIds &&
+                (holidaySelection & (1ULL << holidayId->integer))) {
+                const SLTestPlistNode *name = SLTestPlistObjectForKey(holiday, "name");
+                *day = occurrence->day;
+                if (holidayName != NULL) {
+                    *holidayName = name != NULL ? name->text : "";
+                }
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+//
+//  SLTestHolidays.h
+//  Reads the holiday fixtures and evaluates the compiled holiday resources in the bundle for the host tests.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLTestHolidays_h
+#define SLTestHolidays_h
+
+#include <stdint.h>
+#include "SLTest.h"
+#include "SLTestPlist.h"
+#include "SLHolidayRules.h"
+
+// the directory of the fixtures that contain the dates that each holiday resource was compiled from (written by holiday_gen.py)
+#define kSLTestHolidayFixturesPath  kSLTestFixturesPath "/holidays"
+
+// the suffix of the holiday fixtures
+#define kSLTestHolidayFixtureSuffix "_holidays.txt"
+
+// the maximum number of dates that a single holiday can have in a fixture
+#define kSLTestMaxHolidayDays       1024
+
+// the first version of the holiday resources that contains rules (older resources only contain a table of dates for each holiday)
+#define kSLTestHolidayRulesVersion  2
+
+// the number of holiday IDs that can be selected for a single country
+#define kSLTestMaxHolidayIds        64
+
+// the number of days that is returned by SLTestDaysForHoliday for a holiday that could not be evaluated
+#define kSLTestInvalidHoliday       SIZE_MAX
+
+// a single holiday from a fixture along with the sorted days that it occurs on
+typedef struct SLTestFixtureHoliday {
+    long long holidayId;
+    char *name;
+    SLDay *days;
+    size_t numDays;
+} SLTestFixtureHoliday;
+
+// the holidays of a fixture, along with the first and last days (inclusive) that the dates were compiled for
+typedef struct SLTestHolidayFixture {
+    SLDay firstDay;
+    SLDay lastDay;
+    SLTestFixtureHoliday *holidays;
+    size_t numHolidays;
+} SLTestHolidayFixture;
+
+// Reads the fixture of the holiday resource with the given name (a range line followed by the ID, name, and space separated dates of each
+// holiday), returning the fixture (which must be freed with SLTestHolidayFixtureFree) or NULL if it could not be read or is invalid.
+SLTestHolidayFixture *SLTestHolidayFixtureRead(const char *resourceName);
+
+// frees the given fixture that was returned by SLTestHolidayFixtureRead
+void SLTestHolidayFixtureFree(SLTestHolidayFixture *fixture);
+
+// Calls the given function with the name of every holiday resource that has a fixture (i.e. "us_holidays"), returning the number of
+// resources or 0 if the fixtures could not be listed.
+size_t SLTestEnumerateHolidayFixtures(void (*function)(const char *resourceName, void *context), void *context);
+
+// reads the holiday resource with the given name from the bundle, returning NULL if it could not be read
+SLTestPlistNode *SLTestHolidayResourceRead(const char *resourceName);
+
+// returns whether or not the given holiday resource contains rules (rather than a table of dates for each holiday)
+int SLTestHolidayResourceHasRules(const SLTestPlistNode *resource);
+
+// returns the holiday with the given ID in the given array of holidays from a resource, or NULL if the resource does not contain the holiday
+const SLTestPlistNode *SLTestHolidayForId(const SLTestPlistNode *holidays, long long holidayId);
+
+// Populates the given array with the sorted days that a compiled holiday from the bundle occurs on within the given range (inclusive),
+// evaluating the rule for each year and then applying the removed and added days the same way that the holiday manager does.  Returns the
+// number of days, the capacity plus one if there are more days than the capacity, or kSLTestInvalidHoliday if the holiday is invalid.
+size_t SLTestDaysForHoliday(const SLTestPlistNode *holiday, int hasRules, SLDay firstDay, SLDay lastDay, SLDay *days, size_t capacity);
+
+// The holidays of the resources in the bundle, which are evaluated one year at a time (each year of a resource is only evaluated once) the
+// same way that the holiday manager builds the occurrences of a resource.
+typedef struct SLTestHolidayCalendar SLTestHolidayCalendar;
+
+// creates an empty holiday calendar, which must be freed with SLTestHolidayCalendarFree
+SLTestHolidayCalendar *SLTestHolidayCalendarCreate(void);
+
+// frees the given holiday calendar that was returned by SLTestHolidayCalendarCreate
+void SLTestHolidayCalendarFree(SLTestHolidayCalendar *calendar);
+
+// returns the number of years of any resource that the given calendar has evaluated
+size_t SLTestHolidayCalendarNumEvaluatedYears(const SLTestHolidayCalendar *calendar);
+
+// Finds the first day within the given range (inclusive) that any of the selected holidays of the resource with the given name occur on,
+// along with the name of that holiday (which is owned by the calendar).  Ties are broken by the order of the holidays in the resource.
+// Returns 0 if none of the holidays occur within the range or if the resource could not be read.
+int SLTestHolidayCalendarFirstDay(SLTestHolidayCalendar *calendar, const char *resourceName, uint64_t holidaySelection, SLDay firstDay,
+                                  SLDay lastDay, SLDay *day, const char **holidayName);
+
+#endif /* SLTestHolidays_h */
@@ -0,0 +1,254 @@
+//
+//  SLTestPlist.c
+//  Minimal XML property list reader that lets the host tests read the holiday resources and fixtures without Foundation.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLTestPlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the maximum length of the name of a tag
+#define kSLTestPlistMaxTagLength    32
+
+// the state of the parser, which reads from a copy of the whole file
+typedef struct SLTestPlistParser {
+    const char *cursor;
+    const char *end;
+} SLTestPlistParser;
+
+// a tag that was read from the file
+typedef struct SLTestPlistTag {
+    char name[kSLTestPlistMaxTagLength];
+    int isClosing;
+    int isEmpty;
+} SLTestPlistTag;
+
+// skips any whitespace, processing instructions, comments, and document type declarations
+static void SLTestPlistSkipMarkup(SLTestPlistParser *parser)
+{
+    while (parser->cursor < parser->end) {
+        if (*parser->cursor == ' ' || *parser->cursor == '\t' || *parser->cursor == '\r' || *parser->cursor == '\n') {
+            parser->cursor++;
+        } else if (parser->end - parser->cursor >= 4 && strncmp(parser->cursor, "<!--", 4) == 0) {
+            const char *commentEnd = strstr(parser->cursor, "-->");
+            parser->cursor = commentEnd != NULL ? commentEnd + 3 : parser->end;
+        } else if (parser->end - parser->cursor >= 2 && (strncmp(parser->cursor, "<?", 2) == 0 || strncmp(parser->cursor, "<!", 2) == 0)) {
+            const char *markupEnd = memchr(parser->cursor, '>', (size_t)(parser->end - parser->cursor));
+            parser->cursor = markupEnd != NULL ? markupEnd + 1 : parser->end;
+        } else {
+            return;
+        }
+    }
+}
+
+// reads the next tag (ignoring any attributes), returning 0 if the next part of the file is not a tag
+static int SLTestPlistReadTag(SLTestPlistParser *parser, SLTestPlistTag *tag)
+{
+    SLTestPlistSkipMarkup(parser);
+    if (parser->cursor >= parser->end || *parser->cursor != '<') {
+        return 0;
+    }
+    const char *tagEnd = memchr(parser->cursor, '>', (size_t)(parser->end - parser->cursor));
+    if (tagEnd == NULL) {
+        return 0;
+    }
+
+    const char *name = parser->cursor + 1;
+    tag->isClosing = *name == '/';
+    if (tag->isClosing) {
+        name++;
+    }
+    tag->isEmpty = tagEnd[-1] == '/';
+    size_t nameLength = strcspn(name, " \t\r\n/>");
+    if (nameLength == 0 || nameLength >= kSLTestPlistMaxTagLength) {
+        return 0;
+    }
+    memcpy(tag->name, name, nameLength);
+    tag->name[nameLength] = '\0';
+    parser->cursor = tagEnd + 1;
+    return 1;
+}
+
+// reads the text up to the closing tag with the given name, decoding the entities that are written by the property list encoders
+static char *SLTestPlistReadText(SLTestPlistParser *parser, const char *name)
+{
+    const char *textEnd = memchr(parser->cursor, '<', (size_t)(parser->end - parser->cursor));
+    if (textEnd == NULL) {
+        return NULL;
+    }
+    char *text = malloc((size_t)(textEnd - parser->cursor) + 1);
+    if (text == NULL) {
+        return NULL;
+    }
+    size_t length = 0;
+    static const char *const entities[][2] = {{"&amp;", "&"}, {"&lt;", "<"}, {"&gt;", ">"}, {"&apos;", "'"}, {"&quot;", "\""}};
+    size_t numEntities = sizeof(entities) / sizeof(entities[0]);
+    while (parser->cursor < textEnd) {
+        size_t i = numEntities;
+        if (*parser->cursor == '&') {
+            for (i = 0; i < numEntities; i++) {
+                size_t entityLength = strlen(entities[i][0]);
+                if ((size_t)(textEnd - parser->cursor) >= entityLength && strncmp(parser->cursor, entities[i][0], entityLength) == 0) {
+                    text[length++] = entities[i][1][0];
+                    parser->cursor += entityLength;
+                    break;
+                }
+            }
+        }
+        if (i == numEntities) {
+            text[length++] = *parser->cursor++;
+        }
+    }
+    text[length] = '\0';
+
+    SLTestPlistTag tag;
+    if (!SLTestPlistReadTag(parser, &tag) || !tag.isClosing || strcmp(tag.name, name) != 0) {
+        free(text);
+        return NULL;
+    }
+    return text;
+}
+
+// frees the contents of the given object (but not the object itself)
+static void SLTestPlistFreeContents(SLTestPlistNode *node)
+{
+    for (size_t i = 0; i < node->numChildren; i++) {
+        SLTestPlistFreeContents(&node->children[i]);
+    }
+    free(node->children);
+    free(node->key);
+    free(node->text);
+    memset(node, 0, sizeof(*node));
+}
+
+// appends an empty child to the given object, returning NULL if it could not be allocated
+static SLTestPlistNode *SLTestPlistAddChild(SLTestPlistNode *node)
+{
+    SLTestPlistNode *children = realloc(node->children, (node->numChildren + 1) * sizeof(SLTestPlistNode));
+    if (children == NULL) {
+        return NULL;
+    }
+    node->children = children;
+    memset(&children[node->numChildren], 0, sizeof(SLTestPlistNode));
+    return &children[node->numChildren++];
+}
+
+// reads the object that starts with the given (opening) tag into the given object, returning 0 if the object could not be parsed
+static int SLTestPlistReadObject(SLTestPlistParser *parser, const SLTestPlistTag *tag, SLTestPlistNode *node)
+{
+    if (strcmp(tag->name, "dict") == 0 || strcmp(tag->name, "array") == 0) {
+        int isDictionary = tag->name[0] == 'd';
+        node->type = isDictionary ? kSLTestPlistTypeDictionary : kSLTestPlistTypeArray;
+        if (tag->isEmpty) {
+            return 1;
+        }
+        SLTestPlistTag childTag = {{0}, 0, 0};
+        while (SLTestPlistReadTag(parser, &childTag) && !childTag.isClosing) {
+            char *key = NULL;
+            if (isDictionary) {
+                if (strcmp(childTag.name, "key") != 0 || (key = SLTestPlistReadText(parser, "key")) == NULL ||
+                    !SLTestPlistReadTag(parser, &childTag) || childTag.isClosing) {
+                    free(key);
+                    return 0;
+                }
+            }
+            SLTestPlistNode *child = SLTestPlistAddChild(node);
+            if (child == NULL) {
+                free(key);
+                return 0;
+            }
+            child->key = key;
+            if (!SLTestPlistReadObject(parser, &childTag, child)) {
+                return 0;
+            }
+        }
+        return childTag.isClosing && strcmp(childTag.name, tag->name) == 0;
+    } else if (strcmp(tag->name, "true") == 0 || strcmp(tag->name, "false") == 0) {
+        node->type = kSLTestPlistTypeBoolean;
+        node->integer = tag->name[0] == 't';
+        SLTestPlistTag closingTag;
+        return tag->isEmpty || (SLTestPlistReadTag(parser, &closingTag) && closingTag.isClosing);
+    }
+
+    static const struct {
+        const char *name;
+        SLTestPlistType type;
+    } textTypes[] = {{"string", kSLTestPlistTypeString}, {"integer", kSLTestPlistTypeInteger}, {"real", kSLTestPlistTypeReal},
+                     {"date", kSLTestPlistTypeDate}, {"data", kSLTestPlistTypeData}};
+    for (size_t i = 0; i < sizeof(textTypes) / sizeof(textTypes[0]); i++) {
+        if (strcmp(tag->name, textTypes[i].name) == 0) {
+            node->type = textTypes[i].type;
+            node->text = tag->isEmpty ? calloc(1, 1) : SLTestPlistReadText(parser, tag->name);
+            if (node->text == NULL) {
+                return 0;
+            }
+            node->integer = node->type == kSLTestPlistTypeInteger ? strtoll(node->text, NULL, 10) : 0;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// reads the XML property list at the given path, returning the root object or NULL if the file could not be read or parsed
+SLTestPlistNode *SLTestPlistRead(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    char *contents = NULL;
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+        contents = malloc((size_t)length + 1);
+        if (contents != NULL && fread(contents, 1, (size_t)length, file) != (size_t)length) {
+            free(contents);
+            contents = NULL;
+        }
+    }
+    fclose(file);
+    if (contents == NULL) {
+        return NULL;
+    }
+    contents[length] = '\0';
+
+    // the root object is wrapped in the plist element
+    SLTestPlistParser parser = {contents, contents + length};
+    SLTestPlistNode *root = calloc(1, sizeof(SLTestPlistNode));
+    SLTestPlistTag tag;
+    int success = root != NULL && SLTestPlistReadTag(&parser, &tag) && strcmp(tag.name, "plist") == 0 &&
+                  SLTestPlistReadTag(&parser, &tag) && !tag.isClosing && SLTestPlistReadObject(&parser, &tag, root) &&
+                  SLTestPlistReadTag(&parser, &tag) && tag.isClosing && strcmp(tag.name, "plist") == 0;
+    free(contents);
+    if (!success) {
+        SLTestPlistFree(root);
+        return NULL;
+    }
+    return root;
+}
+
+// frees the given root object that was returned by SLTestPlistRead
+void SLTestPlistFree(SLTestPlistNode *root)
+{
+    if (root != NULL) {
+        SLTestPlistFreeContents(root);
+        free(root);
+    }
+}
+
+// returns the value for the given key in the given dictionary, or NULL if the key does not exist
+const SLTestPlistNode *SLTestPlistObjectForKey(const SLTestPlistNode *dictionary, const char *key)
+{
+    if (dictionary == NULL || dictionary->type != kSLTestPlistTypeDictionary) {
+        return NULL;
+    }
+    for (size_t i = 0; i < dictionary->numChildren; i++) {
+        if (strcmp(dictionary->children[i].key, key) == 0) {
+            return &dictionary->children[i];
+        }
+    }
+    return NULL;
+}
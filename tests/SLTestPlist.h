@@ -0,0 +1,47 @@
+//
+//  SLTestPlist.h
+//  Minimal XML property list reader that lets the host tests read the holiday resources and fixtures without Foundation.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLTestPlist_h
+#define SLTestPlist_h
+
+#include <stddef.h>
+
+// the types of the objects in a property list
+typedef enum SLTestPlistType {
+    kSLTestPlistTypeDictionary,
+    kSLTestPlistTypeArray,
+    kSLTestPlistTypeString,
+    kSLTestPlistTypeInteger,
+    kSLTestPlistTypeReal,
+    kSLTestPlistTypeBoolean,
+    kSLTestPlistTypeDate,
+    kSLTestPlistTypeData
+} SLTestPlistType;
+
+// A single object in a property list.  The children of a dictionary are its values (each with the key that it is stored with), while the
+// text of a string, real, date, or data object is kept as it appears in the file (with any entities decoded).
+typedef struct SLTestPlistNode {
+    SLTestPlistType type;
+    char *key;
+    char *text;
+    long long integer;
+    struct SLTestPlistNode *children;
+    size_t numChildren;
+} SLTestPlistNode;
+
+// Reads the XML property list at the given path, returning the root object (which must be freed with SLTestPlistFree) or NULL if the file
+// could not be read or parsed.
+SLTestPlistNode *SLTestPlistRead(const char *path);
+
+// frees the given root object that was returned by SLTestPlistRead
+void SLTestPlistFree(SLTestPlistNode *root);
+
+// returns the value for the given key in the given dictionary, or NULL if the key does not exist (or the object is not a dictionary)
+const SLTestPlistNode *SLTestPlistObjectForKey(const SLTestPlistNode *dictionary, const char *key);
+
+#endif /* SLTestPlist_h */
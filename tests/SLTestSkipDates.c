@@ -0,0 +1,232 @@
+//
+//  SLTestSkipDates.c
+//  Compiles the skip dates of an alarm and makes the skip decisions with the portable parts of libSleeper for the host tests.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#include "SLTestSkipDates.h"
+#include <stdlib.h>
+#include <string.h>
+
+// compares two day numbers for sorting and searching
+static int SLTestCompareDays(const void *lhs, const void *rhs)
+{
+    SLDay lhsDay = *(const SLDay *)lhs;
+    SLDay rhsDay = *(const SLDay *)rhs;
+    return (lhsDay > rhsDay) - (lhsDay < rhsDay);
+}
+
+// compiles a skip rule from the values that are stored in the preferences
+int SLTestCompileSkipRule(const char *type, const char *startDateString, const char *endDateString, long long interval, long long weekdays,
+                          long long weekday, long long ordinal, SLSkipRule *skipRule)
+{
+    // every rule must have a start date, while only date ranges require an end date
+    memset(skipRule, 0, sizeof(SLSkipRule));
+    if (type == NULL || startDateString == NULL || !SLSkipRuleParseDateString(startDateString, &skipRule->startDay)) {
+        return 0;
+    }
+    if (endDateString != NULL) {
+        if (!SLSkipRuleParseDateString(endDateString, &skipRule->endDay)) {
+            return 0;
+        }
+    } else if (strcmp(type, kSLTestSkipRuleTypeDateRangeString) == 0) {
+        return 0;
+    } else {
+        skipRule->endDay = kSLSkipRuleNoEndDay;
+    }
+    skipRule->interval = (int32_t)(interval > 1 ? interval : 1);
+
+    if (strcmp(type, kSLTestSkipRuleTypeWeeklyString) == 0) {
+        skipRule->type = kSLSkipRuleTypeWeekly;
+        skipRule->weekdays = (uint8_t)(weekdays & ((1 << kSLWeekdayNumWeekdays) - 1));
+        return skipRule->weekdays != 0;
+    } else if (strcmp(type, kSLTestSkipRuleTypeNthWeekdayString) == 0) {
+        if (weekday < kSLWeekdayMonday || weekday > kSLWeekdaySunday || ((ordinal < 1 || ordinal > 5) && ordinal != kSLHolidayRuleLastOrdinal)) {
+            return 0;
+        }
+        skipRule->type = kSLSkipRuleTypeNthWeekday;
+        skipRule->weekday = (SLWeekday)weekday;
+        skipRule->ordinal = (int32_t)ordinal;
+        return 1;
+    } else if (strcmp(type, kSLTestSkipRuleTypeDateRangeString) == 0) {
+        skipRule->type = kSLSkipRuleTypeDateRange;
+        return skipRule->endDay >= skipRule->startDay;
+    }
+    return 0;
+}
+
+// adds the given custom skip date string to the given skip dates, keeping the custom skip days sorted
+int SLTestSkipDatesAddCustomSkipDateString(SLTestSkipDates *skipDates, const char *dateString)
+{
+    SLDay day;
+    if (skipDates->numCustomSkipDays == kSLTestMaxCustomSkipDays || !SLSkipRuleParseDateString(dateString, &day)) {
+        return 0;
+    }
+    size_t index = skipDates->numCustomSkipDays;
+    while (index > 0 && skipDates->customSkipDays[index - 1] > day) {
+        skipDates->customSkipDays[index] = skipDates->customSkipDays[index - 1];
+        index--;
+    }
+    skipDates->customSkipDays[index] = day;
+    skipDates->numCustomSkipDays++;
+    return 1;
+}
+
+// adds the given holiday selection of the resource with the given name to the given skip dates
+int SLTestSkipDatesAddHolidaySelection(SLTestSkipDates *skipDates, const char *resourceName, uint64_t holidaySelection)
+{
+    if (skipDates->numHolidaySelections == kSLTestMaxHolidaySelections || strlen(resourceName) >= kSLTestMaxResourceNameLength) {
+        return 0;
+    }
+    SLTestHolidaySelection *selection = &skipDates->holidaySelections[skipDates->numHolidaySelections++];
+    strcpy(selection->resourceName, resourceName);
+    selection->holidaySelection = holidaySelection;
+    return 1;
+}
+
+// adds the given compiled skip rule to the given skip dates along with its sorted exception days
+int SLTestSkipDatesAddSkipRule(SLTestSkipDates *skipDates, const SLSkipRule *skipRule, const char *const *exceptionStrings,
+                               size_t numExceptionStrings)
+{
+    if (skipDates->numSkipRules == kSLTestMaxSkipRules || numExceptionStrings > kSLTestMaxSkipRuleExceptions) {
+        return 0;
+    }
+    SLTestCompiledSkipRule *compiledSkipRule = &skipDates->skipRules[skipDates->numSkipRules++];
+    compiledSkipRule->skipRule = *skipRule;
+    compiledSkipRule->numExceptions = 0;
+    for (size_t i = 0; i < numExceptionStrings; i++) {
+        if (exceptionStrings[i] != NULL && SLSkipRuleParseDateString(exceptionStrings[i], &compiledSkipRule->exceptions[compiledSkipRule->numExceptions])) {
+            compiledSkipRule->numExceptions++;
+        }
+    }
+    qsort(compiledSkipRule->exceptions, compiledSkipRule->numExceptions, sizeof(SLDay), SLTestCompareDays);
+    return 1;
+}
+
+// returns the text of the given string object, or NULL if the object is missing or is not a string
+static const char *SLTestPlistString(const SLTestPlistNode *node)
+{
+    return node != NULL && node->type == kSLTestPlistTypeString ? node->text : NULL;
+}
+
+// returns the value of the given integer object, or 0 if the object is missing or is not an integer
+static long long SLTestPlistInteger(const SLTestPlistNode *node)
+{
+    return node != NULL && node->type == kSLTestPlistTypeInteger ? node->integer : 0;
+}
+
+// compiles the given skip dates dictionary from the preferences into the given skip dates
+int SLTestSkipDatesFromPlist(const SLTestPlistNode *skipDatesDictionary, SLTestSkipDates *skipDates)
+{
+    memset(skipDates, 0, sizeof(SLTestSkipDates));
+    const SLTestPlistNode *customSkipDateStrings = SLTestPlistObjectForKey(skipDatesDictionary, kSLTestCustomSkipDateStringsKey);
+    for (size_t i = 0; customSkipDateStrings != NULL && i < customSkipDateStrings->numChildren; i++) {
+        const char *dateString = SLTestPlistString(&customSkipDateStrings->children[i]);
+        if (dateString != NULL && !SLTestSkipDatesAddCustomSkipDateString(skipDates, dateString) &&
+            skipDates->numCustomSkipDays == kSLTestMaxCustomSkipDays) {
+            return 0;
+        }
+    }
+
+    const SLTestPlistNode *holidaySkipDates = SLTestPlistObjectForKey(skipDatesDictionary, kSLTestHolidaySkipDatesKey);
+    for (size_t i = 0; holidaySkipDates != NULL && holidaySkipDates->type == kSLTestPlistTypeDictionary && i < holidaySkipDates->numChildren; i++) {
+        const SLTestPlistNode *holidaySelection = &holidaySkipDates->children[i];
+        if (!SLTestSkipDatesAddHolidaySelection(skipDates, holidaySelection->key, (uint64_t)SLTestPlistInteger(holidaySelection))) {
+            return 0;
+        }
+    }
+
+    // the rules that are not valid are skipped, just like they are when the rules of an alarm are compiled
+    const SLTestPlistNode *skipRules = SLTestPlistObjectForKey(skipDatesDictionary, kSLTestSkipRulesKey);
+    for (size_t i = 0; skipRules != NULL && i < skipRules->numChildren; i++) {
+        const SLTestPlistNode *skipRuleDictionary = &skipRules->children[i];
+        SLSkipRule skipRule;
+        if (skipRuleDictionary->type != kSLTestPlistTypeDictionary ||
+            !SLTestCompileSkipRule(SLTestPlistString(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleTypeKey)),
+                                   SLTestPlistString(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleStartDateKey)),
+                                   SLTestPlistString(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleEndDateKey)),
+                                   SLTestPlistInteger(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleIntervalKey)),
+                                   SLTestPlistInteger(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleWeekdaysKey)),
+                                   SLTestPlistInteger(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleWeekdayKey)),
+                                   SLTestPlistInteger(SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleOrdinalKey)), &skipRule)) {
+            continue;
+        }
+        const SLTestPlistNode *exceptions = SLTestPlistObjectForKey(skipRuleDictionary, kSLTestSkipRuleExceptionsKey);
+        const char *exceptionStrings[kSLTestMaxSkipRuleExceptions];
+        size_t numExceptionStrings = exceptions != NULL ? exceptions->numChildren : 0;
+        if (numExceptionStrings > kSLTestMaxSkipRuleExceptions) {
+            return 0;
+        }
+        for (size_t j = 0; j < numExceptionStrings; j++) {
+            exceptionStrings[j] = SLTestPlistString(&exceptions->children[j]);
+        }
+        if (!SLTestSkipDatesAddSkipRule(skipDates, &skipRule, exceptionStrings, numExceptionStrings)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// returns the first reason that the given skip dates are skipped on the given day
+SLTestSkipReason SLTestSkipDatesReasonOnDay(const SLTestSkipDates *skipDates, SLTestHolidayCalendar *calendar, SLDay day)
+{
+    if (bsearch(&day, skipDates->customSkipDays, skipDates->numCustomSkipDays, sizeof(SLDay), SLTestCompareDays) != NULL) {
+        return kSLTestSkipReasonCustomDate;
+    }
+    for (size_t i = 0; i < skipDates->numHolidaySelections; i++) {
+        SLDay holidayDay;
+        if (SLTestHolidayCalendarFirstDay(calendar, skipDates->holidaySelections[i].resourceName, skipDates->holidaySelections[i].holidaySelection,
+                                          day, day, &holidayDay, NULL)) {
+            return kSLTestSkipReasonHoliday;
+        }
+    }
+
+    // a rule that occurs on an exception is not skipped, which the next day of the rule accounts for
+    for (size_t i = 0; i < skipDates->numSkipRules; i++) {
+        const SLTestCompiledSkipRule *compiledSkipRule = &skipDates->skipRules[i];
+        SLDay nextDay;
+        if (SLSkipRuleOccursOnDay(&compiledSkipRule->skipRule, day) &&
+            SLSkipRuleNextDay(&compiledSkipRule->skipRule, day, compiledSkipRule->exceptions, compiledSkipRule->numExceptions, &nextDay) &&
+            nextDay == day) {
+            return kSLTestSkipReasonSkipRule;
+        }
+    }
+    return kSLTestSkipReasonNone;
+}
+
+// fills in the given explanation with the first day of each kind of skip date on or after the given day
+void SLTestSkipDatesExplanation(const SLTestSkipDates *skipDates, SLTestHolidayCalendar *calendar, SLDay today, SLDay lastHolidayDay,
+                                SLTestSkipExplanation *explanation)
+{
+    memset(explanation, 0, sizeof(SLTestSkipExplanation));
+    if (skipDates->numCustomSkipDays > 0) {
+        explanation->hasCustomSkipDay = 1;
+        explanation->customSkipDay = skipDates->customSkipDays[0];
+    }
+
+    // each selection only needs to be searched up to the first holiday that has been found so far
+    for (size_t i = 0; i < skipDates->numHolidaySelections; i++) {
+        SLDay holidayDay;
+        const char *holidayName;
+        SLDay lastDay = explanation->hasHoliday ? explanation->holidayDay - 1 : lastHolidayDay;
+        if (SLTestHolidayCalendarFirstDay(calendar, skipDates->holidaySelections[i].resourceName, skipDates->holidaySelections[i].holidaySelection,
+                                          today, lastDay, &holidayDay, &holidayName)) {
+            explanation->hasHoliday = 1;
+            explanation->holidayDay = holidayDay;
+            explanation->holidayName = holidayName;
+        }
+    }
+
+    for (size_t i = 0; i < skipDates->numSkipRules; i++) {
+        const SLTestCompiledSkipRule *compiledSkipRule = &skipDates->skipRules[i];
+        SLDay nextDay;
+        if (SLSkipRuleNextDay(&compiledSkipRule->skipRule, today, compiledSkipRule->exceptions, compiledSkipRule->numExceptions, &nextDay) &&
+            (!explanation->hasSkipRule || nextDay < explanation->skipRuleDay)) {
+            explanation->hasSkipRule = 1;
+            explanation->skipRuleDay = nextDay;
+            explanation->skipRuleIndex = i;
+        }
+    }
+}
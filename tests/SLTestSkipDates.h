@@ -0,0 +1,117 @@
+//
+//  SLTestSkipDates.h
+//  Compiles the skip dates of an alarm and makes the skip decisions with the portable parts of libSleeper for the host tests.
+//
+//  Created by Joshua Seltzer on 10/19/26.
+//  Copyright (c) 2026 Joshua Seltzer. All rights reserved.
+//
+
+#ifndef SLTestSkipDates_h
+#define SLTestSkipDates_h
+
+#include <stdint.h>
+#include "SLTestPlist.h"
+#include "SLTestHolidays.h"
+#include "SLSkipRules.h"
+
+// the keys of the skip dates in the preferences (these must match the keys that are defined in SLPrefsManager.h)
+#define kSLTestCustomSkipDateStringsKey     "customSkipDateStrings"
+#define kSLTestHolidaySkipDatesKey          "holidaySkipDates"
+#define kSLTestSkipRulesKey                 "skipRules"
+#define kSLTestSkipRuleTypeKey              "type"
+#define kSLTestSkipRuleStartDateKey         "startDate"
+#define kSLTestSkipRuleEndDateKey           "endDate"
+#define kSLTestSkipRuleIntervalKey          "interval"
+#define kSLTestSkipRuleWeekdaysKey          "weekdays"
+#define kSLTestSkipRuleWeekdayKey           "weekday"
+#define kSLTestSkipRuleOrdinalKey           "ordinal"
+#define kSLTestSkipRuleExceptionsKey        "exceptions"
+
+// the type strings of the skip rules in the preferences
+#define kSLTestSkipRuleTypeWeeklyString     "weekly"
+#define kSLTestSkipRuleTypeNthWeekdayString "nthWeekday"
+#define kSLTestSkipRuleTypeDateRangeString  "dateRange"
+
+// the maximum number of each kind of skip date that can be compiled for a single alarm
+#define kSLTestMaxCustomSkipDays            512
+#define kSLTestMaxHolidaySelections         8
+#define kSLTestMaxSkipRules                 8
+#define kSLTestMaxSkipRuleExceptions        32
+
+// the maximum length of the name of a holiday resource (including the terminator)
+#define kSLTestMaxResourceNameLength        64
+
+// the reason that an alarm is skipped on a day, which are checked in this order
+typedef enum SLTestSkipReason {
+    kSLTestSkipReasonNone,
+    kSLTestSkipReasonCustomDate,
+    kSLTestSkipReasonHoliday,
+    kSLTestSkipReasonSkipRule
+} SLTestSkipReason;
+
+// the holidays that are selected from a single holiday resource
+typedef struct SLTestHolidaySelection {
+    char resourceName[kSLTestMaxResourceNameLength];
+    uint64_t holidaySelection;
+} SLTestHolidaySelection;
+
+// a compiled skip rule along with its sorted exception days
+typedef struct SLTestCompiledSkipRule {
+    SLSkipRule skipRule;
+    SLDay exceptions[kSLTestMaxSkipRuleExceptions];
+    size_t numExceptions;
+} SLTestCompiledSkipRule;
+
+// The compiled skip dates of an alarm (or of a skip profile), which are evaluated the same way as SLAlarmPrefs evaluates them.  The custom
+// skip days are kept sorted, and the holiday selections and skip rules are kept in the order that they were added.
+typedef struct SLTestSkipDates {
+    SLDay customSkipDays[kSLTestMaxCustomSkipDays];
+    size_t numCustomSkipDays;
+    SLTestHolidaySelection holidaySelections[kSLTestMaxHolidaySelections];
+    size_t numHolidaySelections;
+    SLTestCompiledSkipRule skipRules[kSLTestMaxSkipRules];
+    size_t numSkipRules;
+} SLTestSkipDates;
+
+// The first upcoming day of each kind of skip date, which is what the skip explanation of an alarm lists.  The first custom skip day is the
+// first day of the sorted custom skip days (even if it has passed), while the name of the holiday is owned by the holiday calendar.
+typedef struct SLTestSkipExplanation {
+    int hasCustomSkipDay;
+    SLDay customSkipDay;
+    int hasHoliday;
+    SLDay holidayDay;
+    const char *holidayName;
+    int hasSkipRule;
+    SLDay skipRuleDay;
+    size_t skipRuleIndex;
+} SLTestSkipExplanation;
+
+// Compiles a skip rule from the values that are stored in the preferences (where the end date can be NULL), returning 0 if the rule is not
+// valid.  This must match SLCompileSkipRule in SLAlarmPrefs.m.
+int SLTestCompileSkipRule(const char *type, const char *startDateString, const char *endDateString, long long interval, long long weekdays,
+                          long long weekday, long long ordinal, SLSkipRule *skipRule);
+
+// adds the given custom skip date string to the given skip dates, returning 0 if the string is not a valid date or there is no room for it
+int SLTestSkipDatesAddCustomSkipDateString(SLTestSkipDates *skipDates, const char *dateString);
+
+// adds the given holiday selection of the resource with the given name to the given skip dates, returning 0 if there is no room for it
+int SLTestSkipDatesAddHolidaySelection(SLTestSkipDates *skipDates, const char *resourceName, uint64_t holidaySelection);
+
+// Adds the given compiled skip rule to the given skip dates along with its exception date strings (any of which that are not valid dates
+// are ignored), returning 0 if there is no room for it.
+int SLTestSkipDatesAddSkipRule(SLTestSkipDates *skipDates, const SLSkipRule *skipRule, const char *const *exceptionStrings,
+                               size_t numExceptionStrings);
+
+// Compiles the given skip dates dictionary from the preferences into the given skip dates, ignoring any skip rules that are not valid like
+// SLAlarmPrefs does.  Returns 0 if the dictionary does not fit.
+int SLTestSkipDatesFromPlist(const SLTestPlistNode *skipDatesDictionary, SLTestSkipDates *skipDates);
+
+// returns the first reason that the given skip dates are skipped on the given day (in the order of shouldSkipOnDate: in SLAlarmPrefs.m)
+SLTestSkipReason SLTestSkipDatesReasonOnDay(const SLTestSkipDates *skipDates, SLTestHolidayCalendar *calendar, SLDay day);
+
+// Fills in the given explanation with the first day of each kind of skip date on or after the given day, where the holidays are searched
+// through the given last day.  Ties are broken by the order of the holiday selections and of the skip rules.
+void SLTestSkipDatesExplanation(const SLTestSkipDates *skipDates, SLTestHolidayCalendar *calendar, SLDay today, SLDay lastHolidayDay,
+                                SLTestSkipExplanation *explanation);
+
+#endif /* SLTestSkipDates_h */
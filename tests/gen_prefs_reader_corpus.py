@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+import os
+import plistlib
+
+# Writes the corpus of preferences files for SLPrefsReaderTests, where every file is written in both the XML and binary formats along
+# with the expected result of finding each alarm Id.  The expectations are derived from the same preferences that are written, so the
+# reader is checked against plistlib rather than against itself.  Run from the root of the repository: python3 tests/gen_prefs_reader_corpus.py
+
+CORPUS_PATH = "tests/fixtures/prefs_reader"
+
+# the scalar fields of an alarm that are read by the reader, in the order of SLPrefsAlarmRecord
+RECORD_FIELDS = ["snoozeTimeHour", "snoozeTimeMinute", "snoozeTimeSecond", "skipEnabled", "skipTimeHour", "skipTimeMinute",
+                 "skipTimeSecond", "skipActivatedStatus", "autoSetOption", "autoSetOffsetOption", "autoSetOffsetHour",
+                 "autoSetOffsetMinute"]
+
+# an alarm Id that is longer than kSLPrefsReaderMaxStringLength, which the reader rejects
+LONG_ALARM_ID = "L" * 300
+
+# the Ids of the alarms that are placed before the other alarms so that the file is larger than the read buffer of the reader
+FILLER_ALARM_IDS = ["filler-{0:03d}".format(i) for i in range(60)]
+
+# returns an alarm with every scalar field set, starting from the given value
+def full_alarm(alarm_id, first_value, **extra):
+    alarm = {"alarmId": alarm_id}
+    for i, field in enumerate(RECORD_FIELDS):
+        alarm[field] = first_value + i
+    alarm["skipEnabled"] = True
+    alarm.update(extra)
+    return alarm
+
+# the preferences that exercise the reader, where the target alarms are placed after enough other alarms to cross the read buffer
+def alarms_prefs():
+    filler = [full_alarm(alarm_id, i, skipDates={"customSkipDateStrings": ["2026-12-25"], "holidaySkipDates": {}})
+              for i, alarm_id in enumerate(FILLER_ALARM_IDS)]
+    return {
+        "schemaVersion": 3,
+        # the skip profiles come before the alarms and contain an alarm Id that must not be found
+        "skipProfiles": [{"skipProfileId": "P1", "name": "Work & <Home>", "alarmId": "decoy-in-profile",
+                          "skipDates": {"customSkipDateStrings": [], "holidaySkipDates": {"us_holidays": 4609}}}],
+        "Alarms": filler + [
+            "not an alarm",
+            {},
+            {"alarmId": 42, "snoozeTimeHour": 9},
+            full_alarm("A&B <alarm>", 1, skipDates={"customSkipDateStrings": ["2026-11-26"], "holidaySkipDates": {"us_holidays": 4609},
+                                                     "skipRules": [{"type": "weekly", "alarmId": "decoy-in-rule"}]}),
+            # the alarm Id does not come first, and the values include negative numbers and a skip profile
+            {"snoozeTimeHour": 2, "autoSetOffsetHour": -2, "alarmId": "Réveil ⏰ 7:00", "skipEnabled": False,
+             "skipProfileId": "P1", "autoSetOption": 1},
+            # values that were written as reals are truncated, and booleans can be stored for numbers
+            {"alarmId": "reals", "snoozeTimeMinute": 7.9, "skipTimeHour": -1.5, "skipActivatedStatus": True},
+            {"alarmId": "last-alarm"},
+        ],
+        "trailingKey": ["after", "the", "alarms"],
+    }
+
+# returns the expectation line for finding the given alarm Id, where the record is only listed for alarms that are found
+def expectation(status, alarm_id, alarm=None):
+    fields = []
+    if alarm is not None:
+        fields = ["{0}={1}".format(field, int(alarm.get(field, 0))) for field in RECORD_FIELDS]
+        fields.append("hasSkipDates={0}".format(int("skipDates" in alarm)))
+        fields.append("hasSkipProfileId={0}".format(int("skipProfileId" in alarm)))
+    return "\t".join([status, alarm_id] + fields)
+
+# returns the expectations for finding the alarms in the given preferences (other than the filler alarms in the middle), along with the Ids
+# that must not be found
+def expectations_for_prefs(prefs):
+    lines = []
+    for alarm in prefs.get("Alarms", []):
+        if isinstance(alarm, dict) and isinstance(alarm.get("alarmId"), str) and alarm["alarmId"] not in FILLER_ALARM_IDS[1:-1]:
+            lines.append(expectation("found", alarm["alarmId"], alarm))
+    for alarm_id in ["decoy-in-profile", "decoy-in-rule", "42", "missing", ""]:
+        lines.append(expectation("notFound", alarm_id))
+    lines.append(expectation("invalid", LONG_ALARM_ID))
+    return lines
+
+# writes the given data to the corpus file with the given name along with the given expectations
+def write_corpus_file(file_name, data, lines):
+    with open(os.path.join(CORPUS_PATH, file_name), 'wb') as fp:
+        fp.write(data)
+    header = "# the expected results of finding each alarm Id in {0}, which are generated by gen_prefs_reader_corpus.py".format(file_name)
+    with open(os.path.join(CORPUS_PATH, os.path.splitext(file_name)[0] + ".txt"), 'w', encoding='utf-8') as fp:
+        fp.write("\n".join([header] + lines) + "\n")
+
+def write_corpus():
+    os.makedirs(CORPUS_PATH, exist_ok=True)
+    for name, prefs in [("alarms", alarms_prefs()), ("no_alarms", {"schemaVersion": 3}), ("empty_alarms", {"Alarms": []})]:
+        lines = expectations_for_prefs(prefs)
+        write_corpus_file(name + "_xml.plist", plistlib.dumps(prefs, fmt=plistlib.FMT_XML, sort_keys=False), lines)
+        write_corpus_file(name + "_binary.plist", plistlib.dumps(prefs, fmt=plistlib.FMT_BINARY, sort_keys=False), lines)
+
+    # A file that was truncated just after the first alarm can still find that alarm (since the reading stops there), but not any of the
+    # alarms after it.  A truncated binary file does not have its trailer, so nothing can be found.
+    prefs = {"Alarms": [full_alarm("first", 1), full_alarm("second", 2)]}
+    xml = plistlib.dumps(prefs, fmt=plistlib.FMT_XML, sort_keys=False)
+    truncated_xml = xml[:xml.index(b"second") - 20]
+    write_corpus_file("truncated_xml.plist", truncated_xml, [expectation("found", "first", prefs["Alarms"][0]),
+                                                             expectation("invalid", "second"), expectation("invalid", "missing")])
+    binary = plistlib.dumps(prefs, fmt=plistlib.FMT_BINARY, sort_keys=False)
+    write_corpus_file("truncated_binary.plist", binary[:len(binary) // 2], [expectation("invalid", "first"),
+                                                                             expectation("invalid", "missing")])
+    write_corpus_file("not_a_plist.plist", b"alarmId = first\n", [expectation("invalid", "first")])
+
+if __name__== "__main__":
+    write_corpus()
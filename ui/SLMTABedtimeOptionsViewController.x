@@ -10,7 +10,7 @@
 #import "custom/SLSnoozeTimeViewController.h"
 #import "../common/SLPrefsManager.h"
 #import "../common/SLLocalizedStrings.h"
-#import "../common/SLCompatibilityHelper.h"
+#import "../common/ui/SLCompatibilityHelper+UserInterface.h"
 
 // define an enum to reference the sections of the table view
 typedef enum SLBedtimeOptionsViewControllerSection : NSUInteger {
@@ -290,10 +290,12 @@ static NSString * const kSLBedtimeOptionsViewControllerSleeperSectionCellReuseId
 
 // create a new delegate method for when the skip dates controller has updated skip dates
 %new
-- (void)SLSkipDatesViewController:(SLSkipDatesViewController *)skipDatesViewController didUpdateCustomSkipDates:(NSArray *)customSkipDates holidaySkipDates:(NSDictionary *)holidaySkipDates
+- (void)SLSkipDatesViewController:(SLSkipDatesViewController *)skipDatesViewController didUpdateCustomSkipDates:(NSArray *)customSkipDates holidaySkipDates:(NSDictionary *)holidaySkipDates skipRules:(NSArray *)skipRules skipProfileId:(NSString *)skipProfileId
 {
     self.SLAlarmPrefs.customSkipDates = customSkipDates;
     self.SLAlarmPrefs.holidaySkipDates = holidaySkipDates;
+    self.SLAlarmPrefs.skipRules = skipRules;
+    self.SLAlarmPrefs.skipProfileId = skipProfileId;
 
     // reload the cell that contains the skip dates
     [self.tableView reloadRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:kSLBedtimeOptionsViewControllerSleeperSectionRowSkipDates
@@ -8,7 +8,7 @@
 
 #import "SLUserInterfaceHeaders.h"
 #import "../common/SLCommonHeaders.h"
-#import "../common/SLCompatibilityHelper.h"
+#import "../common/ui/SLCompatibilityHelper+UserInterface.h"
 
 // interface for the sleep alarm (i.e. Bedtime) view controller
 @interface MTABedtimeViewController : UIViewController
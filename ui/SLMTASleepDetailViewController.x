@@ -9,7 +9,7 @@
 #import "../common/SLCommonHeaders.h"
 #import "../common/SLAlarmPrefs.h"
 #import "../common/SLPrefsManager.h"
-#import "../common/SLCompatibilityHelper.h"
+#import "../common/ui/SLCompatibilityHelper+UserInterface.h"
 
 // define an enum to reference the sections of the table view
 typedef enum SLSleepDetailViewControllerSection : NSUInteger {
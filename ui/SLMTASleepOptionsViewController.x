@@ -11,7 +11,7 @@
 #import "custom/SLSkipDatesViewController.h"
 #import "../common/SLCommonHeaders.h"
 #import "../common/SLAlarmPrefs.h"
-#import "../common/SLCompatibilityHelper.h"
+#import "../common/ui/SLCompatibilityHelper+UserInterface.h"
 #import "../common/SLLocalizedStrings.h"
 
 // define an enum to reference the sections of the table view
@@ -304,10 +304,12 @@ static NSString * const kSLSleepOptionsViewControllerSleeperSectionCellReuseIden
 
 // create a new delegate method for when the skip dates controller has updated skip dates
 %new
-- (void)SLSkipDatesViewController:(SLSkipDatesViewController *)skipDatesViewController didUpdateCustomSkipDates:(NSArray *)customSkipDates holidaySkipDates:(NSDictionary *)holidaySkipDates
+- (void)SLSkipDatesViewController:(SLSkipDatesViewController *)skipDatesViewController didUpdateCustomSkipDates:(NSArray *)customSkipDates holidaySkipDates:(NSDictionary *)holidaySkipDates skipRules:(NSArray *)skipRules skipProfileId:(NSString *)skipProfileId
 {
     self.SLAlarmPrefs.customSkipDates = customSkipDates;
     self.SLAlarmPrefs.holidaySkipDates = holidaySkipDates;
+    self.SLAlarmPrefs.skipRules = skipRules;
+    self.SLAlarmPrefs.skipProfileId = skipProfileId;
 
     // reload the cell that contains the skip dates
     [self.tableView reloadRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:kSLSleepOptionsViewControllerSleeperSectionRowSkipDates
@@ -9,7 +9,7 @@
 #import "../common/SLCommonHeaders.h"
 #import "../common/SLAlarmPrefs.h"
 #import "../common/SLPrefsManager.h"
-#import "../common/SLCompatibilityHelper.h"
+#import "../common/ui/SLCompatibilityHelper+UserInterface.h"
 
 // interface for the sleep alarm view controller
 @interface MTSleepAlarmViewController : UIViewController
@@ -8,7 +8,7 @@
 
 #import "SLAutoSetOptionsTableViewController.h"
 #import "SLPartialModalPresentationController.h"
-#import "../../common/SLCompatibilityHelper.h"
+#import "../../common/ui/SLCompatibilityHelper+UserInterface.h"
 #import "../../common/SLLocalizedStrings.h"
 
 // define the reuse identifier for the cells in this table
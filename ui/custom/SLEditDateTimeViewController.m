@@ -6,7 +6,7 @@
 //
 
 #import "SLEditDateTimeViewController.h"
-#import "../../common/SLCompatibilityHelper.h"
+#import "../../common/ui/SLCompatibilityHelper+UserInterface.h"
 #import "../../common/SLLocalizedStrings.h"
 
 // define constants for the view dictionary when creating constraints
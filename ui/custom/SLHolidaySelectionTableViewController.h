@@ -17,17 +17,22 @@ NS_ASSUME_NONNULL_BEGIN
 // delegate that will notify the object that holidays have been updated
 @protocol SLHolidaySelectionDelegate <NSObject>
 
-// passes the updated holiday selections for the holiday country
+// Passes the updated holiday selections for the holiday country.  The parent holiday selection is the updated selection of the country
+// that a subdivision belongs to (since the holidays that a subdivision observes from its country are selected for the country), which
+// is the same as the holiday selection for a country.
 - (void)SLHolidaySelectionTableViewController:(SLHolidaySelectionTableViewController *)holidaySelectionTableViewController
-                    didUpdateSelectedHolidays:(NSArray *)selectedHolidays
+                    didUpdateHolidaySelection:(SLHolidaySelection)holidaySelection
+                      parentHolidaySelection:(SLHolidaySelection)parentHolidaySelection
                             forHolidayCountry:(SLHolidayCountry)holidayCountry;
 
 @end
 
 @interface SLHolidaySelectionTableViewController : UITableViewController
 
-// initialize this controller with the selected holidays and available holidays for a given holiday country
-- (instancetype)initWithSelectedHolidays:(NSArray *)selectedHolidays holidayResource:(NSDictionary *)holidayResource inHolidayCountry:(SLHolidayCountry)holidayCountry;
+// Initialize this controller with the selected holidays and available holidays for a given holiday country, along with the selected
+// holidays of the country that a subdivision belongs to (which is ignored for a country).
+- (instancetype)initWithHolidaySelection:(SLHolidaySelection)holidaySelection parentHolidaySelection:(SLHolidaySelection)parentHolidaySelection
+                         holidayResource:(NSDictionary *)holidayResource inHolidayCountry:(SLHolidayCountry)holidayCountry;
 
 // the delegate of this view controller
 @property (nonatomic, weak) id <SLHolidaySelectionDelegate> delegate;
@@ -8,8 +8,9 @@
 
 #import "SLHolidaySelectionTableViewController.h"
 #import "SLSkipDatesViewController.h"
-#import "../../common/SLCompatibilityHelper.h"
+#import "../../common/ui/SLCompatibilityHelper+UserInterface.h"
 #import "../../common/SLLocalizedStrings.h"
+#import "../../common/SLHolidayManager.h"
 
 // define the reuse identifier for the cells in this table
 #define kSLHolidayTableViewCellIdentifier               @"SLHolidayTableViewCell"
@@ -23,8 +24,11 @@
 
 @interface SLHolidaySelectionTableViewController ()
 
-// the array of selected holidays to be displayed
-@property (nonatomic, strong) NSMutableArray *selectedHolidays;
+// the set of selected holiday IDs to be displayed
+@property (nonatomic) SLHolidaySelection holidaySelection;
+
+// the set of selected holiday IDs of the country that a subdivision belongs to, which are used for the inherited holidays
+@property (nonatomic) SLHolidaySelection parentHolidaySelection;
 
 // the available holidays for this country (loaded from the bundle resource)
 @property (nonatomic, strong) NSArray *availableHolidays;
@@ -36,12 +40,15 @@
 
 @implementation SLHolidaySelectionTableViewController
 
-// initialize this controller with the selected holidays and available holidays for a given holiday country
-- (instancetype)initWithSelectedHolidays:(NSArray *)selectedHolidays holidayResource:(NSDictionary *)holidayResource inHolidayCountry:(SLHolidayCountry)holidayCountry
+// Initialize this controller with the selected holidays and available holidays for a given holiday country, along with the selected
+// holidays of the country that a subdivision belongs to (which is ignored for a country).
+- (instancetype)initWithHolidaySelection:(SLHolidaySelection)holidaySelection parentHolidaySelection:(SLHolidaySelection)parentHolidaySelection
+                         holidayResource:(NSDictionary *)holidayResource inHolidayCountry:(SLHolidayCountry)holidayCountry
 {
     self = [super initWithStyle:UITableViewStyleGrouped];
     if (self) {
-        self.selectedHolidays = [[NSMutableArray alloc] initWithArray:selectedHolidays];
+        self.holidaySelection = holidaySelection;
+        self.parentHolidaySelection = holidayCountry < kSLHolidayCountryNumCountries ? holidaySelection : parentHolidaySelection;
         self.availableHolidays = [holidayResource objectForKey:kSLHolidayHolidaysKey];
         self.holidayCountry = holidayCountry;
     }
@@ -71,14 +78,15 @@
     // change all of the holidays/cells that were previously selected
     NSMutableArray *indexPathsToReload = [[NSMutableArray alloc] init];
     for (NSInteger i = 0; i < self.availableHolidays.count; i++) {
-        NSDictionary *holiday = [self.availableHolidays objectAtIndex:i];
-        for (NSString *selectedHolidayName in self.selectedHolidays) {
-            if ([selectedHolidayName isEqualToString:[holiday objectForKey:kSLHolidayNameKey]]) {
-                [indexPathsToReload addObject:[NSIndexPath indexPathForRow:i inSection:0]];
-            }
+        if ([self isHolidayAtIndexSelected:i]) {
+            [indexPathsToReload addObject:[NSIndexPath indexPathForRow:i inSection:0]];
+            [self setHolidayAtIndex:i selected:NO];
         }
     }
-    [self.selectedHolidays removeAllObjects];
+    self.holidaySelection = 0;
+    if (self.holidayCountry < kSLHolidayCountryNumCountries) {
+        self.parentHolidaySelection = 0;
+    }
     [self.tableView reloadRowsAtIndexPaths:indexPathsToReload withRowAnimation:UITableViewRowAnimationAutomatic];
 }
 
@@ -89,11 +97,47 @@
     if (!parent && self.delegate && [self.delegate conformsToProtocol:@protocol(SLHolidaySelectionDelegate)]) {
         // tell the delegate about the updated skip dates
         [self.delegate SLHolidaySelectionTableViewController:self
-                                   didUpdateSelectedHolidays:[self.selectedHolidays copy]
+                                   didUpdateHolidaySelection:self.holidaySelection
+                                     parentHolidaySelection:self.parentHolidaySelection
                                            forHolidayCountry:self.holidayCountry];
     }
 }
 
+// returns the holiday selection that only contains the available holiday at the given index
+- (SLHolidaySelection)holidaySelectionForHolidayAtIndex:(NSInteger)index
+{
+    NSUInteger holidayId = [[[self.availableHolidays objectAtIndex:index] objectForKey:kSLHolidayIdKey] unsignedIntegerValue];
+    return holidayId < kSLHolidayMaxHolidayIds ? SLHolidaySelectionForHolidayId(holidayId) : 0;
+}
+
+// returns whether or not the available holiday at the given index is a holiday that a subdivision observes from its country
+- (BOOL)isHolidayAtIndexInherited:(NSInteger)index
+{
+    return [[[self.availableHolidays objectAtIndex:index] objectForKey:kSLHolidayInheritedKey] boolValue];
+}
+
+// returns whether or not the available holiday at the given index is selected
+- (BOOL)isHolidayAtIndexSelected:(NSInteger)index
+{
+    SLHolidaySelection holidaySelection = [self isHolidayAtIndexInherited:index] ? self.parentHolidaySelection : self.holidaySelection;
+    return (holidaySelection & [self holidaySelectionForHolidayAtIndex:index]) != 0;
+}
+
+// Adds or removes the ID of the available holiday at the given index from the selection.  An inherited holiday is selected for the
+// country, while the selection of a country is kept the same as its parent holiday selection.
+- (void)setHolidayAtIndex:(NSInteger)index selected:(BOOL)selected
+{
+    SLHolidaySelection holidaySelection = [self holidaySelectionForHolidayAtIndex:index];
+    if ([self isHolidayAtIndexInherited:index]) {
+        self.parentHolidaySelection = selected ? self.parentHolidaySelection | holidaySelection : self.parentHolidaySelection & ~holidaySelection;
+    } else {
+        self.holidaySelection = selected ? self.holidaySelection | holidaySelection : self.holidaySelection & ~holidaySelection;
+        if (self.holidayCountry < kSLHolidayCountryNumCountries) {
+            self.parentHolidaySelection = self.holidaySelection;
+        }
+    }
+}
+
 // allow this view controller to be shown even when the device is in secure mode
 - (BOOL)_canShowWhileLocked
 {
@@ -163,27 +207,24 @@
 - (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
 {
     // set the selection for this cell if it should be selected
-    for (NSString *selectedHolidayName in self.selectedHolidays) {
-        if ([selectedHolidayName isEqualToString:[[self.availableHolidays objectAtIndex:indexPath.row] objectForKey:kSLHolidayNameKey]]) {
-            [cell setSelected:YES animated:NO];
-            [tableView selectRowAtIndexPath:indexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
-            break;
-        }
+    if ([self isHolidayAtIndexSelected:indexPath.row]) {
+        [cell setSelected:YES animated:NO];
+        [tableView selectRowAtIndexPath:indexPath animated:NO scrollPosition:UITableViewScrollPositionNone];
     }
 }
 
 // handle cell selection
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    // add the name of the holiday to the selected array
-    [self.selectedHolidays addObject:[[self.availableHolidays objectAtIndex:indexPath.row] objectForKey:kSLHolidayNameKey]];
+    // add the ID of the holiday to the selection
+    [self setHolidayAtIndex:indexPath.row selected:YES];
 }
 
 // handle cell deselection
 - (void)tableView:(UITableView *)tableView didDeselectRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    // remove the name of the selected holiday from the selected array
-    [self.selectedHolidays removeObject:[[self.availableHolidays objectAtIndex:indexPath.row] objectForKey:kSLHolidayNameKey]];
+    // remove the ID of the holiday from the selection
+    [self setHolidayAtIndex:indexPath.row selected:NO];
 }
 
 // calculate the height for the cell based on the text provided
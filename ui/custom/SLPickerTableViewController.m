@@ -8,7 +8,7 @@
 
 #import "SLPickerTableViewController.h"
 #import "../../common/SLLocalizedStrings.h"
-#import "../../common/SLCompatibilityHelper.h"
+#import "../../common/ui/SLCompatibilityHelper+UserInterface.h"
 
 // define constants for the view dictionary when creating constraints
 static NSString *const kSLTimePickerViewKey =       @"timePickerView";
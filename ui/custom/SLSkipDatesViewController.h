@@ -18,14 +18,16 @@ NS_ASSUME_NONNULL_BEGIN
 // delegate that will notify the object that skip dates have been updated
 @protocol SLSkipDatesDelegate <NSObject>
 
-// passes the updated picker times to the delegate
+// passes the updated skip dates to the delegate, along with the Id of the skip profile that the alarm uses (if any)
 - (void)SLSkipDatesViewController:(SLSkipDatesViewController *)skipDatesViewController
          didUpdateCustomSkipDates:(NSArray *)customSkipDates
-                 holidaySkipDates:(NSDictionary *)holidaySkipDates;
+                 holidaySkipDates:(NSDictionary *)holidaySkipDates
+                        skipRules:(NSArray *)skipRules
+                    skipProfileId:(nullable NSString *)skipProfileId;
 
 @end
 
-@interface SLSkipDatesViewController : UITableViewController <SLEditDateTimeViewControllerDelegate, SLHolidaySelectionDelegate, UIViewControllerTransitioningDelegate>
+@interface SLSkipDatesViewController : UITableViewController <SLEditDateTimeViewControllerDelegate, SLHolidaySelectionDelegate, UIViewControllerTransitioningDelegate, UIDocumentPickerDelegate>
 
 // initialize this controller with the preferences for the given alarm
 - (instancetype)initWithAlarmPrefs:(SLAlarmPrefs *)alarmPrefs;
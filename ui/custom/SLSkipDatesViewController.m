@@ -9,13 +9,14 @@
 #import "SLPartialModalPresentationController.h"
 #import "../../common/SLPrefsManager.h"
 #import "../../common/SLLocalizedStrings.h"
-#import "../../common/SLCompatibilityHelper.h"
+#import "../../common/ui/SLCompatibilityHelper+UserInterface.h"
 
 // define the reuse identifier for the cells in this table
 #define kSLSkipDateTableViewCellIdentifier              @"SLSkipDateTableViewCell"
 #define kSLAddNewDateTableViewCellIdentifier            @"SLAddNewDateTableViewCell"
 #define kSLResetDefaultTableViewCellIdentifier          @"SLResetDefaultTableViewCell"
 #define kSLCountriesTableViewCellIdentifier             @"SLCountriesTableViewCell"
+#define kSLSkipProfileTableViewCellIdentifier           @"SLSkipProfileTableViewCell"
 
 // enum that defines the sections that will be used in this table
 typedef enum SLSkipDatesViewControllerSection : NSInteger {
@@ -23,6 +24,7 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     kSLSkipDatesViewControllerSectionAddDate,
     kSLSkipDatesViewControllerSectionRecommendedHolidays,
     kSLSkipDatesViewControllerSectionAllHolidays,
+    kSLSkipDatesViewControllerSectionSkipProfile,
     kSLSkipDatesViewControllerSectionResetDefault,
     kSLSkipDatesViewControllerSectionNumSections
 } SLSkipDatesViewControllerSection;
@@ -35,6 +37,13 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
 // the dictionary containing the holiday skip dates for this alarm
 @property (nonatomic, strong) NSMutableDictionary *holidaySkipDates;
 
+// the recurring skip rules for this alarm, which are only replaced when a skip profile is selected
+@property (nonatomic, strong) NSArray *skipRules;
+
+// the Id and name of the skip profile that is used for this alarm, or nil if the alarm uses its own skip dates
+@property (nonatomic, strong) NSString *skipProfileId;
+@property (nonatomic, strong) NSString *skipProfileName;
+
 // dictionary of all available holiday country resources
 @property (nonatomic, strong) NSDictionary *holidayResources;
 
@@ -68,25 +77,36 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
         self.alarmPrefs = alarmPrefs;
         self.customSkipDates = [[NSMutableArray alloc] initWithArray:alarmPrefs.customSkipDates];
         self.holidaySkipDates = [[NSMutableDictionary alloc] initWithDictionary:alarmPrefs.holidaySkipDates];
+        self.skipRules = alarmPrefs.skipRules;
         self.deviceHolidayCountry = -1;
 
+        // find the name of the skip profile that is used by the alarm
+        if (alarmPrefs.skipProfileId != nil) {
+            for (NSDictionary *skipProfile in [SLPrefsManager allSkipProfiles]) {
+                if ([[skipProfile objectForKey:kSLSkipProfileIdKey] isEqualToString:alarmPrefs.skipProfileId]) {
+                    self.skipProfileId = alarmPrefs.skipProfileId;
+                    self.skipProfileName = [skipProfile objectForKey:kSLSkipProfileNameKey];
+                    break;
+                }
+            }
+        }
+
         // Populate a dictionary of all available holiday resource objects.  Also use this as an opportunity to check to see
         // if this device has any recommended holidays
-        NSString *deviceCountryCode = [[NSLocale currentLocale] objectForKey:NSLocaleCountryCode];
-        NSMutableDictionary *holidayResources = [[NSMutableDictionary alloc] initWithCapacity:kSLHolidayCountryNumCountries];
-        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumCountries; holidayCountry++) {
+        NSMutableDictionary *holidayResources = [[NSMutableDictionary alloc] initWithCapacity:kSLHolidayCountryNumRegions];
+        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
             // grab the resource for the holiday country
-            NSString *countryCode = [SLPrefsManager countryCodeForHolidayCountry:holidayCountry];
-            NSString *resourceName = [SLPrefsManager resourceNameForCountryCode:countryCode];
+            NSString *resourceName = kSLHolidayCountryInfo[holidayCountry].resourceName;
             NSDictionary *holidayResource = [SLPrefsManager holidayResourceForResourceName:resourceName];
             [holidayResources setObject:holidayResource forKey:resourceName];
-
-            // check to see if the country code matches the device's country code
-            if ([deviceCountryCode caseInsensitiveCompare:countryCode] == NSOrderedSame) {
-                self.deviceHolidayCountry = holidayCountry;
-            }
         }
         self.holidayResources = [holidayResources copy];
+
+        // the device's country code is an ISO code, which does not always match the code used for the holiday resource
+        SLHolidayCountry deviceHolidayCountry = SLHolidayCountryForCountryCode([[NSLocale currentLocale] objectForKey:NSLocaleCountryCode]);
+        if (deviceHolidayCountry < kSLHolidayCountryNumCountries) {
+            self.deviceHolidayCountry = deviceHolidayCountry;
+        }
     }
     return self;
 }
@@ -151,7 +171,9 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
         // tell the delegate about the updated skip dates
         [self.delegate SLSkipDatesViewController:self
                         didUpdateCustomSkipDates:[self.customSkipDates copy]
-                                holidaySkipDates:[self.holidaySkipDates copy]];
+                                holidaySkipDates:[self.holidaySkipDates copy]
+                                       skipRules:self.skipRules
+                                   skipProfileId:self.skipProfileId];
     }
 }
 
@@ -237,6 +259,14 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
                                                                     }];
     [selectDateAlertController addAction:skipDateRangeAlertAction];
 
+    // create an action that will let the user import the all-day events from a calendar file
+    UIAlertAction *importCalendarAlertAction = [UIAlertAction actionWithTitle:kSLImportCalendarString
+                                                                        style:UIAlertActionStyleDefault
+                                                                      handler:^(UIAlertAction * _Nonnull action) {
+                                                                          [self presentCalendarDocumentPicker];
+                                                                    }];
+    [selectDateAlertController addAction:importCalendarAlertAction];
+
     // create an action that will close the alert
     UIAlertAction *closeAlertAction = [UIAlertAction actionWithTitle:kSLCancelString
                                                                style:UIAlertActionStyleCancel
@@ -264,6 +294,125 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     [self presentViewController:selectDateAlertController animated:YES completion:nil];
 }
 
+// presents the alert controller (shown as an action sheet) that lets the user pick the skip profile that is used for this alarm
+- (void)presentSkipProfileAlertControllerFromIndexPath:(NSIndexPath *)indexPath
+{
+    UIAlertController *skipProfileAlertController = [UIAlertController alertControllerWithTitle:kSLSkipProfileString
+                                                                                        message:nil
+                                                                                 preferredStyle:UIAlertControllerStyleActionSheet];
+
+    // create an action for each of the existing skip profiles, which will replace the skip dates with the ones from the profile
+    for (NSDictionary *skipProfile in [SLPrefsManager allSkipProfiles]) {
+        NSString *skipProfileId = [skipProfile objectForKey:kSLSkipProfileIdKey];
+        if ([skipProfileId isEqualToString:self.skipProfileId]) {
+            continue;
+        }
+        UIAlertAction *skipProfileAlertAction = [UIAlertAction actionWithTitle:[skipProfile objectForKey:kSLSkipProfileNameKey]
+                                                                         style:UIAlertActionStyleDefault
+                                                                       handler:^(UIAlertAction * _Nonnull action) {
+                                                                           [self useSkipProfile:skipProfile];
+                                                                       }];
+        [skipProfileAlertController addAction:skipProfileAlertAction];
+    }
+
+    // create an action that will create a new skip profile from the current skip dates
+    UIAlertAction *newSkipProfileAlertAction = [UIAlertAction actionWithTitle:kSLNewSkipProfileString
+                                                                        style:UIAlertActionStyleDefault
+                                                                      handler:^(UIAlertAction * _Nonnull action) {
+                                                                          [self presentNewSkipProfileAlertController];
+                                                                      }];
+    [skipProfileAlertController addAction:newSkipProfileAlertAction];
+
+    // create an action that will stop using the skip profile, keeping a copy of the skip dates for this alarm
+    if (self.skipProfileId != nil) {
+        UIAlertAction *stopUsingSkipProfileAlertAction = [UIAlertAction actionWithTitle:kSLStopUsingSkipProfileString
+                                                                                  style:UIAlertActionStyleDestructive
+                                                                                handler:^(UIAlertAction * _Nonnull action) {
+                                                                                    self.skipProfileId = nil;
+                                                                                    self.skipProfileName = nil;
+                                                                                    [self.tableView reloadSections:[NSIndexSet indexSetWithIndex:kSLSkipDatesViewControllerSectionSkipProfile]
+                                                                                                  withRowAnimation:UITableViewRowAnimationFade];
+                                                                                }];
+        [skipProfileAlertController addAction:stopUsingSkipProfileAlertAction];
+    }
+
+    // create an action that will close the alert
+    UIAlertAction *closeAlertAction = [UIAlertAction actionWithTitle:kSLCancelString
+                                                               style:UIAlertActionStyleCancel
+                                                             handler:nil];
+    [skipProfileAlertController addAction:closeAlertAction];
+
+    // if the popover presentation controller exists, then we require one for this device (iPad)
+    if (skipProfileAlertController.popoverPresentationController != nil && indexPath != nil) {
+        UITableViewCell *skipProfileCell = [self.tableView cellForRowAtIndexPath:indexPath];
+        if (skipProfileCell != nil) {
+            skipProfileAlertController.popoverPresentationController.sourceView = skipProfileCell.contentView;
+            skipProfileAlertController.popoverPresentationController.sourceRect = skipProfileCell.contentView.bounds;
+        }
+    }
+
+    // modify the subviews of the alert controller if necessary
+    if (kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
+        [SLCompatibilityHelper updateSubviewsForAlertController:skipProfileAlertController];
+    }
+
+    [self presentViewController:skipProfileAlertController animated:YES completion:nil];
+}
+
+// presents an alert that asks the user for the name of a new skip profile, which is created from the current skip dates
+- (void)presentNewSkipProfileAlertController
+{
+    UIAlertController *newSkipProfileAlertController = [UIAlertController alertControllerWithTitle:kSLNewSkipProfileString
+                                                                                           message:nil
+                                                                                    preferredStyle:UIAlertControllerStyleAlert];
+    [newSkipProfileAlertController addTextFieldWithConfigurationHandler:^(UITextField * _Nonnull textField) {
+        textField.placeholder = kSLSkipProfileNameString;
+        textField.autocapitalizationType = UITextAutocapitalizationTypeWords;
+    }];
+
+    // create an action that will create the profile and use it for this alarm
+    __weak UIAlertController *weakNewSkipProfileAlertController = newSkipProfileAlertController;
+    UIAlertAction *saveAlertAction = [UIAlertAction actionWithTitle:kSLSaveString
+                                                              style:UIAlertActionStyleDefault
+                                                            handler:^(UIAlertAction * _Nonnull action) {
+                                                                NSString *name = [weakNewSkipProfileAlertController.textFields.firstObject.text stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+                                                                if (name.length == 0) {
+                                                                    name = kSLSkipProfileString;
+                                                                }
+                                                                self.skipProfileId = [SLPrefsManager createSkipProfileWithName:name
+                                                                                                               customSkipDates:[self.customSkipDates copy]
+                                                                                                              holidaySkipDates:[self.holidaySkipDates copy]
+                                                                                                                     skipRules:self.skipRules];
+                                                                self.skipProfileName = name;
+                                                                [self.tableView reloadSections:[NSIndexSet indexSetWithIndex:kSLSkipDatesViewControllerSectionSkipProfile]
+                                                                              withRowAnimation:UITableViewRowAnimationFade];
+                                                            }];
+    [newSkipProfileAlertController addAction:saveAlertAction];
+    [newSkipProfileAlertController addAction:[UIAlertAction actionWithTitle:kSLCancelString style:UIAlertActionStyleCancel handler:nil]];
+
+    // modify the subviews of the alert controller if necessary
+    if (kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
+        [SLCompatibilityHelper updateSubviewsForAlertController:newSkipProfileAlertController];
+    }
+
+    [self presentViewController:newSkipProfileAlertController animated:YES completion:nil];
+}
+
+// uses the given skip profile for this alarm, replacing the skip dates, holidays, and skip rules with the ones from the profile
+- (void)useSkipProfile:(NSDictionary *)skipProfile
+{
+    NSDictionary *skipDates = [skipProfile objectForKey:kSLSkipDatesKey];
+    self.skipProfileId = [skipProfile objectForKey:kSLSkipProfileIdKey];
+    self.skipProfileName = [skipProfile objectForKey:kSLSkipProfileNameKey];
+    [self.customSkipDates setArray:[skipDates objectForKey:kSLCustomSkipDateStringsKey] ?: @[]];
+    [self.holidaySkipDates setDictionary:[skipDates objectForKey:kSLHolidaySkipDatesKey] ?: @{}];
+    self.skipRules = [skipDates objectForKey:kSLSkipRulesKey] ?: @[];
+
+    // only show the edit button if there are skip dates to remove
+    self.navigationItem.rightBarButtonItem = self.customSkipDates.count > 0 ? self.editButtonItem : nil;
+    [self.tableView reloadData];
+}
+
 // creates and presents the edit date view controller with the various options
 - (void)presentEditDateViewControllerWithTitle:(NSString *)title initialDate:(NSDate *)initialDate minimumDate:(NSDate *)minimumDate maximumDate:(NSDate *)maximumDate
 {
@@ -276,6 +425,49 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     [self presentViewController:navController animated:YES completion:nil];
 }
 
+// presents the document picker that lets the user choose a calendar file to import
+- (void)presentCalendarDocumentPicker
+{
+    UIDocumentPickerViewController *documentPickerViewController = [[UIDocumentPickerViewController alloc] initWithDocumentTypes:@[@"com.apple.ical.ics", @"public.calendar-event"]
+                                                                                                                          inMode:UIDocumentPickerModeImport];
+    documentPickerViewController.delegate = self;
+    [self presentViewController:documentPickerViewController animated:YES completion:nil];
+}
+
+// imports the calendar file at the given URL into the custom skip dates
+- (void)importCalendarFileAtURL:(NSURL *)url
+{
+    // the calendar is parsed in the background since the file could contain thousands of events
+    NSArray *customSkipDates = [self.customSkipDates copy];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSInteger numImportedDates = 0;
+        NSArray *mergedSkipDates = [SLPrefsManager customSkipDateStrings:customSkipDates
+                                           byImportingCalendarFileAtPath:url.path
+                                                        numImportedDates:&numImportedDates];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (mergedSkipDates == nil) {
+                UIAlertController *importFailedAlertController = [UIAlertController alertControllerWithTitle:kSLImportCalendarString
+                                                                                                     message:kSLImportCalendarFailedString
+                                                                                              preferredStyle:UIAlertControllerStyleAlert];
+                [importFailedAlertController addAction:[UIAlertAction actionWithTitle:kSLOkString style:UIAlertActionStyleCancel handler:nil]];
+                if (kSLSystemVersioniOS12 || kSLSystemVersioniOS11 || kSLSystemVersioniOS10) {
+                    [SLCompatibilityHelper updateSubviewsForAlertController:importFailedAlertController];
+                }
+                [self presentViewController:importFailedAlertController animated:YES completion:nil];
+            } else if (numImportedDates > 0) {
+                // replace the custom skip dates with the merged dates, which are already sorted
+                [self.customSkipDates setArray:mergedSkipDates];
+                [self.tableView reloadSections:[NSIndexSet indexSetWithIndex:kSLSkipDatesViewControllerSectionDates]
+                              withRowAnimation:UITableViewRowAnimationFade];
+
+                // set the edit button to the right bar button since there are now skip dates to remove
+                self.navigationItem.rightBarButtonItem = self.editButtonItem;
+                [self.tableView setEditing:NO animated:NO];
+            }
+        });
+    });
+}
+
 // creates and presents a confirmation alert that asks the user if they'd really like to clear the skip dates / holidays
 - (void)presentConfirmationAlertControllerWithMessage:(NSString *)message includeHolidays:(BOOL)includeHolidays
 {
@@ -338,14 +530,12 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     // clear out any of the selected holidays if necessary
     if (includeHolidaySelections) {
         NSMutableArray *updatedHolidayCountryIndexPaths = [[NSMutableArray alloc] init];
-        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumCountries; holidayCountry++) {
+        for (SLHolidayCountry holidayCountry = 0; holidayCountry < kSLHolidayCountryNumRegions; holidayCountry++) {
             // get the holidays that correspond to the country's particular resource
             NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
-            NSMutableArray *selectedHolidayNames = [[NSMutableArray alloc] initWithArray:[self.holidaySkipDates objectForKey:resourceName]];
-            if (selectedHolidayNames != nil && selectedHolidayNames.count > 0) {
+            if ([[self.holidaySkipDates objectForKey:resourceName] unsignedLongLongValue] != 0) {
                 // remove all selected holidays
-                [selectedHolidayNames removeAllObjects];
-                [self.holidaySkipDates setObject:selectedHolidayNames forKey:resourceName];
+                [self.holidaySkipDates removeObjectForKey:resourceName];
 
                 // add the corresponding index path to update
                 if (holidayCountry == self.deviceHolidayCountry) {
@@ -505,7 +695,8 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
             }
             break;
         case kSLSkipDatesViewControllerSectionAllHolidays:
-            numRows = kSLHolidayCountryNumCountries;
+            // the subdivisions are listed after all of the countries
+            numRows = kSLHolidayCountryNumRegions;
 
             // remove a row if the device's holiday country is set
             if (self.deviceHolidayCountry != -1) {
@@ -513,6 +704,7 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
             }
             break;
         case kSLSkipDatesViewControllerSectionAddDate:
+        case kSLSkipDatesViewControllerSectionSkipProfile:
         case kSLSkipDatesViewControllerSectionResetDefault:
             numRows = 1;
             break;
@@ -574,6 +766,25 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
         case kSLSkipDatesViewControllerSectionAllHolidays:
             cell = [self tableView:tableView countryCellForHolidayCountry:[self offsetHolidayCountryIndexForIndex:indexPath.row increase:YES]];
             break;
+        case kSLSkipDatesViewControllerSectionSkipProfile: {
+            UITableViewCell *skipProfileCell = [tableView dequeueReusableCellWithIdentifier:kSLSkipProfileTableViewCellIdentifier];
+            if (skipProfileCell == nil) {
+                skipProfileCell = [[UITableViewCell alloc] initWithStyle:UITableViewCellStyleValue1
+                                                         reuseIdentifier:kSLSkipProfileTableViewCellIdentifier];
+                skipProfileCell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
+                skipProfileCell.selectionStyle = UITableViewCellSelectionStyleDefault;
+                skipProfileCell.textLabel.textAlignment = NSTextAlignmentLeft;
+                [self setBackgroundColorsForCell:skipProfileCell];
+            }
+
+            // customize the cell
+            skipProfileCell.textLabel.textColor = [SLCompatibilityHelper defaultLabelColor];
+            skipProfileCell.textLabel.text = kSLSkipProfileString;
+            skipProfileCell.detailTextLabel.text = self.skipProfileName != nil ? self.skipProfileName : kSLNoneString;
+
+            cell = skipProfileCell;
+            break;
+        }
         case kSLSkipDatesViewControllerSectionResetDefault: {
             cell = [self tableView:tableView resetDefaultCellForIndexPath:indexPath];
             break;
@@ -624,7 +835,7 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
     NSDictionary *holidayResource = [self.holidayResources objectForKey:resourceName];
     NSInteger numTotalAvailableHolidays = [[holidayResource objectForKey:kSLHolidayHolidaysKey] count];
-    NSInteger numSelectedHolidays = [[self.holidaySkipDates objectForKey:resourceName] count];
+    NSInteger numSelectedHolidays = [self numberOfSelectedHolidaysForHolidayCountry:holidayCountry];
     if (numSelectedHolidays > 0) {
         countryCell.detailTextLabel.text = [NSString stringWithFormat:@"%ld (%@)", (long)numTotalAvailableHolidays, kSLNumberSelectedString(numSelectedHolidays)];
     } else {
@@ -634,6 +845,29 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     return countryCell;
 }
 
+// Returns the number of the holidays of the given holiday country that are selected.  The holidays that a subdivision observes from its
+// country are counted when they are selected for the country.
+- (NSInteger)numberOfSelectedHolidaysForHolidayCountry:(SLHolidayCountry)holidayCountry
+{
+    NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
+    SLHolidaySelection holidaySelection = [[self.holidaySkipDates objectForKey:resourceName] unsignedLongLongValue];
+    if (holidayCountry < kSLHolidayCountryNumCountries) {
+        return __builtin_popcountll(holidaySelection);
+    }
+
+    NSString *parentResourceName = [SLPrefsManager resourceNameForHolidayCountry:kSLHolidayCountryInfo[holidayCountry].parentCountry];
+    SLHolidaySelection parentHolidaySelection = [[self.holidaySkipDates objectForKey:parentResourceName] unsignedLongLongValue];
+    NSInteger numSelectedHolidays = 0;
+    for (NSDictionary *holiday in [[self.holidayResources objectForKey:resourceName] objectForKey:kSLHolidayHolidaysKey]) {
+        NSUInteger holidayId = [[holiday objectForKey:kSLHolidayIdKey] unsignedIntegerValue];
+        SLHolidaySelection selection = [[holiday objectForKey:kSLHolidayInheritedKey] boolValue] ? parentHolidaySelection : holidaySelection;
+        if (holidayId < kSLHolidayMaxHolidayIds && (selection & SLHolidaySelectionForHolidayId(holidayId))) {
+            ++numSelectedHolidays;
+        }
+    }
+    return numSelectedHolidays;
+}
+
 // sets some default colors for newly created cells
 - (void)setBackgroundColorsForCell:(UITableViewCell *)cell
 {
@@ -717,6 +951,9 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
                 footerTitle = @" ";
             }
             break;
+        case kSLSkipDatesViewControllerSectionSkipProfile:
+            footerTitle = kSLSkipProfileExplanationString;
+            break;
         case kSLSkipDatesViewControllerSectionResetDefault:
             footerTitle = kSLDefaultSkipDatesAndHolidaysString;
             break;
@@ -786,6 +1023,11 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
             [self tableView:tableView didSelectHolidayCountry:[self offsetHolidayCountryIndexForIndex:indexPath.row increase:YES]];
             break;
         }
+        case kSLSkipDatesViewControllerSectionSkipProfile: {
+            [tableView deselectRowAtIndexPath:indexPath animated:YES];
+            [self presentSkipProfileAlertControllerFromIndexPath:indexPath];
+            break;
+        }
         case kSLSkipDatesViewControllerSectionResetDefault: {
             [tableView deselectRowAtIndexPath:indexPath animated:YES];
 
@@ -803,7 +1045,9 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
     if (resourceName != nil) {
         // create a new holiday selection controller with the list of holidays for the user to configure
-        SLHolidaySelectionTableViewController *holidaySelectionTableViewController = [[SLHolidaySelectionTableViewController alloc] initWithSelectedHolidays:[self.holidaySkipDates objectForKey:resourceName]
+        NSString *parentResourceName = [SLPrefsManager resourceNameForHolidayCountry:kSLHolidayCountryInfo[holidayCountry].parentCountry];
+        SLHolidaySelectionTableViewController *holidaySelectionTableViewController = [[SLHolidaySelectionTableViewController alloc] initWithHolidaySelection:[[self.holidaySkipDates objectForKey:resourceName] unsignedLongLongValue]
+                                                                                                                                      parentHolidaySelection:[[self.holidaySkipDates objectForKey:parentResourceName] unsignedLongLongValue]
                                                                                                                                              holidayResource:[self.holidayResources objectForKey:resourceName]
                                                                                                                                             inHolidayCountry:holidayCountry];
         holidaySelectionTableViewController.delegate = self;
@@ -928,15 +1172,37 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
 #pragma mark - SLHolidaySelectionDelegate
 
 // invoked when the holiday selection controller returns with updated holidays
-- (void)SLHolidaySelectionTableViewController:(SLHolidaySelectionTableViewController *)holidaySelectionTableViewController didUpdateSelectedHolidays:(NSArray *)selectedHolidays forHolidayCountry:(SLHolidayCountry)holidayCountry
+- (void)SLHolidaySelectionTableViewController:(SLHolidaySelectionTableViewController *)holidaySelectionTableViewController didUpdateHolidaySelection:(SLHolidaySelection)holidaySelection parentHolidaySelection:(SLHolidaySelection)parentHolidaySelection forHolidayCountry:(SLHolidayCountry)holidayCountry
 {
-    // update the row that corresponds to the holiday country
-    NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
+    // set the new selected holidays for the holiday country along with its country (if it is a subdivision)
+    SLHolidayCountry parentCountry = kSLHolidayCountryInfo[holidayCountry].parentCountry;
+    [self setHolidaySelection:holidaySelection forHolidayCountry:holidayCountry];
+    if (parentCountry != holidayCountry) {
+        [self setHolidaySelection:parentHolidaySelection forHolidayCountry:parentCountry];
+    }
 
-    // set the new selected holidays
-    [self.holidaySkipDates setObject:selectedHolidays forKey:resourceName];
+    // refresh the table UI, where the country and all of its subdivisions display the holidays that the subdivisions observe from it
+    for (SLHolidayCountry region = 0; region < kSLHolidayCountryNumRegions; region++) {
+        if (kSLHolidayCountryInfo[region].parentCountry == parentCountry) {
+            [self reloadRowForHolidayCountry:region];
+        }
+    }
+}
+
+// sets the selected holidays for the given holiday country (countries without any selected holidays are not saved)
+- (void)setHolidaySelection:(SLHolidaySelection)holidaySelection forHolidayCountry:(SLHolidayCountry)holidayCountry
+{
+    NSString *resourceName = [SLPrefsManager resourceNameForHolidayCountry:holidayCountry];
+    if (holidaySelection != 0) {
+        [self.holidaySkipDates setObject:[NSNumber numberWithUnsignedLongLong:holidaySelection] forKey:resourceName];
+    } else {
+        [self.holidaySkipDates removeObjectForKey:resourceName];
+    }
+}
 
-    // refresh the table UI
+// reloads the row that corresponds to the holiday country
+- (void)reloadRowForHolidayCountry:(SLHolidayCountry)holidayCountry
+{
     if (self.deviceHolidayCountry == holidayCountry) {
         [self.tableView reloadRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:0 inSection:kSLSkipDatesViewControllerSectionRecommendedHolidays]]
                               withRowAnimation:UITableViewRowAnimationFade];
@@ -946,4 +1212,20 @@ typedef enum SLSkipDatesViewControllerSection : NSInteger {
     }
 }
 
+#pragma mark - UIDocumentPickerDelegate
+
+// invoked when the user picks a calendar file to import (iOS 11 and later)
+- (void)documentPicker:(UIDocumentPickerViewController *)controller didPickDocumentsAtURLs:(NSArray<NSURL *> *)urls
+{
+    if (urls.count > 0) {
+        [self importCalendarFileAtURL:urls.firstObject];
+    }
+}
+
+// invoked when the user picks a calendar file to import
+- (void)documentPicker:(UIDocumentPickerViewController *)controller didPickDocumentAtURL:(NSURL *)url
+{
+    [self importCalendarFileAtURL:url];
+}
+
 @end